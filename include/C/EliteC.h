@@ -0,0 +1,404 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright (c) 2025, Elite Robots. */
+/*
+ * EliteC.h
+ * A stable C ABI over EliteDriver, RtsiIOInterface and DashboardClient, for C and foreign function interfaces.
+ */
+#ifndef __ELITE__C_API_H__
+#define __ELITE__C_API_H__
+
+#include <Elite/EliteOptions.hpp>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Version of the C ABI. It only grows when a function or a struct changes incompatibly, check it with
+ * elite_c_abi_version() when the library is loaded at run time.
+ *
+ * The handles are opaque, the structs only have fixed size fields, no C++ type crosses the ABI and no exception leaves a
+ * function: every failure is returned as an elite_status_t and described by elite_last_error().
+ */
+#define ELITE_C_ABI_VERSION 1
+
+typedef enum {
+    ELITE_OK = 0,
+    /// A pointer is NULL or a parameter is out of range
+    ELITE_ERR_INVALID_ARGUMENT = 1,
+    /// The connection failed or is lost
+    ELITE_ERR_SOCKET = 2,
+    /// No reply in time
+    ELITE_ERR_TIMEOUT = 3,
+    /// The robot rejected or could not execute the request
+    ELITE_ERR_FAILED = 4,
+    /// A string does not fit in the buffer of the caller, it is truncated
+    ELITE_ERR_BUFFER_TOO_SMALL = 5,
+    /// An unexpected SDK error
+    ELITE_ERR_INTERNAL = 6,
+} elite_status_t;
+
+typedef struct elite_driver elite_driver_t;
+typedef struct elite_rtsi elite_rtsi_t;
+typedef struct elite_dashboard elite_dashboard_t;
+
+/**
+ * @brief The C ABI version of the library, ELITE_C_ABI_VERSION when it was built
+ *
+ */
+ELITE_EXPORT uint32_t elite_c_abi_version(void);
+
+/**
+ * @brief The SDK version, e.g. "1.3.0"
+ *
+ */
+ELITE_EXPORT const char* elite_sdk_version(void);
+
+/**
+ * @brief The message of the last failure of the calling thread, "" if none. Valid until the next call of the thread.
+ *
+ */
+ELITE_EXPORT const char* elite_last_error(void);
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * EliteDriver
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief See EliteDriverConfig. Initialize it with elite_driver_config_init() to get the defaults.
+ *
+ */
+typedef struct {
+    const char* robot_ip;
+    const char* script_file_path;
+    /// NULL or "" for any local interface
+    const char* local_ip;
+    bool headless_mode;
+    int32_t script_sender_port;
+    int32_t reverse_port;
+    int32_t trajectory_port;
+    int32_t script_command_port;
+    float servoj_time;
+    float servoj_lookahead_time;
+    int32_t servoj_gain;
+    float stopj_acc;
+} elite_driver_config_t;
+
+/// TrajectoryMotionResult: 0 success, 1 canceled, 2 failure
+typedef void (*elite_trajectory_result_callback_t)(int32_t result, void* context);
+
+/// DriverServer: 0 reverse, 1 trajectory, 2 script command
+typedef void (*elite_connection_callback_t)(int32_t server, bool connected, void* context);
+
+/**
+ * @brief A robot exception. The fields which do not apply to the type are 0.
+ *
+ */
+typedef struct {
+    /// RobotException::Type: -1 robot disconnected, 6 robot error, 10 script runtime
+    int32_t type;
+    /// Milliseconds
+    uint64_t timestamp;
+    /// Robot error
+    int32_t error_code;
+    int32_t sub_error_code;
+    int32_t error_source;
+    int32_t error_level;
+    /// Script runtime exception
+    int32_t line;
+    int32_t column;
+    /// Script runtime message, valid during the callback
+    const char* message;
+} elite_robot_exception_t;
+
+typedef void (*elite_robot_exception_callback_t)(const elite_robot_exception_t* exception, void* context);
+
+ELITE_EXPORT void elite_driver_config_init(elite_driver_config_t* config);
+
+/**
+ * @brief Create the driver. It binds the driver servers and connects the primary port.
+ *
+ * @param config Configuration
+ * @param driver The driver, NULL on failure
+ */
+ELITE_EXPORT elite_status_t elite_driver_create(const elite_driver_config_t* config, elite_driver_t** driver);
+
+ELITE_EXPORT void elite_driver_destroy(elite_driver_t* driver);
+
+ELITE_EXPORT bool elite_driver_is_robot_connected(elite_driver_t* driver);
+
+ELITE_EXPORT elite_status_t elite_driver_send_external_control_script(elite_driver_t* driver);
+
+ELITE_EXPORT elite_status_t elite_driver_write_servoj(elite_driver_t* driver, const double pos[6], int32_t timeout_ms,
+                                                      bool cartesian, bool queue_mode);
+
+ELITE_EXPORT elite_status_t elite_driver_write_speedj(elite_driver_t* driver, const double vel[6], int32_t timeout_ms);
+
+ELITE_EXPORT elite_status_t elite_driver_write_speedl(elite_driver_t* driver, const double vel[6], int32_t timeout_ms);
+
+ELITE_EXPORT elite_status_t elite_driver_write_idle(elite_driver_t* driver, int32_t timeout_ms);
+
+/// action: FreedriveAction, -1 end, 0 noop, 1 start
+ELITE_EXPORT elite_status_t elite_driver_write_freedrive(elite_driver_t* driver, int32_t action, int32_t timeout_ms);
+
+ELITE_EXPORT elite_status_t elite_driver_write_trajectory_point(elite_driver_t* driver, const double positions[6], float time,
+                                                                float blend_radius, bool cartesian);
+
+/// action: TrajectoryControlAction, -1 cancel, 0 noop, 1 start
+ELITE_EXPORT elite_status_t elite_driver_write_trajectory_control_action(elite_driver_t* driver, int32_t action,
+                                                                         int32_t point_number, int32_t timeout_ms);
+
+ELITE_EXPORT elite_status_t elite_driver_stop_control(elite_driver_t* driver, int32_t wait_ms);
+
+ELITE_EXPORT elite_status_t elite_driver_send_script(elite_driver_t* driver, const char* script);
+
+ELITE_EXPORT elite_status_t elite_driver_zero_ft_sensor(elite_driver_t* driver);
+
+ELITE_EXPORT elite_status_t elite_driver_set_payload(elite_driver_t* driver, double mass, const double cog[3]);
+
+/**
+ * @brief Set a callback, NULL removes it. The callbacks run in the SDK threads and must not block. When a setter returns,
+ * the callback it replaced is no longer running and won't be called again, so its context can be freed. A setter may be
+ * called from inside the callback it replaces.
+ *
+ */
+ELITE_EXPORT elite_status_t elite_driver_set_trajectory_result_callback(elite_driver_t* driver,
+                                                                        elite_trajectory_result_callback_t callback,
+                                                                        void* context);
+
+ELITE_EXPORT elite_status_t elite_driver_set_connection_callback(elite_driver_t* driver, elite_connection_callback_t callback,
+                                                                 void* context);
+
+ELITE_EXPORT elite_status_t elite_driver_set_robot_exception_callback(elite_driver_t* driver,
+                                                                      elite_robot_exception_callback_t callback, void* context);
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * RtsiIOInterface
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Bits of elite_rtsi_snapshot_t::fields, a field is valid if its variable is in the output recipe
+ *
+ */
+typedef enum {
+    ELITE_RTSI_TIMESTAMP = 1ull << 0,
+    ELITE_RTSI_TARGET_JOINT_POSITIONS = 1ull << 1,
+    ELITE_RTSI_TARGET_JOINT_SPEEDS = 1ull << 2,
+    ELITE_RTSI_ACTUAL_JOINT_POSITIONS = 1ull << 3,
+    ELITE_RTSI_ACTUAL_JOINT_SPEEDS = 1ull << 4,
+    ELITE_RTSI_ACTUAL_JOINT_TORQUES = 1ull << 5,
+    ELITE_RTSI_ACTUAL_JOINT_CURRENT = 1ull << 6,
+    ELITE_RTSI_JOINT_TEMPERATURES = 1ull << 7,
+    ELITE_RTSI_ACTUAL_TCP_POSE = 1ull << 8,
+    ELITE_RTSI_ACTUAL_TCP_SPEED = 1ull << 9,
+    ELITE_RTSI_ACTUAL_TCP_FORCE = 1ull << 10,
+    ELITE_RTSI_TARGET_TCP_POSE = 1ull << 11,
+    ELITE_RTSI_TARGET_TCP_SPEED = 1ull << 12,
+    ELITE_RTSI_ELBOW_POSITION = 1ull << 13,
+    ELITE_RTSI_ELBOW_VELOCITY = 1ull << 14,
+    ELITE_RTSI_PAYLOAD_MASS = 1ull << 15,
+    ELITE_RTSI_PAYLOAD_COG = 1ull << 16,
+    ELITE_RTSI_SPEED_SCALING = 1ull << 17,
+    ELITE_RTSI_TARGET_SPEED_FRACTION = 1ull << 18,
+    ELITE_RTSI_ACTUAL_ROBOT_VOLTAGE = 1ull << 19,
+    ELITE_RTSI_ACTUAL_ROBOT_CURRENT = 1ull << 20,
+    ELITE_RTSI_ROBOT_MODE = 1ull << 21,
+    ELITE_RTSI_SAFETY_STATUS = 1ull << 22,
+    ELITE_RTSI_RUNTIME_STATE = 1ull << 23,
+    ELITE_RTSI_JOINT_MODE = 1ull << 24,
+    ELITE_RTSI_ROBOT_STATUS_BITS = 1ull << 25,
+    ELITE_RTSI_SAFETY_STATUS_BITS = 1ull << 26,
+    ELITE_RTSI_ACTUAL_DIGITAL_INPUT_BITS = 1ull << 27,
+    ELITE_RTSI_ACTUAL_DIGITAL_OUTPUT_BITS = 1ull << 28,
+    ELITE_RTSI_SCRIPT_CONTROL_LINE = 1ull << 29,
+} elite_rtsi_field_t;
+
+/**
+ * @brief The state of the robot after the newest RTSI frame. Fields whose variable is not in the output recipe are 0.
+ *
+ * The receive thread updates it in place, guarded by 'sequence' like a sequence lock: 'sequence' is odd while a frame is
+ * written and grows by 2 for every frame. A zero-copy reader loads 'sequence' (acquire), retries if it is odd, copies the
+ * fields, and retries if 'sequence' changed meanwhile. elite_rtsi_read_snapshot() does it.
+ */
+typedef struct {
+    uint64_t sequence;
+    /// elite_rtsi_field_t bits of the valid fields
+    uint64_t fields;
+    /// Frames received since connect()
+    uint64_t frame_count;
+    double timestamp;
+    double target_joint_positions[6];
+    double target_joint_speeds[6];
+    double actual_joint_positions[6];
+    double actual_joint_speeds[6];
+    double actual_joint_torques[6];
+    double actual_joint_current[6];
+    double joint_temperatures[6];
+    double actual_TCP_pose[6];
+    double actual_TCP_speed[6];
+    double actual_TCP_force[6];
+    double target_TCP_pose[6];
+    double target_TCP_speed[6];
+    double elbow_position[3];
+    double elbow_velocity[3];
+    double payload_mass;
+    double payload_cog[3];
+    double speed_scaling;
+    double target_speed_fraction;
+    double actual_robot_voltage;
+    double actual_robot_current;
+    int32_t robot_mode;
+    int32_t safety_status;
+    int32_t runtime_state;
+    int32_t joint_mode[6];
+    uint32_t robot_status_bits;
+    uint32_t safety_status_bits;
+    uint32_t actual_digital_input_bits;
+    uint32_t actual_digital_output_bits;
+    uint32_t script_control_line;
+} elite_rtsi_snapshot_t;
+
+/**
+ * @brief Called in the RTSI receive thread after the snapshot is updated, it must not block
+ *
+ */
+typedef void (*elite_rtsi_frame_callback_t)(const elite_rtsi_snapshot_t* snapshot, void* context);
+
+/**
+ * @brief Create the RTSI interface
+ *
+ * @param output_recipe Output variable names
+ * @param output_count Number of output variables
+ * @param input_recipe Input variable names, may be NULL if input_count is 0
+ * @param input_count Number of input variables
+ * @param frequency Output frequency
+ * @param rtsi The interface, NULL on failure
+ */
+ELITE_EXPORT elite_status_t elite_rtsi_create(const char* const* output_recipe, size_t output_count,
+                                              const char* const* input_recipe, size_t input_count, double frequency,
+                                              elite_rtsi_t** rtsi);
+
+ELITE_EXPORT void elite_rtsi_destroy(elite_rtsi_t* rtsi);
+
+ELITE_EXPORT elite_status_t elite_rtsi_connect(elite_rtsi_t* rtsi, const char* ip);
+
+ELITE_EXPORT void elite_rtsi_disconnect(elite_rtsi_t* rtsi);
+
+ELITE_EXPORT bool elite_rtsi_is_connected(elite_rtsi_t* rtsi);
+
+ELITE_EXPORT bool elite_rtsi_is_started(elite_rtsi_t* rtsi);
+
+/**
+ * @brief The controller version, 0 if not connected
+ *
+ * @param version major, minor, bugfix, build
+ */
+ELITE_EXPORT elite_status_t elite_rtsi_get_controller_version(elite_rtsi_t* rtsi, uint32_t version[4]);
+
+/**
+ * @brief The snapshot, updated in place by the receive thread. Valid until elite_rtsi_destroy().
+ *
+ */
+ELITE_EXPORT const volatile elite_rtsi_snapshot_t* elite_rtsi_snapshot(elite_rtsi_t* rtsi);
+
+/**
+ * @brief Copy a consistent snapshot
+ *
+ * @param snapshot Output
+ */
+ELITE_EXPORT elite_status_t elite_rtsi_read_snapshot(elite_rtsi_t* rtsi, elite_rtsi_snapshot_t* snapshot);
+
+/**
+ * @brief Set the frame callback, NULL removes it. When it returns, a removed callback is no longer running. It may be called
+ * from inside the frame callback, e.g. to remove it.
+ *
+ */
+ELITE_EXPORT elite_status_t elite_rtsi_set_frame_callback(elite_rtsi_t* rtsi, elite_rtsi_frame_callback_t callback,
+                                                          void* context);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_speed_scaling(elite_rtsi_t* rtsi, double scaling);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_standard_digital(elite_rtsi_t* rtsi, int32_t index, bool level);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_configure_digital(elite_rtsi_t* rtsi, int32_t index, bool level);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_analog_output_voltage(elite_rtsi_t* rtsi, int32_t index, double value);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_tool_digital_output(elite_rtsi_t* rtsi, int32_t index, bool level);
+
+/**
+ * @brief Write consecutive input registers, in the same frame
+ *
+ */
+ELITE_EXPORT elite_status_t elite_rtsi_set_input_int_registers(elite_rtsi_t* rtsi, int32_t start, const int32_t* values,
+                                                               int32_t count);
+
+ELITE_EXPORT elite_status_t elite_rtsi_set_input_double_registers(elite_rtsi_t* rtsi, int32_t start, const double* values,
+                                                                  int32_t count);
+
+ELITE_EXPORT elite_status_t elite_rtsi_get_out_int_register(elite_rtsi_t* rtsi, int32_t index, int32_t* value);
+
+ELITE_EXPORT elite_status_t elite_rtsi_get_out_double_register(elite_rtsi_t* rtsi, int32_t index, double* value);
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * DashboardClient
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+ELITE_EXPORT elite_status_t elite_dashboard_create(elite_dashboard_t** dashboard);
+
+ELITE_EXPORT void elite_dashboard_destroy(elite_dashboard_t* dashboard);
+
+/// port: 0 for the default port 29999
+ELITE_EXPORT elite_status_t elite_dashboard_connect(elite_dashboard_t* dashboard, const char* ip, int32_t port);
+
+ELITE_EXPORT void elite_dashboard_disconnect(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_echo(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_power_on(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_power_off(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_brake_release(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_close_safety_dialog(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_unlock_protective_stop(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_safety_system_restart(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_play_program(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_pause_program(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_stop_program(elite_dashboard_t* dashboard);
+
+ELITE_EXPORT elite_status_t elite_dashboard_load_task(elite_dashboard_t* dashboard, const char* path);
+
+ELITE_EXPORT elite_status_t elite_dashboard_set_speed_scaling(elite_dashboard_t* dashboard, int32_t scaling);
+
+/// RobotMode, SafetyMode and TaskStatus as integers
+ELITE_EXPORT elite_status_t elite_dashboard_robot_mode(elite_dashboard_t* dashboard, int32_t* mode);
+
+ELITE_EXPORT elite_status_t elite_dashboard_safety_mode(elite_dashboard_t* dashboard, int32_t* mode);
+
+ELITE_EXPORT elite_status_t elite_dashboard_task_status(elite_dashboard_t* dashboard, int32_t* status);
+
+/**
+ * @brief Send a command and copy the reply to 'reply', always zero terminated
+ *
+ * @param reply Buffer of the caller
+ * @param reply_size Size of the buffer. ELITE_ERR_BUFFER_TOO_SMALL if the reply is truncated.
+ */
+ELITE_EXPORT elite_status_t elite_dashboard_send_and_receive(elite_dashboard_t* dashboard, const char* command, char* reply,
+                                                             size_t reply_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
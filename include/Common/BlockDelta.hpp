@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// BlockDelta.hpp
+// rsync style block signatures and deltas, used by the delta transfer of the control software upgrade.
+#ifndef __ELITE__BLOCK_DELTA_HPP__
+#define __ELITE__BLOCK_DELTA_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ELITE {
+
+namespace DELTA {
+
+/**
+ * @brief Rolling checksum of a window (the rsync weak checksum)
+ *
+ */
+class RollingHash {
+   public:
+    RollingHash() : a_(0), b_(0), length_(0) {}
+
+    /**
+     * @brief Start a window
+     *
+     */
+    void reset(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Move the window one byte forward
+     *
+     * @param out The first byte of the window
+     * @param in The byte after the window
+     */
+    void roll(uint8_t out, uint8_t in) {
+        a_ += in - out;
+        b_ += a_ - (uint32_t)length_ * out;
+    }
+
+    uint32_t value() const { return (a_ & 0xffff) | (b_ << 16); }
+
+   private:
+    uint32_t a_;
+    uint32_t b_;
+    size_t length_;
+};
+
+/**
+ * @brief 64-bit FNV-1a, the strong checksum of a block
+ *
+ */
+uint64_t strongHash(const uint8_t* data, size_t length);
+
+/**
+ * @brief MD5 of the data as a lowercase hex string, like the output of md5sum
+ *
+ */
+std::string md5Hex(const uint8_t* data, size_t length);
+
+struct BlockSignature {
+    uint32_t weak;
+    uint64_t strong;
+};
+
+/**
+ * @brief The signatures of the full blocks of a file, the last partial block is not matched
+ *
+ */
+std::vector<BlockSignature> signatures(const uint8_t* data, size_t size, size_t block_size);
+
+/**
+ * @brief One step of the reconstruction
+ *
+ */
+struct DeltaOp {
+    enum Type { COPY, LITERAL };
+    Type type;
+    /// COPY: byte offset in the old file, a multiple of the block size. LITERAL: byte offset in the literals.
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+ * @brief The new file as copies of old blocks and literal bytes
+ *
+ */
+struct Delta {
+    size_t block_size = 0;
+    std::vector<DeltaOp> ops;
+    std::vector<uint8_t> literals;
+    /// Bytes copied from the old file
+    uint64_t copied = 0;
+};
+
+/**
+ * @brief Find the blocks of the old file in the new one with the rolling checksum. Consecutive copies are merged.
+ *
+ * @param old_signatures signatures() of the old file
+ * @param block_size The block size of the signatures
+ * @param data The new file
+ * @param size Size of the new file
+ */
+Delta computeDelta(const std::vector<BlockSignature>& old_signatures, size_t block_size, const uint8_t* data, size_t size);
+
+/**
+ * @brief Rebuild the new file
+ *
+ * @return std::vector<uint8_t> The new file, empty if a copy is out of the old file
+ */
+std::vector<uint8_t> applyDelta(const uint8_t* old_data, size_t old_size, const Delta& delta);
+
+/**
+ * @brief A POSIX shell script rebuilding the new file on the controller with dd, tail and head
+ *
+ * @param delta The delta
+ * @param old_path The old file on the controller
+ * @param literal_path The literals of the delta, uploaded to the controller
+ * @param new_path The new file to write
+ */
+std::string patchScript(const Delta& delta, const std::string& old_path, const std::string& literal_path,
+                        const std::string& new_path);
+
+}  // namespace DELTA
+
+}  // namespace ELITE
+
+#endif
@@ -148,6 +148,41 @@ class EndianUtils {
         return result;
     }
 
+    /**
+     * @brief Append an value which is base type to the end of a byte buffer
+     *
+     * @tparam T Must base type
+     * @param out The byte buffer. When its capacity is enough, no memory is allocated.
+     * @param value Will be converted value
+     */
+    template <typename T>
+    static void packTo(std::vector<uint8_t>& out, const T value) {
+        static_assert(std::is_fundamental<T>::value, "must use base type");
+        union {
+            T value;
+            uint8_t bytes[sizeof(T)];
+        } msg;
+        msg.value = value;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out.push_back(msg.bytes[(sizeof(T) - 1) - i]);
+        }
+    }
+
+    /**
+     * @brief Append an array to the end of a byte buffer
+     *
+     * @tparam T The type in array
+     * @tparam size Array size
+     * @param out The byte buffer
+     * @param value Will be converted array
+     */
+    template <typename T, int size>
+    static void packTo(std::vector<uint8_t>& out, const std::array<T, size>& value) {
+        for (size_t i = 0; i < size; i++) {
+            packTo<T>(out, value[i]);
+        }
+    }
+
     /**
      * @brief Pack an array to bytes
      *
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// GzipStream.hpp
+// Streaming gzip decompression, used by the compressed controller log download.
+#ifndef __ELITE__GZIP_STREAM_HPP__
+#define __ELITE__GZIP_STREAM_HPP__
+
+#ifdef ELITE_USE_ZLIB
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief Decompresses a gzip stream chunk by chunk, as it arrives. Concatenated gzip members are decompressed one after the
+ * other, like gunzip does.
+ *
+ */
+class GzipInflater {
+   public:
+    /**
+     * @brief The output of the decompression
+     *
+     * @return false stop the decompression
+     */
+    using OutputCallback = std::function<bool(const char* data, size_t size)>;
+
+    GzipInflater();
+    ~GzipInflater();
+    GzipInflater(const GzipInflater&) = delete;
+    GzipInflater& operator=(const GzipInflater&) = delete;
+
+    /**
+     * @brief Decompress a chunk of the stream
+     *
+     * @param data Compressed data
+     * @param size Size of the data
+     * @param output Receives the decompressed data
+     * @return true success
+     * @return false the data is not a valid gzip stream, or the output stopped the decompression
+     */
+    bool feed(const char* data, size_t size, const OutputCallback& output);
+
+    /**
+     * @brief Whether the stream ended at the end of a gzip member
+     *
+     */
+    bool finished() const { return finished_; }
+
+    uint64_t compressedBytes() const { return compressed_; }
+
+    uint64_t uncompressedBytes() const { return uncompressed_; }
+
+   private:
+    z_stream stream_;
+    bool initialized_;
+    bool finished_;
+    uint64_t compressed_;
+    uint64_t uncompressed_;
+    std::vector<char> buffer_;
+};
+
+}  // namespace ELITE
+
+#endif  // ELITE_USE_ZLIB
+
+#endif
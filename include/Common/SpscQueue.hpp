@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// SpscQueue.hpp
+// A bounded lock-free single producer single consumer queue.
+#ifndef __ELITE__SPSC_QUEUE_HPP__
+#define __ELITE__SPSC_QUEUE_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * @tparam T Element type, must be default constructible and move assignable
+ */
+template <typename T>
+class SpscQueue {
+   public:
+    /**
+     * @brief Construct a new Spsc Queue object
+     *
+     * @param capacity Minimum capacity, rounded up to a power of two
+     */
+    explicit SpscQueue(size_t capacity) : head_(0), tail_(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    /**
+     * @brief Push an element. Only called by the producer thread.
+     *
+     * @return true success
+     * @return false the queue is full
+     */
+    template <typename U>
+    bool push(U&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= buffer_.size()) {
+            return false;
+        }
+        buffer_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an element. Only called by the consumer thread.
+     *
+     * @param value The element
+     * @return true success
+     * @return false the queue is empty
+     */
+    bool pop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(buffer_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of elements
+     *
+     */
+    size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return buffer_.size(); }
+
+   private:
+    std::vector<T> buffer_;
+    size_t mask_;
+    // Keep the producer and consumer indexes in different cache lines.
+    std::atomic<size_t> head_;
+    char head_pad_[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail_;
+    char tail_pad_[64 - sizeof(std::atomic<size_t>)];
+};
+
+}  // namespace ELITE
+
+#endif
@@ -24,6 +24,21 @@ namespace SSH_UTILS {
  */
 std::string executeCommand(const std::string &host, const std::string &user, const std::string &password, const std::string &cmd);
 
+/**
+ * @brief Log in to the server via SSH, execute a command, and pass its output to a callback as it arrives, without buffering
+ * the whole output. Suited to large or binary outputs, like a compressed file.
+ *
+ * @param host SSH server IP
+ * @param user user name
+ * @param password user password
+ * @param cmd Want execute commands
+ * @param output_cb Receives the output chunks. Return false to stop reading.
+ * @return true The command exited with status 0 and all of its output was read
+ * @return false fail
+ */
+bool executeCommandStream(const std::string &host, const std::string &user, const std::string &password, const std::string &cmd,
+                          std::function<bool(const char *data, size_t size)> output_cb);
+
 /**
  * @brief Download files via SCP.
  *
@@ -8,10 +8,13 @@
 
 #include <atomic>
 #include <boost/asio.hpp>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace ELITE {
@@ -29,22 +32,74 @@ class TcpServer : public std::enable_shared_from_this<TcpServer> {
         ~StaticResource();
         void shutdown();
 
+        /**
+         * @brief Provide listening sockets created by another process, e.g. a process manager which keeps them across restarts
+         *  of this process. A TcpServer created later takes the socket bound to its port instead of binding a new one.
+         *  Descriptors which are not listening TCP sockets are ignored. Only supported on Linux.
+         *
+         * @param fds Listening socket descriptors
+         * @return int The number of sockets added
+         */
+        int addListenSockets(const std::vector<int>& fds);
+
+        /**
+         * @brief Provide a listening socket for a port, whatever port it is bound to
+         *
+         * @param fd The socket descriptor
+         * @param port The port of the server which takes it
+         * @return true The socket is added
+         * @return false It is not a listening TCP socket, or not on Linux
+         */
+        bool addListenSocket(int fd, int port);
+
+        /**
+         * @brief Take the listening socket bound to a port out of the provided sockets
+         *
+         * @param port The port
+         * @return int The socket descriptor, -1 if there is none.
+         */
+        int takeListenSocket(int port);
+
         StaticResource(const StaticResource&) = delete;
         StaticResource& operator=(const StaticResource&) = delete;
 
        private:
         std::atomic<bool> shutting_down_{false};
+        std::mutex listen_fds_mutex_;
+        // port : listening socket
+        std::unordered_map<int, int> listen_fds_;
+    };
+
+    /**
+     * @brief A listening socket passed by systemd socket activation
+     *
+     */
+    struct ActivationSocket {
+        int fd;
+        // From 'LISTEN_FDNAMES' (FileDescriptorName= of the socket unit), empty if not passed
+        std::string name;
     };
 
+    /**
+     * @brief Get the listening sockets passed by systemd socket activation ('LISTEN_PID', 'LISTEN_FDS' and 'LISTEN_FDNAMES').
+     *
+     * @return std::vector<ActivationSocket> The sockets with their names, empty if there is none or not on Linux.
+     */
+    static std::vector<ActivationSocket> activationListenSockets();
+
     // Read callback
     using ReceiveCallback = std::function<void(const uint8_t[], int)>;
 
+    // Connection state callback, called when the client connects or disconnects
+    using ConnectionCallback = std::function<void(bool connected, std::chrono::steady_clock::time_point timestamp)>;
+
     /**
      * @brief Construct a new Tcp Server object
      *
      * @param port Listen port
      * @param recv_buf_size
-     * @note Ensure that the start() method has been called before instantiation
+     * @note Ensure that the start() method has been called before instantiation. If the resource provides a listening socket
+     * bound to 'port', that socket is used.
      */
     TcpServer(int port, int recv_buf_size, std::shared_ptr<StaticResource> resource);
 
@@ -67,6 +122,15 @@ class TcpServer : public std::enable_shared_from_this<TcpServer> {
      */
     void unsetReceiveCallback();
 
+    /**
+     * @brief Set the connection state callback.
+     *  It is called in the io_context thread shared by all servers, and must not call this server's functions other than
+     *  isClientConnected().
+     *
+     * @param cb connection callback, nullptr to unset. No call is in progress after this function returns.
+     */
+    void setConnectionCallback(ConnectionCallback cb);
+
     /**
      * @brief Write data to client
      *
@@ -83,12 +147,12 @@ class TcpServer : public std::enable_shared_from_this<TcpServer> {
     void startListen();
 
     /**
-     * @brief Determine if there is a client connected
+     * @brief Determine if there is a client connected. Doesn't lock.
      *
      * @return true Connected
      * @return false Disconnected
      */
-    bool isClientConnected();
+    bool isClientConnected() { return connected_.load(std::memory_order_acquire); }
 
    protected:
     std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
@@ -105,6 +169,11 @@ class TcpServer : public std::enable_shared_from_this<TcpServer> {
     std::mutex receive_cb_mutex_;
     std::mutex socket_mutex_;
 
+    // Updated on accept and close
+    std::atomic<bool> connected_{false};
+    ConnectionCallback connection_cb_;
+    std::mutex connection_cb_mutex_;
+
     /**
      * @brief Async accept client connection and add async read task
      *
@@ -133,6 +202,14 @@ class TcpServer : public std::enable_shared_from_this<TcpServer> {
      * @param size received data size
      */
     void callReceiveCallback(const uint8_t data[], int size);
+
+    /**
+     * @brief Update the connection state and call the connection callback if it changed.
+     *  Must be called without 'socket_mutex_' locked.
+     *
+     * @param connected New state
+     */
+    void updateConnectionState(bool connected);
 };
 
 }  // namespace ELITE
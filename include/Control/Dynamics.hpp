@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// Dynamics.hpp
+// Inverse dynamics of the robot with the recursive Newton-Euler algorithm, from the DH parameters and the link inertias.
+#ifndef __ELITE__DYNAMICS_HPP__
+#define __ELITE__DYNAMICS_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/Kinematics.hpp>
+
+#include <array>
+
+namespace ELITE {
+
+/**
+ * @brief The inertia of a link, in the DH frame of the link (frame i for link i, the flange frame for link 6)
+ *
+ */
+struct LinkInertia {
+    /// Mass (kg)
+    double mass = 0;
+    /// Center of mass (m)
+    vector3d_t com{};
+    /// Inertia tensor about the center of mass (kg*m^2): Ixx, Iyy, Izz, Ixy, Ixz, Iyz
+    vector6d_t inertia{};
+};
+
+/**
+ * @brief Inverse dynamics of a 6 joint arm with standard DH parameters.
+ *
+ * The joint torques are computed with the recursive Newton-Euler algorithm in the link frames, with fixed-size arrays and without
+ * allocation, in about a microsecond, so it can run in the RTSI receive thread every frame. The link inertias are not reported
+ * by the robot and have to be supplied. The payload is added to link 6 as a point mass.
+ */
+class Dynamics {
+   public:
+    /**
+     * @brief Construct a new Dynamics object
+     *
+     * @param kinematics The DH parameters of the robot, the TCP offset is not used
+     * @param links The inertias of links 1~6
+     * @param gravity The gravity in the base frame (m/s^2)
+     */
+    ELITE_EXPORT Dynamics(const Kinematics& kinematics, const std::array<LinkInertia, 6>& links,
+                          const vector3d_t& gravity = vector3d_t{0, 0, -9.81});
+
+    /**
+     * @brief Set the payload, like EliteDriver::setPayload()
+     *
+     * @param mass Mass (kg)
+     * @param cog Center of gravity in the flange frame (m)
+     */
+    ELITE_EXPORT void setPayload(double mass, const vector3d_t& cog);
+
+    /**
+     * @brief The joint torques of a motion
+     *
+     * @param q Joint positions (rad)
+     * @param qd Joint speeds (rad/s)
+     * @param qdd Joint accelerations (rad/s^2)
+     * @param torques The joint torques (N*m)
+     */
+    ELITE_EXPORT void inverseDynamics(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& qdd,
+                                      vector6d_t& torques) const;
+
+    /**
+     * @brief The joint torques holding the arm still against the gravity
+     *
+     */
+    ELITE_EXPORT vector6d_t gravityTorques(const vector6d_t& q) const;
+
+   private:
+    void updateFlange();
+
+    Kinematics kinematics_;
+    std::array<LinkInertia, 6> links_;
+    // Link 6 with the payload
+    LinkInertia flange_;
+    double payload_mass_;
+    vector3d_t payload_cog_;
+    vector3d_t gravity_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// Kinematics.hpp
+// Forward kinematics, Jacobian and damped least squares of the robot, from the DH parameters.
+#ifndef __ELITE__KINEMATICS_HPP__
+#define __ELITE__KINEMATICS_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RobotConfPackage.hpp>
+
+#include <array>
+
+namespace ELITE {
+
+/// A 6x6 matrix, row major
+using matrix6d_t = std::array<vector6d_t, 6>;
+
+/**
+ * @brief Kinematics of a 6 joint arm with standard DH parameters, as reported by the robot in KinematicsInfo.
+ *
+ * Everything is computed with fixed-size arrays, without allocation, so it can run in the RTSI receive thread every frame.
+ * Poses are [x, y, z, rx, ry, rz] in the base frame with a rotation vector, like "actual_TCP_pose".
+ */
+class Kinematics {
+   public:
+    /**
+     * @brief Construct with all DH parameters zero
+     *
+     */
+    ELITE_EXPORT Kinematics();
+
+    /**
+     * @brief Construct from DH parameters
+     *
+     * @param dh_a Link lengths (m)
+     * @param dh_d Link offsets (m)
+     * @param dh_alpha Link twists (rad)
+     */
+    ELITE_EXPORT Kinematics(const vector6d_t& dh_a, const vector6d_t& dh_d, const vector6d_t& dh_alpha);
+
+    /**
+     * @brief Construct from the DH parameters of the robot
+     *
+     * @param info The kinematics information of the primary port
+     */
+    ELITE_EXPORT explicit Kinematics(const KinematicsInfo& info);
+
+    /**
+     * @brief Set the TCP offset from the flange
+     *
+     * @param tcp_offset [x, y, z, rx, ry, rz] in the flange frame
+     */
+    ELITE_EXPORT void setTcpOffset(const vector6d_t& tcp_offset);
+
+    ELITE_EXPORT const vector6d_t& dhA() const;
+
+    ELITE_EXPORT const vector6d_t& dhD() const;
+
+    ELITE_EXPORT const vector6d_t& dhAlpha() const;
+
+    ELITE_EXPORT const vector6d_t& tcpOffset() const;
+
+    /**
+     * @brief Forward kinematics
+     *
+     * @param q Joint positions (rad)
+     * @return vector6d_t The TCP pose
+     */
+    ELITE_EXPORT vector6d_t forward(const vector6d_t& q) const;
+
+    /**
+     * @brief The geometric Jacobian of the TCP in the base frame. Rows 0~2 are the linear velocity of the TCP, rows 3~5 the
+     * angular velocity, so J * qd is a twist like the argument of speedl.
+     *
+     * @param q Joint positions (rad)
+     * @param jacobian The Jacobian
+     */
+    ELITE_EXPORT void jacobian(const vector6d_t& q, matrix6d_t& jacobian) const;
+
+    /**
+     * @brief Yoshikawa manipulability, sqrt(det(J J^T)) = |det(J)|. It goes to 0 at a singularity.
+     *
+     */
+    ELITE_EXPORT static double manipulability(const matrix6d_t& jacobian);
+
+    /**
+     * @brief Damped least squares: qd = J^T (J J^T + damping^2 I)^-1 twist. Near a singularity the joint velocities stay bounded,
+     * the twist is followed approximately.
+     *
+     * @param jacobian The Jacobian
+     * @param twist The twist
+     * @param damping The damping factor, 0 for the exact solution
+     * @param qd The joint velocities
+     * @return true success
+     * @return false the damped matrix is singular (only possible with a damping of 0)
+     */
+    ELITE_EXPORT static bool dampedLeastSquares(const matrix6d_t& jacobian, const vector6d_t& twist, double damping,
+                                                vector6d_t& qd);
+
+    /**
+     * @brief Convert a rotation vector to a rotation matrix, row major
+     *
+     */
+    ELITE_EXPORT static std::array<double, 9> rotationMatrix(const vector3d_t& rotation_vector);
+
+    /**
+     * @brief Convert a rotation matrix, row major, to a rotation vector
+     *
+     */
+    ELITE_EXPORT static vector3d_t rotationVector(const std::array<double, 9>& rotation);
+
+   private:
+    // Frames of the base and of the links, row major 3x4
+    void chain(const vector6d_t& q, std::array<std::array<double, 12>, 7>& frames) const;
+
+    vector6d_t dh_a_;
+    vector6d_t dh_d_;
+    vector6d_t dh_alpha_;
+    vector6d_t tcp_offset_;
+    // Transform of the flange to the TCP, row major 3x4
+    std::array<double, 12> tcp_;
+};
+
+}  // namespace ELITE
+
+#endif
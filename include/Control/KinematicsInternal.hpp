@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// KinematicsInternal.hpp
+// Homogeneous transform helpers shared by Kinematics and ReachabilityMap, used internal.
+#ifndef __ELITE__KINEMATICS_INTERNAL_HPP__
+#define __ELITE__KINEMATICS_INTERNAL_HPP__
+
+#include "Kinematics.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace ELITE {
+
+namespace KINEMATICS {
+
+/// A homogeneous transform, the upper 3x4 part row major
+using Transform = std::array<double, 12>;
+
+constexpr double PI = 3.14159265358979323846;
+
+inline Transform identity() { return Transform{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0}; }
+
+/// a * b
+inline Transform multiply(const Transform& a, const Transform& b) {
+    Transform r;
+    for (int row = 0; row < 3; row++) {
+        const double* ar = &a[row * 4];
+        r[row * 4 + 0] = ar[0] * b[0] + ar[1] * b[4] + ar[2] * b[8];
+        r[row * 4 + 1] = ar[0] * b[1] + ar[1] * b[5] + ar[2] * b[9];
+        r[row * 4 + 2] = ar[0] * b[2] + ar[1] * b[6] + ar[2] * b[10];
+        r[row * 4 + 3] = ar[0] * b[3] + ar[1] * b[7] + ar[2] * b[11] + ar[3];
+    }
+    return r;
+}
+
+/// Rot_z(theta) Trans_z(d) Trans_x(a) Rot_x(alpha)
+inline Transform dhTransform(double theta, double a, double d, double alpha) {
+    double ct = std::cos(theta), st = std::sin(theta);
+    double ca = std::cos(alpha), sa = std::sin(alpha);
+    return Transform{ct, -st * ca, st * sa, a * ct, st, ct * ca, -ct * sa, a * st, 0, sa, ca, d};
+}
+
+/**
+ * @brief The geometric Jacobian of a point from the frames of the joint axes
+ *
+ * @param axes Frames 0~5, the z axis of frame i is the axis of joint i
+ * @param point The TCP
+ * @param jacobian Rows 0~2 linear, 3~5 angular
+ */
+inline void jacobianOf(const Transform* axes, const Transform& point, matrix6d_t& jacobian) {
+    for (int i = 0; i < 6; i++) {
+        const Transform& f = axes[i];
+        double z[3] = {f[2], f[6], f[10]};
+        double r[3] = {point[3] - f[3], point[7] - f[7], point[11] - f[11]};
+        jacobian[0][i] = z[1] * r[2] - z[2] * r[1];
+        jacobian[1][i] = z[2] * r[0] - z[0] * r[2];
+        jacobian[2][i] = z[0] * r[1] - z[1] * r[0];
+        jacobian[3][i] = z[0];
+        jacobian[4][i] = z[1];
+        jacobian[5][i] = z[2];
+    }
+}
+
+}  // namespace KINEMATICS
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// PayloadEstimator.hpp
+// Online payload mass and center of gravity estimation from joint torques, with the DH model.
+#ifndef __ELITE__PAYLOAD_ESTIMATOR_HPP__
+#define __ELITE__PAYLOAD_ESTIMATOR_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/Kinematics.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief The static torques of the arm without the unknown payload: the gravity of links 2~6 and, per joint, a torque offset
+ * and a Coulomb friction. It is learned once with a known payload and can be saved.
+ *
+ */
+struct ArmGravityModel {
+    static constexpr int PARAMETERS = 30;
+    /// Link 2~6: mass and first moments (mass * center of gravity) in the link frame, then joints 2~6: offset and friction
+    std::array<double, PARAMETERS> parameters{};
+    /// The payload configured on the robot while the model was learned (kg)
+    double reference_mass = 0;
+    /// Its center of gravity in the flange frame (m)
+    vector3d_t reference_cog{};
+    bool valid = false;
+};
+
+/**
+ * @brief The estimated payload
+ *
+ */
+struct PayloadEstimate {
+    /// Mass (kg)
+    double mass = 0;
+    /// Center of gravity in the flange frame (m), for setPayload()
+    vector3d_t cog{};
+    /// RMS of the torque prediction errors (N*m), smoothed
+    double residual_rms = 0;
+    /// Joint torque observations used
+    uint64_t samples = 0;
+    /// The mass is positive and there were observations
+    bool valid = false;
+};
+
+/**
+ * @brief Estimates the payload with recursive least squares as the frames arrive, from the joint positions, speeds and torques.
+ *
+ * The motion should be slow, the inertial torques are not modeled. The torques of joints 2~6 are used, the gravity does not
+ * load joint 1. The payload is the change of the flange link parameters from the arm model, added to the reference payload of
+ * the model, so the arm model has to be learned first (startArmCalibration() and updateArm()) with a correctly configured
+ * payload, for example without a tool.
+ */
+class PayloadEstimator {
+   public:
+    /**
+     * @brief Construct a new Payload Estimator object
+     *
+     * @param kinematics The kinematics of the robot, from KinematicsInfo. The TCP offset is not used.
+     * @param gravity The gravity in the base frame (m/s^2)
+     * @param friction_deadband Below this joint speed (rad/s) the friction is scaled down linearly
+     */
+    ELITE_EXPORT explicit PayloadEstimator(const Kinematics& kinematics, const vector3d_t& gravity = vector3d_t{0, 0, -9.81},
+                                           double friction_deadband = 0.02);
+
+    ELITE_EXPORT ~PayloadEstimator();
+
+    /**
+     * @brief Start learning the arm model
+     *
+     * @param reference_mass The payload mass configured on the robot (kg)
+     * @param reference_cog The payload center of gravity configured on the robot (m)
+     */
+    ELITE_EXPORT void startArmCalibration(double reference_mass, const vector3d_t& reference_cog);
+
+    /**
+     * @brief Add a frame to the arm model
+     *
+     * @param q Joint positions (rad)
+     * @param qd Joint speeds (rad/s)
+     * @param torques Joint torques (N*m)
+     */
+    ELITE_EXPORT void updateArm(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& torques);
+
+    ELITE_EXPORT ArmGravityModel getArmModel() const;
+
+    ELITE_EXPORT void setArmModel(const ArmGravityModel& model);
+
+    /**
+     * @brief Start estimating the payload
+     *
+     */
+    ELITE_EXPORT void startPayload();
+
+    /**
+     * @brief Add a frame to the payload estimation
+     *
+     * @param q Joint positions (rad)
+     * @param qd Joint speeds (rad/s)
+     * @param torques Joint torques (N*m)
+     * @return true success
+     * @return false there is no valid arm model
+     */
+    ELITE_EXPORT bool updatePayload(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& torques);
+
+    ELITE_EXPORT PayloadEstimate getEstimate() const;
+
+    /**
+     * @brief The static joint torques predicted by the arm model with the estimated payload
+     *
+     */
+    ELITE_EXPORT vector6d_t predict(const vector6d_t& q, const vector6d_t& qd) const;
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
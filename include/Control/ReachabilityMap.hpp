@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// ReachabilityMap.hpp
+// Workspace reachability and manipulability map built from the DH model, stored in a memory-mappable file.
+#ifndef __ELITE__REACHABILITY_MAP_HPP__
+#define __ELITE__REACHABILITY_MAP_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/Kinematics.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ELITE {
+
+/**
+ * @brief Sampling of the map
+ *
+ */
+struct ReachabilityConfig {
+    /// Cell size (m)
+    double resolution = 0.01;
+    /// Samples of the wrist joints 4 and 5 (and 6 with a TCP offset) over their range, they mostly change the orientation
+    int wrist_samples = 12;
+    /// Joint position limits (rad). Joint 1 is assumed to turn fully.
+    vector6d_t joint_lower{-6.2832, -6.2832, -3.1416, -6.2832, -6.2832, -6.2832};
+    vector6d_t joint_upper{6.2832, 6.2832, 3.1416, 6.2832, 6.2832, 6.2832};
+    /// Threads of the build, 0: one per core
+    int threads = 0;
+};
+
+/**
+ * @brief Where the TCP can reach, with which approach directions and with which manipulability.
+ *
+ * A rotation of joint 1 rotates the whole arm about the base z axis, so the reachability depends only on the distance from
+ * that axis and the height. The map is a grid of (r, z) cells, each one standing for a ring of voxels, and the approach
+ * directions are stored relative to the radial direction. Joints 2 and 3 are sampled with a step which moves the TCP less than
+ * a cell, the wrist joints 4~6 with a fixed number of samples (ReachabilityConfig::wrist_samples) over their range, which
+ * mostly cover the approach directions and may leave cells near the border of the workspace unreached. Joint 1 is not
+ * sampled at all, so a 1 cm map is built in seconds. A query is one cell lookup.
+ *
+ * The approach direction is the z axis of the TCP, binned into 32 directions (4 elevation x 8 azimuth).
+ */
+class ReachabilityMap {
+   public:
+    /// Number of approach direction bins
+    static constexpr int DIRECTION_BINS = 32;
+
+    ELITE_EXPORT ReachabilityMap();
+
+    ELITE_EXPORT ~ReachabilityMap();
+
+    /**
+     * @brief Build the map by sampling the joint space in parallel
+     *
+     * @param kinematics The kinematics of the robot, with the TCP offset
+     * @param config Sampling
+     * @return true success
+     * @return false the resolution is not positive, or the arm has no reach
+     */
+    ELITE_EXPORT bool build(const Kinematics& kinematics, const ReachabilityConfig& config = ReachabilityConfig());
+
+    /**
+     * @brief Save the map. The file is a header and the cells in the native byte order, it can be mapped by load().
+     *
+     * @param path File path
+     * @return true success
+     */
+    ELITE_EXPORT bool save(const std::string& path) const;
+
+    /**
+     * @brief Map a file written by save() into memory, the cells are not copied
+     *
+     * @param path File path
+     * @return true success
+     * @return false the file can not be mapped, or it is not a map of this version
+     */
+    ELITE_EXPORT bool load(const std::string& path);
+
+    ELITE_EXPORT bool isValid() const;
+
+    ELITE_EXPORT double resolution() const;
+
+    /**
+     * @brief The number of joint samples of the last build
+     *
+     */
+    ELITE_EXPORT uint64_t sampleCount() const;
+
+    /**
+     * @brief Whether the TCP can reach a position
+     *
+     * @param position [x, y, z] in the base frame
+     */
+    ELITE_EXPORT bool reachable(const vector3d_t& position) const;
+
+    /**
+     * @brief Whether the TCP can reach a position with the approach direction of a pose
+     *
+     * @param pose [x, y, z, rx, ry, rz] in the base frame
+     */
+    ELITE_EXPORT bool reachable(const vector6d_t& pose) const;
+
+    /**
+     * @brief The best manipulability at a position, 0 if it is not reachable
+     *
+     * @param position [x, y, z] in the base frame
+     */
+    ELITE_EXPORT double manipulability(const vector3d_t& position) const;
+
+    /**
+     * @brief The number of approach direction bins reached at a position, 0 to DIRECTION_BINS
+     *
+     * @param position [x, y, z] in the base frame
+     */
+    ELITE_EXPORT int directionCount(const vector3d_t& position) const;
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
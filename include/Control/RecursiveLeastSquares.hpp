@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RecursiveLeastSquares.hpp
+// Fixed-size recursive least squares with scalar observations, used by PayloadEstimator.
+#ifndef __ELITE__RECURSIVE_LEAST_SQUARES_HPP__
+#define __ELITE__RECURSIVE_LEAST_SQUARES_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ELITE {
+
+/**
+ * @brief Estimates theta of y = phi . theta, one observation at a time, in O(N^2) without allocation.
+ *
+ * The initial covariance is a prior: parameters which the observations do not excite stay near their initial value instead of
+ * drifting, so a model with dependent parameters still predicts well.
+ */
+template <size_t N>
+class RecursiveLeastSquares {
+   public:
+    using Vector = std::array<double, N>;
+
+    /**
+     * @param initial_covariance Initial variance of every parameter
+     * @param forgetting Forgetting factor, (0, 1]. 1: all observations weigh the same.
+     */
+    explicit RecursiveLeastSquares(double initial_covariance = 1e4, double forgetting = 1.0)
+        : initial_covariance_(initial_covariance), forgetting_(forgetting) {
+        reset();
+    }
+
+    /**
+     * @brief Restart from zero parameters
+     *
+     */
+    void reset() {
+        theta_.fill(0);
+        for (size_t i = 0; i < N; i++) {
+            p_[i].fill(0);
+            p_[i][i] = initial_covariance_;
+        }
+        count_ = 0;
+    }
+
+    /**
+     * @brief Add an observation
+     *
+     * @param phi Regressor
+     * @param y Observed value
+     * @return double The prediction error before the update
+     */
+    double update(const Vector& phi, double y) {
+        Vector pphi;
+        double denominator = forgetting_;
+        for (size_t i = 0; i < N; i++) {
+            double sum = 0;
+            for (size_t k = 0; k < N; k++) {
+                sum += p_[i][k] * phi[k];
+            }
+            pphi[i] = sum;
+            denominator += phi[i] * sum;
+        }
+        double error = y - predict(phi);
+        for (size_t i = 0; i < N; i++) {
+            theta_[i] += pphi[i] / denominator * error;
+        }
+        // P = (P - P phi phi^T P / denominator) / forgetting, kept symmetric
+        for (size_t i = 0; i < N; i++) {
+            for (size_t k = i; k < N; k++) {
+                double v = (p_[i][k] - pphi[i] * pphi[k] / denominator) / forgetting_;
+                p_[i][k] = v;
+                p_[k][i] = v;
+            }
+        }
+        count_++;
+        return error;
+    }
+
+    double predict(const Vector& phi) const {
+        double sum = 0;
+        for (size_t i = 0; i < N; i++) {
+            sum += phi[i] * theta_[i];
+        }
+        return sum;
+    }
+
+    const Vector& parameters() const { return theta_; }
+
+    /**
+     * @brief Set the parameters, the covariance is reset
+     *
+     */
+    void setParameters(const Vector& theta) {
+        reset();
+        theta_ = theta;
+    }
+
+    /**
+     * @brief The variance of a parameter
+     *
+     */
+    double variance(size_t i) const { return p_[i][i]; }
+
+    uint64_t count() const { return count_; }
+
+   private:
+    double initial_covariance_;
+    double forgetting_;
+    Vector theta_;
+    std::array<Vector, N> p_;
+    uint64_t count_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -21,9 +21,17 @@ class ReversePort {
     ReversePort(int port, int receive_buffer_size, std::shared_ptr<TcpServer::StaticResource> resource) {
         server_ = std::make_shared<TcpServer>(port, receive_buffer_size, resource);
     }
-    ~ReversePort() = default;
+    ~ReversePort() { server_->setConnectionCallback(nullptr); }
 
     bool isRobotConnect() { return server_->isClientConnected(); }
+
+    /**
+     * @brief Set the callback of the robot connecting and disconnecting.
+     *  It is called in the TCP server thread.
+     *
+     * @param cb callback
+     */
+    void setConnectionCallback(TcpServer::ConnectionCallback cb) { server_->setConnectionCallback(std::move(cb)); }
 };
 
 }  // namespace ELITE
@@ -12,19 +12,14 @@
 #include "TcpServer.hpp"
 
 #include <boost/asio.hpp>
+#include <future>
 #include <memory>
 
 namespace ELITE {
 
 class ScriptCommandInterface : public ReversePort {
    private:
-    enum class Cmd {
-        ZERO_FTSENSOR = 0,
-        SET_PAYLOAD = 1,
-        SET_TOOL_VOLTAGE = 2,
-        START_FORCE_MODE = 3,
-        END_FORCE_MODE = 4,
-    };
+    using Cmd = ScriptCommand;
 
     enum class SerialResult {
         START = 1,
@@ -32,7 +27,11 @@ class ScriptCommandInterface : public ReversePort {
     };
 
    public:
-    static constexpr int SCRIPT_COMMAND_DATA_SIZE = 26;
+    // The last integer is the sequence number, the script acknowledges it with (sequence number, result)
+    static constexpr int SCRIPT_COMMAND_DATA_SIZE = 27;
+    static constexpr int SCRIPT_COMMAND_SEQ_INDEX = SCRIPT_COMMAND_DATA_SIZE - 1;
+    static constexpr int SCRIPT_COMMAND_ACK_SIZE = 2 * sizeof(int32_t);
+    static constexpr int DEFAULT_ACK_TIMEOUT_MS = 1000;
 
     ScriptCommandInterface() = delete;
 
@@ -108,6 +107,49 @@ class ScriptCommandInterface : public ReversePort {
      * @return false fail
      */
     bool endForceMode();
+
+    /**
+     * @brief The acknowledged variants of the commands above.
+     *      The future is ready when the script has executed the command and acknowledged it, or on timeout.
+     *      If the command can not be written, the returned future is already ready with SEND_FAIL.
+     *
+     * @param timeout_ms Timeout of the acknowledge
+     * @return std::future<ScriptCommandAck> The acknowledge
+     */
+    std::future<ScriptCommandAck> zeroFTSensorAsync(int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+    std::future<ScriptCommandAck> setPayloadAsync(double mass, const vector3d_t& cog, int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+    std::future<ScriptCommandAck> setToolVoltageAsync(const ToolVoltage& vol, int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+    std::future<ScriptCommandAck> startForceModeAsync(const vector6d_t& task_frame, const vector6int32_t& selection_vector,
+                                                      const vector6d_t& wrench, const ForceMode& mode, const vector6d_t& limits,
+                                                      int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+    std::future<ScriptCommandAck> endForceModeAsync(int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+
+    /**
+     * @brief Send a command which does nothing, to measure the round trip of the script command socket
+     *
+     * @param timeout_ms Timeout of the acknowledge
+     * @return std::future<ScriptCommandAck> The acknowledge
+     */
+    std::future<ScriptCommandAck> ping(int timeout_ms = DEFAULT_ACK_TIMEOUT_MS);
+
+    /**
+     * @brief Get the round trip statistics of a command. Commands sent by the 'bool' interfaces are counted too.
+     *
+     * @param cmd The command
+     * @return ScriptCommandStats Statistics
+     */
+    ScriptCommandStats getStats(ScriptCommand cmd);
+
+   private:
+    class AckState;
+    std::shared_ptr<AckState> ack_state_;
+    std::shared_ptr<TcpServer::StaticResource> resource_;
+
+    // Set the sequence number of the command in 'buffer', register it and write it to the robot
+    std::future<ScriptCommandAck> sendCommand(Cmd cmd, int32_t* buffer, int timeout_ms);
+
+    // true if the command was written, the acknowledge is not waited for
+    static bool isSent(std::future<ScriptCommandAck> ack);
 };
 
 }  // namespace ELITE
@@ -10,17 +10,24 @@
 
 #include <boost/asio.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace ELITE {
 
 class ScriptSender : protected TcpServer {
    private:
-    const std::string PROGRAM_REQUEST_ = std::string("request_program");
-    const std::string& program_;
-    boost::asio::streambuf recv_request_buffer_;
-
-    void responseRequest(std::shared_ptr<boost::asio::ip::tcp::socket> sock);
+    // Shared with the asio handlers, which may complete after this object is destroyed
+    struct State {
+        std::mutex mutex;
+        // Cleared by the destructor, the handlers don't touch this object after that
+        bool alive = true;
+        std::string program;
+    };
+    std::shared_ptr<State> state_;
+
+    static void responseRequest(std::shared_ptr<State> state, std::shared_ptr<boost::asio::ip::tcp::socket> sock,
+                                std::shared_ptr<boost::asio::streambuf> buffer);
 
     virtual void doAccept() override;
 
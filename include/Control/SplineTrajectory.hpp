@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// SplineTrajectory.hpp
+// Fits joint splines through waypoints, to be executed with EliteDriver::writeTrajectorySplinePoint().
+#ifndef __ELITE__SPLINE_TRAJECTORY_HPP__
+#define __ELITE__SPLINE_TRAJECTORY_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief The end of a spline segment, sent as one trajectory point
+ *
+ */
+struct SplineKnot {
+    /// Joint positions (rad)
+    vector6d_t positions{};
+    /// Joint velocities (rad/s)
+    vector6d_t velocities{};
+    /// Joint accelerations (rad/s^2)
+    vector6d_t accelerations{};
+    /// Duration of the segment ending at this knot (s)
+    double duration = 0;
+};
+
+/**
+ * @brief Joint limits of a spline
+ *
+ */
+struct SplineLimits {
+    /// Maximum absolute joint velocities (rad/s)
+    vector6d_t max_velocity{};
+    /// Maximum absolute joint accelerations (rad/s^2)
+    vector6d_t max_acceleration{};
+};
+
+/**
+ * @brief A cubic spline through joint waypoints, continuous in position, velocity and acceleration.
+ *
+ * The spline is clamped: the velocities at the first and the last waypoint are given, the accelerations are free. The knots
+ * carry the position, velocity and acceleration of every waypoint after the first one, so the control script can rebuild the
+ * segments as cubic (position and velocity) or quintic (position, velocity and acceleration) polynomials. The acceleration at
+ * the first waypoint is generally not zero, send start() before the knots so that the robot starts along the fitted spline.
+ */
+class SplineTrajectory {
+   public:
+    ELITE_EXPORT SplineTrajectory();
+
+    /**
+     * @brief Fit the spline
+     *
+     * @param waypoints Joint waypoints, the first one is the start of the trajectory (usually the current joint positions)
+     * @param durations Durations of the segments (s), one less than the waypoints
+     * @param start_velocity Joint velocities at the first waypoint
+     * @param end_velocity Joint velocities at the last waypoint
+     * @return true success
+     * @return false less than 2 waypoints, the number of durations does not match, or a duration is not positive
+     */
+    ELITE_EXPORT bool fit(const std::vector<vector6d_t>& waypoints, const std::vector<double>& durations,
+                          const vector6d_t& start_velocity = vector6d_t{}, const vector6d_t& end_velocity = vector6d_t{});
+
+    /**
+     * @brief The knots after the first waypoint, in order. Send them with EliteDriver::writeTrajectorySplinePoint().
+     *
+     */
+    ELITE_EXPORT const std::vector<SplineKnot>& knots() const;
+
+    /**
+     * @brief The state at the first waypoint, with duration 0. Sent before the knots with
+     * EliteDriver::writeTrajectorySplinePoint(), it sets the velocity and acceleration the first segment starts with, instead
+     * of zero.
+     *
+     */
+    ELITE_EXPORT const SplineKnot& start() const;
+
+    /**
+     * @brief Total duration of the spline (s)
+     *
+     */
+    ELITE_EXPORT double duration() const;
+
+    /**
+     * @brief Evaluate the spline
+     *
+     * @param time Time from the start (s), clamped to [0, duration()]
+     * @param positions Joint positions
+     * @param velocities Joint velocities, optional
+     * @param accelerations Joint accelerations, optional
+     * @return true success
+     * @return false the spline is not fitted
+     */
+    ELITE_EXPORT bool sample(double time, vector6d_t& positions, vector6d_t* velocities = nullptr,
+                             vector6d_t* accelerations = nullptr) const;
+
+    /**
+     * @brief Get the peak absolute joint velocities and accelerations of the whole spline, computed from the polynomials
+     *
+     */
+    ELITE_EXPORT void peaks(vector6d_t& velocity, vector6d_t& acceleration) const;
+
+    /**
+     * @brief Check the spline against joint limits
+     *
+     * @param limits The limits, a limit <= 0 is not checked
+     * @return true The spline is within the limits
+     */
+    ELITE_EXPORT bool withinLimits(const SplineLimits& limits) const;
+
+    /**
+     * @brief Stretch the durations uniformly so that the spline is within the limits. The path is not changed, the velocities
+     * (including the start and end velocities) are divided by the factor and the accelerations by its square.
+     *
+     * @param limits The limits, a limit <= 0 is not checked
+     * @return double The factor the durations are multiplied by, 1 if the spline is already within the limits
+     */
+    ELITE_EXPORT double scaleToLimits(const SplineLimits& limits);
+
+   private:
+    // Start of the spline, not sent
+    SplineKnot start_;
+    std::vector<SplineKnot> knots_;
+    double duration_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <memory>
+#include "CallbackExecutor.hpp"
 #include "DataType.hpp"
 #include "ReversePort.hpp"
 #include "TcpServer.hpp"
@@ -23,6 +24,9 @@ enum class TrajectoryMotionType : int {
 class TrajectoryInterface : public ReversePort {
    public:
     static const int TRAJECTORY_MESSAGE_LEN = 21;
+    // Order of a spline segment, sent in the blend radius field
+    static const int SPLINE_CUBIC = 3;
+    static const int SPLINE_QUINTIC = 5;
 
     TrajectoryInterface() = delete;
 
@@ -31,8 +35,10 @@ class TrajectoryInterface : public ReversePort {
      *
      * @param port Port the Server is started on
      * @param resource TCP resource shared pointer
+     * @param executor Runs the motion result callback, nullptr to run it in the TCP server thread.
      */
-    TrajectoryInterface(int port, std::shared_ptr<TcpServer::StaticResource> resource);
+    TrajectoryInterface(int port, std::shared_ptr<TcpServer::StaticResource> resource,
+                        CallbackExecutorSharedPtr executor = nullptr);
 
     ~TrajectoryInterface();
 
@@ -46,6 +52,13 @@ class TrajectoryInterface : public ReversePort {
      */
     void setMotionResultCallback(std::function<void(TrajectoryMotionResult)> cb) { motion_result_func_ = cb; }
 
+    /**
+     * @brief Get the callback set by setMotionResultCallback()
+     *
+     * @return std::function<void(TrajectoryMotionResult)> The callback, empty if none
+     */
+    std::function<void(TrajectoryMotionResult)> getMotionResultCallback() const { return motion_result_func_; }
+
     /**
      * @brief Writes a trajectory point onto the dedicated socket.
      *
@@ -58,8 +71,23 @@ class TrajectoryInterface : public ReversePort {
      */
     bool writeTrajectoryPoint(const vector6d_t& positions, float time, float blend_radius, bool cartesian);
 
+    /**
+     * @brief Writes a joint spline knot onto the dedicated socket. The robot moves from the previous knot (or the current joint
+     * positions for the first knot) to this knot along a polynomial, with servoj at every control cycle.
+     *
+     * @param positions Joint positions of the knot
+     * @param velocities Joint velocities of the knot
+     * @param accelerations Joint accelerations of the knot. nullptr: cubic segment, otherwise quintic segment.
+     * @param time Duration of the segment
+     * @return true
+     * @return false
+     */
+    bool writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities, const vector6d_t* accelerations,
+                                    float time);
+
    private:
     std::function<void(TrajectoryMotionResult)> motion_result_func_;
+    CallbackExecutorSharedPtr executor_;
 };
 
 }  // namespace ELITE
@@ -326,6 +326,12 @@ class DashboardClient {
     void sendCommand(const std::string& cmd);
 
     std::string sendAndRequest(const std::string& cmd, const std::string& expected = "");
+
+    // Exception free variants, the functions above are wrappers which throw the returned code.
+    EliteException::Code tryReadLine(std::string& line, unsigned timeout_ms = 10000) noexcept;
+    EliteException::Code trySendCommand(const std::string& cmd) noexcept;
+    // If the response does not match 'expected', returns DASHBOARD_NOT_EXPECT_RECIVE and 'response' keeps the whole line.
+    EliteException::Code trySendAndRequest(const std::string& cmd, const std::string& expected, std::string& response) noexcept;
     bool waitForReply(const std::string& cmd, const std::string& expected,
                       const std::chrono::duration<double> timeout = std::chrono::seconds(30));
 };
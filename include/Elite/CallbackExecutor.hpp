@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// CallbackExecutor.hpp
+// Provides the executors which run the user callbacks of the SDK.
+#ifndef __ELITE__CALLBACK_EXECUTOR_HPP__
+#define __ELITE__CALLBACK_EXECUTOR_HPP__
+
+#include <Elite/EliteOptions.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief Statistics of a callback executor
+ *
+ */
+struct CallbackExecutorStats {
+    /// Tasks run
+    uint64_t executed = 0;
+    /// Tasks rejected because the queue was full
+    uint64_t dropped = 0;
+    /// The largest number of tasks waiting in the queue
+    uint64_t max_queue_size = 0;
+    /// Time from post() to the start of the task
+    std::chrono::microseconds max_queue_latency{0};
+    std::chrono::microseconds mean_queue_latency{0};
+    std::chrono::microseconds last_queue_latency{0};
+};
+
+/**
+ * @brief Runs the user callbacks of the SDK, e.g. the trajectory result, robot exception and connection callbacks.
+ *  Implement post() to provide your own executor (e.g. the event loop of your application).
+ *
+ */
+class CallbackExecutor {
+   public:
+    using Task = std::function<void()>;
+
+    virtual ~CallbackExecutor() = default;
+
+    /**
+     * @brief Run a task, or queue it to run later. Called in the SDK threads, must not block.
+     *
+     * @param task The task
+     * @return true The task is run or queued
+     * @return false The task is dropped
+     */
+    virtual bool post(Task task) = 0;
+
+    /**
+     * @brief Get the statistics
+     *
+     * @return CallbackExecutorStats Statistics, empty if the executor does not record them.
+     */
+    virtual CallbackExecutorStats getStats() { return CallbackExecutorStats(); }
+};
+
+using CallbackExecutorSharedPtr = std::shared_ptr<CallbackExecutor>;
+
+/**
+ * @brief Runs the tasks in the thread calling post(), i.e. in the SDK threads. A slow callback delays the SDK thread.
+ *
+ */
+class InlineExecutor : public CallbackExecutor {
+   private:
+    std::atomic<uint64_t> executed_{0};
+
+   public:
+    ELITE_EXPORT bool post(Task task) override;
+    ELITE_EXPORT CallbackExecutorStats getStats() override;
+};
+
+/**
+ * @brief Runs the tasks in order in a dedicated thread, from a bounded queue.
+ *  When the queue is full, the new task is dropped and counted.
+ *
+ */
+class ThreadExecutor : public CallbackExecutor {
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * @brief Construct a new Thread Executor object and start the thread
+     *
+     * @param capacity The most tasks waiting in the queue
+     */
+    ELITE_EXPORT explicit ThreadExecutor(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Run the tasks already queued and stop the thread
+     *
+     */
+    ELITE_EXPORT ~ThreadExecutor() override;
+
+    ELITE_EXPORT bool post(Task task) override;
+
+    ELITE_EXPORT CallbackExecutorStats getStats() override;
+
+    /**
+     * @brief Get the number of tasks waiting in the queue
+     *
+     */
+    ELITE_EXPORT size_t size();
+};
+
+/**
+ * @brief Run a task with an executor, or in the current thread if 'executor' is nullptr.
+ *
+ * @param executor The executor
+ * @param task The task
+ * @return true The task is run or queued
+ * @return false The task is dropped
+ */
+ELITE_EXPORT bool dispatchCallback(const CallbackExecutorSharedPtr& executor, CallbackExecutor::Task task);
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// CartesianVelocityStreamer.hpp
+// Streams Cartesian twists as joint velocities with speedj, solved on the client with a damped least squares Jacobian.
+#ifndef __ELITE__CARTESIAN_VELOCITY_STREAMER_HPP__
+#define __ELITE__CARTESIAN_VELOCITY_STREAMER_HPP__
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/Kinematics.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief Configuration of the twist to joint velocity conversion
+ *
+ */
+struct CartesianVelocityConfig {
+    /// Below this manipulability the damping is raised, and the manipulability callback is called
+    double manipulability_threshold = 0.005;
+    /// The damping at a singularity, it goes to 0 at the threshold
+    double max_damping = 0.05;
+    /// Joint position limits (rad)
+    vector6d_t joint_lower{-6.2832, -6.2832, -3.1416, -6.2832, -6.2832, -6.2832};
+    vector6d_t joint_upper{6.2832, 6.2832, 3.1416, 6.2832, 6.2832, 6.2832};
+    /// Within this distance of a limit (rad) the joint is slowed towards the limit, and stopped at the limit
+    double limit_margin = 0.2;
+    /// Maximum joint speeds (rad/s), the joint velocities are scaled down together so the direction is kept
+    vector6d_t max_joint_speed{3.14, 3.14, 3.14, 3.14, 3.14, 3.14};
+    /// The twist is set to zero when it is not updated for this time
+    int twist_timeout_ms = 100;
+    /// The read timeout of the speedj commands
+    int timeout_ms = 100;
+};
+
+/**
+ * @brief The result of a conversion
+ *
+ */
+struct CartesianVelocitySolution {
+    vector6d_t joint_velocities{};
+    double manipulability = 0;
+    double damping = 0;
+    /// The factor the joint velocities were scaled down by to respect max_joint_speed, 1 if not scaled
+    double speed_scale = 1;
+    /// Bit i: joint i was slowed by its position limit
+    int limited_joints = 0;
+};
+
+/**
+ * @brief Converts Cartesian twists to joint velocities on the client and streams them with EliteDriver::writeSpeedj(), one
+ * command per RTSI frame from the receive thread, instead of the controller speedl which faults near singularities.
+ *
+ * The damping of the least squares solution rises smoothly when the manipulability falls below the threshold, so the joint
+ * velocities stay bounded through a singularity. A joint within 'limit_margin' of a position limit is weighted down in the
+ * solution when it moves towards the limit, so the other joints take over the twist.
+ *
+ * Subscribe "actual_joint_positions" in the output recipe.
+ */
+class CartesianVelocityStreamer {
+   public:
+    /**
+     * @brief Called in the executor when the manipulability falls below the threshold, and when it is above it again
+     *
+     * @param manipulability The manipulability
+     * @param below true: below the threshold
+     */
+    using ManipulabilityCallback = std::function<void(double manipulability, bool below)>;
+
+    CartesianVelocityStreamer() = delete;
+
+    /**
+     * @brief Construct a new Cartesian Velocity Streamer object
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param driver The driver, usually an EliteDriver. Must outlive this object.
+     * @param kinematics The kinematics of the robot, with the TCP offset of the twists
+     * @param executor Runs the manipulability callback, nullptr to run it in the RTSI receive thread
+     */
+    ELITE_EXPORT CartesianVelocityStreamer(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Kinematics& kinematics,
+                                           CallbackExecutorSharedPtr executor = nullptr);
+
+    ELITE_EXPORT ~CartesianVelocityStreamer();
+
+    /**
+     * @brief Start streaming from the next frame, with a zero twist
+     *
+     * @param config Configuration
+     * @return true success
+     * @return false already streaming
+     */
+    ELITE_EXPORT bool start(const CartesianVelocityConfig& config = CartesianVelocityConfig());
+
+    /**
+     * @brief Stop streaming. A zero joint velocity is sent once.
+     *
+     */
+    ELITE_EXPORT void stop();
+
+    ELITE_EXPORT bool isStreaming();
+
+    /**
+     * @brief Set the twist to follow
+     *
+     * @param twist [vx, vy, vz, wx, wy, wz] of the TCP in the base frame, like speedl
+     */
+    ELITE_EXPORT void setTwist(const vector6d_t& twist);
+
+    /**
+     * @brief Get the solution of the last frame
+     *
+     */
+    ELITE_EXPORT CartesianVelocitySolution getLastSolution();
+
+    /**
+     * @brief The maximum and the mean time of the conversion in a frame
+     *
+     */
+    ELITE_EXPORT void getSolveTime(std::chrono::nanoseconds& max, std::chrono::nanoseconds& mean);
+
+    ELITE_EXPORT void setManipulabilityCallback(ManipulabilityCallback cb);
+
+    /**
+     * @brief Convert a twist to joint velocities, as done every frame
+     *
+     * @param kinematics The kinematics
+     * @param config Configuration
+     * @param q Joint positions
+     * @param twist The twist
+     * @param solution The solution
+     * @return true success
+     * @return false the solution is singular, the joint velocities are zero
+     */
+    ELITE_EXPORT static bool solve(const Kinematics& kinematics, const CartesianVelocityConfig& config, const vector6d_t& q,
+                                   const vector6d_t& twist, CartesianVelocitySolution& solution);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// CollisionDetector.hpp
+// Detects collisions from the residual of the RTSI joint torques against the model torques, in the RTSI receive thread.
+#ifndef __ELITE__COLLISION_DETECTOR_HPP__
+#define __ELITE__COLLISION_DETECTOR_HPP__
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/Dynamics.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+enum class CollisionSource : int {
+    /// "actual_joint_torques"
+    JOINT_TORQUE = 0,
+    /// "actual_joint_current" times the torque constants
+    JOINT_CURRENT = 1,
+};
+
+/**
+ * @brief Thresholds, filters and friction of the collision detection
+ *
+ */
+struct CollisionConfig {
+    CollisionSource source = CollisionSource::JOINT_TORQUE;
+    /// Thresholds of the joint torque residuals (N*m). <= 0: the joint is not watched.
+    vector6d_t thresholds{};
+    /// Torque per current of the joints (N*m/A), for JOINT_CURRENT
+    vector6d_t torque_constants{};
+    /// Coulomb friction of the joints (N*m), added to the model torques
+    vector6d_t coulomb_friction{};
+    /// Viscous friction of the joints (N*m*s/rad), added to the model torques
+    vector6d_t viscous_friction{};
+    /// Below this joint speed (rad/s) the Coulomb friction is scaled down linearly
+    double friction_deadband = 0.02;
+    /// Low-pass smoothing of the residuals, (0, 1]. 1: no filtering.
+    double filter_alpha = 0.3;
+    /// Low-pass smoothing of the joint accelerations, differentiated from "actual_joint_speeds", (0, 1]
+    double acceleration_alpha = 0.2;
+    /// Adaption of the residual offsets to slow model errors, [0, 1). 0: the offsets are the residuals when armed.
+    double baseline_alpha = 0;
+    /// Consecutive frames over a threshold before a collision is reported
+    int debounce_frames = 2;
+    /// Stop the motion with EliteDriver::writeToolContact() at a collision
+    bool stop = true;
+    /// The read timeout of the reverse socket sent with the stop command
+    int stop_timeout_ms = 100;
+};
+
+/**
+ * @brief A detected collision
+ *
+ */
+struct CollisionEvent {
+    /// The joint with the largest residual relative to its threshold
+    int joint = -1;
+    /// The residual of the joint (N*m)
+    double residual = 0;
+    /// Model torques of the frame (N*m)
+    vector6d_t expected_torques{};
+    /// Measured torques of the frame (N*m)
+    vector6d_t measured_torques{};
+    /// "actual_joint_positions" of the frame
+    vector6d_t joint_positions{};
+    /// Controller timestamp of the frame (s), 0 if "timestamp" is not subscribed
+    double timestamp = 0;
+    /// The stop command was written to the robot
+    bool stop_sent = false;
+    /// Time from the frame being received to the stop command being written
+    std::chrono::microseconds detect_to_send{0};
+};
+
+/**
+ * @brief Processing time of the frames
+ *
+ */
+struct CollisionStats {
+    uint64_t frames = 0;
+    uint64_t collisions = 0;
+    std::chrono::nanoseconds max_frame_time{0};
+    std::chrono::nanoseconds mean_frame_time{0};
+};
+
+/**
+ * @brief Watches the joint torques in the RTSI receive thread. Every frame the model torques of the current motion are computed
+ * with Dynamics, the joint accelerations are differentiated from the speeds, and the filtered residual of the measured torques
+ * is compared with the thresholds. A collision stops the motion at once, from the same thread, and is reported.
+ *
+ * A frame takes a few microseconds. The residual offsets are taken when armed, so arm it without contact. Subscribe
+ * "actual_joint_positions", "actual_joint_speeds" and "actual_joint_torques" or "actual_joint_current" in the output recipe,
+ * and "timestamp" for the acceleration (the host clock is used without it).
+ */
+class CollisionDetector {
+   public:
+    using CollisionCallback = std::function<void(const CollisionEvent&)>;
+
+    CollisionDetector() = delete;
+
+    /**
+     * @brief Construct a new Collision Detector object, disarmed
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param driver The driver which stops the motion, usually an EliteDriver. Must outlive this object.
+     * @param dynamics The dynamics of the robot, with the link inertias
+     * @param executor Runs the collision callback, nullptr to run it in the RTSI receive thread
+     */
+    ELITE_EXPORT CollisionDetector(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Dynamics& dynamics,
+                                   CallbackExecutorSharedPtr executor = nullptr);
+
+    ELITE_EXPORT ~CollisionDetector();
+
+    /**
+     * @brief Start watching
+     *
+     * @param config Thresholds and filters
+     * @return true success
+     * @return false no threshold is set, or a filter parameter is out of range
+     */
+    ELITE_EXPORT bool arm(const CollisionConfig& config);
+
+    ELITE_EXPORT void disarm();
+
+    ELITE_EXPORT bool isArmed();
+
+    /**
+     * @brief Whether a collision was detected and not released
+     *
+     */
+    ELITE_EXPORT bool inCollision();
+
+    /**
+     * @brief Release the collision: clear the stop of this detector (EliteDriver::clearToolContact()). The motion commands are
+     * allowed again unless another detector still holds its stop. Call arm() to watch again.
+     *
+     */
+    ELITE_EXPORT void release();
+
+    /**
+     * @brief Change the payload of the model, after EliteDriver::setPayload()
+     *
+     * @param mass Mass (kg)
+     * @param cog Center of gravity in the flange frame (m)
+     */
+    ELITE_EXPORT void setPayload(double mass, const vector3d_t& cog);
+
+    /**
+     * @brief Set the callback of a collision
+     *
+     * @param cb The callback, run by the executor given to the constructor
+     */
+    ELITE_EXPORT void setCollisionCallback(CollisionCallback cb);
+
+    /**
+     * @brief Get the last collision
+     *
+     * @param event The collision
+     * @return true There was a collision
+     */
+    ELITE_EXPORT bool getLastCollision(CollisionEvent& event);
+
+    /**
+     * @brief The filtered residuals of the last frame (N*m), to tune the thresholds
+     *
+     */
+    ELITE_EXPORT vector6d_t getResiduals();
+
+    ELITE_EXPORT CollisionStats getStats();
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
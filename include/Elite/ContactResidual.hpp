@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// ContactResidual.hpp
+// Filtered residual of a signal against a slowly adapting baseline, used by ToolContactDetector.
+#ifndef __ELITE__CONTACT_RESIDUAL_HPP__
+#define __ELITE__CONTACT_RESIDUAL_HPP__
+
+namespace ELITE {
+
+namespace CONTACT {
+
+/**
+ * @brief The difference between a low-pass filtered signal and its baseline.
+ *
+ * The baseline follows the filtered signal slowly, so a slow drift (payload, temperature, sensor offset) is not a residual, while
+ * a contact, which changes the signal within a few frames, is. The baseline is only adapted when the caller sees no contact.
+ */
+class ResidualFilter {
+   public:
+    ResidualFilter() : ResidualFilter(1, 0) {}
+
+    /**
+     * @param filter_alpha Smoothing of the signal, (0, 1]. 1: no filtering.
+     * @param baseline_alpha Adaption of the baseline, [0, 1). 0: the baseline is the first sample.
+     */
+    ResidualFilter(double filter_alpha, double baseline_alpha)
+        : filter_alpha_(filter_alpha), baseline_alpha_(baseline_alpha), filtered_(0), baseline_(0), initialized_(false) {}
+
+    /**
+     * @brief Forget the samples, the next one is the new baseline
+     *
+     */
+    void reset() { initialized_ = false; }
+
+    /**
+     * @brief Feed a sample
+     *
+     * @return double The residual, the filtered signal minus the baseline. 0 for the first sample.
+     */
+    double update(double value) {
+        if (!initialized_) {
+            initialized_ = true;
+            filtered_ = value;
+            baseline_ = value;
+            return 0;
+        }
+        filtered_ += filter_alpha_ * (value - filtered_);
+        return filtered_ - baseline_;
+    }
+
+    /**
+     * @brief Move the baseline towards the filtered signal. Call it for the samples without contact.
+     *
+     */
+    void adapt() { baseline_ += baseline_alpha_ * (filtered_ - baseline_); }
+
+    double filtered() const { return filtered_; }
+
+    double baseline() const { return baseline_; }
+
+   private:
+    double filter_alpha_;
+    double baseline_alpha_;
+    double filtered_;
+    double baseline_;
+    bool initialized_;
+};
+
+}  // namespace CONTACT
+
+}  // namespace ELITE
+
+#endif
@@ -18,7 +18,7 @@ enum class ControlMode : int {
     MODE_SPEEDL = 4,           // Set when cartesian velocity control is active.
     MODE_POSE = 5,             // Set when cartesian pose control is active.
     MODE_FREEDRIVE = 6,        // Set when freedrive mode is active.
-    MODE_TOOL_IN_CONTACT = 7,  // Set tool in contact.(Not use now, coming soon)
+    MODE_TOOL_IN_CONTACT = 7,  // Set when the tool is in contact, the motion is stopped.
     MODE_SERVOJ_QUEUE = 8,     // Set when servoj queue control is active.
     MODE_POSE_QUEUE = 9,       // Set when cartesian pose queue control is active.
 };
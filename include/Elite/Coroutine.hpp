@@ -0,0 +1,441 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// Coroutine.hpp
+// Provides C++20 awaitables for the trajectory result, RTSI frames, IO events and dashboard requests.
+// The SDK itself is built as C++14/17, this header is only active when the application is compiled as C++20.
+#ifndef __ELITE__COROUTINE_HPP__
+#define __ELITE__COROUTINE_HPP__
+
+#if (__cplusplus >= 202002L) && __has_include(<coroutine>)
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DashboardClient.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/EliteDriver.hpp>
+#include <Elite/Log.hpp>
+#include <Elite/RtsiIOEventEngine.hpp>
+#include <Elite/RtsiIOInterface.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#define ELITE_SDK_COROUTINE 1
+
+namespace ELITE {
+
+namespace detail {
+
+/**
+ * @brief Resume a coroutine with an executor, or in the current thread if 'executor' is nullptr.
+ *  If the executor drops the task, the coroutine is resumed in the current thread, so it never hangs.
+ *
+ */
+inline void resumeCoroutine(const CallbackExecutorSharedPtr& executor, std::coroutine_handle<> handle) {
+    if (executor && executor->post([handle]() { handle.resume(); })) {
+        return;
+    }
+    if (executor) {
+        ELITE_LOG_WARN("Coroutine resume dropped by the executor, resume in the current thread");
+    }
+    handle.resume();
+}
+
+/**
+ * @brief The result of a single event, set in an SDK thread and awaited by one coroutine.
+ *
+ * @tparam T Type of the result
+ */
+template <typename T>
+class OneShotState {
+   private:
+    std::mutex mutex_;
+    std::optional<T> value_;
+    std::exception_ptr exception_;
+    std::coroutine_handle<> waiter_;
+    CallbackExecutorSharedPtr executor_;
+
+    void complete(std::unique_lock<std::mutex>& lock) {
+        std::coroutine_handle<> waiter = waiter_;
+        waiter_ = nullptr;
+        lock.unlock();
+        if (waiter) {
+            resumeCoroutine(executor_, waiter);
+        }
+    }
+
+   public:
+    explicit OneShotState(CallbackExecutorSharedPtr executor) : executor_(std::move(executor)) {}
+
+    /**
+     * @brief Set the result. Only the first call takes effect.
+     *
+     * @return true The result is set
+     */
+    bool set(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (value_ || exception_) {
+            return false;
+        }
+        value_.emplace(std::move(value));
+        complete(lock);
+        return true;
+    }
+
+    bool setException(std::exception_ptr exception) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (value_ || exception_) {
+            return false;
+        }
+        exception_ = exception;
+        complete(lock);
+        return true;
+    }
+
+    bool ready() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return value_ || exception_;
+    }
+
+    /**
+     * @brief Register the waiting coroutine
+     *
+     * @return false The result is already set, do not suspend
+     */
+    bool suspend(std::coroutine_handle<> waiter) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (value_ || exception_) {
+            return false;
+        }
+        waiter_ = waiter;
+        return true;
+    }
+
+    T take() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        return std::move(*value_);
+    }
+};
+
+/**
+ * @brief Awaits a OneShotState. The source is registered when the awaitable is created and unregistered when it is destroyed,
+ *  so an event happening between the creation and the co_await is not missed.
+ *
+ * @tparam T Type of the result
+ */
+template <typename T>
+class OneShotAwaitable {
+   private:
+    std::shared_ptr<OneShotState<T>> state_;
+    std::function<void()> unregister_;
+
+   public:
+    OneShotAwaitable(std::shared_ptr<OneShotState<T>> state, std::function<void()> unregister)
+        : state_(std::move(state)), unregister_(std::move(unregister)) {}
+
+    OneShotAwaitable(OneShotAwaitable&& other) noexcept
+        : state_(std::move(other.state_)), unregister_(std::exchange(other.unregister_, nullptr)) {}
+
+    OneShotAwaitable(const OneShotAwaitable&) = delete;
+    OneShotAwaitable& operator=(const OneShotAwaitable&) = delete;
+    OneShotAwaitable& operator=(OneShotAwaitable&&) = delete;
+
+    ~OneShotAwaitable() {
+        if (unregister_) {
+            unregister_();
+        }
+    }
+
+    bool await_ready() { return state_->ready(); }
+
+    bool await_suspend(std::coroutine_handle<> handle) { return state_->suspend(handle); }
+
+    T await_resume() { return state_->take(); }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A lazily started coroutine. Await it from another coroutine, or start it detached with spawn().
+ *  An exception thrown in the coroutine is rethrown to the awaiting coroutine.
+ *
+ * @tparam T Type of the result
+ */
+template <typename T = void>
+class CoTask {
+   public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct PromiseBase {
+        std::coroutine_handle<> continuation_;
+        std::exception_ptr exception_;
+        bool detached_ = false;
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept {
+                auto& promise = handle.promise();
+                if (promise.detached_) {
+                    if (promise.exception_) {
+                        try {
+                            std::rethrow_exception(promise.exception_);
+                        } catch (const std::exception& e) {
+                            ELITE_LOG_ERROR("Detached coroutine throw exception: %s", e.what());
+                        } catch (...) {
+                            ELITE_LOG_ERROR("Detached coroutine throw exception");
+                        }
+                    }
+                    handle.destroy();
+                    return std::noop_coroutine();
+                }
+                if (promise.continuation_) {
+                    return promise.continuation_;
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { exception_ = std::current_exception(); }
+    };
+
+    struct ValuePromise : PromiseBase {
+        std::optional<T> value_;
+        void return_value(T value) { value_.emplace(std::move(value)); }
+        T result() {
+            if (this->exception_) {
+                std::rethrow_exception(this->exception_);
+            }
+            return std::move(*value_);
+        }
+    };
+
+    struct VoidPromise : PromiseBase {
+        void return_void() {}
+        void result() {
+            if (this->exception_) {
+                std::rethrow_exception(this->exception_);
+            }
+        }
+    };
+
+    struct promise_type : std::conditional_t<std::is_void<T>::value, VoidPromise, ValuePromise> {
+        CoTask get_return_object() { return CoTask(Handle::from_promise(*this)); }
+    };
+
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    CoTask& operator=(CoTask&&) = delete;
+
+    ~CoTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+        handle_.promise().continuation_ = awaiting;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+    /**
+     * @brief Start the coroutine in the current thread and release it, the frame is destroyed when it finishes.
+     *
+     */
+    void spawn() && {
+        Handle handle = std::exchange(handle_, nullptr);
+        if (handle) {
+            handle.promise().detached_ = true;
+            handle.resume();
+        }
+    }
+
+   private:
+    explicit CoTask(Handle handle) : handle_(handle) {}
+
+    Handle handle_;
+};
+
+/**
+ * @brief Start a coroutine detached, optionally in an executor
+ *
+ * @param task The coroutine
+ * @param executor The executor which starts the coroutine, nullptr to start it in the current thread
+ * @return true The coroutine is started or queued
+ * @return false The executor dropped it
+ */
+inline bool spawn(CoTask<void> task, const CallbackExecutorSharedPtr& executor = nullptr) {
+    auto shared = std::make_shared<CoTask<void>>(std::move(task));
+    return dispatchCallback(executor, [shared]() { std::move(*shared).spawn(); });
+}
+
+namespace detail {
+
+/**
+ * @brief The trajectory result callback installed by trajectoryDone(). It calls the callback it replaced, then completes the
+ *  awaitable. A named type, so the next trajectoryDone() chains the user callback and not the previous awaitable.
+ *
+ */
+struct TrajectoryDoneCallback {
+    std::shared_ptr<OneShotState<TrajectoryMotionResult>> state;
+    std::function<void(TrajectoryMotionResult)> user;
+
+    void operator()(TrajectoryMotionResult result) const {
+        if (user) {
+            user(result);
+        }
+        // The resumed coroutine may replace this callback, keep the state alive
+        auto keep = state;
+        keep->set(result);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Awaits the result of the trajectory started by EliteDriver::writeTrajectoryControlAction().
+ *  Create it before starting the trajectory, the result is kept until it is awaited.
+ *
+ * @param driver The driver
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the thread which reports the result
+ * @return The awaitable, co_await returns TrajectoryMotionResult
+ * @note The callback set by EliteDriver::setTrajectoryResultCallback() is kept and still called, before the coroutine resumes.
+ * Setting a callback after this call replaces the awaitable's one, and the awaitable never completes.
+ */
+inline detail::OneShotAwaitable<TrajectoryMotionResult> trajectoryDone(EliteDriver& driver,
+                                                                        CallbackExecutorSharedPtr resume_on = nullptr) {
+    auto state = std::make_shared<detail::OneShotState<TrajectoryMotionResult>>(std::move(resume_on));
+    std::function<void(TrajectoryMotionResult)> user = driver.getTrajectoryResultCallback();
+    if (auto previous = user.target<detail::TrajectoryDoneCallback>()) {
+        user = previous->user;
+    }
+    driver.setTrajectoryResultCallback(detail::TrajectoryDoneCallback{state, std::move(user)});
+    return detail::OneShotAwaitable<TrajectoryMotionResult>(state, nullptr);
+}
+
+/**
+ * @brief Awaits the next output frame of the RTSI interface
+ *
+ * @param rtsi The RTSI interface, must outlive the awaitable
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the RTSI receive thread. In the receive
+ * thread, the coroutine runs before the input recipe of the cycle is sent and must not block.
+ * @return The awaitable, co_await returns true
+ */
+inline detail::OneShotAwaitable<bool> nextFrame(RtsiIOInterface& rtsi, CallbackExecutorSharedPtr resume_on = nullptr) {
+    auto state = std::make_shared<detail::OneShotState<bool>>(std::move(resume_on));
+    int handle = rtsi.addFrameCallback([state]() { state->set(true); });
+    RtsiIOInterface* rtsi_ptr = &rtsi;
+    return detail::OneShotAwaitable<bool>(state, [rtsi_ptr, handle]() { rtsi_ptr->removeFrameCallback(handle); });
+}
+
+/**
+ * @brief Awaits the next IO event matching a filter
+ *
+ * @param events The IO event engine, must outlive the awaitable. The signal must be watched by watchDigital() or watchAnalog().
+ * @param filter Returns true for the event to await
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the RTSI receive thread
+ * @return The awaitable, co_await returns the IOEvent
+ */
+inline detail::OneShotAwaitable<IOEvent> nextIOEvent(RtsiIOEventEngine& events, std::function<bool(const IOEvent&)> filter,
+                                                     CallbackExecutorSharedPtr resume_on = nullptr) {
+    auto state = std::make_shared<detail::OneShotState<IOEvent>>(std::move(resume_on));
+    int handle = events.addListener([state, filter](const IOEvent& event) {
+        if (filter(event)) {
+            state->set(event);
+        }
+    });
+    RtsiIOEventEngine* events_ptr = &events;
+    return detail::OneShotAwaitable<IOEvent>(state, [events_ptr, handle]() { events_ptr->removeListener(handle); });
+}
+
+/**
+ * @brief Awaits an edge of a standard digital input
+ *
+ * @param events The IO event engine, the input must be watched by watchDigital(IOEventSource::DIGITAL_INPUT, ...)
+ * @param index Index of the digital input
+ * @param rising true: rising edge, false: falling edge
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the RTSI receive thread
+ * @return The awaitable, co_await returns the IOEvent
+ */
+inline detail::OneShotAwaitable<IOEvent> digitalInputEdge(RtsiIOEventEngine& events, int index, bool rising = true,
+                                                          CallbackExecutorSharedPtr resume_on = nullptr) {
+    return nextIOEvent(
+        events,
+        [index, rising](const IOEvent& event) {
+            return event.source == IOEventSource::DIGITAL_INPUT && event.index == index && event.rising == rising;
+        },
+        std::move(resume_on));
+}
+
+/**
+ * @brief Run a blocking function in an executor and await its result. Used for the requests which have no asynchronous
+ * interface, e.g. DashboardClient.
+ *
+ * @param worker The executor which runs the function, e.g. a ThreadExecutor. nullptr runs it in the current thread.
+ * @param func The function
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the worker thread
+ * @return The awaitable, co_await returns the result of the function or rethrows its exception
+ */
+template <typename F, typename R = std::invoke_result_t<F>>
+detail::OneShotAwaitable<std::conditional_t<std::is_void<R>::value, bool, R>> asyncCall(const CallbackExecutorSharedPtr& worker, F func,
+                                                                                      CallbackExecutorSharedPtr resume_on = nullptr) {
+    using Result = std::conditional_t<std::is_void<R>::value, bool, R>;
+    auto state = std::make_shared<detail::OneShotState<Result>>(std::move(resume_on));
+    auto run = [state, func = std::move(func)]() mutable {
+        try {
+            if constexpr (std::is_void<R>::value) {
+                func();
+                state->set(true);
+            } else {
+                state->set(func());
+            }
+        } catch (...) {
+            state->setException(std::current_exception());
+        }
+    };
+    if (!dispatchCallback(worker, std::move(run))) {
+        state->setException(std::make_exception_ptr(std::runtime_error("asyncCall dropped by the executor")));
+    }
+    return detail::OneShotAwaitable<Result>(state, nullptr);
+}
+
+/**
+ * @brief Request the robot mode through the dashboard without blocking the coroutine
+ *
+ * @param dashboard The dashboard client, must outlive the request. Requests of one client must not run concurrently.
+ * @param worker The executor which sends the request, e.g. a ThreadExecutor
+ * @param resume_on The executor which resumes the coroutine, nullptr to resume it in the worker thread
+ * @return The awaitable, co_await returns the RobotMode
+ */
+inline auto robotModeAsync(DashboardClient& dashboard, const CallbackExecutorSharedPtr& worker,
+                           CallbackExecutorSharedPtr resume_on = nullptr) {
+    DashboardClient* client = &dashboard;
+    return asyncCall(worker, [client]() { return client->robotMode(); }, std::move(resume_on));
+}
+
+}  // namespace ELITE
+
+#endif  // C++20
+
+#endif
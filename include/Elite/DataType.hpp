@@ -9,6 +9,7 @@
 #include <Elite/EliteOptions.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 
 #if (ELITE_SDK_COMPILE_STANDARD >= 17)
@@ -120,6 +121,16 @@ enum class TrajectoryControlAction : int {
     START = 1,
 };
 
+/// The owners of the tool contact stop of EliteDriver. Each owner sets and clears only its own latch.
+enum class ToolContactOwner : int {
+    /// The application
+    USER = 0,
+    /// ToolContactDetector
+    TOOL_CONTACT_DETECTOR = 1,
+    /// CollisionDetector
+    COLLISION_DETECTOR = 2,
+};
+
 enum class ToolVoltage : int {
     OFF = 0,    // 0V
     V_12 = 12,  // 12V
@@ -148,6 +159,86 @@ enum class FreedriveAction : int {
     FREEDRIVE_START = 1
 };
 
+enum class ScriptCommand : int {
+    ZERO_FTSENSOR = 0,
+    SET_PAYLOAD = 1,
+    SET_TOOL_VOLTAGE = 2,
+    START_FORCE_MODE = 3,
+    END_FORCE_MODE = 4,
+    /// Does nothing on the robot, only acknowledged
+    PING = 9,
+};
+
+enum class ScriptCommandStatus : int {
+    /// The script executed the command and acknowledged it
+    SUCCESS = 0,
+    /// No acknowledge in time
+    TIMEOUT = 1,
+    /// The command could not be written to the robot
+    SEND_FAIL = 2,
+    /// The interface was destroyed before the acknowledge
+    CANCELED = 3,
+};
+
+/**
+ * @brief Acknowledge of a script command
+ *
+ */
+struct ScriptCommandAck {
+    ScriptCommandStatus status = ScriptCommandStatus::CANCELED;
+    /// The sequence number of the command
+    int32_t seq = 0;
+    /// The result code returned by the script, 0 means success. Only valid if status is SUCCESS.
+    int32_t result = 0;
+    /// Time from sending the command to receiving the acknowledge
+    std::chrono::microseconds latency{0};
+};
+
+/**
+ * @brief Round trip statistics of a script command
+ *
+ */
+struct ScriptCommandStats {
+    uint64_t sent = 0;
+    uint64_t acked = 0;
+    uint64_t timeout = 0;
+    std::chrono::microseconds min_latency{0};
+    std::chrono::microseconds max_latency{0};
+    std::chrono::microseconds mean_latency{0};
+    std::chrono::microseconds last_latency{0};
+};
+
+/**
+ * @brief Statistics of the scripts sent through the primary port.
+ *  The latency is measured from the request being queued until the script is completely written to the socket.
+ *
+ */
+struct ScriptSendStats {
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+    uint64_t timeout = 0;
+    std::chrono::microseconds min_latency{0};
+    std::chrono::microseconds max_latency{0};
+    std::chrono::microseconds mean_latency{0};
+    std::chrono::microseconds last_latency{0};
+};
+
+/**
+ * @brief The servers of the driver which the external control script connects to
+ *
+ */
+enum class DriverServer : int { REVERSE = 0, TRAJECTORY = 1, SCRIPT_COMMAND = 2 };
+
+/**
+ * @brief The external control script connected to or disconnected from a server of the driver
+ *
+ */
+struct ConnectionEvent {
+    DriverServer server;
+    bool connected;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
 using vector3d_t = std::array<double, 3>;
 using vector6d_t = std::array<double, 6>;
 using vector6int32_t = std::array<int32_t, 6>;
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// DriverCommandWriter.hpp
+// The driver commands written by the frame-driven helpers (detectors, recorders, streamers, payload identification).
+#ifndef __ELITE__DRIVER_COMMAND_WRITER_HPP__
+#define __ELITE__DRIVER_COMMAND_WRITER_HPP__
+
+#include <Elite/DataType.hpp>
+
+#include <functional>
+
+namespace ELITE {
+
+/**
+ * @brief The motion and configuration commands of EliteDriver used by the helpers which react to RTSI frames.
+ *  EliteDriver is the writer connected to the robot. Implement it to run the helpers without a robot, e.g. in tests.
+ *  See EliteDriver for the meaning of every command.
+ *
+ */
+class DriverCommandWriter {
+   public:
+    virtual ~DriverCommandWriter() = default;
+
+    virtual bool writeServoj(const vector6d_t& pos, int timeout_ms, bool cartesian = false, bool queue_mode = false) = 0;
+
+    virtual bool writeSpeedj(const vector6d_t& vel, int timeout_ms) = 0;
+
+    virtual void setTrajectoryResultCallback(std::function<void(TrajectoryMotionResult)> cb) = 0;
+
+    virtual std::function<void(TrajectoryMotionResult)> getTrajectoryResultCallback() = 0;
+
+    virtual bool writeTrajectoryPoint(const vector6d_t& positions, float time, float blend_radius, bool cartesian) = 0;
+
+    virtual bool writeTrajectoryControlAction(TrajectoryControlAction action, const int point_number, int timeout_ms) = 0;
+
+    virtual bool writeToolContact(int timeout_ms, ToolContactOwner owner = ToolContactOwner::USER) = 0;
+
+    virtual void clearToolContact() = 0;
+
+    virtual void clearToolContact(ToolContactOwner owner) = 0;
+
+    virtual bool setPayload(double mass, const vector3d_t& cog) = 0;
+};
+
+}  // namespace ELITE
+
+#endif
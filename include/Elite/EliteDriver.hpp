@@ -6,15 +6,19 @@
 #ifndef __ELITE_DRIVER_HPP__
 #define __ELITE_DRIVER_HPP__
 
+#include <Elite/CallbackExecutor.hpp>
 #include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
 #include <Elite/EliteOptions.hpp>
 #include <Elite/PrimaryPackage.hpp>
 #include <Elite/PrimaryPortInterface.hpp>
 #include <Elite/SerialCommunication.hpp>
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ELITE {
 
@@ -67,6 +71,30 @@ class EliteDriverConfig {
     // this interface in the API documentation.)
     float servoj_queue_pre_recv_timeout = -1;
 
+    // Take over the listening sockets of the reverse, trajectory, script command and script sender ports from the process
+    // manager instead of binding the ports: the descriptors in `listen_fds`, or the ones passed by systemd socket activation
+    // ('LISTEN_FDS') if it is empty. An activation socket named "reverse", "trajectory", "script_command" or "script_sender"
+    // ('LISTEN_FDNAMES', FileDescriptorName= of the socket unit) is used for that server, any other socket for the port it is
+    // bound to. Only supported on Linux.
+    bool inherit_listen_sockets = false;
+
+    // Listening socket descriptors used when `inherit_listen_sockets` is true.
+    std::vector<int> listen_fds;
+
+    // Attach to the external control script already running on the robot, e.g. after this process restarted. The control script
+    // is not sent in headless mode, the running script connects again to the inherited listening sockets. The running script
+    // must be generated with `reattach_timeout` greater than 0.
+    bool reattach = false;
+
+    // Time [s] the external control script waits to connect again after the reverse socket is lost, instead of exiting. The
+    // robot stops the motion while waiting. If the value is less than or equal to 0, the script exits.
+    float reattach_timeout = 0;
+
+    // Runs the user callbacks: trajectory result, robot exception and connection callbacks. If nullptr, the callbacks run in the
+    // SDK threads and a slow callback delays them. Use a `ThreadExecutor` to run them in a dedicated thread, or your own
+    // `CallbackExecutor`.
+    CallbackExecutorSharedPtr callback_executor = nullptr;
+
     EliteDriverConfig() = default;
     ~EliteDriverConfig() = default;
 };
@@ -75,7 +103,7 @@ class EliteDriverConfig {
  * @brief This is the main class for interfacing the driver.
  *  It sets up all the necessary socket connections and handles the data exchange with the robot.
  */
-class EliteDriver {
+class EliteDriver : public DriverCommandWriter {
    private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -135,7 +163,8 @@ class EliteDriver {
      * @return true Joint angles sent successfully.
      * @return false Fail to send joint angles.
      */
-    ELITE_EXPORT bool writeServoj(const vector6d_t& pos, int timeout_ms, bool cartesian = false, bool queue_mode = false);
+    ELITE_EXPORT bool writeServoj(const vector6d_t& pos, int timeout_ms, bool cartesian = false,
+                                  bool queue_mode = false) override;
 
     /**
      * @brief Write speedl() velocity to robot
@@ -155,7 +184,7 @@ class EliteDriver {
      * @return true Joint velocity sent successfully.
      * @return false Fail to send joint velocity.
      */
-    ELITE_EXPORT bool writeSpeedj(const vector6d_t& vel, int timeout_ms);
+    ELITE_EXPORT bool writeSpeedj(const vector6d_t& vel, int timeout_ms) override;
 
     /**
      * @brief Register a callback for the robot-based trajectory execution completion.
@@ -165,7 +194,14 @@ class EliteDriver {
      *
      * @param cb Callback function that will be triggered in the event of finishing
      */
-    ELITE_EXPORT void setTrajectoryResultCallback(std::function<void(TrajectoryMotionResult)> cb);
+    ELITE_EXPORT void setTrajectoryResultCallback(std::function<void(TrajectoryMotionResult)> cb) override;
+
+    /**
+     * @brief Get the callback set by setTrajectoryResultCallback()
+     *
+     * @return std::function<void(TrajectoryMotionResult)> The callback, empty if none
+     */
+    ELITE_EXPORT std::function<void(TrajectoryMotionResult)> getTrajectoryResultCallback() override;
 
     /**
      * @brief Writes a trajectory point onto the dedicated socket.
@@ -177,7 +213,37 @@ class EliteDriver {
      * @return true Trajectory point sent successfully.
      * @return false Fail to send trajectory point.
      */
-    ELITE_EXPORT bool writeTrajectoryPoint(const vector6d_t& positions, float time, float blend_radius, bool cartesian);
+    ELITE_EXPORT bool writeTrajectoryPoint(const vector6d_t& positions, float time, float blend_radius,
+                                           bool cartesian) override;
+
+    /**
+     * @brief Writes a joint spline knot with position and velocity in trajectory forward mode. The robot moves from the previous
+     * knot (or the current joint positions for the first knot) along a cubic polynomial, with servoj at every control cycle.
+     *
+     * @param positions Joint positions of the knot
+     * @param velocities Joint velocities of the knot
+     * @param time Duration of the segment. A knot with time 0 does not move the robot, the next segment starts with its
+     * velocities (and accelerations) instead of at rest, see SplineTrajectory::start().
+     * @return true Trajectory point sent successfully.
+     * @return false Fail to send trajectory point.
+     * @note The start and the knots of a SplineTrajectory can be sent directly. The point is counted in
+     * writeTrajectoryControlAction().
+     */
+    ELITE_EXPORT bool writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities, float time);
+
+    /**
+     * @brief Writes a joint spline knot with position, velocity and acceleration in trajectory forward mode. The robot moves
+     * along a quintic polynomial, so the acceleration is continuous between the segments.
+     *
+     * @param positions Joint positions of the knot
+     * @param velocities Joint velocities of the knot
+     * @param accelerations Joint accelerations of the knot
+     * @param time Duration of the segment, 0 for a start knot
+     * @return true Trajectory point sent successfully.
+     * @return false Fail to send trajectory point.
+     */
+    ELITE_EXPORT bool writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities,
+                                                 const vector6d_t& accelerations, float time);
 
     /**
      * @brief Writes a control message in trajectory forward mode.
@@ -188,7 +254,8 @@ class EliteDriver {
      * @return true Trajectory action sent successfully.
      * @return false Fail to send trajectory action.
      */
-    ELITE_EXPORT bool writeTrajectoryControlAction(TrajectoryControlAction action, const int point_number, int timeout_ms);
+    ELITE_EXPORT bool writeTrajectoryControlAction(TrajectoryControlAction action, const int point_number,
+                                                   int timeout_ms) override;
 
     /**
      * @brief Write a idle signal only.
@@ -211,6 +278,39 @@ class EliteDriver {
      */
     ELITE_EXPORT bool writeFreedrive(FreedriveAction action, int timeout_ms);
 
+    /**
+     * @brief Stop the motion because the tool is in contact. The control script stops the current control mode with stopj and
+     * holds the robot. While the latch of any owner is set, the motion commands (writeServoj(), writeSpeedl(), writeSpeedj(),
+     * writeTrajectoryControlAction() and writeFreedrive()) are replaced by this command and return false, so a streaming loop
+     * can't move the robot again. writeIdle() and stopControl() are not affected.
+     *
+     * @param timeout_ms The read timeout configuration for the reverse socket running in the external control script on the robot.
+     * @param owner The latch set by this stop. ToolContactDetector and CollisionDetector use their own.
+     * @return true Contact command sent successfully.
+     * @return false Fail to send contact command.
+     * @note Usually called by ToolContactDetector or CollisionDetector in the RTSI receive thread.
+     */
+    ELITE_EXPORT bool writeToolContact(int timeout_ms, ToolContactOwner owner = ToolContactOwner::USER) override;
+
+    /**
+     * @brief Clear the latches of all owners, the motion commands are allowed again
+     *
+     */
+    ELITE_EXPORT void clearToolContact() override;
+
+    /**
+     * @brief Clear the latch of one owner. The motion commands stay blocked while another owner's latch is set.
+     *
+     * @param owner The owner
+     */
+    ELITE_EXPORT void clearToolContact(ToolContactOwner owner) override;
+
+    /**
+     * @brief Whether the motion commands are blocked by writeToolContact() of any owner
+     *
+     */
+    ELITE_EXPORT bool isToolInContact();
+
     /**
      * @brief Sends a stop command to the socket interface which will signal the program running on
      * the robot to no longer listen for commands sent from the remote pc.
@@ -231,13 +331,39 @@ class EliteDriver {
     printRobotScript();
 
     /**
-     * @brief Is robot connect to server.
+     * @brief Is robot connect to server. Reads the connection states kept by the servers, doesn't lock.
      *
      * @return true connected
      * @return false don't
      */
     ELITE_EXPORT bool isRobotConnected();
 
+    /**
+     * @brief Wait until isRobotConnected() equals 'connected'. Wakes on the connection events instead of polling.
+     *
+     * @param connected The connection state to wait for
+     * @param timeout_ms Timeout
+     * @return true The state is reached
+     * @return false timeout
+     */
+    ELITE_EXPORT bool waitRobotConnection(bool connected, int timeout_ms);
+
+    /**
+     * @brief Register a callback of the external control script connecting to and disconnecting from the servers of the driver.
+     *  The callback is run by the callback executor with a timestamp of the event. Without an executor it is called in the
+     *  server thread and must not block.
+     *
+     * @param cb Callback, nullptr to unregister.
+     */
+    ELITE_EXPORT void registerConnectionCallback(std::function<void(const ConnectionEvent&)> cb);
+
+    /**
+     * @brief Get the statistics of the callback executor set in the configuration
+     *
+     * @return CallbackExecutorStats Statistics, empty if there is no executor.
+     */
+    ELITE_EXPORT CallbackExecutorStats getCallbackExecutorStats();
+
     /**
      * @brief Zero (tare) the force and torque values measured by the force/torque sensor and applied to the tool TCP. The force and
      * torque values are the force and torque vectors applied to the tool TCP obtained by the `get_tcp_force(True)` script
@@ -264,7 +390,7 @@ class EliteDriver {
      * @return true success
      * @return false fail
      */
-    ELITE_EXPORT bool setPayload(double mass, const vector3d_t& cog);
+    ELITE_EXPORT bool setPayload(double mass, const vector3d_t& cog) override;
 
     /**
      * @brief Set the tool voltage
@@ -310,6 +436,40 @@ class EliteDriver {
      */
     ELITE_EXPORT bool endForceMode();
 
+    /**
+     * @brief The acknowledged variants of `zeroFTSensor()`, `setPayload()`, `setToolVoltage()`, `startForceMode()` and
+     * `endForceMode()`. Every script command carries a sequence number, the control script acknowledges it after the command
+     * is executed.
+     *
+     * @param timeout_ms Timeout of the acknowledge
+     * @return std::future<ScriptCommandAck> Ready when the acknowledge is received or on timeout. If the command can not be
+     * sent, the future is already ready with `ScriptCommandStatus::SEND_FAIL`.
+     */
+    ELITE_EXPORT std::future<ScriptCommandAck> zeroFTSensorAsync(int timeout_ms = 1000);
+    ELITE_EXPORT std::future<ScriptCommandAck> setPayloadAsync(double mass, const vector3d_t& cog, int timeout_ms = 1000);
+    ELITE_EXPORT std::future<ScriptCommandAck> setToolVoltageAsync(const ToolVoltage& vol, int timeout_ms = 1000);
+    ELITE_EXPORT std::future<ScriptCommandAck> startForceModeAsync(const vector6d_t& reference_frame,
+                                                                   const vector6int32_t& selection_vector,
+                                                                   const vector6d_t& wrench, const ForceMode& mode,
+                                                                   const vector6d_t& limits, int timeout_ms = 1000);
+    ELITE_EXPORT std::future<ScriptCommandAck> endForceModeAsync(int timeout_ms = 1000);
+
+    /**
+     * @brief Send a script command which does nothing, to measure the round trip of the script command socket.
+     *
+     * @param timeout_ms Timeout of the acknowledge
+     * @return std::future<ScriptCommandAck> The acknowledge
+     */
+    ELITE_EXPORT std::future<ScriptCommandAck> pingScriptCommand(int timeout_ms = 1000);
+
+    /**
+     * @brief Get the round trip statistics of a script command
+     *
+     * @param cmd The script command
+     * @return ScriptCommandStats Statistics
+     */
+    ELITE_EXPORT ScriptCommandStats getScriptCommandStats(ScriptCommand cmd);
+
     /**
      * @brief Send a custom script.
      *
@@ -319,6 +479,13 @@ class EliteDriver {
      */
     ELITE_EXPORT bool sendScript(const std::string& script);
 
+    /**
+     * @brief Get the statistics of the scripts sent through the primary port
+     *
+     * @return ScriptSendStats Statistics
+     */
+    ELITE_EXPORT ScriptSendStats getScriptSendStats();
+
     /**
      * @brief Send external control script
      *
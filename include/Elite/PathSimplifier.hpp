@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// PathSimplifier.hpp
+// Online simplification of a sampled joint path within a tolerance, used by TeachRecorder.
+#ifndef __ELITE__PATH_SIMPLIFIER_HPP__
+#define __ELITE__PATH_SIMPLIFIER_HPP__
+
+#include <Elite/DataType.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ELITE {
+
+namespace TEACH {
+
+struct PathSample {
+    /// Time (s)
+    double time = 0;
+    vector6d_t joints{};
+    /// TCP pose, only x, y, z are checked
+    vector6d_t tcp{};
+};
+
+/**
+ * @brief Opening window simplification with the synchronized distance: a sample is dropped if the straight line between the
+ * waypoints, interpolated in time, passes within the tolerance of it. So the replay with the waypoint durations keeps the
+ * timing of the path, a pause is kept as two waypoints.
+ *
+ * The samples after the last waypoint are buffered, at most 'max_segment_samples', the buffer is allocated once.
+ */
+class PathSimplifier {
+   public:
+    /**
+     * @param joint_tolerance Maximum absolute joint deviation (rad), <= 0: not checked
+     * @param position_tolerance Maximum TCP position deviation (m), <= 0: not checked
+     * @param max_segment_samples Maximum samples between two waypoints, at least 1
+     */
+    PathSimplifier(double joint_tolerance, double position_tolerance, size_t max_segment_samples)
+        : joint_tolerance_(joint_tolerance),
+          position_tolerance_(position_tolerance),
+          max_segment_samples_(std::max<size_t>(max_segment_samples, 1)),
+          started_(false) {
+        window_.reserve(max_segment_samples_);
+    }
+
+    void reset() {
+        started_ = false;
+        window_.clear();
+    }
+
+    /**
+     * @brief Feed a sample
+     *
+     * @param sample The sample, the time must not decrease
+     * @param waypoint The waypoint completed by this sample
+     * @return true A waypoint was completed. The first sample is always a waypoint.
+     */
+    bool add(const PathSample& sample, PathSample& waypoint) {
+        if (!started_) {
+            started_ = true;
+            anchor_ = sample;
+            waypoint = sample;
+            return true;
+        }
+        if (window_.size() < max_segment_samples_ && windowFits(sample)) {
+            window_.push_back(sample);
+            return false;
+        }
+        waypoint = window_.back();
+        anchor_ = waypoint;
+        window_.clear();
+        window_.push_back(sample);
+        return true;
+    }
+
+    /**
+     * @brief End the path
+     *
+     * @param waypoint The last sample, if it is not a waypoint yet
+     * @return true There was a last waypoint
+     */
+    bool finish(PathSample& waypoint) {
+        if (window_.empty()) {
+            return false;
+        }
+        waypoint = window_.back();
+        anchor_ = waypoint;
+        window_.clear();
+        return true;
+    }
+
+    /**
+     * @brief The synchronized deviation of a sample from the line between two waypoints
+     *
+     * @param joint Maximum absolute joint deviation
+     * @param position TCP position deviation
+     */
+    static void deviation(const PathSample& from, const PathSample& to, const PathSample& sample, double& joint,
+                          double& position) {
+        double span = to.time - from.time;
+        double s = span > 0 ? (sample.time - from.time) / span : 0;
+        joint = 0;
+        for (int i = 0; i < 6; i++) {
+            double expected = from.joints[i] + s * (to.joints[i] - from.joints[i]);
+            joint = std::max(joint, std::abs(sample.joints[i] - expected));
+        }
+        double sum = 0;
+        for (int i = 0; i < 3; i++) {
+            double d = sample.tcp[i] - (from.tcp[i] + s * (to.tcp[i] - from.tcp[i]));
+            sum += d * d;
+        }
+        position = std::sqrt(sum);
+    }
+
+   private:
+    bool windowFits(const PathSample& to) const {
+        for (const PathSample& sample : window_) {
+            double joint, position;
+            deviation(anchor_, to, sample, joint, position);
+            if ((joint_tolerance_ > 0 && joint > joint_tolerance_) || (position_tolerance_ > 0 && position > position_tolerance_)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double joint_tolerance_;
+    double position_tolerance_;
+    size_t max_segment_samples_;
+    bool started_;
+    PathSample anchor_;
+    std::vector<PathSample> window_;
+};
+
+}  // namespace TEACH
+
+}  // namespace ELITE
+
+#endif
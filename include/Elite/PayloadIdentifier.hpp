@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// PayloadIdentifier.hpp
+// Moves the wrist through an excitation trajectory and identifies the payload from the RTSI joint torques.
+#ifndef __ELITE__PAYLOAD_IDENTIFIER_HPP__
+#define __ELITE__PAYLOAD_IDENTIFIER_HPP__
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/Kinematics.hpp>
+#include <Elite/PayloadEstimator.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief Configuration of an identification run
+ *
+ */
+struct PayloadIdentificationConfig {
+    /// Amplitude of the wrist joint motion around the start position (rad). Joints 2 and 3 move a third of it.
+    double amplitude = 0.6;
+    /// Time of each trajectory point (s). Slow motion keeps the inertial torques, which are not modeled, small.
+    float point_time = 2.0;
+    /// The read timeout of the trajectory commands
+    int timeout_ms = 200;
+    /// Set the identified payload on the robot with EliteDriver::setPayload() when the trajectory is done
+    bool apply = true;
+};
+
+/**
+ * @brief Identifies the payload mass and center of gravity online, while the robot moves, from the RTSI joint torques.
+ *
+ * The torques are fed to a PayloadEstimator in the RTSI receive thread, frame by frame, so no data is stored. The arm model is
+ * learned once by calibrateArm() with a correctly configured payload (for example without a tool), it can be saved with
+ * getArmModel() and restored with setArmModel(). identify() then estimates any new payload.
+ *
+ * Subscribe "actual_joint_positions", "actual_joint_speeds" and "actual_joint_torques" in the output recipe, and "payload_mass"
+ * and "payload_cog" for calibrateArm(). The excitation is run as a trajectory (EliteDriver::writeTrajectoryPoint()), so the
+ * external control script must be running. The robot moves from the current position, make sure the space around the wrist
+ * is free.
+ *
+ * While a run is active, a thread of the identifier writes the NOOP actions which keep the trajectory alive, twice per
+ * 'timeout_ms'. The RTSI receive thread only feeds the estimator.
+ *
+ * @note A run replaces the trajectory result callback of the driver (EliteDriver::setTrajectoryResultCallback()).
+ */
+class PayloadIdentifier {
+   public:
+    /**
+     * @brief The callback of a finished run
+     *
+     * @param success The trajectory succeeded and the estimate is valid
+     * @param estimate The estimate, for calibrateArm() with the reference payload
+     */
+    using DoneCallback = std::function<void(bool success, const PayloadEstimate& estimate)>;
+
+    PayloadIdentifier() = delete;
+
+    /**
+     * @brief Construct a new Payload Identifier object
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param driver The driver which moves the robot, usually an EliteDriver. Must outlive this object.
+     * @param kinematics The kinematics of the robot, from KinematicsInfo
+     * @param executor Runs the done callback, nullptr to run it in the thread of the trajectory result
+     */
+    ELITE_EXPORT PayloadIdentifier(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Kinematics& kinematics,
+                                   CallbackExecutorSharedPtr executor = nullptr);
+
+    ELITE_EXPORT ~PayloadIdentifier();
+
+    /**
+     * @brief Learn the arm model. The reference payload is read from "payload_mass" and "payload_cog".
+     *
+     * @param config Excitation
+     * @return true the excitation started
+     * @return false a run is active, the recipe values can not be read, or the trajectory can not be started
+     */
+    ELITE_EXPORT bool calibrateArm(const PayloadIdentificationConfig& config = PayloadIdentificationConfig());
+
+    /**
+     * @brief Identify the payload
+     *
+     * @param config Excitation
+     * @return true the excitation started
+     * @return false a run is active, there is no arm model, "actual_joint_positions" can not be read, or the trajectory can
+     * not be started
+     */
+    ELITE_EXPORT bool identify(const PayloadIdentificationConfig& config = PayloadIdentificationConfig());
+
+    /**
+     * @brief Cancel the run, the robot stops and the done callback is called with false
+     *
+     */
+    ELITE_EXPORT void cancel();
+
+    ELITE_EXPORT bool isRunning();
+
+    ELITE_EXPORT void setDoneCallback(DoneCallback cb);
+
+    /**
+     * @brief The estimate so far, it is updated while the robot moves
+     *
+     */
+    ELITE_EXPORT PayloadEstimate getEstimate();
+
+    ELITE_EXPORT ArmGravityModel getArmModel();
+
+    ELITE_EXPORT void setArmModel(const ArmGravityModel& model);
+
+    /**
+     * @brief The excitation trajectory, it starts and ends at the start position
+     *
+     * @param start Joint positions (rad)
+     * @param amplitude Amplitude of the wrist joints (rad)
+     * @return The joint positions of the trajectory points, without the start
+     */
+    ELITE_EXPORT static std::vector<vector6d_t> excitation(const vector6d_t& start, double amplitude);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -24,9 +24,29 @@ namespace UPGRADE {
  *      1. On Linux, if `libssh` is not installed, you need to ensure that the computer running the SDK has the `scp`, `ssh`, and
  * `sshpass` commands available.
  *      2. In Windows, if libssh is not installed, then this interface will not be available.
+ *      3. The package is not cached on the controller, see the delta transfer variant below.
  */
 ELITE_EXPORT bool upgradeControlSoftware(std::string ip, std::string file, std::string password);
 
+/**
+ * @brief Upgrade the robot control software, uploading only the blocks changed since the previous upgrade
+ *
+ * Upgrades through this variant keep their package on the controller (/root/CS_UPDATE_CACHE.eup), the other variant leaves
+ * nothing behind. Call this variant with an empty `previous_file` to seed the cache for the next upgrade. The rolling checksum block signatures of `previous_file` are matched
+ * against `file`, and only the changed bytes and a patch script are uploaded. The script rebuilds the package on the controller
+ * from the cached one with `dd`, `tail` and `head`, and the result is verified by MD5.
+ *
+ * @param ip Robot ip
+ * @param file Upgrade file
+ * @param password Robot controller ssh password
+ * @param previous_file A local copy of the package of the previous upgrade of this robot. If it is empty, or it is not the package
+ * cached on the controller, or the patched package does not match, the whole package is uploaded.
+ * @return true success
+ * @return false fail
+ * @note The delta and the patch script are written next to `file` for the upload and removed afterwards.
+ */
+ELITE_EXPORT bool upgradeControlSoftware(std::string ip, std::string file, std::string password, std::string previous_file);
+
 }  // namespace UPGRADE
 }  // namespace ELITE
 
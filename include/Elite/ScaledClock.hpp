@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// ScaledClock.hpp
+// Trajectory time advanced by the controller speed scaling, used by ScaledServoStreamer.
+#ifndef __ELITE__SCALED_CLOCK_HPP__
+#define __ELITE__SCALED_CLOCK_HPP__
+
+#include <algorithm>
+
+namespace ELITE {
+
+namespace STREAM {
+
+/**
+ * @brief The trajectory time of a stream. Every frame advances it by the frame period times the speed scaling, so the
+ * commanded progress follows the actual progress of the robot at any speed slider setting.
+ *
+ * The applied scaling changes at most 'max_rate' per second, a slider step does not step the joint velocities.
+ */
+class ScaledClock {
+   public:
+    /**
+     * @param nominal_period Frame period used when the timestamps can not be used (s)
+     * @param max_rate Maximum change of the applied scaling per second, <= 0: not limited
+     */
+    ScaledClock(double nominal_period, double max_rate)
+        : nominal_period_(nominal_period), max_rate_(max_rate), time_(0), scaling_(0), last_stamp_(0), started_(false) {}
+
+    /**
+     * @brief Restart at time 0. The first frame applies its scaling without the rate limit.
+     *
+     */
+    void reset() {
+        time_ = 0;
+        started_ = false;
+    }
+
+    /**
+     * @brief Advance by one frame
+     *
+     * @param stamp Controller timestamp of the frame (s)
+     * @param scaling Speed scaling of the frame, clamped to [0, 1]
+     * @return double The trajectory time
+     */
+    double advance(double stamp, double scaling) {
+        double target = std::min(std::max(scaling, 0.0), 1.0);
+        double period = nominal_period_;
+        if (!started_) {
+            scaling_ = target;
+        } else {
+            double dt = stamp - last_stamp_;
+            // A repeated, reversed or lost-frames timestamp is not a usable period
+            if (dt > 0 && dt < 4 * nominal_period_) {
+                period = dt;
+            }
+        }
+        started_ = true;
+        last_stamp_ = stamp;
+
+        if (max_rate_ > 0) {
+            double step = max_rate_ * period;
+            target = std::min(std::max(target, scaling_ - step), scaling_ + step);
+        }
+        // Trapezoidal integration of the scaling over the frame
+        time_ += period * (scaling_ + target) / 2;
+        scaling_ = target;
+        return time_;
+    }
+
+    double time() const { return time_; }
+
+    /**
+     * @brief The scaling applied in the last frame
+     *
+     */
+    double scaling() const { return scaling_; }
+
+   private:
+    double nominal_period_;
+    double max_rate_;
+    double time_;
+    double scaling_;
+    double last_stamp_;
+    bool started_;
+};
+
+}  // namespace STREAM
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// ScaledServoStreamer.hpp
+// Streams a time-parameterized trajectory with servoj from the RTSI receive thread, following the controller speed scaling.
+#ifndef __ELITE__SCALED_SERVO_STREAMER_HPP__
+#define __ELITE__SCALED_SERVO_STREAMER_HPP__
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+#include <Elite/SplineTrajectory.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief Configuration of a stream
+ *
+ */
+struct ScaledServoConfig {
+    /// The RTSI frame period (s), used when "timestamp" is not subscribed or a frame is lost
+    double frame_period = 0.004;
+    /// Maximum change of the applied speed scaling per second, so a slider step does not step the velocities. <= 0: not limited.
+    double max_scaling_rate = 2.0;
+    /// The read timeout of the servoj commands
+    int timeout_ms = 100;
+    /// The sampled positions are cartesian poses
+    bool cartesian = false;
+};
+
+/**
+ * @brief Streams a time-parameterized trajectory with EliteDriver::writeServoj(), one point per RTSI frame, from the receive
+ * thread. Every frame advances the trajectory time by the frame period times the speed scaling of the controller
+ * ("speed_scaling", or "target_speed_fraction" if it is not subscribed), so when the speed slider is lowered the commanded
+ * progress matches the actual progress instead of racing ahead.
+ *
+ * Subscribe "timestamp" and "speed_scaling" in the output recipe. The frame rate should match EliteDriverConfig::servoj_time.
+ */
+class ScaledServoStreamer {
+   public:
+    /**
+     * @brief Samples the trajectory
+     *
+     * @param time Trajectory time (s), from 0 to the duration
+     * @param positions The positions at the time
+     * @return false the trajectory can not be sampled, the stream is aborted
+     */
+    using Sampler = std::function<bool(double time, vector6d_t& positions)>;
+
+    /**
+     * @brief Called when the stream ends
+     *
+     * @param finished true: the end of the trajectory was sent. false: aborted by a failed write or sample, or by stop().
+     */
+    using DoneCallback = std::function<void(bool finished)>;
+
+    ScaledServoStreamer() = delete;
+
+    /**
+     * @brief Construct a new Scaled Servo Streamer object
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param driver The driver, usually an EliteDriver. Must outlive this object.
+     * @param executor Runs the done callback, nullptr to run it in the RTSI receive thread
+     */
+    ELITE_EXPORT ScaledServoStreamer(RtsiFrameSource& rtsi, DriverCommandWriter& driver,
+                                     CallbackExecutorSharedPtr executor = nullptr);
+
+    ELITE_EXPORT ~ScaledServoStreamer();
+
+    /**
+     * @brief Start streaming from the next frame. The robot should be at the start of the trajectory.
+     *
+     * @param sampler Samples the trajectory, called in the RTSI receive thread
+     * @param duration Duration of the trajectory at full speed (s)
+     * @param config Configuration
+     * @return true success
+     * @return false already streaming, or the duration is not positive
+     */
+    ELITE_EXPORT bool start(Sampler sampler, double duration, const ScaledServoConfig& config = ScaledServoConfig());
+
+    /**
+     * @brief Start streaming a joint spline
+     *
+     * @param spline The fitted spline, copied
+     * @param config Configuration, 'cartesian' is ignored
+     * @return true success
+     * @return false already streaming, or the spline is not fitted
+     */
+    ELITE_EXPORT bool start(const SplineTrajectory& spline, const ScaledServoConfig& config = ScaledServoConfig());
+
+    /**
+     * @brief Abort the stream, no more points are sent. The script stops the servo motion when its read timeout expires.
+     *
+     */
+    ELITE_EXPORT void stop();
+
+    ELITE_EXPORT bool isStreaming();
+
+    /**
+     * @brief The trajectory time sent last (s)
+     *
+     */
+    ELITE_EXPORT double progress();
+
+    /**
+     * @brief The speed scaling applied in the last frame
+     *
+     */
+    ELITE_EXPORT double scaling();
+
+    /**
+     * @brief Set the callback of the end of a stream
+     *
+     */
+    ELITE_EXPORT void setDoneCallback(DoneCallback cb);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
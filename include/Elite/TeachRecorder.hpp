@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// TeachRecorder.hpp
+// Records a path taught in freedrive from the RTSI data, simplified online to a list of trajectory waypoints.
+#ifndef __ELITE__TEACH_RECORDER_HPP__
+#define __ELITE__TEACH_RECORDER_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief Tolerances of the recording
+ *
+ */
+struct TeachRecorderConfig {
+    /// Maximum absolute joint deviation of the simplified path from the samples (rad). <= 0: not checked.
+    double joint_tolerance = 0.002;
+    /// Maximum TCP position deviation of the simplified path from the samples (m), "actual_TCP_pose". <= 0: not checked.
+    double position_tolerance = 0.001;
+    /// Maximum samples between two waypoints, bounds the memory and the work of a frame
+    size_t max_segment_samples = 500;
+};
+
+/**
+ * @brief A waypoint of the taught path
+ *
+ */
+struct TeachWaypoint {
+    vector6d_t joint_positions{};
+    /// Zero if "actual_TCP_pose" is not subscribed
+    vector6d_t tcp_pose{};
+    /// Time from the start of the recording (s)
+    double time = 0;
+    /// Time from the previous waypoint (s), 0 for the first one
+    double duration = 0;
+};
+
+/**
+ * @brief Records the joint positions and TCP pose of every RTSI frame in the receive thread, and simplifies the path while
+ * recording: a sample is dropped when the line between the waypoints, interpolated in time, stays within the tolerances. The
+ * timing of the teaching, including the pauses, is kept in the waypoint durations.
+ *
+ * Subscribe "actual_joint_positions" in the output recipe, and "actual_TCP_pose" and "timestamp" (the controller time, the
+ * host time is used without it). The recorder does not switch freedrive on, use EliteDriver::writeFreedrive() for that.
+ */
+class TeachRecorder {
+   public:
+    TeachRecorder() = delete;
+
+    /**
+     * @brief Construct a new Teach Recorder object
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     */
+    ELITE_EXPORT explicit TeachRecorder(RtsiFrameSource& rtsi);
+
+    ELITE_EXPORT ~TeachRecorder();
+
+    /**
+     * @brief Start a recording from the next frame, the previous path is cleared
+     *
+     * @param config Tolerances
+     * @return true success
+     * @return false already recording
+     */
+    ELITE_EXPORT bool start(const TeachRecorderConfig& config = TeachRecorderConfig());
+
+    /**
+     * @brief Stop the recording
+     *
+     * @return std::vector<TeachWaypoint> The simplified path, the last sample is the last waypoint
+     */
+    ELITE_EXPORT std::vector<TeachWaypoint> stop();
+
+    ELITE_EXPORT bool isRecording();
+
+    /**
+     * @brief Get the waypoints completed so far
+     *
+     */
+    ELITE_EXPORT std::vector<TeachWaypoint> getWaypoints();
+
+    /**
+     * @brief The number of frames recorded
+     *
+     */
+    ELITE_EXPORT uint64_t sampleCount();
+
+    /**
+     * @brief Send a path in trajectory forward mode: START with the number of points, then every waypoint after the first one
+     * as a joint point with its duration. The robot must be at the first waypoint. Keep sending NOOP actions until the
+     * trajectory result callback is called.
+     *
+     * @param driver The driver, usually an EliteDriver
+     * @param path The path
+     * @param blend_radius The blend radius of the points (m)
+     * @param timeout_ms The read timeout of the START action
+     * @return true success
+     * @return false the path has less than 2 waypoints, or a write failed
+     */
+    ELITE_EXPORT static bool writeTrajectory(DriverCommandWriter& driver, const std::vector<TeachWaypoint>& path,
+                                             float blend_radius, int timeout_ms);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// ToolContactDetector.hpp
+// Detects a tool contact from the RTSI TCP force and joint currents, and stops the motion in the RTSI receive thread.
+#ifndef __ELITE__TOOL_CONTACT_DETECTOR_HPP__
+#define __ELITE__TOOL_CONTACT_DETECTOR_HPP__
+
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/DriverCommandWriter.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief Thresholds and filters of the contact detection
+ *
+ */
+struct ToolContactConfig {
+    /// Threshold of the TCP force residual magnitude (N), "actual_TCP_force" x, y, z. <= 0: not watched.
+    double force_threshold = 0;
+    /// Thresholds of the joint current residuals (A), "actual_joint_current". <= 0: the joint is not watched.
+    vector6d_t current_thresholds{};
+    /// Low-pass smoothing of the signals, (0, 1]. 1: no filtering.
+    double filter_alpha = 0.5;
+    /// Adaption of the baselines to slow drifts, [0, 1). 0: the baselines are the values when armed.
+    double baseline_alpha = 0.002;
+    /// Consecutive frames over a threshold before a contact is reported
+    int debounce_frames = 2;
+    /// Joint speed (rad/s) below which the robot is considered stopped, "actual_joint_speeds"
+    double stop_speed = 0.01;
+    /// The read timeout of the reverse socket sent with the contact command
+    int stop_timeout_ms = 100;
+};
+
+enum class ToolContactSource : int {
+    /// TCP force residual
+    FORCE = 0,
+    /// Joint current residual
+    JOINT_CURRENT = 1,
+};
+
+/**
+ * @brief A detected contact
+ *
+ */
+struct ToolContactEvent {
+    ToolContactSource source = ToolContactSource::FORCE;
+    /// The joint of a JOINT_CURRENT contact, -1 for FORCE
+    int joint = -1;
+    /// The residual that crossed the threshold
+    double residual = 0;
+    /// Controller timestamp of the frame (s), 0 if "timestamp" is not subscribed
+    double timestamp = 0;
+    /// "actual_TCP_pose" of the frame, the contact pose
+    vector6d_t tcp_pose{};
+    /// "actual_joint_positions" of the frame
+    vector6d_t joint_positions{};
+    /// "actual_TCP_force" of the frame
+    vector6d_t tcp_force{};
+    /// The contact command was written to the robot
+    bool stop_sent = false;
+    /// Time from the frame being received to the contact command being written
+    std::chrono::microseconds detect_to_send{0};
+};
+
+/**
+ * @brief Latency statistics of the contact detection
+ *
+ */
+struct ToolContactStats {
+    uint64_t contacts = 0;
+    /// Time from the frame being received to the contact command being written
+    std::chrono::microseconds last_detect_to_send{0};
+    std::chrono::microseconds max_detect_to_send{0};
+    std::chrono::microseconds mean_detect_to_send{0};
+    /// Controller time from the contact frame to the first frame with all joints below 'stop_speed' (s). -1: not measured.
+    double last_stop_time = -1;
+};
+
+/**
+ * @brief Watches the RTSI TCP force and joint currents in the receive thread. When a filtered residual crosses its threshold,
+ * the motion is stopped at once with EliteDriver::writeToolContact(), from the same thread, and the contact is reported.
+ *
+ * The detection latency is one RTSI frame plus the filtering and debounce, the stop is one write on the reverse socket. Subscribe
+ * "actual_TCP_force" and/or "actual_joint_current" in the output recipe, and "timestamp", "actual_TCP_pose",
+ * "actual_joint_positions" and "actual_joint_speeds" for a complete report.
+ */
+class ToolContactDetector {
+   public:
+    using ContactCallback = std::function<void(const ToolContactEvent&)>;
+
+    ToolContactDetector() = delete;
+
+    /**
+     * @brief Construct a new Tool Contact Detector object, disarmed
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param driver The driver which stops the motion, usually an EliteDriver. Must outlive this object.
+     * @param executor Runs the contact callback, nullptr to run it in the RTSI receive thread
+     */
+    ELITE_EXPORT ToolContactDetector(RtsiFrameSource& rtsi, DriverCommandWriter& driver,
+                                     CallbackExecutorSharedPtr executor = nullptr);
+
+    ELITE_EXPORT ~ToolContactDetector();
+
+    /**
+     * @brief Start watching. The baselines are taken from the next frame, so arm it before the approach, without contact.
+     *
+     * @param config Thresholds and filters
+     * @return true success
+     * @return false no threshold is set, or a filter parameter is out of range
+     */
+    ELITE_EXPORT bool arm(const ToolContactConfig& config);
+
+    /**
+     * @brief Stop watching. A contact already detected is kept.
+     *
+     */
+    ELITE_EXPORT void disarm();
+
+    ELITE_EXPORT bool isArmed();
+
+    /**
+     * @brief Whether a contact was detected and not released
+     *
+     */
+    ELITE_EXPORT bool inContact();
+
+    /**
+     * @brief Release the contact: clear the stop of this detector (EliteDriver::clearToolContact()). The motion commands are
+     * allowed again unless another detector still holds its stop. Call arm() to watch again.
+     *
+     */
+    ELITE_EXPORT void release();
+
+    /**
+     * @brief Set the callback of a contact
+     *
+     * @param cb The callback, run by the executor given to the constructor
+     */
+    ELITE_EXPORT void setContactCallback(ContactCallback cb);
+
+    /**
+     * @brief Get the last contact
+     *
+     * @param event The contact
+     * @return true There was a contact
+     */
+    ELITE_EXPORT bool getLastContact(ToolContactEvent& event);
+
+    ELITE_EXPORT ToolContactStats getStats();
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// Trace.hpp
+// Lightweight tracing of the SDK threads, exported as a Chrome trace or a Perfetto trace.
+#ifndef __ELITE__TRACE_HPP__
+#define __ELITE__TRACE_HPP__
+
+#include <Elite/EliteOptions.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#define ELITE_TRACE_CONCAT_INNER(a, b) a##b
+#define ELITE_TRACE_CONCAT(a, b) ELITE_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope as a slice. 'name' must live as long as the trace, e.g. a string literal.
+ *
+ */
+#define ELITE_TRACE_SCOPE(name) ELITE::TRACE::Scope ELITE_TRACE_CONCAT(elite_trace_scope_, __LINE__)(name)
+
+/**
+ * @brief Trace an instant event. 'name' must live as long as the trace, e.g. a string literal.
+ *
+ */
+#define ELITE_TRACE_INSTANT(name)            \
+    do {                                     \
+        if (ELITE::TRACE::isEnabled()) {     \
+            ELITE::TRACE::instant(name);     \
+        }                                    \
+    } while (0)
+
+namespace ELITE {
+
+/**
+ * @brief Records begin, end and instant events of the threads with a monotonic timestamp (steady clock, ns).
+ *
+ * Every thread writes to its own ring buffer, without a lock, so the recent history of each thread is kept and the oldest events
+ * are overwritten. When the tracing is disabled an event costs one relaxed atomic load. The SDK traces the RTSI receive loop
+ * (receive, decode, frame callbacks, send), the TCP server thread (accept, receive, write), the primary port (message parsing,
+ * script write), the callback dispatch and the log output. The event names are stored as pointers, they must stay valid until
+ * the trace is dumped.
+ */
+namespace TRACE {
+
+namespace DETAIL {
+ELITE_EXPORT extern std::atomic<bool> enabled;
+}  // namespace DETAIL
+
+/**
+ * @brief Start recording
+ *
+ * @param events_per_thread The size of the ring buffer of each thread. It applies to the threads which record their first
+ * event after this call. A full ring reports its newest events_per_thread - 1 events.
+ */
+ELITE_EXPORT void enable(size_t events_per_thread = 16384);
+
+/**
+ * @brief Stop recording, the recorded events are kept
+ *
+ */
+ELITE_EXPORT void disable();
+
+inline bool isEnabled() { return DETAIL::enabled.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Name the calling thread in the trace. It can be called before the tracing is enabled.
+ *
+ * @param name Thread name
+ */
+ELITE_EXPORT void setThreadName(const std::string& name);
+
+/**
+ * @brief Record an event of the calling thread if the tracing is enabled. A slice is a begin and an end event of the same name.
+ *
+ * @param name Event name, it must stay valid until the trace is dumped
+ */
+ELITE_EXPORT void begin(const char* name);
+
+ELITE_EXPORT void end(const char* name);
+
+ELITE_EXPORT void instant(const char* name);
+
+/**
+ * @brief Drop the recorded events, and the buffers of the threads which exited
+ *
+ */
+ELITE_EXPORT void clear();
+
+/**
+ * @brief Write the recorded events as Chrome trace event JSON, for chrome://tracing or ui.perfetto.dev
+ *
+ * @param path File path
+ * @return true success
+ * @return false the file can not be written
+ */
+ELITE_EXPORT bool dumpChromeJson(const std::string& path);
+
+/**
+ * @brief Write the recorded events as a Perfetto protobuf trace (track events), for ui.perfetto.dev
+ *
+ * @param path File path
+ * @return true success
+ * @return false the file can not be written
+ */
+ELITE_EXPORT bool dumpPerfetto(const std::string& path);
+
+/**
+ * @brief Records a slice from the construction to the destruction, if the tracing is enabled at the construction
+ *
+ */
+class Scope {
+   public:
+    explicit Scope(const char* name) : name_(isEnabled() ? name : nullptr) {
+        if (name_) {
+            begin(name_);
+        }
+    }
+
+    ~Scope() {
+        if (name_) {
+            end(name_);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const char* name_;
+};
+
+}  // namespace TRACE
+
+}  // namespace ELITE
+
+#endif
@@ -42,6 +42,8 @@ class EliteException : virtual public std::runtime_error {
         FILE_OPEN_FAIL,
         /// The "s_io_context_ptr_" point is nullptr, if throw this expection, SDK had a bug
         TCP_SERVER_CONTEXT_NULL,
+        /// socket did not receive data in time
+        SOCKET_TIMEOUT,
     };
 
     EliteException() = delete;
@@ -68,7 +70,7 @@ class EliteException : virtual public std::runtime_error {
 
     operator bool() const { return exception_code_ != Code::SUCCESS; }
 
-    const char* exceptionCodeToString(const Code& ec);
+    static const char* exceptionCodeToString(const Code& ec);
 
    private:
     std::string exceptionStringDeal(const std::string& what) {
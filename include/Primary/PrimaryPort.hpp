@@ -6,12 +6,17 @@
 #ifndef __ELITE__PRIMARY_PORT_HPP__
 #define __ELITE__PRIMARY_PORT_HPP__
 
+#include "CallbackExecutor.hpp"
 #include "DataType.hpp"
 #include "PrimaryPackage.hpp"
 #include "RobotException.hpp"
 
 #include <boost/asio.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -30,11 +35,32 @@ class PrimaryPort {
     // The type of 'RobotException' package
     static constexpr int ROBOT_EXCEPTION_MSG_TYPE = 20;
 
+    // A script waiting in the write queue
+    struct ScriptRequest {
+        std::string data;
+        std::promise<bool> promise;
+        std::chrono::steady_clock::time_point enqueue_time;
+        std::chrono::steady_clock::time_point deadline;
+    };
+    using ScriptRequestSharedPtr = std::shared_ptr<ScriptRequest>;
+
+    // Held by the receive thread, connect() and disconnect().
     std::mutex socket_mutex_;
+    // Held by the write thread while writing a script.
+    // 'socket_ptr_' is only replaced or closed with both locks held, so either of them is enough to use it.
+    std::mutex write_mutex_;
     boost::asio::io_context io_context_;
     std::unique_ptr<boost::asio::ip::tcp::socket> socket_ptr_;
 
+    std::mutex write_queue_mutex_;
+    std::condition_variable write_queue_cv_;
+    std::deque<ScriptRequestSharedPtr> write_queue_;
+    std::unique_ptr<std::thread> write_thread_;
+    bool write_thread_alive_;
+    ScriptSendStats send_stats_;
+
     std::function<void(RobotExceptionSharedPtr)> robot_exception_cb_;
+    CallbackExecutorSharedPtr callback_executor_;
 
     // The buffer of package head
     std::vector<uint8_t> message_head_;
@@ -86,14 +112,44 @@ class PrimaryPort {
 
     bool socketReconnect(const std::string& ip, int port, bool is_last_connect_success);
 
+    /**
+     * @brief The write thread.
+     *  Write the queued scripts in order, never waits for the receive thread.
+     */
+    void writeLoop();
+
+    /**
+     * @brief Write a whole script before the deadline of the request.
+     *  A script written partly is followed by a shutdown of the socket, the receive thread then reconnects.
+     *
+     * @return true success
+     * @return false fail or timeout, 'is_timeout' tells which one
+     */
+    bool writeScript(const ScriptRequest& req, bool& is_timeout);
+
+    /**
+     * @brief Complete a request and update the statistics
+     *
+     */
+    void completeRequest(const ScriptRequestSharedPtr& req, bool success, bool is_timeout);
+
     RobotExceptionSharedPtr parserException(const std::vector<uint8_t>& msg_body);
 
+    /**
+     * @brief Run the robot exception callback with the callback executor
+     *
+     */
+    void callRobotExceptionCallback(RobotExceptionSharedPtr ex);
+
     RobotErrorSharedPtr parserRobotError(uint64_t timestamp, RobotError::Source source, const std::vector<uint8_t>& msg_body,
                                          int offset);
 
     RobotRuntimeExceptionSharedPtr paraserRuntimeException(uint64_t timestamp, const std::vector<uint8_t>& msg_body, int offset);
 
    public:
+    // Default timeout of a script send
+    static constexpr int DEFAULT_SEND_TIMEOUT_MS = 1000;
+
     PrimaryPort();
     ~PrimaryPort();
 
@@ -119,12 +175,30 @@ class PrimaryPort {
 
     /**
      * @brief Sends a custom script program to the robot.
+     *  The script is queued to the write thread, the receiving of packages does not delay it.
      *
      * @param script Script code that shall be executed by the robot.
+     * @param timeout_ms The longest time to wait for the script being queued and written.
      * @return true success
      * @return false fail
      */
-    bool sendScript(const std::string& script);
+    bool sendScript(const std::string& script, int timeout_ms = DEFAULT_SEND_TIMEOUT_MS);
+
+    /**
+     * @brief Queue a custom script program without waiting for it to be written.
+     *
+     * @param script Script code that shall be executed by the robot.
+     * @param timeout_ms The longest time the script may stay in the queue and be written.
+     * @return std::future<bool> Becomes true when the whole script was written to the socket, false when it fails or timeout.
+     */
+    std::future<bool> sendScriptAsync(const std::string& script, int timeout_ms = DEFAULT_SEND_TIMEOUT_MS);
+
+    /**
+     * @brief Get the statistics of the scripts sent
+     *
+     * @return ScriptSendStats Statistics
+     */
+    ScriptSendStats getScriptSendStats();
 
     /**
      * @brief Get primary sub-package data.
@@ -153,6 +227,13 @@ class PrimaryPort {
      *           representing the received exception.
      */
     void registerRobotExceptionCallback(std::function<void(RobotExceptionSharedPtr)> cb) { robot_exception_cb_ = cb; }
+
+    /**
+     * @brief Set the executor which runs the robot exception callback. Call it before connect().
+     *
+     * @param executor The executor, nullptr to run the callback in the receive thread.
+     */
+    void setCallbackExecutor(CallbackExecutorSharedPtr executor) { callback_executor_ = std::move(executor); }
 };
 
 }  // namespace ELITE
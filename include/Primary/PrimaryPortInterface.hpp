@@ -6,10 +6,13 @@
 #ifndef __ELITE__PRIMARY_PORT_INTERFACE_HPP__
 #define __ELITE__PRIMARY_PORT_INTERFACE_HPP__
 
+#include <Elite/CallbackExecutor.hpp>
+#include <Elite/DataType.hpp>
 #include <Elite/EliteOptions.hpp>
 #include <Elite/PrimaryPackage.hpp>
 #include <Elite/RobotException.hpp>
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -55,6 +58,23 @@ class PrimaryPortInterface {
      */
     ELITE_EXPORT bool sendScript(const std::string& script);
 
+    /**
+     * @brief Queue a custom script program without waiting for it to be written.
+     *  Scripts are written by a separate thread in order, the receiving of packages does not delay them.
+     *
+     * @param script Script code that shall be executed by the robot.
+     * @param timeout_ms The longest time the script may stay in the queue and be written.
+     * @return std::future<bool> Becomes true when the whole script was written to the socket, false when it fails or timeout.
+     */
+    ELITE_EXPORT std::future<bool> sendScriptAsync(const std::string& script, int timeout_ms = 1000);
+
+    /**
+     * @brief Get the statistics of the scripts sent
+     *
+     * @return ScriptSendStats Statistics
+     */
+    ELITE_EXPORT ScriptSendStats getScriptSendStats();
+
     /**
      * @brief Get primary sub-package data.
      *
@@ -82,6 +102,13 @@ class PrimaryPortInterface {
      *           representing the received exception.
      */
     ELITE_EXPORT void registerRobotExceptionCallback(std::function<void(RobotExceptionSharedPtr)> cb);
+
+    /**
+     * @brief Set the executor which runs the robot exception callback. Call it before connect().
+     *
+     * @param executor The executor, nullptr to run the callback in the receive thread.
+     */
+    ELITE_EXPORT void setCallbackExecutor(CallbackExecutorSharedPtr executor);
 };
 
 }  // namespace ELITE
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiAggregator.hpp
+// Receives the RTSI output of many robots on a few event loop threads.
+#ifndef __RTSI_AGGREGATOR_HPP__
+#define __RTSI_AGGREGATOR_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+#include <Elite/VersionInfo.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief The newest output frame of a robot
+ *
+ */
+struct RtsiSnapshot {
+    /// The robot, as returned by RtsiAggregator::addRobot()
+    int robot = -1;
+    /// The number of frames received from the robot, this one included
+    uint64_t sequence = 0;
+    /// Host time when the frame was received
+    std::chrono::steady_clock::time_point received;
+    /// The values, in the order of the output recipe
+    std::vector<RtsiTypeVariant> values;
+
+    /**
+     * @brief Get a value
+     *
+     * @tparam T data type
+     * @param slot Index in the output recipe, see RtsiAggregator::getSlot()
+     * @param out_value The value
+     * @return true success
+     * @return false illegal slot or the type does not match
+     */
+    template <typename T>
+    bool getValue(int slot, T& out_value) const {
+        if (slot < 0 || slot >= (int)values.size()) {
+            return false;
+        }
+#if (ELITE_SDK_COMPILE_STANDARD >= 17)
+        const T* value = std::get_if<T>(&values[slot]);
+#elif (ELITE_SDK_COMPILE_STANDARD == 14)
+        const T* value = boost::get<T>(&values[slot]);
+#endif
+        if (!value) {
+            return false;
+        }
+        out_value = *value;
+        return true;
+    }
+};
+
+/**
+ * @brief Subscribes the same output recipe from many robots and receives all of them on a fixed number of event loop threads.
+ *
+ * RtsiIOInterface starts one receive thread per robot. The aggregator instead puts the RTSI connections of all robots on
+ * 'threads' boost::asio event loops (epoll on Linux), so the thread count does not grow with the robot count. Every frame is
+ * decoded into the snapshot of its robot, which is read with getSnapshot(), and is delivered to the frame callbacks and to a
+ * lock-free queue read with pollFrame().
+ *
+ * The aggregator only receives, it does not set up an input recipe. A robot whose connection is lost stays in the aggregator
+ * with its last snapshot, until removeRobot() is called.
+ */
+class RtsiAggregator {
+   public:
+    using FrameCallback = std::function<void(const RtsiSnapshot&)>;
+
+    RtsiAggregator() = delete;
+
+    /**
+     * @brief Construct a new Rtsi Aggregator object
+     *
+     * @param output_recipe Output recipe of every robot
+     * @param frequency Output frequency
+     * @param threads The number of event loop threads
+     * @param queue_capacity The capacity of the frame queue of each thread. If a queue is full, new frames are dropped. 0
+     * disables the queue.
+     * @throws EliteException ILLEGAL_PARAM if the output recipe is empty
+     */
+    ELITE_EXPORT explicit RtsiAggregator(const std::vector<std::string>& output_recipe, double frequency, int threads = 1,
+                                         size_t queue_capacity = 1024);
+
+    /**
+     * @brief Disconnect all robots and stop the threads
+     *
+     */
+    ELITE_EXPORT ~RtsiAggregator();
+
+    /**
+     * @brief Connect to a robot, set up the output recipe and start its output. It blocks until the robot streams or the setup
+     * fails.
+     *
+     * @param ip The IP of the RTSI server
+     * @param port The port of the RTSI server
+     * @param timeout_ms Timeout of the connection and of the setup
+     * @return int The robot, or -1 if the setup failed
+     */
+    ELITE_EXPORT int addRobot(const std::string& ip, int port = 30004, unsigned timeout_ms = 5000);
+
+    /**
+     * @brief Disconnect a robot and drop its snapshot
+     *
+     * @param robot The robot
+     * @note If it is called outside the thread of the robot, it waits until the robot's frame callbacks have returned.
+     */
+    ELITE_EXPORT void removeRobot(int robot);
+
+    /**
+     * @brief Get the robots, the disconnected ones included
+     *
+     */
+    ELITE_EXPORT std::vector<int> getRobots();
+
+    /**
+     * @brief Get connection state of a robot
+     *
+     * @param robot The robot
+     * @return true the robot streams
+     * @return false the connection is lost, or no such robot
+     */
+    ELITE_EXPORT bool isConnected(int robot);
+
+    /**
+     * @brief Get the Controller Version of a robot
+     *
+     * @param robot The robot
+     * @return VersionInfo The version, all zero if no such robot
+     */
+    ELITE_EXPORT VersionInfo getControllerVersion(int robot);
+
+    /**
+     * @brief Get the index of a variable in the output recipe, for RtsiSnapshot::getValue()
+     *
+     * @param name The variable name
+     * @return int The index, -1 if the variable is not in the recipe
+     */
+    ELITE_EXPORT int getSlot(const std::string& name) const;
+
+    /**
+     * @brief Copy the newest frame of a robot
+     *
+     * @param robot The robot
+     * @param snapshot The frame
+     * @return true success
+     * @return false no such robot, or no frame has been received yet
+     */
+    ELITE_EXPORT bool getSnapshot(int robot, RtsiSnapshot& snapshot);
+
+    /**
+     * @brief Take the oldest queued frame. The frames of one robot are in order, the frames of different robots are not. The
+     * queue has a single consumer, call it from one thread only.
+     *
+     * @param snapshot The frame
+     * @return true got a frame
+     * @return false the queue is empty
+     */
+    ELITE_EXPORT bool pollFrame(RtsiSnapshot& snapshot);
+
+    /**
+     * @brief The number of frames dropped because the queue was full
+     *
+     */
+    ELITE_EXPORT uint64_t droppedCount();
+
+    /**
+     * @brief Register a callback that is called for each frame of every robot
+     *
+     * @param cb Callback function. It is called in the event loop thread of the robot, so it must not block: the other robots
+     * of the thread wait for it.
+     * @return int The handle of the callback, used by removeFrameCallback()
+     */
+    ELITE_EXPORT int addFrameCallback(FrameCallback cb);
+
+    /**
+     * @brief Remove a callback registered by addFrameCallback()
+     *
+     * @param handle The handle of the callback
+     * @note It waits for the running callbacks of the other event loop threads to return.
+     */
+    ELITE_EXPORT void removeFrameCallback(int handle);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
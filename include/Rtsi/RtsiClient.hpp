@@ -6,6 +6,7 @@
 #ifndef __RTSICLIENT_HPP__
 #define __RTSICLIENT_HPP__
 
+#include "EliteException.hpp"
 #include "RtsiRecipe.hpp"
 #include "VersionInfo.hpp"
 
@@ -13,6 +14,7 @@
 #include <boost/asio.hpp>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -100,6 +102,15 @@ class RtsiClient {
      */
     void send(RtsiRecipeSharedPtr& recipe);
 
+    /**
+     * @brief Send an recipe to controller, without exception.
+     *      The package buffer is reused, so no memory is allocated once the first package was sent.
+     *
+     * @param recipe The recipe sent to the controller.
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or RTSI_RECIPE_PARSER_FAIL
+     */
+    EliteException::Code trySend(const RtsiRecipeSharedPtr& recipe) noexcept;
+
     /**
      * @brief Receive RTSI output recipes data
      *
@@ -119,6 +130,26 @@ class RtsiClient {
      */
     bool receiveData(RtsiRecipeSharedPtr recipe, bool read_newest = false);
 
+    /**
+     * @brief Receive RTSI output recipes data, without exception
+     *
+     * @param recipes The recipe you want to receive. Note that only one recipe will be received.
+     * @param read_newest If want to parser the newest message
+     * @param recipe_id The ID of recipe which is received. If -1, not match recipe
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT. The connection is closed on SOCKET_TIMEOUT.
+     */
+    EliteException::Code tryReceiveData(std::vector<RtsiRecipeSharedPtr>& recipes, bool read_newest, int& recipe_id) noexcept;
+
+    /**
+     * @brief Receive RTSI output recipe data, without exception
+     *
+     * @param recipe The recipe you want to receive.
+     * @param read_newest If want to parser the newest message
+     * @param received true if the data of recipe is received
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT. The connection is closed on SOCKET_TIMEOUT.
+     */
+    EliteException::Code tryReceiveData(const RtsiRecipeSharedPtr& recipe, bool read_newest, bool& received) noexcept;
+
     /**
      * @brief Get connection state
      *
@@ -168,24 +199,42 @@ class RtsiClient {
         CONTROL_PACKAGE_PAUSE = 80           // ascii P
     };
 
+    // Buffers reused by every package, to keep the data path free of allocations
+    std::vector<uint8_t> recv_buffer_;
+    std::vector<uint8_t> send_buffer_;
+    // Held while 'send_buffer_' is filled and written, packages may be sent from several threads
+    std::mutex send_mutex_;
+
+    // The error of the last failed socket operation
+    boost::system::error_code last_error_;
+
     /**
      * @brief Send an package to RTSI server
      *
      * @param cmd Send package type
      * @param payload Package payload
+     * @throws EliteException SOCKET_FAIL if send fail
      */
     void sendAll(const PackageType& cmd, const std::vector<uint8_t>& payload = std::vector<uint8_t>());
 
     /**
-     * @brief Receive socket bytes from RTSI server
+     * @brief Fill the package header of 'send_buffer_' and send it. The payload must already be in 'send_buffer_', and
+     * 'send_mutex_' held.
+     *
+     * @param cmd Send package type
+     * @return EliteException::Code SUCCESS or SOCKET_FAIL
+     */
+    EliteException::Code writePackage(const PackageType& cmd) noexcept;
+
+    /**
+     * @brief Receive socket bytes from RTSI server to 'recv_buffer_'
      *
-     * @param buff Data buffer
-     * @param size Size of buffer
+     * @param size The number of bytes to receive
      * @param offset Offset of buffer
      * @param timeout_ms Timeout(ms)
-     * @return int The number of bytes recieved
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT
      */
-    int receiveSocket(std::vector<uint8_t>& buff, int size, int offset, unsigned timeout_ms = 1000);
+    EliteException::Code receiveSocket(int size, int offset, unsigned timeout_ms = 1000) noexcept;
 
     /**
      * @brief Loop receive util target package come
@@ -193,10 +242,23 @@ class RtsiClient {
      * @param target_type Target package type
      * @param parser_func When receive target type, will call the parser function
      * @param read_newest If want to parser the newest message
+     * @throws EliteException If socket fail or timeout
      */
     void receive(const PackageType& target_type, std::function<void(int, const std::vector<uint8_t>&)> parser_func,
                  bool read_newest = false);
 
+    /**
+     * @brief Loop receive util target package come, without exception.
+     *      Only throws what 'parser_func' throws.
+     *
+     * @param target_type Target package type
+     * @param parser_func When receive target type, will call the parser function
+     * @param read_newest If want to parser the newest message
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT
+     */
+    template <typename F>
+    EliteException::Code receivePackage(const PackageType& target_type, F&& parser_func, bool read_newest);
+
     /**
      * @brief Close socket connection
      *
@@ -6,6 +6,7 @@
 #ifndef __RTSI_CLIENT_INTERFACE_HPP__
 #define __RTSI_CLIENT_INTERFACE_HPP__
 
+#include <Elite/EliteException.hpp>
 #include <Elite/EliteOptions.hpp>
 #include <Elite/RtsiRecipe.hpp>
 #include <Elite/VersionInfo.hpp>
@@ -118,6 +119,38 @@ class RtsiClientInterface {
      */
     ELITE_EXPORT bool receiveData(RtsiRecipeSharedPtr recipe, bool read_newest = false);
 
+    /**
+     * @brief Send an recipe to controller, without exception.
+     *      Intended for real-time loops. 'send()' is a wrapper which throws the returned code.
+     *
+     * @param recipe The recipe sent to the controller.
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or RTSI_RECIPE_PARSER_FAIL
+     */
+    ELITE_EXPORT EliteException::Code trySend(const RtsiRecipeSharedPtr& recipe) noexcept;
+
+    /**
+     * @brief Receive RTSI output recipes data, without exception
+     *
+     * @param recipes The recipe you want to receive. Note that only one recipe will be received.
+     * @param read_newest If want to parser the newest message
+     * @param recipe_id The ID of recipe which is received. If -1, not match recipe
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT. The connection is closed on SOCKET_TIMEOUT.
+     */
+    ELITE_EXPORT EliteException::Code tryReceiveData(std::vector<RtsiRecipeSharedPtr>& recipes, bool read_newest,
+                                                     int& recipe_id) noexcept;
+
+    /**
+     * @brief Receive RTSI output recipe data, without exception.
+     *      Intended for real-time loops. 'receiveData()' is a wrapper which throws the returned code.
+     *
+     * @param recipe The recipe you want to receive.
+     * @param read_newest If want to parser the newest message
+     * @param received true if the data of recipe is received
+     * @return EliteException::Code SUCCESS, SOCKET_FAIL or SOCKET_TIMEOUT. The connection is closed on SOCKET_TIMEOUT.
+     */
+    ELITE_EXPORT EliteException::Code tryReceiveData(const RtsiRecipeSharedPtr& recipe, bool read_newest,
+                                                     bool& received) noexcept;
+
     /**
      * @brief Get connection state
      *
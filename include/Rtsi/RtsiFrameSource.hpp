@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiFrameSource.hpp
+// The RTSI output frames as seen by the frame-driven helpers (IO events, detectors, recorders, streamers).
+#ifndef __RTSI_FRAME_SOURCE_HPP__
+#define __RTSI_FRAME_SOURCE_HPP__
+
+#include <Elite/DataType.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ELITE {
+
+/**
+ * @brief A source of RTSI output frames. RtsiIOInterface is the source connected to the robot.
+ *  Implement it to drive the frame-driven helpers from recorded or simulated frames, e.g. in tests.
+ *
+ */
+class RtsiFrameSource {
+   public:
+    virtual ~RtsiFrameSource() = default;
+
+    /**
+     * @brief Register a callback that is called each time a new output frame has been received
+     *
+     * @param cb Callback function, must not block
+     * @return int The handle of the callback, used by removeFrameCallback()
+     */
+    virtual int addFrameCallback(std::function<void()> cb) = 0;
+
+    /**
+     * @brief Remove a callback registered by addFrameCallback(). Outside the frame thread, it waits for the running callbacks
+     * to return.
+     *
+     * @param handle The handle of the callback
+     */
+    virtual void removeFrameCallback(int handle) = 0;
+
+    /**
+     * @brief Get a value of the current output frame
+     *
+     * @param name Variable name
+     * @param out_value Output value
+     * @return true success
+     * @return false the variable is not in the output recipe
+     */
+    virtual bool getRecipeValue(const std::string& name, bool& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, int32_t& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, uint32_t& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, uint64_t& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, double& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, vector3d_t& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, vector6d_t& out_value) = 0;
+    virtual bool getRecipeValue(const std::string& name, vector6int32_t& out_value) = 0;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiIOEdge.hpp
+// Edge and threshold crossing detection used by RtsiIOEventEngine.
+#ifndef __RTSI_IO_EDGE_HPP__
+#define __RTSI_IO_EDGE_HPP__
+
+#include <cstdint>
+
+namespace ELITE {
+
+namespace IO_EDGE {
+
+/**
+ * @brief Call 'emit(bit_index, rising)' for every bit in 'mask' that differs between 'prev' and 'curr', from the lowest bit.
+ *
+ */
+template <typename F>
+inline void forEachEdge(uint64_t prev, uint64_t curr, uint64_t mask, F&& emit) {
+    uint64_t changed = (prev ^ curr) & mask;
+    while (changed) {
+#if defined(__GNUC__) || defined(__clang__)
+        int index = __builtin_ctzll(changed);
+#else
+        int index = 0;
+        while (!((changed >> index) & 1)) {
+            index++;
+        }
+#endif
+        emit(index, ((curr >> index) & 1) != 0);
+        changed &= changed - 1;
+    }
+}
+
+/**
+ * @brief Threshold crossing with hysteresis
+ *
+ */
+class HysteresisTrigger {
+   public:
+    HysteresisTrigger() : HysteresisTrigger(0, 0) {}
+
+    HysteresisTrigger(double threshold, double hysteresis)
+        : high_(threshold + hysteresis / 2), low_(threshold - hysteresis / 2), state_(false), initialized_(false) {}
+
+    /**
+     * @brief Feed a sample
+     *
+     * @return int 1: crossed above, -1: crossed below, 0: no crossing. The first sample only initializes the state.
+     */
+    int update(double value) {
+        if (!initialized_) {
+            initialized_ = true;
+            state_ = value > high_;
+            return 0;
+        }
+        if (!state_ && value > high_) {
+            state_ = true;
+            return 1;
+        }
+        if (state_ && value < low_) {
+            state_ = false;
+            return -1;
+        }
+        return 0;
+    }
+
+    bool state() const { return state_; }
+
+   private:
+    double high_;
+    double low_;
+    bool state_;
+    bool initialized_;
+};
+
+}  // namespace IO_EDGE
+
+}  // namespace ELITE
+
+#endif
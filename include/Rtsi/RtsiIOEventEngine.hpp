@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiIOEventEngine.hpp
+// Detects digital edges and analog threshold crossings in the RTSI receive thread.
+#ifndef __RTSI_IO_EVENT_ENGINE_HPP__
+#define __RTSI_IO_EVENT_ENGINE_HPP__
+
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiFrameSource.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace ELITE {
+
+/**
+ * @brief The signal an IO event comes from
+ *
+ */
+enum class IOEventSource {
+    /// "actual_digital_input_bits"
+    DIGITAL_INPUT,
+    /// "actual_digital_output_bits"
+    DIGITAL_OUTPUT,
+    /// "input_bit_registers0_to_31" and "input_bit_registers32_to_63"
+    IN_BOOL_REGISTER,
+    /// "output_bit_registers0_to_31" and "output_bit_registers32_to_63"
+    OUT_BOOL_REGISTER,
+    /// "standard_analog_input0" and "standard_analog_input1"
+    ANALOG_INPUT,
+    /// "tool_analog_input"
+    TOOL_ANALOG_INPUT,
+};
+
+/**
+ * @brief A digital edge or an analog threshold crossing
+ *
+ */
+struct IOEvent {
+    IOEventSource source = IOEventSource::DIGITAL_INPUT;
+    /// Bit index, or analog input index
+    int index = 0;
+    /// true: rising edge (or crossed above the threshold), false: falling edge
+    bool rising = false;
+    /// Controller timestamp of the frame in which the change was seen (s), 0 if "timestamp" is not subscribed
+    double timestamp = 0;
+    /// Level of the bit, or the analog value
+    double value = 0;
+};
+
+/**
+ * @brief Compares every RTSI output frame with the previous one and turns the changes into IO events.
+ *
+ * Digital signals are watched by bit masks, an edge is reported for every watched bit that changed. Analog inputs are watched
+ * by a threshold with hysteresis. Events are produced in the RTSI receive thread, so nothing is missed between two polls of the
+ * application, and are delivered through a lock-free queue (pollEvent()) and optional listeners.
+ *
+ * Only the fields subscribed in the output recipe are watched. Add "timestamp" to get the controller time of the events.
+ */
+class RtsiIOEventEngine {
+   public:
+    using Listener = std::function<void(const IOEvent&)>;
+
+    RtsiIOEventEngine() = delete;
+
+    /**
+     * @brief Construct a new Rtsi IO Event Engine object
+     *
+     * @param rtsi The RTSI frames, usually a RtsiIOInterface. Must outlive this object.
+     * @param queue_capacity The capacity of the event queue. If the queue is full, new events are dropped.
+     */
+    ELITE_EXPORT explicit RtsiIOEventEngine(RtsiFrameSource& rtsi, size_t queue_capacity = 1024);
+
+    ELITE_EXPORT ~RtsiIOEventEngine();
+
+    /**
+     * @brief Set the bits to watch of a digital source
+     *
+     * @param source A digital source (DIGITAL_INPUT, DIGITAL_OUTPUT, IN_BOOL_REGISTER, OUT_BOOL_REGISTER)
+     * @param mask Bits to watch. For the bool registers, bit 0~63 are register 0~63. 0 stops watching.
+     * @return true success
+     * @return false source is not digital
+     */
+    ELITE_EXPORT bool watchDigital(IOEventSource source, uint64_t mask);
+
+    /**
+     * @brief Watch an analog input
+     *
+     * @param source ANALOG_INPUT or TOOL_ANALOG_INPUT
+     * @param index Analog input index (0 or 1 for ANALOG_INPUT, 0 for TOOL_ANALOG_INPUT)
+     * @param threshold The threshold
+     * @param hysteresis Width of the band around the threshold. A rising event is reported when the value goes above
+     * threshold + hysteresis / 2, a falling event when it goes below threshold - hysteresis / 2.
+     * @return true success
+     * @return false illegal source or index
+     */
+    ELITE_EXPORT bool watchAnalog(IOEventSource source, int index, double threshold, double hysteresis);
+
+    /**
+     * @brief Stop watching an analog input
+     *
+     */
+    ELITE_EXPORT void unwatchAnalog(IOEventSource source, int index);
+
+    /**
+     * @brief Take the oldest event from the queue. The queue has a single consumer, call it from one thread only.
+     *
+     * @param event The event
+     * @return true got an event
+     * @return false the queue is empty
+     */
+    ELITE_EXPORT bool pollEvent(IOEvent& event);
+
+    /**
+     * @brief The number of events dropped because the queue was full
+     *
+     */
+    ELITE_EXPORT uint64_t droppedCount();
+
+    /**
+     * @brief Add a listener, called in the RTSI receive thread for every event
+     *
+     * @param listener The listener, must not block. It may watch, unwatch, add and remove listeners.
+     * @return int Handle of the listener
+     */
+    ELITE_EXPORT int addListener(Listener listener);
+
+    /**
+     * @brief Remove a listener
+     *
+     * @param handle Handle of the listener
+     * @note If it is called outside the RTSI receive thread, it waits for the running listeners to return, so the resources of
+     * the listener can be released afterwards. A listener may remove itself.
+     */
+    ELITE_EXPORT void removeListener(int handle);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
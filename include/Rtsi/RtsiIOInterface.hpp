@@ -9,13 +9,18 @@
 #include <Elite/DataType.hpp>
 #include <Elite/EliteOptions.hpp>
 #include <Elite/RtsiClientInterface.hpp>
+#include <Elite/RtsiFrameSource.hpp>
 #include <Elite/RtsiRecipe.hpp>
 #include <Elite/VersionInfo.hpp>
 
+#include <array>
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace ELITE {
 
@@ -23,8 +28,13 @@ namespace ELITE {
  * @brief The RTSI interface has been functionally encapsulated.
  *
  */
-class RtsiIOInterface : protected RtsiClientInterface {
+class RtsiIOInterface : public RtsiFrameSource, protected RtsiClientInterface {
    public:
+    /// The number of int registers and double registers, in each direction
+    static constexpr int REGISTER_BANK_SIZE = 48;
+    using IntRegisterBank = std::array<int32_t, REGISTER_BANK_SIZE>;
+    using DoubleRegisterBank = std::array<double, REGISTER_BANK_SIZE>;
+
     RtsiIOInterface() = delete;
 
     /**
@@ -458,6 +468,113 @@ class RtsiIOInterface : protected RtsiClientInterface {
      */
     ELITE_EXPORT double getOutDoubleRegister(int index);
 
+    /**
+     * @brief Get all the input int registers subscribed in the output recipe, from the same data package.
+     *
+     * @param values values[i] is register i. Registers that are not subscribed are 0.
+     * @return int The number of subscribed registers
+     */
+    ELITE_EXPORT int getInIntRegisters(IntRegisterBank& values);
+
+    /**
+     * @brief Get all the output int registers subscribed in the output recipe, from the same data package.
+     *
+     * @param values values[i] is register i. Registers that are not subscribed are 0.
+     * @return int The number of subscribed registers
+     */
+    ELITE_EXPORT int getOutIntRegisters(IntRegisterBank& values);
+
+    /**
+     * @brief Get all the input double registers subscribed in the output recipe, from the same data package.
+     *
+     * @param values values[i] is register i. Registers that are not subscribed are 0.
+     * @return int The number of subscribed registers
+     */
+    ELITE_EXPORT int getInDoubleRegisters(DoubleRegisterBank& values);
+
+    /**
+     * @brief Get all the output double registers subscribed in the output recipe, from the same data package.
+     *
+     * @param values values[i] is register i. Registers that are not subscribed are 0.
+     * @return int The number of subscribed registers
+     */
+    ELITE_EXPORT int getOutDoubleRegisters(DoubleRegisterBank& values);
+
+    /**
+     * @return uint64_t Input bool registers 64~127 subscribed in the output recipe, bit i is register 64 + i.
+     */
+    ELITE_EXPORT uint64_t getInBoolRegisters64To127();
+
+    /**
+     * @return uint64_t Output bool registers 64~127 subscribed in the output recipe, bit i is register 64 + i.
+     */
+    ELITE_EXPORT uint64_t getOutBoolRegisters64To127();
+
+    /**
+     * @brief Set consecutive input int registers, they are sent in the same data package.
+     *
+     * @param start The first register
+     * @param values Register values
+     * @param count The number of registers
+     * @return true success
+     * @return false a register is not in the input recipe, nothing is written
+     */
+    ELITE_EXPORT bool setInputIntRegisters(int start, const int32_t* values, int count);
+
+    /**
+     * @brief Set consecutive input double registers, they are sent in the same data package.
+     *
+     * @param start The first register
+     * @param values Register values
+     * @param count The number of registers
+     * @return true success
+     * @return false a register is not in the input recipe, nothing is written
+     */
+    ELITE_EXPORT bool setInputDoubleRegisters(int start, const double* values, int count);
+
+    /**
+     * @brief Set input bool registers 64~127, they are sent in the same data package.
+     *
+     * @param mask The registers to write, bit i is register 64 + i
+     * @param values Register values, bit i is register 64 + i
+     * @return true success
+     * @return false a register is not in the input recipe, nothing is written
+     */
+    ELITE_EXPORT bool setInputBoolRegisters64To127(uint64_t mask, uint64_t values);
+
+    /**
+     * @brief Register a callback that is called each time a new output recipe frame has been received.
+     *
+     * @param cb Callback function. It is called in the RTSI receive thread, after the frame has been parsed and before the
+     * input recipe is sent, so values written by setInputRecipeValue() in the callback are sent in the same cycle.
+     * @return int The handle of the callback, used by removeFrameCallback()
+     * @note The callback must not block, otherwise the synchronization with the robot will be delayed.
+     */
+    ELITE_EXPORT int addFrameCallback(std::function<void()> cb) override;
+
+    /**
+     * @brief Remove a callback registered by addFrameCallback()
+     *
+     * @param handle The handle of the callback
+     * @note If it is called outside the RTSI receive thread, it waits for the running callbacks to return.
+     */
+    ELITE_EXPORT void removeFrameCallback(int handle) override;
+
+    /**
+     * @brief Get data from output recipe, the types of RtsiFrameSource. The other types are read by the template below.
+     *
+     * @param name Variable name
+     * @param out_value Output value
+     */
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, bool& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, int32_t& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, uint32_t& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, uint64_t& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, double& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, vector3d_t& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, vector6d_t& out_value) override;
+    ELITE_EXPORT bool getRecipeValue(const std::string& name, vector6int32_t& out_value) override;
+
     /**
      * @brief Get data from output recipe
      *
@@ -504,12 +621,79 @@ class RtsiIOInterface : protected RtsiClientInterface {
     std::atomic<bool> is_recv_thread_alive_;
     VersionInfo controller_version_;
 
+    // Recipe slots of a register bank, computed in setupRecipe()
+    struct RegisterBankSlots {
+        // Register index of each subscribed register
+        std::vector<int> indexes;
+        // Recipe slot of each subscribed register
+        std::vector<int> slots;
+        // Recipe slot by register index (minus the first register of the bank), -1 if not subscribed
+        std::vector<int> slot_of;
+    };
+    // Registers read back from the output recipe
+    RegisterBankSlots out_in_int_slots_;
+    RegisterBankSlots out_out_int_slots_;
+    RegisterBankSlots out_in_double_slots_;
+    RegisterBankSlots out_out_double_slots_;
+    RegisterBankSlots out_in_bool_slots_;
+    RegisterBankSlots out_out_bool_slots_;
+    // Registers written by the input recipe
+    RegisterBankSlots in_int_slots_;
+    RegisterBankSlots in_double_slots_;
+    RegisterBankSlots in_bool_slots_;
+
+    // Frame callbacks. The list is copied on write, so the receive thread only holds the lock to take a snapshot.
+    using FrameCallbackList = std::vector<std::pair<int, std::function<void()>>>;
+    std::mutex frame_cb_mutex_;
+    std::mutex frame_cb_call_mutex_;
+    std::shared_ptr<const FrameCallbackList> frame_cbs_;
+    int frame_cb_next_handle_;
+
     /**
      * @brief Continuously receive and parse data messages.
      *
      */
     void recvLoop();
 
+    /**
+     * @brief Find the recipe slots of the registers "<prefix><first>" ~ "<prefix><first + count - 1>"
+     *
+     */
+    static void mapRegisterSlots(const std::shared_ptr<RtsiRecipe>& recipe, const std::string& prefix, int first, int count,
+                                 RegisterBankSlots& out);
+
+    /**
+     * @brief Read the subscribed registers of a bank. values[index - first] is written for each subscribed register.
+     *
+     * @return int The number of subscribed registers
+     */
+    template <typename T>
+    static int readRegisterBank(const std::shared_ptr<RtsiRecipe>& recipe, const RegisterBankSlots& bank, int first, T* values);
+
+    /**
+     * @brief Read one register of a bank
+     *
+     * @param offset Register index minus the first register of the bank
+     * @return true success
+     * @return false the register is not subscribed
+     */
+    template <typename T>
+    static bool readSingleRegister(const std::shared_ptr<RtsiRecipe>& recipe, const RegisterBankSlots& bank, int offset, T& value);
+
+    /**
+     * @brief Write registers of a bank to the input recipe. Nothing is written if one of them is not subscribed.
+     *
+     * @param offsets Register index minus the first register of the bank, for each value
+     */
+    template <typename T>
+    bool writeRegisterBank(const RegisterBankSlots& bank, const int* offsets, const T* values, int count);
+
+    /**
+     * @brief Call all frame callbacks
+     *
+     */
+    void callFrameCallbacks();
+
     /**
      * @brief Setup input and output recipe
      *
@@ -79,6 +79,75 @@ class RtsiRecipe {
         return false;
     }
 
+    /**
+     * @brief Get the slot of a variable, which can be used by getSlotValues() and setSlotValues() to access the value without
+     * looking up the name.
+     *
+     * @param name The variable name
+     * @return int The slot (the position of the variable in the recipe), -1 if the variable is not in the recipe
+     */
+    ELITE_EXPORT int getSlot(const std::string& name) const {
+        for (size_t i = 0; i < recipe_list_.size(); i++) {
+            if (recipe_list_[i] == name) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Retrieve the values of several slots under one lock, so they come from the same data package.
+     *
+     * @tparam T The type of the variables, same as getValue()
+     * @param slots The slots, got by getSlot()
+     * @param count The number of slots
+     * @param out_values Output values, out_values[i] is the value of slots[i]
+     * @return true success
+     * @return false a slot is illegal or the recipe has not been set up
+     */
+    template <typename T>
+    bool getSlotValues(const int* slots, size_t count, T* out_values) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        for (size_t i = 0; i < count; i++) {
+            if (slots[i] < 0 || slots[i] >= (int)slot_table_.size()) {
+                return false;
+            }
+#if (ELITE_SDK_COMPILE_STANDARD >= 17)
+            out_values[i] = std::get<T>(*slot_table_[slots[i]]);
+#elif (ELITE_SDK_COMPILE_STANDARD == 14)
+            out_values[i] = *(boost::get<T>(slot_table_[slots[i]]));
+#endif
+        }
+        return true;
+    }
+
+    /**
+     * @brief Set the values of several slots under one lock, so they are sent in the same data package.
+     *
+     * @tparam T The type of the variables, same as setValue()
+     * @param slots The slots, got by getSlot()
+     * @param count The number of slots
+     * @param values values[i] is written to slots[i]
+     * @return true success
+     * @return false a slot is illegal, the type does not match, or the recipe has not been set up. Nothing is written if a
+     * slot is illegal.
+     */
+    template <typename T>
+    bool setSlotValues(const int* slots, size_t count, const T* values) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        for (size_t i = 0; i < count; i++) {
+            if (slots[i] < 0 || slots[i] >= (int)slot_table_.size()) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!setVariantValue(*slot_table_[slots[i]], values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * @brief Get the list of variable names
      *
@@ -97,6 +166,8 @@ class RtsiRecipe {
     RtsiRecipe() = default;
     std::vector<std::string> recipe_list_;
     std::unordered_map<std::string, RtsiTypeVariant> value_table_;
+    // slot_table_[i] points to the value of recipe_list_[i] in value_table_, filled when the recipe is set up.
+    std::vector<RtsiTypeVariant*> slot_table_;
     std::atomic<int> recipe_id_;
     std::mutex update_mutex_;
 
@@ -8,6 +8,7 @@
 
 #include <string>
 #include <vector>
+#include "EliteException.hpp"
 #include "RtsiRecipe.hpp"
 
 namespace ELITE {
@@ -50,14 +51,31 @@ class RtsiRecipeInternal : public RtsiRecipe {
      * @return true success
      * @return false fail
      */
-    bool parserDataPackage(int package_len, const std::vector<std::uint8_t>& package);
+    bool parserDataPackage(int package_len, const std::vector<std::uint8_t>& package) noexcept;
+
+    /**
+     * @brief Copy the values in the order of the recipe
+     *
+     * @param values Output, resized to the size of the recipe. A reused vector does not allocate memory after the first call.
+     */
+    void getValues(std::vector<RtsiTypeVariant>& values);
 
     /**
      * @brief Pack the data in recipe to bytes
      *
      * @return std::vector<uint8_t> The RTSI data package
+     * @throws EliteException If the recipe has not been set up
      */
     std::vector<uint8_t> packToBytes();
+
+    /**
+     * @brief Pack the data in recipe to bytes, without exception.
+     *      The bytes are appended to 'out', so a reused buffer does not allocate memory after the first package.
+     *
+     * @param out Output buffer
+     * @return EliteException::Code SUCCESS, or RTSI_RECIPE_PARSER_FAIL if the recipe has not been set up
+     */
+    EliteException::Code packToBytes(std::vector<uint8_t>& out) noexcept;
 };
 
 }  // namespace ELITE
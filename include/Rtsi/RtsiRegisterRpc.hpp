@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiRegisterRpc.hpp
+// A request/response mailbox over the RTSI int and double registers.
+#ifndef __RTSI_REGISTER_RPC_HPP__
+#define __RTSI_REGISTER_RPC_HPP__
+
+#include <Elite/EliteOptions.hpp>
+#include <Elite/RtsiIOInterface.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief Register layout of RtsiRegisterRpc
+ *
+ */
+struct RtsiRegisterRpcConfig {
+    /// The first int register used by the mailbox
+    int int_register_base = 0;
+    /// The number of int payload registers, in each direction
+    int int_payload_count = 2;
+    /// The first double register used by the mailbox
+    int double_register_base = 0;
+    /// The number of double payload registers, in each direction
+    int double_payload_count = 6;
+    /// Timeout of a single request (ms), counted from the moment it is written to the registers
+    int timeout_ms = 1000;
+};
+
+/**
+ * @brief Request/response channel between the SDK and a robot task, carried by the RTSI general purpose registers.
+ *
+ * Register layout, starting at the configured base indexes:
+ *      - input_int_register[base]      : request sequence number (written last by the SDK)
+ *      - input_int_register[base + 1]  : opcode
+ *      - input_int_register[base + 2..]: int payload
+ *      - input_double_register[base..] : double payload
+ *      - output_int_register[base]     : acknowledged sequence number (written last by the robot)
+ *      - output_int_register[base + 1] : result code
+ *      - output_int_register[base + 2..]: int result payload
+ *      - output_double_register[base..]: double result payload
+ *
+ * The robot side is implemented by "register_rpc.script" in the resources directory. Requests are queued and issued one at a
+ * time. Completion is detected in the RTSI receive thread, and the next queued request is written in the same cycle, so the
+ * throughput is about half of the RTSI frequency.
+ */
+class RtsiRegisterRpc {
+   public:
+    /// The number of RTSI int registers and double registers
+    static constexpr int REGISTER_COUNT = 48;
+
+    using Config = RtsiRegisterRpcConfig;
+
+    /**
+     * @brief The status of a request
+     *
+     */
+    enum class Status {
+        /// The robot acknowledged the request
+        SUCCESS,
+        /// The robot did not acknowledge in time
+        TIMEOUT,
+        /// The registers are not in the input recipe
+        SEND_FAIL,
+        /// The mailbox was destroyed before the request completed
+        CANCELED
+    };
+
+    /**
+     * @brief The response of a request
+     *
+     */
+    struct Response {
+        Status status = Status::CANCELED;
+        /// Result code written by the robot
+        int32_t result = 0;
+        std::vector<int32_t> int_values;
+        std::vector<double> double_values;
+        /// Time between the request being written and the acknowledgement being received
+        std::chrono::microseconds latency{0};
+    };
+
+    RtsiRegisterRpc() = delete;
+
+    /**
+     * @brief Construct a new Rtsi Register Rpc object
+     *
+     * @param rtsi The RTSI interface. Its recipes must include the fields listed by inputRecipe() and outputRecipe(), and it
+     * must outlive this object.
+     * @param config Register layout
+     * @note If the register layout is out of range, an EliteException with ILLEGAL_PARAM will be thrown.
+     */
+    ELITE_EXPORT explicit RtsiRegisterRpc(RtsiIOInterface& rtsi, const Config& config = Config());
+
+    /**
+     * @brief Destroy the Rtsi Register Rpc object. Pending requests are completed with Status::CANCELED.
+     *
+     */
+    ELITE_EXPORT ~RtsiRegisterRpc();
+
+    /**
+     * @brief Queue a request
+     *
+     * @param opcode The opcode, interpreted by the robot task
+     * @param int_values Int payload, no more than Config::int_payload_count. Missing values are sent as 0.
+     * @param double_values Double payload, no more than Config::double_payload_count. Missing values are sent as 0.
+     * @return std::future<Response> Becomes ready when the robot acknowledges or the request times out
+     * @note If the payload is longer than configured, an EliteException with ILLEGAL_PARAM will be thrown.
+     */
+    ELITE_EXPORT std::future<Response> call(int32_t opcode, const std::vector<int32_t>& int_values = {},
+                                            const std::vector<double>& double_values = {});
+
+    /**
+     * @brief Get the number of requests that are queued or in flight
+     *
+     */
+    ELITE_EXPORT size_t pendingCount();
+
+    /**
+     * @brief The input recipe fields required by the layout
+     *
+     */
+    ELITE_EXPORT static std::vector<std::string> inputRecipe(const Config& config);
+
+    /**
+     * @brief The output recipe fields required by the layout
+     *
+     */
+    ELITE_EXPORT static std::vector<std::string> outputRecipe(const Config& config);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// RtsiTelemetry.hpp
+// Columnar compressed recording of RTSI frames, with random access time range reads.
+#ifndef __RTSI_TELEMETRY_HPP__
+#define __RTSI_TELEMETRY_HPP__
+
+#include <Elite/DataType.hpp>
+#include <Elite/EliteOptions.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ELITE {
+
+/**
+ * @brief The type of a recorded field, in the order of the alternatives of RtsiTypeVariant
+ *
+ */
+enum class TelemetryType : uint8_t {
+    BOOL = 0,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    DOUBLE,
+    VECTOR3D,
+    VECTOR6D,
+    VECTOR6INT32,
+    VECTOR6UINT32,
+};
+
+/**
+ * @brief A recorded field, usually an RTSI output recipe variable
+ *
+ */
+struct TelemetryField {
+    std::string name;
+    TelemetryType type;
+};
+
+/**
+ * @brief Writes RTSI frames to a compressed telemetry file.
+ *
+ * Every field is split into scalar columns, stored one after the other in blocks of frames:
+ *  - doubles with the XOR compression of Gorilla: an unchanged value costs 1 bit, a slowly changing one a few meaningful bits
+ *  - the timestamps, in microseconds, with delta-of-delta: a steady 500 Hz stream costs 1 bit per frame
+ *  - integers, booleans and bit fields with run length encoding of zigzag deltas, a value held for a block costs a few bytes
+ *
+ * Each block is decodable on its own and the file ends with an index of the blocks and their time ranges, so TelemetryReader
+ * decodes only the blocks of the requested time range. A file without the index (the writer was not closed) is still readable up
+ * to the last complete block. Encoding takes a few microseconds per frame, several robots at 500 Hz fit on one core.
+ */
+class TelemetryWriter {
+   public:
+    ELITE_EXPORT TelemetryWriter();
+
+    /**
+     * @brief Close the file if it is open
+     *
+     */
+    ELITE_EXPORT ~TelemetryWriter();
+
+    /**
+     * @brief Create a telemetry file
+     *
+     * @param path File path
+     * @param fields The fields of the frames
+     * @param block_frames Frames per block, the granularity of the random access
+     * @return true success
+     * @return false the file can not be created, there is no field, or block_frames is not positive
+     */
+    ELITE_EXPORT bool open(const std::string& path, const std::vector<TelemetryField>& fields, int block_frames = 1000);
+
+    /**
+     * @brief Add a frame
+     *
+     * @param timestamp Time of the frame (s), for example "timestamp". It is stored in microseconds and must not decrease.
+     * @param values The values of the fields, in the order of the fields
+     * @return true success
+     * @return false the file is not open, a value does not match the type of its field, the timestamp decreased, or the block
+     * can not be written
+     */
+    ELITE_EXPORT bool append(double timestamp, const std::vector<RtsiTypeVariant>& values);
+
+    /**
+     * @brief Write the last block and the index, and close the file
+     *
+     * @return true success
+     */
+    ELITE_EXPORT bool close();
+
+    ELITE_EXPORT uint64_t frameCount() const;
+
+    /**
+     * @brief The bytes written to the file so far, the current block is not included
+     *
+     */
+    ELITE_EXPORT uint64_t bytesWritten() const;
+
+    /**
+     * @brief The type of a value
+     *
+     */
+    ELITE_EXPORT static TelemetryType typeOf(const RtsiTypeVariant& value);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Reads a telemetry file written by TelemetryWriter. The file is memory-mapped and only the blocks of a read are decoded.
+ *
+ */
+class TelemetryReader {
+   public:
+    /**
+     * @brief Receives the frames of a read
+     *
+     * @return false stop the read
+     */
+    using FrameCallback = std::function<bool(double timestamp, const std::vector<RtsiTypeVariant>& values)>;
+
+    ELITE_EXPORT TelemetryReader();
+
+    ELITE_EXPORT ~TelemetryReader();
+
+    /**
+     * @brief Map a telemetry file
+     *
+     * @param path File path
+     * @return true success
+     * @return false the file can not be mapped or it is not a telemetry file
+     */
+    ELITE_EXPORT bool open(const std::string& path);
+
+    ELITE_EXPORT const std::vector<TelemetryField>& fields() const;
+
+    ELITE_EXPORT uint64_t frameCount() const;
+
+    ELITE_EXPORT size_t blockCount() const;
+
+    /**
+     * @brief Time of the first frame (s)
+     *
+     */
+    ELITE_EXPORT double startTime() const;
+
+    /**
+     * @brief Time of the last frame (s)
+     *
+     */
+    ELITE_EXPORT double endTime() const;
+
+    /**
+     * @brief Read the frames of a time range, in time order
+     *
+     * @param start Start of the range (s), included
+     * @param end End of the range (s), included
+     * @param cb Receives the frames
+     * @return true success
+     * @return false the file is not open or a block is corrupted
+     */
+    ELITE_EXPORT bool read(double start, double end, const FrameCallback& cb) const;
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ELITE
+
+#endif
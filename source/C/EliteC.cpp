@@ -0,0 +1,793 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "EliteC.h"
+#include "DashboardClient.hpp"
+#include "EliteDriver.hpp"
+#include "EliteException.hpp"
+#include "RobotException.hpp"
+#include "RtsiIOInterface.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace ELITE;
+
+namespace {
+
+/**
+ * A C callback and its context. The SDK thread runs it under the mutex, so when set() returns the previous callback is no
+ * longer running. set() from inside the callback, in the running thread, doesn't lock again.
+ */
+template <typename Callback>
+struct CallbackSlot {
+    std::mutex mutex;
+    Callback callback = nullptr;
+    void* context = nullptr;
+    std::atomic<std::thread::id> running_thread{};
+
+    template <typename... Args>
+    void invoke(Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!callback) {
+            return;
+        }
+        running_thread = std::this_thread::get_id();
+        callback(std::forward<Args>(args)..., context);
+        running_thread = std::thread::id();
+    }
+
+    void set(Callback cb, void* ctx) {
+        if (running_thread == std::this_thread::get_id()) {
+            callback = cb;
+            context = ctx;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        callback = cb;
+        context = ctx;
+    }
+};
+
+}  // namespace
+
+struct elite_driver {
+    // Before the driver, its threads may run the callbacks until it is destroyed
+    CallbackSlot<elite_trajectory_result_callback_t> trajectory_result_cb;
+    CallbackSlot<elite_connection_callback_t> connection_cb;
+    CallbackSlot<elite_robot_exception_callback_t> robot_exception_cb;
+    std::unique_ptr<EliteDriver> driver;
+};
+
+struct elite_rtsi {
+    std::unique_ptr<RtsiIOInterface> rtsi;
+    int frame_handle = -1;
+    // Written by the receive thread only, read by anyone through the sequence
+    elite_rtsi_snapshot_t snapshot;
+    // Built without the sequence held, then published in one copy
+    elite_rtsi_snapshot_t staging;
+    CallbackSlot<elite_rtsi_frame_callback_t> frame_cb;
+};
+
+struct elite_dashboard {
+    DashboardClient dashboard;
+};
+
+namespace {
+
+// The sequence is the first member of the snapshot, the C side sees it as a plain uint64_t
+static_assert(offsetof(elite_rtsi_snapshot_t, sequence) == 0, "sequence must be the first member");
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic sequence must have the size of uint64_t");
+static_assert(alignof(std::atomic<uint64_t>) <= alignof(elite_rtsi_snapshot_t), "snapshot is not aligned for the sequence");
+static_assert(std::is_standard_layout<elite_rtsi_snapshot_t>::value, "snapshot must be a standard layout type");
+
+thread_local std::string s_last_error;
+
+elite_status_t fail(elite_status_t status, const std::string& message) {
+    s_last_error = message;
+    return status;
+}
+
+elite_status_t result(bool ok, const char* what) {
+    if (ok) {
+        s_last_error.clear();
+        return ELITE_OK;
+    }
+    return fail(ELITE_ERR_FAILED, std::string(what) + " failed");
+}
+
+// Run 'fn' and turn every exception into a status, none may reach a C caller
+template <typename F>
+elite_status_t guard(F&& fn) {
+    try {
+        return fn();
+    } catch (const EliteException& e) {
+        elite_status_t status = ELITE_ERR_INTERNAL;
+        if (e == EliteException::Code::SOCKET_CONNECT_FAIL || e == EliteException::Code::SOCKET_FAIL) {
+            status = ELITE_ERR_SOCKET;
+        } else if (e == EliteException::Code::SOCKET_TIMEOUT) {
+            status = ELITE_ERR_TIMEOUT;
+        } else if (e == EliteException::Code::ILLEGAL_PARAM) {
+            status = ELITE_ERR_INVALID_ARGUMENT;
+        }
+        return fail(status, e.what());
+    } catch (const std::exception& e) {
+        return fail(ELITE_ERR_INTERNAL, e.what());
+    } catch (...) {
+        return fail(ELITE_ERR_INTERNAL, "unknown exception");
+    }
+}
+
+elite_status_t nullArgument() { return fail(ELITE_ERR_INVALID_ARGUMENT, "null argument"); }
+
+vector6d_t toVector6d(const double values[6]) {
+    vector6d_t result;
+    std::copy(values, values + 6, result.begin());
+    return result;
+}
+
+std::atomic<uint64_t>& sequenceOf(elite_rtsi_snapshot_t& snapshot) {
+    return *reinterpret_cast<std::atomic<uint64_t>*>(&snapshot.sequence);
+}
+
+template <typename T, size_t N, typename U>
+void copyArray(const std::array<T, N>& from, U* to) {
+    std::copy(from.begin(), from.end(), to);
+}
+
+// Read the variables of the newest frame into the staging snapshot and publish it
+void updateSnapshot(elite_rtsi& handle) {
+    RtsiIOInterface& rtsi = *handle.rtsi;
+    elite_rtsi_snapshot_t& s = handle.staging;
+    uint64_t fields = 0;
+    auto read = [&](const char* name, elite_rtsi_field_t bit, auto& value) {
+        if (rtsi.getRecipeValue(name, value)) {
+            fields |= bit;
+        }
+    };
+    auto readArray = [&](const char* name, elite_rtsi_field_t bit, auto& value, auto* to) {
+        if (rtsi.getRecipeValue(name, value)) {
+            fields |= bit;
+            copyArray(value, to);
+        }
+    };
+    vector6d_t v6;
+    vector3d_t v3;
+    vector6int32_t i6;
+    read("timestamp", ELITE_RTSI_TIMESTAMP, s.timestamp);
+    readArray("target_joint_positions", ELITE_RTSI_TARGET_JOINT_POSITIONS, v6, s.target_joint_positions);
+    readArray("target_joint_speeds", ELITE_RTSI_TARGET_JOINT_SPEEDS, v6, s.target_joint_speeds);
+    readArray("actual_joint_positions", ELITE_RTSI_ACTUAL_JOINT_POSITIONS, v6, s.actual_joint_positions);
+    readArray("actual_joint_speeds", ELITE_RTSI_ACTUAL_JOINT_SPEEDS, v6, s.actual_joint_speeds);
+    readArray("actual_joint_torques", ELITE_RTSI_ACTUAL_JOINT_TORQUES, v6, s.actual_joint_torques);
+    readArray("actual_joint_current", ELITE_RTSI_ACTUAL_JOINT_CURRENT, v6, s.actual_joint_current);
+    readArray("joint_temperatures", ELITE_RTSI_JOINT_TEMPERATURES, v6, s.joint_temperatures);
+    readArray("actual_TCP_pose", ELITE_RTSI_ACTUAL_TCP_POSE, v6, s.actual_TCP_pose);
+    readArray("actual_TCP_speed", ELITE_RTSI_ACTUAL_TCP_SPEED, v6, s.actual_TCP_speed);
+    readArray("actual_TCP_force", ELITE_RTSI_ACTUAL_TCP_FORCE, v6, s.actual_TCP_force);
+    readArray("target_TCP_pose", ELITE_RTSI_TARGET_TCP_POSE, v6, s.target_TCP_pose);
+    readArray("target_TCP_speed", ELITE_RTSI_TARGET_TCP_SPEED, v6, s.target_TCP_speed);
+    readArray("elbow_position", ELITE_RTSI_ELBOW_POSITION, v3, s.elbow_position);
+    readArray("elbow_velocity", ELITE_RTSI_ELBOW_VELOCITY, v3, s.elbow_velocity);
+    read("payload_mass", ELITE_RTSI_PAYLOAD_MASS, s.payload_mass);
+    readArray("payload_cog", ELITE_RTSI_PAYLOAD_COG, v3, s.payload_cog);
+    read("speed_scaling", ELITE_RTSI_SPEED_SCALING, s.speed_scaling);
+    read("target_speed_fraction", ELITE_RTSI_TARGET_SPEED_FRACTION, s.target_speed_fraction);
+    read("actual_robot_voltage", ELITE_RTSI_ACTUAL_ROBOT_VOLTAGE, s.actual_robot_voltage);
+    read("actual_robot_current", ELITE_RTSI_ACTUAL_ROBOT_CURRENT, s.actual_robot_current);
+    read("robot_mode", ELITE_RTSI_ROBOT_MODE, s.robot_mode);
+    read("safety_status", ELITE_RTSI_SAFETY_STATUS, s.safety_status);
+    uint32_t runtime_state = 0;
+    if (rtsi.getRecipeValue("runtime_state", runtime_state)) {
+        fields |= ELITE_RTSI_RUNTIME_STATE;
+        s.runtime_state = (int32_t)runtime_state;
+    }
+    readArray("joint_mode", ELITE_RTSI_JOINT_MODE, i6, s.joint_mode);
+    read("robot_status_bits", ELITE_RTSI_ROBOT_STATUS_BITS, s.robot_status_bits);
+    read("safety_status_bits", ELITE_RTSI_SAFETY_STATUS_BITS, s.safety_status_bits);
+    read("actual_digital_input_bits", ELITE_RTSI_ACTUAL_DIGITAL_INPUT_BITS, s.actual_digital_input_bits);
+    read("actual_digital_output_bits", ELITE_RTSI_ACTUAL_DIGITAL_OUTPUT_BITS, s.actual_digital_output_bits);
+    read("script_control_line", ELITE_RTSI_SCRIPT_CONTROL_LINE, s.script_control_line);
+    s.fields = fields;
+    s.frame_count++;
+
+    // Sequence lock: odd while the fields are written
+    std::atomic<uint64_t>& sequence = sequenceOf(handle.snapshot);
+    uint64_t begin = sequence.load(std::memory_order_relaxed) + 1;
+    sequence.store(begin, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<char*>(&handle.snapshot) + sizeof(uint64_t), reinterpret_cast<const char*>(&s) + sizeof(uint64_t),
+                sizeof(elite_rtsi_snapshot_t) - sizeof(uint64_t));
+    sequence.store(begin + 1, std::memory_order_release);
+    s.sequence = begin + 1;
+}
+
+elite_status_t rtsiConnected(elite_rtsi_t* rtsi) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    if (!rtsi->rtsi->isConnected()) {
+        return fail(ELITE_ERR_SOCKET, "RTSI is not connected");
+    }
+    return ELITE_OK;
+}
+
+void forwardRobotException(elite_driver& handle, const RobotExceptionSharedPtr& ex) {
+    if (!ex) {
+        return;
+    }
+    elite_robot_exception_t c_ex;
+    std::memset(&c_ex, 0, sizeof(c_ex));
+    c_ex.type = (int32_t)ex->getType();
+    c_ex.timestamp = ex->getTimestamp();
+    c_ex.message = "";
+    if (ex->getType() == RobotException::Type::ROBOT_ERROR) {
+        auto error = std::static_pointer_cast<RobotError>(ex);
+        c_ex.error_code = error->getErrorCode();
+        c_ex.sub_error_code = error->getSubErrorCode();
+        c_ex.error_source = (int32_t)error->getErrorSouce();
+        c_ex.error_level = (int32_t)error->getErrorLevel();
+    } else if (ex->getType() == RobotException::Type::SCRIPT_RUNTIME) {
+        auto runtime = std::static_pointer_cast<RobotRuntimeException>(ex);
+        c_ex.line = runtime->getLine();
+        c_ex.column = runtime->getColumn();
+        c_ex.message = runtime->getMessage().c_str();
+    }
+    handle.robot_exception_cb.invoke((const elite_robot_exception_t*)&c_ex);
+}
+
+}  // namespace
+
+uint32_t elite_c_abi_version(void) { return ELITE_C_ABI_VERSION; }
+
+const char* elite_sdk_version(void) { return ELITE_SDK_VERSION; }
+
+const char* elite_last_error(void) { return s_last_error.c_str(); }
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * EliteDriver
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+void elite_driver_config_init(elite_driver_config_t* config) {
+    if (!config) {
+        return;
+    }
+    EliteDriverConfig defaults;
+    std::memset(config, 0, sizeof(*config));
+    config->headless_mode = defaults.headless_mode;
+    config->script_sender_port = defaults.script_sender_port;
+    config->reverse_port = defaults.reverse_port;
+    config->trajectory_port = defaults.trajectory_port;
+    config->script_command_port = defaults.script_command_port;
+    config->servoj_time = defaults.servoj_time;
+    config->servoj_lookahead_time = defaults.servoj_lookahead_time;
+    config->servoj_gain = defaults.servoj_gain;
+    config->stopj_acc = defaults.stopj_acc;
+}
+
+elite_status_t elite_driver_create(const elite_driver_config_t* config, elite_driver_t** driver) {
+    if (!driver) {
+        return nullArgument();
+    }
+    *driver = nullptr;
+    if (!config || !config->robot_ip || !config->script_file_path) {
+        return nullArgument();
+    }
+    return guard([&]() {
+        EliteDriverConfig cpp_config;
+        cpp_config.robot_ip = config->robot_ip;
+        cpp_config.script_file_path = config->script_file_path;
+        cpp_config.local_ip = config->local_ip ? config->local_ip : "";
+        cpp_config.headless_mode = config->headless_mode;
+        cpp_config.script_sender_port = config->script_sender_port;
+        cpp_config.reverse_port = config->reverse_port;
+        cpp_config.trajectory_port = config->trajectory_port;
+        cpp_config.script_command_port = config->script_command_port;
+        cpp_config.servoj_time = config->servoj_time;
+        cpp_config.servoj_lookahead_time = config->servoj_lookahead_time;
+        cpp_config.servoj_gain = config->servoj_gain;
+        cpp_config.stopj_acc = config->stopj_acc;
+        std::unique_ptr<elite_driver> handle(new elite_driver);
+        handle->driver.reset(new EliteDriver(cpp_config));
+        // The driver keeps forwarding to the slots, the setters only change the slots
+        elite_driver* raw = handle.get();
+        raw->driver->setTrajectoryResultCallback(
+            [raw](TrajectoryMotionResult motion_result) { raw->trajectory_result_cb.invoke((int32_t)motion_result); });
+        raw->driver->registerConnectionCallback(
+            [raw](const ConnectionEvent& event) { raw->connection_cb.invoke((int32_t)event.server, event.connected); });
+        raw->driver->registerRobotExceptionCallback([raw](RobotExceptionSharedPtr ex) { forwardRobotException(*raw, ex); });
+        *driver = handle.release();
+        return result(true, "");
+    });
+}
+
+void elite_driver_destroy(elite_driver_t* driver) {
+    guard([&]() {
+        delete driver;
+        return ELITE_OK;
+    });
+}
+
+bool elite_driver_is_robot_connected(elite_driver_t* driver) { return driver && driver->driver->isRobotConnected(); }
+
+elite_status_t elite_driver_send_external_control_script(elite_driver_t* driver) {
+    if (!driver) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->sendExternalControlScript(), "sendExternalControlScript"); });
+}
+
+elite_status_t elite_driver_write_servoj(elite_driver_t* driver, const double pos[6], int32_t timeout_ms, bool cartesian,
+                                         bool queue_mode) {
+    if (!driver || !pos) {
+        return nullArgument();
+    }
+    return guard(
+        [&]() { return result(driver->driver->writeServoj(toVector6d(pos), timeout_ms, cartesian, queue_mode), "writeServoj"); });
+}
+
+elite_status_t elite_driver_write_speedj(elite_driver_t* driver, const double vel[6], int32_t timeout_ms) {
+    if (!driver || !vel) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->writeSpeedj(toVector6d(vel), timeout_ms), "writeSpeedj"); });
+}
+
+elite_status_t elite_driver_write_speedl(elite_driver_t* driver, const double vel[6], int32_t timeout_ms) {
+    if (!driver || !vel) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->writeSpeedl(toVector6d(vel), timeout_ms), "writeSpeedl"); });
+}
+
+elite_status_t elite_driver_write_idle(elite_driver_t* driver, int32_t timeout_ms) {
+    if (!driver) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->writeIdle(timeout_ms), "writeIdle"); });
+}
+
+elite_status_t elite_driver_write_freedrive(elite_driver_t* driver, int32_t action, int32_t timeout_ms) {
+    if (!driver) {
+        return nullArgument();
+    }
+    if (action < (int)FreedriveAction::FREEDRIVE_END || action > (int)FreedriveAction::FREEDRIVE_START) {
+        return fail(ELITE_ERR_INVALID_ARGUMENT, "illegal freedrive action");
+    }
+    return guard(
+        [&]() { return result(driver->driver->writeFreedrive((FreedriveAction)action, timeout_ms), "writeFreedrive"); });
+}
+
+elite_status_t elite_driver_write_trajectory_point(elite_driver_t* driver, const double positions[6], float time,
+                                                   float blend_radius, bool cartesian) {
+    if (!driver || !positions) {
+        return nullArgument();
+    }
+    return guard([&]() {
+        return result(driver->driver->writeTrajectoryPoint(toVector6d(positions), time, blend_radius, cartesian),
+                      "writeTrajectoryPoint");
+    });
+}
+
+elite_status_t elite_driver_write_trajectory_control_action(elite_driver_t* driver, int32_t action, int32_t point_number,
+                                                            int32_t timeout_ms) {
+    if (!driver) {
+        return nullArgument();
+    }
+    if (action < (int)TrajectoryControlAction::CANCEL || action > (int)TrajectoryControlAction::START) {
+        return fail(ELITE_ERR_INVALID_ARGUMENT, "illegal trajectory control action");
+    }
+    return guard([&]() {
+        return result(driver->driver->writeTrajectoryControlAction((TrajectoryControlAction)action, point_number, timeout_ms),
+                      "writeTrajectoryControlAction");
+    });
+}
+
+elite_status_t elite_driver_stop_control(elite_driver_t* driver, int32_t wait_ms) {
+    if (!driver) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->stopControl(wait_ms), "stopControl"); });
+}
+
+elite_status_t elite_driver_send_script(elite_driver_t* driver, const char* script) {
+    if (!driver || !script) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->sendScript(script), "sendScript"); });
+}
+
+elite_status_t elite_driver_zero_ft_sensor(elite_driver_t* driver) {
+    if (!driver) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->zeroFTSensor(), "zeroFTSensor"); });
+}
+
+elite_status_t elite_driver_set_payload(elite_driver_t* driver, double mass, const double cog[3]) {
+    if (!driver || !cog) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(driver->driver->setPayload(mass, {cog[0], cog[1], cog[2]}), "setPayload"); });
+}
+
+elite_status_t elite_driver_set_trajectory_result_callback(elite_driver_t* driver, elite_trajectory_result_callback_t callback,
+                                                           void* context) {
+    if (!driver) {
+        return nullArgument();
+    }
+    driver->trajectory_result_cb.set(callback, context);
+    return ELITE_OK;
+}
+
+elite_status_t elite_driver_set_connection_callback(elite_driver_t* driver, elite_connection_callback_t callback,
+                                                    void* context) {
+    if (!driver) {
+        return nullArgument();
+    }
+    driver->connection_cb.set(callback, context);
+    return ELITE_OK;
+}
+
+elite_status_t elite_driver_set_robot_exception_callback(elite_driver_t* driver, elite_robot_exception_callback_t callback,
+                                                         void* context) {
+    if (!driver) {
+        return nullArgument();
+    }
+    driver->robot_exception_cb.set(callback, context);
+    return ELITE_OK;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * RtsiIOInterface
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+elite_status_t elite_rtsi_create(const char* const* output_recipe, size_t output_count, const char* const* input_recipe,
+                                 size_t input_count, double frequency, elite_rtsi_t** rtsi) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    *rtsi = nullptr;
+    if ((!output_recipe && output_count > 0) || (!input_recipe && input_count > 0)) {
+        return nullArgument();
+    }
+    if (output_count == 0 || frequency <= 0) {
+        return fail(ELITE_ERR_INVALID_ARGUMENT, "the output recipe is empty or the frequency is not positive");
+    }
+    return guard([&]() {
+        std::vector<std::string> outputs, inputs;
+        for (size_t i = 0; i < output_count; i++) {
+            if (!output_recipe[i]) {
+                return nullArgument();
+            }
+            outputs.emplace_back(output_recipe[i]);
+        }
+        for (size_t i = 0; i < input_count; i++) {
+            if (!input_recipe[i]) {
+                return nullArgument();
+            }
+            inputs.emplace_back(input_recipe[i]);
+        }
+        std::unique_ptr<elite_rtsi> handle(new elite_rtsi);
+        std::memset(&handle->snapshot, 0, sizeof(handle->snapshot));
+        std::memset(&handle->staging, 0, sizeof(handle->staging));
+        handle->rtsi.reset(new RtsiIOInterface(outputs, inputs, frequency));
+        elite_rtsi* raw = handle.get();
+        handle->frame_handle = handle->rtsi->addFrameCallback([raw]() {
+            updateSnapshot(*raw);
+            raw->frame_cb.invoke(&raw->staging);
+        });
+        *rtsi = handle.release();
+        return result(true, "");
+    });
+}
+
+void elite_rtsi_destroy(elite_rtsi_t* rtsi) {
+    guard([&]() {
+        if (rtsi) {
+            rtsi->rtsi->removeFrameCallback(rtsi->frame_handle);
+            rtsi->rtsi->disconnect();
+        }
+        delete rtsi;
+        return ELITE_OK;
+    });
+}
+
+elite_status_t elite_rtsi_connect(elite_rtsi_t* rtsi, const char* ip) {
+    if (!rtsi || !ip) {
+        return nullArgument();
+    }
+    return guard([&]() {
+        if (!rtsi->rtsi->connect(ip)) {
+            return fail(ELITE_ERR_FAILED, "RTSI setup failed");
+        }
+        return result(true, "");
+    });
+}
+
+void elite_rtsi_disconnect(elite_rtsi_t* rtsi) {
+    if (rtsi) {
+        guard([&]() {
+            rtsi->rtsi->disconnect();
+            return ELITE_OK;
+        });
+    }
+}
+
+bool elite_rtsi_is_connected(elite_rtsi_t* rtsi) { return rtsi && rtsi->rtsi->isConnected(); }
+
+bool elite_rtsi_is_started(elite_rtsi_t* rtsi) { return rtsi && rtsi->rtsi->isStarted(); }
+
+elite_status_t elite_rtsi_get_controller_version(elite_rtsi_t* rtsi, uint32_t version[4]) {
+    if (!rtsi || !version) {
+        return nullArgument();
+    }
+    return guard([&]() {
+        VersionInfo info = rtsi->rtsi->getControllerVersion();
+        version[0] = info.major;
+        version[1] = info.minor;
+        version[2] = info.bugfix;
+        version[3] = info.build;
+        return result(true, "");
+    });
+}
+
+const volatile elite_rtsi_snapshot_t* elite_rtsi_snapshot(elite_rtsi_t* rtsi) { return rtsi ? &rtsi->snapshot : nullptr; }
+
+elite_status_t elite_rtsi_read_snapshot(elite_rtsi_t* rtsi, elite_rtsi_snapshot_t* snapshot) {
+    if (!rtsi || !snapshot) {
+        return nullArgument();
+    }
+    std::atomic<uint64_t>& sequence = sequenceOf(rtsi->snapshot);
+    for (;;) {
+        uint64_t begin = sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            continue;
+        }
+        std::memcpy(snapshot, &rtsi->snapshot, sizeof(*snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == begin) {
+            snapshot->sequence = begin;
+            return ELITE_OK;
+        }
+    }
+}
+
+elite_status_t elite_rtsi_set_frame_callback(elite_rtsi_t* rtsi, elite_rtsi_frame_callback_t callback, void* context) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    rtsi->frame_cb.set(callback, context);
+    return ELITE_OK;
+}
+
+elite_status_t elite_rtsi_set_speed_scaling(elite_rtsi_t* rtsi, double scaling) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setSpeedScaling(scaling), "setSpeedScaling"); });
+}
+
+elite_status_t elite_rtsi_set_standard_digital(elite_rtsi_t* rtsi, int32_t index, bool level) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setStandardDigital(index, level), "setStandardDigital"); });
+}
+
+elite_status_t elite_rtsi_set_configure_digital(elite_rtsi_t* rtsi, int32_t index, bool level) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setConfigureDigital(index, level), "setConfigureDigital"); });
+}
+
+elite_status_t elite_rtsi_set_analog_output_voltage(elite_rtsi_t* rtsi, int32_t index, double value) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setAnalogOutputVoltage(index, value), "setAnalogOutputVoltage"); });
+}
+
+elite_status_t elite_rtsi_set_tool_digital_output(elite_rtsi_t* rtsi, int32_t index, bool level) {
+    if (!rtsi) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setToolDigitalOutput(index, level), "setToolDigitalOutput"); });
+}
+
+elite_status_t elite_rtsi_set_input_int_registers(elite_rtsi_t* rtsi, int32_t start, const int32_t* values, int32_t count) {
+    if (!rtsi || (!values && count > 0)) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(rtsi->rtsi->setInputIntRegisters(start, values, count), "setInputIntRegisters"); });
+}
+
+elite_status_t elite_rtsi_set_input_double_registers(elite_rtsi_t* rtsi, int32_t start, const double* values, int32_t count) {
+    if (!rtsi || (!values && count > 0)) {
+        return nullArgument();
+    }
+    return guard(
+        [&]() { return result(rtsi->rtsi->setInputDoubleRegisters(start, values, count), "setInputDoubleRegisters"); });
+}
+
+elite_status_t elite_rtsi_get_out_int_register(elite_rtsi_t* rtsi, int32_t index, int32_t* value) {
+    if (!value) {
+        return nullArgument();
+    }
+    elite_status_t status = rtsiConnected(rtsi);
+    if (status != ELITE_OK) {
+        return status;
+    }
+    return guard([&]() {
+        *value = rtsi->rtsi->getOutIntRegister(index);
+        return result(true, "");
+    });
+}
+
+elite_status_t elite_rtsi_get_out_double_register(elite_rtsi_t* rtsi, int32_t index, double* value) {
+    if (!value) {
+        return nullArgument();
+    }
+    elite_status_t status = rtsiConnected(rtsi);
+    if (status != ELITE_OK) {
+        return status;
+    }
+    return guard([&]() {
+        *value = rtsi->rtsi->getOutDoubleRegister(index);
+        return result(true, "");
+    });
+}
+
+/* ----------------------------------------------------------------------------------------------------------------------------
+ * DashboardClient
+ * --------------------------------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+template <typename F>
+elite_status_t dashboardCall(elite_dashboard_t* dashboard, const char* what, F&& fn) {
+    if (!dashboard) {
+        return nullArgument();
+    }
+    return guard([&]() { return result(fn(dashboard->dashboard), what); });
+}
+
+template <typename T>
+elite_status_t dashboardQuery(elite_dashboard_t* dashboard, int32_t* out, T (DashboardClient::*query)()) {
+    if (!dashboard || !out) {
+        return nullArgument();
+    }
+    return guard([&]() {
+        *out = (int32_t)(dashboard->dashboard.*query)();
+        return result(true, "");
+    });
+}
+
+}  // namespace
+
+elite_status_t elite_dashboard_create(elite_dashboard_t** dashboard) {
+    if (!dashboard) {
+        return nullArgument();
+    }
+    *dashboard = nullptr;
+    return guard([&]() {
+        *dashboard = new elite_dashboard;
+        return result(true, "");
+    });
+}
+
+void elite_dashboard_destroy(elite_dashboard_t* dashboard) {
+    guard([&]() {
+        delete dashboard;
+        return ELITE_OK;
+    });
+}
+
+elite_status_t elite_dashboard_connect(elite_dashboard_t* dashboard, const char* ip, int32_t port) {
+    if (!ip) {
+        return nullArgument();
+    }
+    elite_status_t status = dashboardCall(dashboard, "connect", [&](DashboardClient& client) {
+        return port > 0 ? client.connect(ip, port) : client.connect(ip);
+    });
+    if (status == ELITE_ERR_FAILED) {
+        return fail(ELITE_ERR_SOCKET, "dashboard connect failed");
+    }
+    return status;
+}
+
+void elite_dashboard_disconnect(elite_dashboard_t* dashboard) {
+    if (dashboard) {
+        guard([&]() {
+            dashboard->dashboard.disconnect();
+            return ELITE_OK;
+        });
+    }
+}
+
+elite_status_t elite_dashboard_echo(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "echo", [](DashboardClient& client) { return client.echo(); });
+}
+
+elite_status_t elite_dashboard_power_on(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "powerOn", [](DashboardClient& client) { return client.powerOn(); });
+}
+
+elite_status_t elite_dashboard_power_off(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "powerOff", [](DashboardClient& client) { return client.powerOff(); });
+}
+
+elite_status_t elite_dashboard_brake_release(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "brakeRelease", [](DashboardClient& client) { return client.brakeRelease(); });
+}
+
+elite_status_t elite_dashboard_close_safety_dialog(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "closeSafetyDialog", [](DashboardClient& client) { return client.closeSafetyDialog(); });
+}
+
+elite_status_t elite_dashboard_unlock_protective_stop(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "unlockProtectiveStop", [](DashboardClient& client) { return client.unlockProtectiveStop(); });
+}
+
+elite_status_t elite_dashboard_safety_system_restart(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "safetySystemRestart", [](DashboardClient& client) { return client.safetySystemRestart(); });
+}
+
+elite_status_t elite_dashboard_play_program(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "playProgram", [](DashboardClient& client) { return client.playProgram(); });
+}
+
+elite_status_t elite_dashboard_pause_program(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "pauseProgram", [](DashboardClient& client) { return client.pauseProgram(); });
+}
+
+elite_status_t elite_dashboard_stop_program(elite_dashboard_t* dashboard) {
+    return dashboardCall(dashboard, "stopProgram", [](DashboardClient& client) { return client.stopProgram(); });
+}
+
+elite_status_t elite_dashboard_load_task(elite_dashboard_t* dashboard, const char* path) {
+    if (!path) {
+        return nullArgument();
+    }
+    return dashboardCall(dashboard, "loadTask", [&](DashboardClient& client) { return client.loadTask(path); });
+}
+
+elite_status_t elite_dashboard_set_speed_scaling(elite_dashboard_t* dashboard, int32_t scaling) {
+    return dashboardCall(dashboard, "setSpeedScaling", [&](DashboardClient& client) { return client.setSpeedScaling(scaling); });
+}
+
+elite_status_t elite_dashboard_robot_mode(elite_dashboard_t* dashboard, int32_t* mode) {
+    return dashboardQuery(dashboard, mode, &DashboardClient::robotMode);
+}
+
+elite_status_t elite_dashboard_safety_mode(elite_dashboard_t* dashboard, int32_t* mode) {
+    return dashboardQuery(dashboard, mode, &DashboardClient::safetyMode);
+}
+
+elite_status_t elite_dashboard_task_status(elite_dashboard_t* dashboard, int32_t* status) {
+    return dashboardQuery(dashboard, status, &DashboardClient::getTaskStatus);
+}
+
+elite_status_t elite_dashboard_send_and_receive(elite_dashboard_t* dashboard, const char* command, char* reply,
+                                                size_t reply_size) {
+    if (!dashboard || !command || !reply || reply_size == 0) {
+        return nullArgument();
+    }
+    reply[0] = '\0';
+    return guard([&]() {
+        std::string answer = dashboard->dashboard.sendAndReceive(command);
+        size_t length = std::min(answer.size(), reply_size - 1);
+        std::memcpy(reply, answer.data(), length);
+        reply[length] = '\0';
+        if (length < answer.size()) {
+            return fail(ELITE_ERR_BUFFER_TOO_SMALL, "the reply is truncated");
+        }
+        return result(true, "");
+    });
+}
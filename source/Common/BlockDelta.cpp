@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "Common/BlockDelta.hpp"
+
+#include <boost/uuid/detail/md5.hpp>
+#include <boost/version.hpp>
+#include <cstring>
+#include <unordered_map>
+
+namespace ELITE {
+
+namespace DELTA {
+
+void RollingHash::reset(const uint8_t* data, size_t length) {
+    a_ = 0;
+    b_ = 0;
+    length_ = length;
+    for (size_t i = 0; i < length; i++) {
+        a_ += data[i];
+        b_ += (uint32_t)(length - i) * data[i];
+    }
+}
+
+uint64_t strongHash(const uint8_t* data, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+namespace {
+
+const char HEX[] = "0123456789abcdef";
+
+void appendHex(std::string& hex, uint8_t byte) {
+    hex += HEX[byte >> 4];
+    hex += HEX[byte & 0xf];
+}
+
+#if BOOST_VERSION >= 108600
+// Boost 1.86 and later returns the 16 bytes in order
+void appendDigest(std::string& hex, const unsigned char (&digest)[16]) {
+    for (int i = 0; i < 16; i++) {
+        appendHex(hex, digest[i]);
+    }
+}
+#else
+// Boost before 1.86 returns four big-endian words
+void appendDigest(std::string& hex, const unsigned int (&digest)[4]) {
+    for (int i = 0; i < 4; i++) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            appendHex(hex, (digest[i] >> shift) & 0xff);
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+std::string md5Hex(const uint8_t* data, size_t length) {
+    using Md5 = boost::uuids::detail::md5;
+    static_assert(sizeof(Md5::digest_type) == 16, "unexpected boost md5 digest layout");
+    Md5 md5;
+    md5.process_bytes(data, length);
+    Md5::digest_type digest;
+    md5.get_digest(digest);
+    // Any other digest layout does not compile
+    std::string hex;
+    appendDigest(hex, digest);
+    return hex;
+}
+
+std::vector<BlockSignature> signatures(const uint8_t* data, size_t size, size_t block_size) {
+    std::vector<BlockSignature> result;
+    if (block_size == 0) {
+        return result;
+    }
+    RollingHash hash;
+    for (size_t offset = 0; offset + block_size <= size; offset += block_size) {
+        hash.reset(data + offset, block_size);
+        result.push_back({hash.value(), strongHash(data + offset, block_size)});
+    }
+    return result;
+}
+
+namespace {
+
+void addCopy(Delta& delta, uint64_t offset, uint64_t length) {
+    delta.copied += length;
+    if (!delta.ops.empty()) {
+        DeltaOp& last = delta.ops.back();
+        if (last.type == DeltaOp::COPY && last.offset + last.length == offset) {
+            last.length += length;
+            return;
+        }
+    }
+    delta.ops.push_back({DeltaOp::COPY, offset, length});
+}
+
+void addLiteral(Delta& delta, const uint8_t* data, uint64_t length) {
+    if (length == 0) {
+        return;
+    }
+    delta.ops.push_back({DeltaOp::LITERAL, delta.literals.size(), length});
+    delta.literals.insert(delta.literals.end(), data, data + length);
+}
+
+}  // namespace
+
+Delta computeDelta(const std::vector<BlockSignature>& old_signatures, size_t block_size, const uint8_t* data, size_t size) {
+    Delta delta;
+    delta.block_size = block_size;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> blocks;
+    for (uint32_t i = 0; i < old_signatures.size(); i++) {
+        blocks[old_signatures[i].weak].push_back(i);
+    }
+
+    size_t literal_start = 0;
+    size_t position = 0;
+    // The block after the last match, most likely the next match
+    uint32_t next_block = 0;
+    RollingHash hash;
+    if (block_size > 0 && size >= block_size && !blocks.empty()) {
+        hash.reset(data, block_size);
+        while (true) {
+            auto found = blocks.find(hash.value());
+            int64_t match = -1;
+            if (found != blocks.end()) {
+                uint64_t strong = strongHash(data + position, block_size);
+                for (uint32_t block : found->second) {
+                    if (old_signatures[block].strong == strong && (match < 0 || block == next_block)) {
+                        match = block;
+                    }
+                }
+            }
+            if (match >= 0) {
+                addLiteral(delta, data + literal_start, position - literal_start);
+                addCopy(delta, (uint64_t)match * block_size, block_size);
+                next_block = match + 1;
+                position += block_size;
+                literal_start = position;
+                if (position + block_size > size) {
+                    break;
+                }
+                hash.reset(data + position, block_size);
+                continue;
+            }
+            if (position + block_size >= size) {
+                break;
+            }
+            hash.roll(data[position], data[position + block_size]);
+            position++;
+        }
+    }
+    addLiteral(delta, data + literal_start, size - literal_start);
+    return delta;
+}
+
+std::vector<uint8_t> applyDelta(const uint8_t* old_data, size_t old_size, const Delta& delta) {
+    std::vector<uint8_t> result;
+    for (const DeltaOp& op : delta.ops) {
+        if (op.type == DeltaOp::COPY) {
+            if (op.offset + op.length > old_size) {
+                return std::vector<uint8_t>();
+            }
+            result.insert(result.end(), old_data + op.offset, old_data + op.offset + op.length);
+        } else {
+            result.insert(result.end(), delta.literals.begin() + op.offset, delta.literals.begin() + op.offset + op.length);
+        }
+    }
+    return result;
+}
+
+std::string patchScript(const Delta& delta, const std::string& old_path, const std::string& literal_path,
+                        const std::string& new_path) {
+    std::string script = "set -e\n{\n";
+    for (const DeltaOp& op : delta.ops) {
+        if (op.type == DeltaOp::COPY) {
+            script += "dd if='" + old_path + "' bs=" + std::to_string(delta.block_size) +
+                      " skip=" + std::to_string(op.offset / delta.block_size) +
+                      " count=" + std::to_string(op.length / delta.block_size) + " 2>/dev/null\n";
+        } else {
+            script += "tail -c +" + std::to_string(op.offset + 1) + " '" + literal_path + "' | head -c " +
+                      std::to_string(op.length) + "\n";
+        }
+    }
+    script += "} > '" + new_path + "'\n";
+    return script;
+}
+
+}  // namespace DELTA
+
+}  // namespace ELITE
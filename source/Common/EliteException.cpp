@@ -23,6 +23,8 @@ const char* EliteException::exceptionCodeToString(const Code& ec) {
         return "dashboard not expect recive";
     case Code::TCP_SERVER_CONTEXT_NULL:
         return "tcp server io_context is nullptr";
+    case Code::SOCKET_TIMEOUT:
+        return "socket timeout";
     default:
         return "unknow code";
     }
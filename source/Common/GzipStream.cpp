@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "Common/GzipStream.hpp"
+
+#ifdef ELITE_USE_ZLIB
+
+#include <cstring>
+
+namespace ELITE {
+
+// Decompress 256 KB at a time.
+static constexpr size_t OUTPUT_CHUNK_SIZE = 262144;
+
+GzipInflater::GzipInflater()
+    : initialized_(false), finished_(false), compressed_(0), uncompressed_(0), buffer_(OUTPUT_CHUNK_SIZE) {
+    std::memset(&stream_, 0, sizeof(stream_));
+    // 16 + MAX_WBITS: gzip header and trailer
+    initialized_ = inflateInit2(&stream_, 16 + MAX_WBITS) == Z_OK;
+}
+
+GzipInflater::~GzipInflater() {
+    if (initialized_) {
+        inflateEnd(&stream_);
+    }
+}
+
+bool GzipInflater::feed(const char* data, size_t size, const OutputCallback& output) {
+    if (!initialized_) {
+        return false;
+    }
+    compressed_ += size;
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream_.avail_in = static_cast<uInt>(size);
+    while (stream_.avail_in > 0) {
+        if (finished_) {
+            // The next member
+            if (inflateReset(&stream_) != Z_OK) {
+                return false;
+            }
+            finished_ = false;
+        }
+        stream_.next_out = reinterpret_cast<Bytef*>(buffer_.data());
+        stream_.avail_out = static_cast<uInt>(buffer_.size());
+        int ret = inflate(&stream_, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            return false;
+        }
+        size_t produced = buffer_.size() - stream_.avail_out;
+        uncompressed_ += produced;
+        if (produced > 0 && !output(buffer_.data(), produced)) {
+            return false;
+        }
+        if (ret == Z_STREAM_END) {
+            finished_ = true;
+        } else if (ret == Z_BUF_ERROR && produced == 0) {
+            // No progress, wait for more input
+            break;
+        }
+    }
+    return true;
+}
+
+}  // namespace ELITE
+
+#endif  // ELITE_USE_ZLIB
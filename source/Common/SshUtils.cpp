@@ -12,6 +12,7 @@
 #include <vector>
 
 #if defined(__linux) || defined(linux) || defined(__linux__)
+#include <signal.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #elif defined(_WIN32) || defined(_WIN64)
@@ -150,6 +151,117 @@ std::string executeCommand(const std::string& host, const std::string& user, con
 #endif
 }
 
+bool executeCommandStream(const std::string& host, const std::string& user, const std::string& password, const std::string& cmd,
+                          std::function<bool(const char* data, size_t size)> output_cb) {
+#ifdef ELITE_USE_LIB_SSH
+    ssh_session session = ssh_new();
+    if (!session) {
+        ELITE_LOG_ERROR("Failed to create SSH session");
+        return false;
+    }
+
+    ssh_options_set(session, SSH_OPTIONS_HOST, host.c_str());
+    ssh_options_set(session, SSH_OPTIONS_USER, user.c_str());
+
+    if (ssh_connect(session) != SSH_OK) {
+        ELITE_LOG_ERROR("SSH connection failed: %s", ssh_get_error(session));
+        ssh_free(session);
+        return false;
+    }
+
+    if (ssh_userauth_password(session, nullptr, password.c_str()) != SSH_AUTH_SUCCESS) {
+        ELITE_LOG_ERROR("Authentication failed: %s", ssh_get_error(session));
+        ssh_disconnect(session);
+        ssh_free(session);
+        return false;
+    }
+
+    ssh_channel channel = ssh_channel_new(session);
+    if (!channel) {
+        ELITE_LOG_ERROR("Failed to create SSH channel");
+        ssh_disconnect(session);
+        ssh_free(session);
+        return false;
+    }
+
+    if (ssh_channel_open_session(channel) != SSH_OK || ssh_channel_request_exec(channel, cmd.c_str()) != SSH_OK) {
+        ELITE_LOG_ERROR("Failed to execute command \"%s\": %s", cmd.c_str(), ssh_get_error(session));
+        ssh_channel_free(channel);
+        ssh_disconnect(session);
+        ssh_free(session);
+        return false;
+    }
+
+    std::vector<char> buffer(65536);
+    int nbytes;
+    bool completed = true;
+    while ((nbytes = ssh_channel_read(channel, buffer.data(), buffer.size(), 0)) > 0) {
+        if (!output_cb(buffer.data(), nbytes)) {
+            completed = false;
+            break;
+        }
+    }
+    if (nbytes == SSH_ERROR) {
+        ELITE_LOG_ERROR("Read command \"%s\" output fail: %s", cmd.c_str(), ssh_get_error(session));
+        completed = false;
+    }
+
+    ssh_channel_send_eof(channel);
+    ssh_channel_close(channel);
+    int status = completed ? ssh_channel_get_exit_status(channel) : -1;
+    ssh_channel_free(channel);
+    ssh_disconnect(session);
+    ssh_free(session);
+    return completed && status == 0;
+#else
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    int pipefd[2];
+    if (pipe(pipefd) == -1) {
+        char buf[256] = {0};
+        ELITE_LOG_ERROR("Execute cmd \"%s\" fail: %s", cmd.c_str(), strerror_r(errno, buf, sizeof(buf)));
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        char buf[256] = {0};
+        ELITE_LOG_ERROR("Execute cmd \"%s\" fail: %s", cmd.c_str(), strerror_r(errno, buf, sizeof(buf)));
+        close(pipefd[0]);
+        close(pipefd[1]);
+        return false;
+    }
+
+    if (pid == 0) {  // child process
+        close(pipefd[0]);
+        dup2(pipefd[1], STDOUT_FILENO);
+        close(pipefd[1]);
+        execlp("sshpass", "sshpass", "-p", password.c_str(), "ssh", "-o", "StrictHostKeyChecking=no", (user + "@" + host).c_str(),
+               cmd.c_str(), nullptr);
+        exit(1);
+    } else {
+        close(pipefd[1]);
+        std::vector<char> buffer(65536);
+        ssize_t bytes_read;
+        bool completed = true;
+        while ((bytes_read = read(pipefd[0], buffer.data(), buffer.size())) > 0) {
+            if (!output_cb(buffer.data(), bytes_read)) {
+                completed = false;
+                kill(pid, SIGTERM);
+                break;
+            }
+        }
+        close(pipefd[0]);
+        int status;
+        waitpid(pid, &status, 0);
+        return completed && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#else
+    (void)output_cb;
+    return false;
+#endif
+#endif
+}
+
 static bool scpCommand(const std::string& password, const std::string& path1, const std::string& path2) {
 #if defined(__linux) || defined(linux) || defined(__linux__)
     pid_t pid = fork();
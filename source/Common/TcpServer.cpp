@@ -1,15 +1,38 @@
 // SPDX-License-Identifier: MIT
 // Copyright (c) 2025, Elite Robots.
 #include "TcpServer.hpp"
+#include <cstdlib>
 #include <iostream>
 #include "Common/RtUtils.hpp"
+#include "Common/StringUtils.hpp"
 #include "EliteException.hpp"
 #include "Log.hpp"
+#include "Trace.hpp"
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 namespace ELITE {
 
 TcpServer::TcpServer(int port, int recv_buf_size, std::shared_ptr<StaticResource> resource) : read_buffer_(recv_buf_size) {
     resource_ = resource;
+    int listen_fd = resource_->takeListenSocket(port);
+    if (listen_fd >= 0) {
+        // The socket kept listening while no process accepted, the connections of the robot wait in its backlog.
+        try {
+            acceptor_ = std::make_unique<boost::asio::ip::tcp::acceptor>(*(resource_->io_context_ptr_));
+            acceptor_->assign(boost::asio::ip::tcp::v4(), listen_fd);
+        } catch (const boost::system::system_error& error) {
+            ELITE_LOG_FATAL("TCP server on port %d take over listening socket %d fail: %s", port, listen_fd, error.what());
+            throw EliteException(EliteException::Code::SOCKET_FAIL, error.what());
+        }
+        ELITE_LOG_INFO("TCP port %d takes over listening socket %d", port, listen_fd);
+        return;
+    }
     try {
         acceptor_ = std::make_unique<boost::asio::ip::tcp::acceptor>(
             *(resource_->io_context_ptr_), boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port), true);
@@ -21,6 +44,7 @@ TcpServer::TcpServer(int port, int recv_buf_size, std::shared_ptr<StaticResource
 }
 
 TcpServer::~TcpServer() {
+    connected_ = false;
     std::lock_guard<std::mutex> lock(socket_mutex_);
     if (acceptor_ && acceptor_->is_open()) {
         boost::system::error_code ec;
@@ -45,6 +69,26 @@ void TcpServer::unsetReceiveCallback() {
     receive_cb_ = nullptr; 
 }
 
+void TcpServer::setConnectionCallback(ConnectionCallback cb) {
+    std::lock_guard<std::mutex> lock(connection_cb_mutex_);
+    connection_cb_ = std::move(cb);
+}
+
+void TcpServer::updateConnectionState(bool connected) {
+    if (connected_.exchange(connected, std::memory_order_acq_rel) == connected) {
+        return;
+    }
+    auto timestamp = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(connection_cb_mutex_);
+    if (connection_cb_) {
+        try {
+            connection_cb_(connected, timestamp);
+        } catch (const std::exception& e) {
+            ELITE_LOG_ERROR("TCP port %d connection callback exception: %s", local_endpoint_.port(), e.what());
+        }
+    }
+}
+
 void TcpServer::startListen() { doAccept(); }
 
 void TcpServer::doAccept() {
@@ -56,12 +100,15 @@ void TcpServer::doAccept() {
     std::weak_ptr<TcpServer> weak_self = shared_from_this();
     // Accept call back
     auto accept_cb = [weak_self, new_socket](boost::system::error_code ec) {
+        ELITE_TRACE_SCOPE("tcp.accept");
         boost::system::error_code ignore_ec;
         if (auto self = weak_self.lock()) {
             if (!ec) {
-                std::lock_guard<std::mutex> lock(self->socket_mutex_);
+                std::unique_lock<std::mutex> lock(self->socket_mutex_);
+                bool replace_old = false;
                 // Close old connection
                 if (self->socket_ && self->socket_->is_open()) {
+                    replace_old = true;
                     auto local_point = self->socket_->local_endpoint(ignore_ec);
                     auto remote_point = self->socket_->remote_endpoint(ignore_ec);
                     self->closeSocket(self->socket_, ignore_ec);
@@ -74,8 +121,8 @@ void TcpServer::doAccept() {
                 new_socket->set_option(boost::asio::ip::tcp::no_delay(true), ignore_ec);
                 new_socket->set_option(boost::asio::socket_base::keep_alive(true), ignore_ec);
 #if defined(__linux) || defined(linux) || defined(__linux__)
-                new_socket->set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true));
-                new_socket->set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_PRIORITY>(6));
+                new_socket->set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), ignore_ec);
+                new_socket->set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_PRIORITY>(6), ignore_ec);
 #endif
                 // Update alive socket
                 self->socket_ = new_socket;
@@ -95,8 +142,13 @@ void TcpServer::doAccept() {
                                boost::system::system_error(ec).what());
                 // Start async read
                 self->doRead(new_socket);
+                lock.unlock();
+                if (replace_old) {
+                    self->updateConnectionState(false);
+                }
+                self->updateConnectionState(true);
             } else {
-                std::lock_guard<std::mutex> lock(self->socket_mutex_);
+                std::unique_lock<std::mutex> lock(self->socket_mutex_);
                 // Close old connection
                 if (self->socket_ && self->socket_->is_open()) {
                     auto local_point = self->socket_->local_endpoint(ignore_ec);
@@ -108,6 +160,8 @@ void TcpServer::doAccept() {
                                     boost::system::system_error(ignore_ec).what());
                 }
                 self->socket_.reset();
+                lock.unlock();
+                self->updateConnectionState(false);
             }
             self->doAccept();
         }
@@ -121,6 +175,7 @@ void TcpServer::doRead(std::shared_ptr<boost::asio::ip::tcp::socket> sock) {
     auto read_cb = [weak_self, sock](boost::system::error_code ec, std::size_t n) {
         if (auto self = weak_self.lock()) {
             if (!ec) {
+                ELITE_TRACE_SCOPE("tcp.receive");
                 self->callReceiveCallback(self->read_buffer_.data(), n);
                 // Continue read
                 self->doRead(sock);
@@ -132,6 +187,15 @@ void TcpServer::doRead(std::shared_ptr<boost::asio::ip::tcp::socket> sock) {
                                    self->remote_endpoint_.address().to_string().c_str(), self->remote_endpoint_.port(),
                                    boost::system::system_error(ignore_ec).what(), boost::system::system_error(ec).what());
                 }
+                bool is_current = false;
+                {
+                    std::lock_guard<std::mutex> lock(self->socket_mutex_);
+                    is_current = self->socket_ == sock;
+                }
+                // A socket replaced by a new connection was reported when it was replaced
+                if (is_current) {
+                    self->updateConnectionState(false);
+                }
             }
         }
     };
@@ -139,6 +203,7 @@ void TcpServer::doRead(std::shared_ptr<boost::asio::ip::tcp::socket> sock) {
 }
 
 int TcpServer::writeClient(void* data, int size) {
+    ELITE_TRACE_SCOPE("tcp.write");
     std::lock_guard<std::mutex> lock(socket_mutex_);
     if (socket_) {
         try {
@@ -157,14 +222,6 @@ int TcpServer::writeClient(void* data, int size) {
     return -1;
 }
 
-bool TcpServer::isClientConnected() {
-    std::lock_guard<std::mutex> lock(socket_mutex_);
-    if (socket_) {
-        return socket_->is_open();
-    }
-    return false;
-}
-
 void TcpServer::closeSocket(std::shared_ptr<boost::asio::ip::tcp::socket> sock, boost::system::error_code& ec) {
     if (sock->is_open()) {
         sock->cancel(ec);
@@ -176,7 +233,12 @@ void TcpServer::closeSocket(std::shared_ptr<boost::asio::ip::tcp::socket> sock,
 void TcpServer::callReceiveCallback(const uint8_t data[], int size) {
     std::lock_guard<std::mutex> lock(receive_cb_mutex_);
     if (receive_cb_) {
-        receive_cb_(data, size);
+        // The handler runs in the io_context thread shared by all servers, an exception must not unwind through it.
+        try {
+            receive_cb_(data, size);
+        } catch (const std::exception& e) {
+            ELITE_LOG_ERROR("TCP port %d receive callback exception: %s", local_endpoint_.port(), e.what());
+        }
     }
 }
 
@@ -191,6 +253,7 @@ TcpServer::StaticResource::StaticResource() {
         boost::asio::make_work_guard(*io_context_ptr_)));
     auto io_ctx = io_context_ptr_;
     server_thread_.reset(new std::thread([io_ctx]() {
+        TRACE::setThreadName("tcp_server");
         try {
             if (io_ctx->stopped()) {
                 io_ctx->restart();
@@ -229,4 +292,101 @@ TcpServer::StaticResource::~StaticResource() {
     shutdown();
 }
 
+#if defined(__linux) || defined(linux) || defined(__linux__)
+// The port a listening IPv4 TCP socket is bound to, -1 if the descriptor is not one
+static int listeningSocketPort(int fd) {
+    int type = 0;
+    int accept_conn = 0;
+    socklen_t opt_len = sizeof(int);
+    if (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &opt_len) != 0 || type != SOCK_STREAM) {
+        ELITE_LOG_WARN("Descriptor %d is not a TCP socket, ignored", fd);
+        return -1;
+    }
+    opt_len = sizeof(int);
+    if (getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &accept_conn, &opt_len) != 0 || !accept_conn) {
+        ELITE_LOG_WARN("Socket %d is not listening, ignored", fd);
+        return -1;
+    }
+    sockaddr_in addr{};
+    socklen_t addr_len = sizeof(addr);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0 || addr.sin_family != AF_INET) {
+        ELITE_LOG_WARN("Socket %d is not an IPv4 socket, ignored", fd);
+        return -1;
+    }
+    return ntohs(addr.sin_port);
+}
+#endif
+
+int TcpServer::StaticResource::addListenSockets(const std::vector<int>& fds) {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    int count = 0;
+    std::lock_guard<std::mutex> lock(listen_fds_mutex_);
+    for (int fd : fds) {
+        int port = listeningSocketPort(fd);
+        if (port < 0) {
+            continue;
+        }
+        listen_fds_[port] = fd;
+        count++;
+    }
+    return count;
+#else
+    if (!fds.empty()) {
+        ELITE_LOG_WARN("Taking over listening sockets is only supported on Linux");
+    }
+    return 0;
+#endif
+}
+
+bool TcpServer::StaticResource::addListenSocket(int fd, int port) {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    if (listeningSocketPort(fd) < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(listen_fds_mutex_);
+    listen_fds_[port] = fd;
+    return true;
+#else
+    ELITE_LOG_WARN("Taking over listening sockets is only supported on Linux");
+    return false;
+#endif
+}
+
+int TcpServer::StaticResource::takeListenSocket(int port) {
+    std::lock_guard<std::mutex> lock(listen_fds_mutex_);
+    auto iter = listen_fds_.find(port);
+    if (iter == listen_fds_.end()) {
+        return -1;
+    }
+    int fd = iter->second;
+    listen_fds_.erase(iter);
+    return fd;
+}
+
+std::vector<TcpServer::ActivationSocket> TcpServer::activationListenSockets() {
+    std::vector<ActivationSocket> sockets;
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    // The first descriptor passed by systemd is SD_LISTEN_FDS_START
+    constexpr int LISTEN_FDS_START = 3;
+    const char* listen_pid = std::getenv("LISTEN_PID");
+    const char* listen_fds = std::getenv("LISTEN_FDS");
+    if (!listen_pid || !listen_fds || std::atol(listen_pid) != (long)getpid()) {
+        return sockets;
+    }
+    // Colon separated, in the order of the descriptors
+    const char* listen_fdnames = std::getenv("LISTEN_FDNAMES");
+    std::vector<std::string> names;
+    if (listen_fdnames) {
+        names = StringUtils::splitString(listen_fdnames, ":");
+    }
+    int count = std::atoi(listen_fds);
+    for (int i = 0; i < count; i++) {
+        int fd = LISTEN_FDS_START + i;
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        sockets.push_back({fd, i < (int)names.size() ? names[i] : std::string()});
+    }
+#endif
+    return sockets;
+}
+
 }  // namespace ELITE
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "Dynamics.hpp"
+
+#include <cmath>
+
+using namespace ELITE;
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+Vec3 add(const Vec3& a, const Vec3& b) { return {a[0] + b[0], a[1] + b[1], a[2] + b[2]}; }
+
+// The rotation of frame i in frame i - 1 is Rz(q) Rx(alpha), stored as cos/sin pairs
+struct Rotation {
+    double cq, sq, ca, sa;
+
+    // R v
+    Vec3 apply(const Vec3& v) const {
+        double y = ca * v[1] - sa * v[2];
+        return {cq * v[0] - sq * y, sq * v[0] + cq * y, sa * v[1] + ca * v[2]};
+    }
+
+    // R^T v
+    Vec3 applyTransposed(const Vec3& v) const {
+        double x = cq * v[0] + sq * v[1];
+        double y = -sq * v[0] + cq * v[1];
+        return {x, ca * y + sa * v[2], -sa * y + ca * v[2]};
+    }
+};
+
+// I v, with I = Ixx, Iyy, Izz, Ixy, Ixz, Iyz
+Vec3 inertiaTimes(const vector6d_t& i, const Vec3& v) {
+    return {i[0] * v[0] + i[3] * v[1] + i[4] * v[2], i[3] * v[0] + i[1] * v[1] + i[5] * v[2],
+            i[4] * v[0] + i[5] * v[1] + i[2] * v[2]};
+}
+
+}  // namespace
+
+Dynamics::Dynamics(const Kinematics& kinematics, const std::array<LinkInertia, 6>& links, const vector3d_t& gravity)
+    : kinematics_(kinematics), links_(links), payload_mass_(0), payload_cog_{}, gravity_(gravity) {
+    updateFlange();
+}
+
+void Dynamics::setPayload(double mass, const vector3d_t& cog) {
+    payload_mass_ = mass;
+    payload_cog_ = cog;
+    updateFlange();
+}
+
+void Dynamics::updateFlange() {
+    const LinkInertia& link = links_[5];
+    flange_ = link;
+    double mass = link.mass + payload_mass_;
+    if (payload_mass_ <= 0 || mass <= 0) {
+        return;
+    }
+    flange_.mass = mass;
+    for (int i = 0; i < 3; i++) {
+        flange_.com[i] = (link.mass * link.com[i] + payload_mass_ * payload_cog_[i]) / mass;
+    }
+    // Move both inertias to the common center of mass, the payload is a point mass
+    auto parallelAxis = [this](double m, const vector3d_t& p) {
+        Vec3 d{p[0] - flange_.com[0], p[1] - flange_.com[1], p[2] - flange_.com[2]};
+        flange_.inertia[0] += m * (d[1] * d[1] + d[2] * d[2]);
+        flange_.inertia[1] += m * (d[0] * d[0] + d[2] * d[2]);
+        flange_.inertia[2] += m * (d[0] * d[0] + d[1] * d[1]);
+        flange_.inertia[3] -= m * d[0] * d[1];
+        flange_.inertia[4] -= m * d[0] * d[2];
+        flange_.inertia[5] -= m * d[1] * d[2];
+    };
+    parallelAxis(link.mass, link.com);
+    parallelAxis(payload_mass_, payload_cog_);
+}
+
+void Dynamics::inverseDynamics(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& qdd, vector6d_t& torques) const {
+    const vector6d_t& a = kinematics_.dhA();
+    const vector6d_t& d = kinematics_.dhD();
+    const vector6d_t& alpha = kinematics_.dhAlpha();
+
+    Rotation rotations[6];
+    // Origin of frame i from the origin of frame i - 1, in frame i
+    Vec3 offsets[6];
+    Vec3 forces[6];
+    Vec3 moments[6];
+
+    // Forward: the velocities and accelerations of the links, in their frames. The base accelerates against the gravity.
+    Vec3 w{0, 0, 0};
+    Vec3 wd{0, 0, 0};
+    Vec3 vd{-gravity_[0], -gravity_[1], -gravity_[2]};
+    for (int i = 0; i < 6; i++) {
+        Rotation& r = rotations[i];
+        r = {std::cos(q[i]), std::sin(q[i]), std::cos(alpha[i]), std::sin(alpha[i])};
+        offsets[i] = {a[i], d[i] * r.sa, d[i] * r.ca};
+        const Vec3& p = offsets[i];
+
+        Vec3 w_prev = w;
+        w = r.applyTransposed({w_prev[0], w_prev[1], w_prev[2] + qd[i]});
+        // w_prev x (z qd)
+        wd = r.applyTransposed({wd[0] + w_prev[1] * qd[i], wd[1] - w_prev[0] * qd[i], wd[2] + qdd[i]});
+        vd = add(add(cross(wd, p), cross(w, cross(w, p))), r.applyTransposed(vd));
+
+        const LinkInertia& link = i == 5 ? flange_ : links_[i];
+        Vec3 vc = add(add(cross(wd, link.com), cross(w, cross(w, link.com))), vd);
+        forces[i] = {link.mass * vc[0], link.mass * vc[1], link.mass * vc[2]};
+        moments[i] = add(inertiaTimes(link.inertia, wd), cross(w, inertiaTimes(link.inertia, w)));
+    }
+
+    // Backward: the force and the moment about the joint axis which the previous link applies, in the link frame
+    Vec3 f{0, 0, 0};
+    Vec3 n{0, 0, 0};
+    for (int i = 5; i >= 0; i--) {
+        Vec3 f_next{0, 0, 0};
+        Vec3 n_next{0, 0, 0};
+        if (i < 5) {
+            f_next = rotations[i + 1].apply(f);
+            n_next = rotations[i + 1].apply(n);
+        }
+        const LinkInertia& link = i == 5 ? flange_ : links_[i];
+        const Vec3& p = offsets[i];
+        n = add(add(n_next, cross(p, f_next)), add(cross(add(p, link.com), forces[i]), moments[i]));
+        f = add(f_next, forces[i]);
+        // The joint axis z of frame i - 1 is [0, sin(alpha), cos(alpha)] in frame i
+        torques[i] = n[1] * rotations[i].sa + n[2] * rotations[i].ca;
+    }
+}
+
+vector6d_t Dynamics::gravityTorques(const vector6d_t& q) const {
+    vector6d_t torques;
+    inverseDynamics(q, vector6d_t{}, vector6d_t{}, torques);
+    return torques;
+}
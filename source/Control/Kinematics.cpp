@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "Kinematics.hpp"
+#include "KinematicsInternal.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace ELITE;
+using namespace ELITE::KINEMATICS;
+
+Kinematics::Kinematics() : dh_a_{}, dh_d_{}, dh_alpha_{}, tcp_offset_{}, tcp_(identity()) {}
+
+Kinematics::Kinematics(const vector6d_t& dh_a, const vector6d_t& dh_d, const vector6d_t& dh_alpha)
+    : dh_a_(dh_a), dh_d_(dh_d), dh_alpha_(dh_alpha), tcp_offset_{}, tcp_(identity()) {}
+
+Kinematics::Kinematics(const KinematicsInfo& info) : Kinematics(info.dh_a_, info.dh_d_, info.dh_alpha_) {}
+
+void Kinematics::setTcpOffset(const vector6d_t& tcp_offset) {
+    tcp_offset_ = tcp_offset;
+    auto rotation = rotationMatrix({tcp_offset[3], tcp_offset[4], tcp_offset[5]});
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            tcp_[row * 4 + col] = rotation[row * 3 + col];
+        }
+        tcp_[row * 4 + 3] = tcp_offset[row];
+    }
+}
+
+const vector6d_t& Kinematics::dhA() const { return dh_a_; }
+
+const vector6d_t& Kinematics::dhD() const { return dh_d_; }
+
+const vector6d_t& Kinematics::dhAlpha() const { return dh_alpha_; }
+
+const vector6d_t& Kinematics::tcpOffset() const { return tcp_offset_; }
+
+void Kinematics::chain(const vector6d_t& q, std::array<std::array<double, 12>, 7>& frames) const {
+    frames[0] = identity();
+    for (int i = 0; i < 6; i++) {
+        frames[i + 1] = multiply(frames[i], dhTransform(q[i], dh_a_[i], dh_d_[i], dh_alpha_[i]));
+    }
+}
+
+vector6d_t Kinematics::forward(const vector6d_t& q) const {
+    std::array<Transform, 7> frames;
+    chain(q, frames);
+    Transform tcp = multiply(frames[6], tcp_);
+    std::array<double, 9> rotation{tcp[0], tcp[1], tcp[2], tcp[4], tcp[5], tcp[6], tcp[8], tcp[9], tcp[10]};
+    vector3d_t rv = rotationVector(rotation);
+    return vector6d_t{tcp[3], tcp[7], tcp[11], rv[0], rv[1], rv[2]};
+}
+
+void Kinematics::jacobian(const vector6d_t& q, matrix6d_t& jacobian) const {
+    std::array<Transform, 7> frames;
+    chain(q, frames);
+    Transform tcp = multiply(frames[6], tcp_);
+    jacobianOf(frames.data(), tcp, jacobian);
+}
+
+double Kinematics::manipulability(const matrix6d_t& jacobian) {
+    // Determinant by Gaussian elimination with partial pivoting
+    matrix6d_t m = jacobian;
+    double det = 1;
+    for (int col = 0; col < 6; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 6; row++) {
+            if (std::abs(m[row][col]) > std::abs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (m[pivot][col] == 0) {
+            return 0;
+        }
+        if (pivot != col) {
+            std::swap(m[pivot], m[col]);
+            det = -det;
+        }
+        det *= m[col][col];
+        for (int row = col + 1; row < 6; row++) {
+            double factor = m[row][col] / m[col][col];
+            for (int k = col; k < 6; k++) {
+                m[row][k] -= factor * m[col][k];
+            }
+        }
+    }
+    return std::abs(det);
+}
+
+bool Kinematics::dampedLeastSquares(const matrix6d_t& jacobian, const vector6d_t& twist, double damping, vector6d_t& qd) {
+    // A = J J^T + damping^2 I, symmetric positive (semi)definite
+    matrix6d_t a;
+    for (int row = 0; row < 6; row++) {
+        for (int col = 0; col <= row; col++) {
+            double sum = 0;
+            for (int k = 0; k < 6; k++) {
+                sum += jacobian[row][k] * jacobian[col][k];
+            }
+            a[row][col] = sum;
+        }
+        a[row][row] += damping * damping;
+    }
+    // Cholesky A = L L^T, in the lower triangle of a
+    for (int col = 0; col < 6; col++) {
+        double diag = a[col][col];
+        for (int k = 0; k < col; k++) {
+            diag -= a[col][k] * a[col][k];
+        }
+        if (!(diag > 1e-15)) {
+            return false;
+        }
+        a[col][col] = std::sqrt(diag);
+        for (int row = col + 1; row < 6; row++) {
+            double sum = a[row][col];
+            for (int k = 0; k < col; k++) {
+                sum -= a[row][k] * a[col][k];
+            }
+            a[row][col] = sum / a[col][col];
+        }
+    }
+    // Solve L L^T y = twist
+    vector6d_t y;
+    for (int row = 0; row < 6; row++) {
+        double sum = twist[row];
+        for (int k = 0; k < row; k++) {
+            sum -= a[row][k] * y[k];
+        }
+        y[row] = sum / a[row][row];
+    }
+    for (int row = 6; row-- > 0;) {
+        double sum = y[row];
+        for (int k = row + 1; k < 6; k++) {
+            sum -= a[k][row] * y[k];
+        }
+        y[row] = sum / a[row][row];
+    }
+    // qd = J^T y
+    for (int i = 0; i < 6; i++) {
+        double sum = 0;
+        for (int k = 0; k < 6; k++) {
+            sum += jacobian[k][i] * y[k];
+        }
+        qd[i] = sum;
+    }
+    return true;
+}
+
+std::array<double, 9> Kinematics::rotationMatrix(const vector3d_t& rotation_vector) {
+    double angle = std::sqrt(rotation_vector[0] * rotation_vector[0] + rotation_vector[1] * rotation_vector[1] +
+                             rotation_vector[2] * rotation_vector[2]);
+    if (angle < 1e-12) {
+        return {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    }
+    double x = rotation_vector[0] / angle, y = rotation_vector[1] / angle, z = rotation_vector[2] / angle;
+    double c = std::cos(angle), s = std::sin(angle), t = 1 - c;
+    return {t * x * x + c,     t * x * y - s * z, t * x * z + s * y, t * x * y + s * z, t * y * y + c,
+            t * y * z - s * x, t * x * z - s * y, t * y * z + s * x, t * z * z + c};
+}
+
+vector3d_t Kinematics::rotationVector(const std::array<double, 9>& r) {
+    double cos_angle = std::min(std::max((r[0] + r[4] + r[8] - 1) / 2, -1.0), 1.0);
+    double angle = std::acos(cos_angle);
+    if (angle < 1e-9) {
+        return {0, 0, 0};
+    }
+    if (PI - angle > 1e-6) {
+        double scale = angle / (2 * std::sin(angle));
+        return {(r[7] - r[5]) * scale, (r[2] - r[6]) * scale, (r[3] - r[1]) * scale};
+    }
+    // Near pi the axis is taken from the diagonal, R = 2 n n^T - I
+    double x = std::sqrt(std::max((r[0] + 1) / 2, 0.0));
+    double y = std::sqrt(std::max((r[4] + 1) / 2, 0.0));
+    double z = std::sqrt(std::max((r[8] + 1) / 2, 0.0));
+    if (x >= y && x >= z) {
+        y = std::copysign(y, r[1] + r[3]);
+        z = std::copysign(z, r[2] + r[6]);
+    } else if (y >= z) {
+        x = std::copysign(x, r[1] + r[3]);
+        z = std::copysign(z, r[5] + r[7]);
+    } else {
+        x = std::copysign(x, r[2] + r[6]);
+        y = std::copysign(y, r[5] + r[7]);
+    }
+    return {x * angle, y * angle, z * angle};
+}
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "PayloadEstimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "KinematicsInternal.hpp"
+#include "RecursiveLeastSquares.hpp"
+
+using namespace ELITE;
+using namespace ELITE::KINEMATICS;
+
+namespace {
+
+constexpr int LINK_PARAMETERS = 4;
+constexpr int GRAVITY_PARAMETERS = 5 * LINK_PARAMETERS;
+constexpr int PAYLOAD_PARAMETERS = LINK_PARAMETERS;
+// Smoothing of the residual RMS
+constexpr double RESIDUAL_ALPHA = 0.01;
+
+using ArmRegressor = std::array<std::array<double, ArmGravityModel::PARAMETERS>, 6>;
+
+}  // namespace
+
+class PayloadEstimator::Impl {
+   public:
+    Kinematics kinematics_;
+    vector3d_t support_;
+    double friction_deadband_;
+
+    ArmGravityModel arm_;
+    RecursiveLeastSquares<ArmGravityModel::PARAMETERS> arm_rls_;
+    RecursiveLeastSquares<PAYLOAD_PARAMETERS> payload_rls_;
+    double residual_square_;
+
+    Impl(const Kinematics& kinematics, const vector3d_t& gravity, double friction_deadband)
+        : kinematics_(kinematics),
+          // The joints hold the links against the gravity
+          support_{-gravity[0], -gravity[1], -gravity[2]},
+          friction_deadband_(friction_deadband),
+          arm_rls_(1e3),
+          payload_rls_(1e3),
+          residual_square_(0) {}
+
+    /**
+     * Row j of the regressor is the torque of joint j. For link k, with frame k + 1, the holding torque is
+     * z_j . ((o - o_j) x m f) + z_j . ((R m c) x f), linear in the mass m and the first moments m c.
+     */
+    void regressor(const vector6d_t& q, const vector6d_t& qd, ArmRegressor& rows) const {
+        Transform frames[7];
+        frames[0] = identity();
+        for (int i = 0; i < 6; i++) {
+            frames[i + 1] = multiply(
+                frames[i], dhTransform(q[i], kinematics_.dhA()[i], kinematics_.dhD()[i], kinematics_.dhAlpha()[i]));
+        }
+        for (auto& row : rows) {
+            row.fill(0);
+        }
+        for (int j = 1; j < 6; j++) {
+            const Transform& axis = frames[j];
+            double z[3] = {axis[2], axis[6], axis[10]};
+            for (int k = j; k < 6; k++) {
+                const Transform& link = frames[k + 1];
+                double* block = &rows[j][(k - 1) * LINK_PARAMETERS];
+                double r[3] = {link[3] - axis[3], link[7] - axis[7], link[11] - axis[11]};
+                block[0] = tripleProduct(z, r, support_.data());
+                for (int i = 0; i < 3; i++) {
+                    double column[3] = {link[i], link[4 + i], link[8 + i]};
+                    block[1 + i] = tripleProduct(z, column, support_.data());
+                }
+            }
+            double friction = friction_deadband_ > 0 ? std::min(std::max(qd[j] / friction_deadband_, -1.0), 1.0)
+                                                     : (qd[j] > 0) - (qd[j] < 0);
+            rows[j][GRAVITY_PARAMETERS + 2 * (j - 1)] = 1;
+            rows[j][GRAVITY_PARAMETERS + 2 * (j - 1) + 1] = friction;
+        }
+    }
+
+    // a . (b x c)
+    static double tripleProduct(const double* a, const double* b, const double* c) {
+        return a[0] * (b[1] * c[2] - b[2] * c[1]) + a[1] * (b[2] * c[0] - b[0] * c[2]) + a[2] * (b[0] * c[1] - b[1] * c[0]);
+    }
+
+    // The regressor of the payload is the one of the flange link
+    static std::array<double, PAYLOAD_PARAMETERS> payloadRow(const ArmRegressor& rows, int joint) {
+        std::array<double, PAYLOAD_PARAMETERS> row;
+        std::copy_n(&rows[joint][GRAVITY_PARAMETERS - LINK_PARAMETERS], PAYLOAD_PARAMETERS, row.begin());
+        return row;
+    }
+
+    double armTorque(const ArmRegressor& rows, int joint) const {
+        double sum = 0;
+        for (int i = 0; i < ArmGravityModel::PARAMETERS; i++) {
+            sum += rows[joint][i] * arm_.parameters[i];
+        }
+        return sum;
+    }
+
+    void addResidual(double error) { residual_square_ += RESIDUAL_ALPHA * (error * error - residual_square_); }
+};
+
+PayloadEstimator::PayloadEstimator(const Kinematics& kinematics, const vector3d_t& gravity, double friction_deadband)
+    : impl_(new Impl(kinematics, gravity, friction_deadband)) {}
+
+PayloadEstimator::~PayloadEstimator() = default;
+
+void PayloadEstimator::startArmCalibration(double reference_mass, const vector3d_t& reference_cog) {
+    impl_->arm_rls_.reset();
+    impl_->arm_ = ArmGravityModel();
+    impl_->arm_.reference_mass = reference_mass;
+    impl_->arm_.reference_cog = reference_cog;
+    impl_->residual_square_ = 0;
+}
+
+void PayloadEstimator::updateArm(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& torques) {
+    ArmRegressor rows;
+    impl_->regressor(q, qd, rows);
+    for (int j = 1; j < 6; j++) {
+        impl_->addResidual(impl_->arm_rls_.update(rows[j], torques[j]));
+    }
+    impl_->arm_.parameters = impl_->arm_rls_.parameters();
+    impl_->arm_.valid = true;
+}
+
+ArmGravityModel PayloadEstimator::getArmModel() const { return impl_->arm_; }
+
+void PayloadEstimator::setArmModel(const ArmGravityModel& model) {
+    impl_->arm_ = model;
+    impl_->arm_rls_.setParameters(model.parameters);
+}
+
+void PayloadEstimator::startPayload() {
+    impl_->payload_rls_.reset();
+    impl_->residual_square_ = 0;
+}
+
+bool PayloadEstimator::updatePayload(const vector6d_t& q, const vector6d_t& qd, const vector6d_t& torques) {
+    if (!impl_->arm_.valid) {
+        return false;
+    }
+    ArmRegressor rows;
+    impl_->regressor(q, qd, rows);
+    for (int j = 1; j < 6; j++) {
+        // The change of the flange link is the payload change from the reference
+        double residual = torques[j] - impl_->armTorque(rows, j);
+        impl_->addResidual(impl_->payload_rls_.update(Impl::payloadRow(rows, j), residual));
+    }
+    return true;
+}
+
+PayloadEstimate PayloadEstimator::getEstimate() const {
+    PayloadEstimate estimate;
+    const auto& delta = impl_->payload_rls_.parameters();
+    const ArmGravityModel& arm = impl_->arm_;
+    estimate.mass = arm.reference_mass + delta[0];
+    estimate.samples = impl_->payload_rls_.count();
+    estimate.residual_rms = std::sqrt(impl_->residual_square_);
+    estimate.valid = estimate.samples > 0 && estimate.mass > 0;
+    if (estimate.valid) {
+        for (int i = 0; i < 3; i++) {
+            estimate.cog[i] = (arm.reference_mass * arm.reference_cog[i] + delta[1 + i]) / estimate.mass;
+        }
+    }
+    return estimate;
+}
+
+vector6d_t PayloadEstimator::predict(const vector6d_t& q, const vector6d_t& qd) const {
+    ArmRegressor rows;
+    impl_->regressor(q, qd, rows);
+    vector6d_t torques{};
+    for (int j = 1; j < 6; j++) {
+        torques[j] = impl_->armTorque(rows, j) + impl_->payload_rls_.predict(Impl::payloadRow(rows, j));
+    }
+    return torques;
+}
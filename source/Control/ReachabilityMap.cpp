@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "ReachabilityMap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "KinematicsInternal.hpp"
+#include "Log.hpp"
+
+using namespace ELITE;
+using namespace ELITE::KINEMATICS;
+
+namespace {
+
+struct Cell {
+    /// Bit i: approach direction bin i reached
+    uint32_t directions;
+    /// The best manipulability
+    float manipulability;
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t cell_size;
+    uint32_t r_cells;
+    uint32_t z_cells;
+    double resolution;
+    double z_min;
+    uint64_t samples;
+};
+
+const char FILE_MAGIC[8] = {'E', 'L', 'I', 'T', 'E', 'R', 'M', 0};
+constexpr uint32_t FILE_VERSION = 1;
+
+// The approach direction bin, relative to the radial direction at the azimuth (cos, sin)
+int directionBin(double x, double y, double z, double c, double s) {
+    double radial = c * x + s * y;
+    double tangential = -s * x + c * y;
+    int elevation = std::min(3, std::max(0, (int)((z + 1) * 2)));
+    int azimuth = (int)((std::atan2(tangential, radial) + PI) * (8 / (2 * PI)));
+    return elevation * 8 + (azimuth & 7);
+}
+
+// Sample values of a joint over its limits, within one turn
+std::vector<double> jointSamples(double lower, double upper, int count) {
+    lower = std::max(lower, -PI);
+    upper = std::min(upper, PI);
+    std::vector<double> samples;
+    if (upper < lower || count <= 1) {
+        samples.push_back(std::min(std::max(0.0, lower), upper));
+        return samples;
+    }
+    bool full_turn = upper - lower >= 2 * PI - 1e-9;
+    // A full turn does not sample both ends, they are the same position
+    double step = (upper - lower) / (full_turn ? count : count - 1);
+    for (int i = 0; i < count; i++) {
+        samples.push_back(lower + i * step);
+    }
+    return samples;
+}
+
+}  // namespace
+
+class ReachabilityMap::Impl {
+   public:
+    double resolution_ = 0;
+    uint32_t r_cells_ = 0;
+    uint32_t z_cells_ = 0;
+    double z_min_ = 0;
+    uint64_t samples_ = 0;
+
+    // Either owned or mapped from a file
+    std::vector<Cell> owned_;
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+    const Cell* cells_ = nullptr;
+
+    const Cell* cellAt(double x, double y, double z) const {
+        if (!cells_) {
+            return nullptr;
+        }
+        double r = std::sqrt(x * x + y * y);
+        double rz = (z - z_min_) / resolution_;
+        if (!(rz >= 0)) {
+            return nullptr;
+        }
+        size_t ri = (size_t)(r / resolution_);
+        size_t zi = (size_t)rz;
+        if (ri >= r_cells_ || zi >= z_cells_) {
+            return nullptr;
+        }
+        return &cells_[zi * r_cells_ + ri];
+    }
+};
+
+ReachabilityMap::ReachabilityMap() : impl_(new Impl()) {}
+
+ReachabilityMap::~ReachabilityMap() = default;
+
+bool ReachabilityMap::build(const Kinematics& kinematics, const ReachabilityConfig& config) {
+    const vector6d_t& dh_a = kinematics.dhA();
+    const vector6d_t& dh_d = kinematics.dhD();
+    const vector6d_t& dh_alpha = kinematics.dhAlpha();
+    const vector6d_t& tcp_offset = kinematics.tcpOffset();
+    double tcp_length = std::sqrt(tcp_offset[0] * tcp_offset[0] + tcp_offset[1] * tcp_offset[1] + tcp_offset[2] * tcp_offset[2]);
+    double reach = tcp_length;
+    for (int i = 0; i < 6; i++) {
+        reach += std::abs(dh_a[i]) + std::abs(dh_d[i]);
+    }
+    if (!(config.resolution > 0) || !(reach > 0)) {
+        return false;
+    }
+
+    const double resolution = config.resolution;
+    const uint32_t r_cells = (uint32_t)std::ceil(reach / resolution) + 1;
+    const uint32_t z_cells = 2 * r_cells;
+    const double z_min = -(double)r_cells * resolution;
+
+    // The arm joints move the TCP at most 'reach' per radian, so this step moves it less than a cell
+    int arm_count = (int)std::ceil(2 * PI * reach / resolution);
+    int wrist_count = std::max(config.wrist_samples, 1);
+    int tool_count = tcp_length > 0 || tcp_offset[3] != 0 || tcp_offset[4] != 0 ? wrist_count : 1;
+    std::vector<double> samples[6];
+    samples[1] = jointSamples(config.joint_lower[1], config.joint_upper[1], arm_count);
+    samples[2] = jointSamples(config.joint_lower[2], config.joint_upper[2], arm_count);
+    samples[3] = jointSamples(config.joint_lower[3], config.joint_upper[3], wrist_count);
+    samples[4] = jointSamples(config.joint_lower[4], config.joint_upper[4], wrist_count);
+    samples[5] = jointSamples(config.joint_lower[5], config.joint_upper[5], tool_count);
+
+    // The link transforms of every sample, so the inner loops only multiply
+    std::vector<Transform> links[6];
+    for (int joint = 1; joint < 6; joint++) {
+        for (double q : samples[joint]) {
+            links[joint].push_back(dhTransform(q, dh_a[joint], dh_d[joint], dh_alpha[joint]));
+        }
+    }
+    Transform tcp;
+    {
+        auto rotation = Kinematics::rotationMatrix({tcp_offset[3], tcp_offset[4], tcp_offset[5]});
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                tcp[row * 4 + col] = rotation[row * 3 + col];
+            }
+            tcp[row * 4 + 3] = tcp_offset[row];
+        }
+    }
+    // Joint 1 at 0
+    const Transform base = dhTransform(0, dh_a[0], dh_d[0], dh_alpha[0]);
+
+    int thread_count = config.threads > 0 ? config.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::vector<Cell>> tables(thread_count, std::vector<Cell>((size_t)r_cells * z_cells, Cell{0, 0}));
+    std::atomic<size_t> next(0);
+
+    auto worker = [&](std::vector<Cell>& table) {
+        Transform axes[6];
+        axes[0] = identity();
+        axes[1] = base;
+        matrix6d_t jacobian;
+        for (size_t i1; (i1 = next.fetch_add(1)) < samples[1].size();) {
+            axes[2] = multiply(axes[1], links[1][i1]);
+            for (const Transform& link2 : links[2]) {
+                axes[3] = multiply(axes[2], link2);
+                for (const Transform& link3 : links[3]) {
+                    axes[4] = multiply(axes[3], link3);
+                    for (const Transform& link4 : links[4]) {
+                        axes[5] = multiply(axes[4], link4);
+                        // The manipulability does not depend on joint 6 and the TCP offset
+                        Transform flange_point = multiply(axes[5], links[5][0]);
+                        jacobianOf(axes, flange_point, jacobian);
+                        float manipulability = (float)Kinematics::manipulability(jacobian);
+                        for (const Transform& link5 : links[5]) {
+                            Transform point = multiply(multiply(axes[5], link5), tcp);
+                            double x = point[3], y = point[7];
+                            double r = std::sqrt(x * x + y * y);
+                            size_t ri = (size_t)(r / resolution);
+                            size_t zi = (size_t)((point[11] - z_min) / resolution);
+                            if (ri >= r_cells || zi >= z_cells) {
+                                continue;
+                            }
+                            double c = r > 0 ? x / r : 1, s = r > 0 ? y / r : 0;
+                            Cell& cell = table[zi * r_cells + ri];
+                            cell.directions |= 1u << directionBin(point[2], point[6], point[10], c, s);
+                            cell.manipulability = std::max(cell.manipulability, manipulability);
+                        }
+                    }
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < thread_count; i++) {
+        threads.emplace_back(worker, std::ref(tables[i]));
+    }
+    worker(tables[0]);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int i = 1; i < thread_count; i++) {
+        for (size_t c = 0; c < tables[0].size(); c++) {
+            tables[0][c].directions |= tables[i][c].directions;
+            tables[0][c].manipulability = std::max(tables[0][c].manipulability, tables[i][c].manipulability);
+        }
+    }
+
+    impl_->region_.reset();
+    impl_->owned_ = std::move(tables[0]);
+    impl_->cells_ = impl_->owned_.data();
+    impl_->resolution_ = resolution;
+    impl_->r_cells_ = r_cells;
+    impl_->z_cells_ = z_cells;
+    impl_->z_min_ = z_min;
+    impl_->samples_ = (uint64_t)samples[1].size() * samples[2].size() * samples[3].size() * samples[4].size() * samples[5].size();
+    return true;
+}
+
+bool ReachabilityMap::save(const std::string& path) const {
+    if (!impl_->cells_) {
+        return false;
+    }
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.cell_size = sizeof(Cell);
+    header.r_cells = impl_->r_cells_;
+    header.z_cells = impl_->z_cells_;
+    header.resolution = impl_->resolution_;
+    header.z_min = impl_->z_min_;
+    header.samples = impl_->samples_;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        ELITE_LOG_ERROR("Can't open reachability map file: %s", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(impl_->cells_), (std::streamsize)impl_->r_cells_ * impl_->z_cells_ * sizeof(Cell));
+    return (bool)file;
+}
+
+bool ReachabilityMap::load(const std::string& path) {
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    try {
+        boost::interprocess::file_mapping mapping(path.c_str(), boost::interprocess::read_only);
+        region.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    } catch (const boost::interprocess::interprocess_exception& e) {
+        ELITE_LOG_ERROR("Can't map reachability map file %s: %s", path.c_str(), e.what());
+        return false;
+    }
+    if (region->get_size() < sizeof(FileHeader)) {
+        ELITE_LOG_ERROR("Reachability map file %s is too short", path.c_str());
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, region->get_address(), sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION ||
+        header.cell_size != sizeof(Cell) || !(header.resolution > 0) ||
+        region->get_size() != sizeof(FileHeader) + (size_t)header.r_cells * header.z_cells * sizeof(Cell)) {
+        ELITE_LOG_ERROR("%s is not a reachability map of version %u", path.c_str(), FILE_VERSION);
+        return false;
+    }
+
+    impl_->owned_.clear();
+    impl_->owned_.shrink_to_fit();
+    impl_->region_ = std::move(region);
+    impl_->cells_ = reinterpret_cast<const Cell*>(static_cast<const char*>(impl_->region_->get_address()) + sizeof(FileHeader));
+    impl_->resolution_ = header.resolution;
+    impl_->r_cells_ = header.r_cells;
+    impl_->z_cells_ = header.z_cells;
+    impl_->z_min_ = header.z_min;
+    impl_->samples_ = header.samples;
+    return true;
+}
+
+bool ReachabilityMap::isValid() const { return impl_->cells_ != nullptr; }
+
+double ReachabilityMap::resolution() const { return impl_->resolution_; }
+
+uint64_t ReachabilityMap::sampleCount() const { return impl_->samples_; }
+
+bool ReachabilityMap::reachable(const vector3d_t& position) const {
+    const Cell* cell = impl_->cellAt(position[0], position[1], position[2]);
+    return cell && cell->directions != 0;
+}
+
+bool ReachabilityMap::reachable(const vector6d_t& pose) const {
+    const Cell* cell = impl_->cellAt(pose[0], pose[1], pose[2]);
+    if (!cell || cell->directions == 0) {
+        return false;
+    }
+    auto rotation = Kinematics::rotationMatrix({pose[3], pose[4], pose[5]});
+    double r = std::sqrt(pose[0] * pose[0] + pose[1] * pose[1]);
+    double c = r > 0 ? pose[0] / r : 1, s = r > 0 ? pose[1] / r : 0;
+    return (cell->directions >> directionBin(rotation[2], rotation[5], rotation[8], c, s)) & 1;
+}
+
+double ReachabilityMap::manipulability(const vector3d_t& position) const {
+    const Cell* cell = impl_->cellAt(position[0], position[1], position[2]);
+    return cell ? cell->manipulability : 0;
+}
+
+int ReachabilityMap::directionCount(const vector3d_t& position) const {
+    const Cell* cell = impl_->cellAt(position[0], position[1], position[2]);
+    if (!cell) {
+        return 0;
+    }
+    int count = 0;
+    for (uint32_t bits = cell->directions; bits; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+}
@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: MIT
 // Copyright (c) 2025, Elite Robots.
+#include <boost/asio/dispatch.hpp>
 #include <future>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 #include "ControlCommon.hpp"
 #include "Log.hpp"
@@ -8,38 +12,210 @@
 
 namespace ELITE {
 
+// Commands waiting for the acknowledge of the script. Shared with the timer and receive handlers, which run in the
+// io_context thread and may outlive the interface.
+class ScriptCommandInterface::AckState {
+   public:
+    struct Pending {
+        Cmd cmd;
+        std::chrono::steady_clock::time_point send_time;
+        std::shared_ptr<boost::asio::steady_timer> timer;
+        std::promise<ScriptCommandAck> promise;
+    };
+
+    explicit AckState(std::shared_ptr<boost::asio::io_context> io_context) : io_context_(std::move(io_context)) {}
+
+    // The timers run in this io_context, they are only touched from its thread
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::mutex mutex_;
+    int32_t last_seq_ = 0;
+    std::unordered_map<int32_t, Pending> pending_;
+    std::map<Cmd, ScriptCommandStats> stats_;
+
+    int32_t nextSeq() {
+        last_seq_++;
+        if (last_seq_ <= 0) {
+            last_seq_ = 1;
+        }
+        return last_seq_;
+    }
+
+    void complete(int32_t seq, ScriptCommandStatus status, int32_t result) {
+        std::promise<ScriptCommandAck> promise;
+        ScriptCommandAck ack;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto iter = pending_.find(seq);
+            if (iter == pending_.end()) {
+                return;
+            }
+            ack.status = status;
+            ack.seq = seq;
+            ack.result = result;
+            ack.latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - iter->second.send_time);
+            cancelTimer(iter->second.timer);
+            updateStats(stats_[iter->second.cmd], ack);
+            promise = std::move(iter->second.promise);
+            pending_.erase(iter);
+        }
+        promise.set_value(ack);
+    }
+
+    // Inline in the io_context thread, posted from the others (e.g. a command which failed to send)
+    void cancelTimer(const std::shared_ptr<boost::asio::steady_timer>& timer) {
+        boost::asio::dispatch(*io_context_, [timer]() { timer->cancel(); });
+    }
+
+    static void updateStats(ScriptCommandStats& stats, const ScriptCommandAck& ack) {
+        if (ack.status == ScriptCommandStatus::TIMEOUT) {
+            stats.timeout++;
+            return;
+        } else if (ack.status != ScriptCommandStatus::SUCCESS) {
+            return;
+        }
+        stats.acked++;
+        if (stats.acked == 1 || ack.latency < stats.min_latency) {
+            stats.min_latency = ack.latency;
+        }
+        if (ack.latency > stats.max_latency) {
+            stats.max_latency = ack.latency;
+        }
+        stats.mean_latency += (ack.latency - stats.mean_latency) / (int64_t)stats.acked;
+        stats.last_latency = ack.latency;
+    }
+};
+
 ScriptCommandInterface::ScriptCommandInterface(int port, std::shared_ptr<TcpServer::StaticResource> resource)
-    : ReversePort(port, 4, resource) {
+    : ReversePort(port, SCRIPT_COMMAND_ACK_SIZE, resource), ack_state_(std::make_shared<AckState>(resource->io_context_ptr_)),
+      resource_(resource) {
+    std::weak_ptr<AckState> weak_state = ack_state_;
+    server_->setReceiveCallback([weak_state](const uint8_t data[], int nb) {
+        auto state = weak_state.lock();
+        if (!state || nb != SCRIPT_COMMAND_ACK_SIZE) {
+            return;
+        }
+        int32_t seq = ntohl(((const int32_t*)data)[0]);
+        int32_t result = ntohl(((const int32_t*)data)[1]);
+        state->complete(seq, ScriptCommandStatus::SUCCESS, result);
+    });
     server_->startListen();
 }
 
-ScriptCommandInterface::~ScriptCommandInterface() {}
+ScriptCommandInterface::~ScriptCommandInterface() {
+    server_->unsetReceiveCallback();
+    std::unordered_map<int32_t, AckState::Pending> pending;
+    {
+        std::lock_guard<std::mutex> lock(ack_state_->mutex_);
+        pending.swap(ack_state_->pending_);
+    }
+    // Cancel the timers in the io_context thread and wait for it. Once stopped, nothing else runs the timers.
+    auto cancel = [&pending]() {
+        for (auto& item : pending) {
+            item.second.timer->cancel();
+        }
+    };
+    if (pending.empty() || ack_state_->io_context_->stopped()) {
+        cancel();
+    } else {
+        std::promise<void> canceled;
+        std::future<void> done = canceled.get_future();
+        boost::asio::dispatch(*ack_state_->io_context_, [&cancel, &canceled]() {
+            cancel();
+            canceled.set_value();
+        });
+        done.wait();
+    }
+    for (auto& item : pending) {
+        ScriptCommandAck ack;
+        ack.status = ScriptCommandStatus::CANCELED;
+        ack.seq = item.first;
+        item.second.promise.set_value(ack);
+    }
+}
+
+std::future<ScriptCommandAck> ScriptCommandInterface::sendCommand(Cmd cmd, int32_t* buffer, int timeout_ms) {
+    std::shared_ptr<AckState> state = ack_state_;
+    std::future<ScriptCommandAck> future;
+    int32_t seq = 0;
+    {
+        // Register before writing, the acknowledge may arrive before 'write()' returns.
+        std::lock_guard<std::mutex> lock(state->mutex_);
+        seq = state->nextSeq();
+        AckState::Pending pending;
+        pending.cmd = cmd;
+        pending.timer = std::make_shared<boost::asio::steady_timer>(*state->io_context_);
+        future = pending.promise.get_future();
+        pending.send_time = std::chrono::steady_clock::now();
+        pending.timer->expires_after(std::chrono::milliseconds(timeout_ms));
+        std::weak_ptr<AckState> weak_state = state;
+        pending.timer->async_wait([weak_state, seq](const boost::system::error_code& ec) {
+            auto state = weak_state.lock();
+            if (ec || !state) {
+                return;
+            }
+            ELITE_LOG_WARN("Script command %d was not acknowledged in time", seq);
+            state->complete(seq, ScriptCommandStatus::TIMEOUT, 0);
+        });
+        state->pending_.emplace(seq, std::move(pending));
+    }
+    buffer[SCRIPT_COMMAND_SEQ_INDEX] = htonl(seq);
+    if (write(buffer, SCRIPT_COMMAND_DATA_SIZE * sizeof(int32_t)) <= 0) {
+        state->complete(seq, ScriptCommandStatus::SEND_FAIL, 0);
+    } else {
+        std::lock_guard<std::mutex> lock(state->mutex_);
+        state->stats_[cmd].sent++;
+    }
+    return future;
+}
+
+bool ScriptCommandInterface::isSent(std::future<ScriptCommandAck> ack) {
+    if (ack.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return true;
+    }
+    return ack.get().status != ScriptCommandStatus::SEND_FAIL;
+}
+
+bool ScriptCommandInterface::zeroFTSensor() { return isSent(zeroFTSensorAsync()); }
+
+bool ScriptCommandInterface::setPayload(double mass, const vector3d_t& cog) { return isSent(setPayloadAsync(mass, cog)); }
+
+bool ScriptCommandInterface::setToolVoltage(const ToolVoltage& vol) { return isSent(setToolVoltageAsync(vol)); }
+
+bool ScriptCommandInterface::startForceMode(const vector6d_t& task_frame, const vector6int32_t& selection_vector,
+                                            const vector6d_t& wrench, const ForceMode& mode, const vector6d_t& limits) {
+    return isSent(startForceModeAsync(task_frame, selection_vector, wrench, mode, limits));
+}
 
-bool ScriptCommandInterface::zeroFTSensor() {
+bool ScriptCommandInterface::endForceMode() { return isSent(endForceModeAsync()); }
+
+std::future<ScriptCommandAck> ScriptCommandInterface::zeroFTSensorAsync(int timeout_ms) {
     int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
     buffer[0] = htonl(static_cast<int32_t>(Cmd::ZERO_FTSENSOR));
-    return write(buffer, sizeof(buffer)) > 0;
+    return sendCommand(Cmd::ZERO_FTSENSOR, buffer, timeout_ms);
 }
 
-bool ScriptCommandInterface::setPayload(double mass, const vector3d_t& cog) {
+std::future<ScriptCommandAck> ScriptCommandInterface::setPayloadAsync(double mass, const vector3d_t& cog, int timeout_ms) {
     int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
     buffer[0] = htonl(static_cast<int32_t>(Cmd::SET_PAYLOAD));
     buffer[1] = htonl(static_cast<int32_t>((mass * CONTROL::COMMON_ZOOM_RATIO)));
     buffer[2] = htonl(static_cast<int32_t>((cog[0] * CONTROL::COMMON_ZOOM_RATIO)));
     buffer[3] = htonl(static_cast<int32_t>((cog[1] * CONTROL::COMMON_ZOOM_RATIO)));
     buffer[4] = htonl(static_cast<int32_t>((cog[2] * CONTROL::COMMON_ZOOM_RATIO)));
-    return write(buffer, sizeof(buffer)) > 0;
+    return sendCommand(Cmd::SET_PAYLOAD, buffer, timeout_ms);
 }
 
-bool ScriptCommandInterface::setToolVoltage(const ToolVoltage& vol) {
+std::future<ScriptCommandAck> ScriptCommandInterface::setToolVoltageAsync(const ToolVoltage& vol, int timeout_ms) {
     int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
     buffer[0] = htonl(static_cast<int32_t>(Cmd::SET_TOOL_VOLTAGE));
     buffer[1] = htonl(static_cast<int32_t>(vol) * CONTROL::COMMON_ZOOM_RATIO);
-    return write(buffer, sizeof(buffer)) > 0;
+    return sendCommand(Cmd::SET_TOOL_VOLTAGE, buffer, timeout_ms);
 }
 
-bool ScriptCommandInterface::startForceMode(const vector6d_t& task_frame, const vector6int32_t& selection_vector,
-                                            const vector6d_t& wrench, const ForceMode& mode, const vector6d_t& limits) {
+std::future<ScriptCommandAck> ScriptCommandInterface::startForceModeAsync(const vector6d_t& task_frame,
+                                                                         const vector6int32_t& selection_vector,
+                                                                         const vector6d_t& wrench, const ForceMode& mode,
+                                                                         const vector6d_t& limits, int timeout_ms) {
     int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
     buffer[0] = htonl(static_cast<int32_t>(Cmd::START_FORCE_MODE));
     int32_t* bp = &buffer[1];
@@ -61,13 +237,28 @@ bool ScriptCommandInterface::startForceMode(const vector6d_t& task_frame, const
         *bp = htonl(static_cast<int32_t>((li * CONTROL::COMMON_ZOOM_RATIO)));
         bp++;
     }
-    return write(buffer, sizeof(buffer)) > 0;
+    return sendCommand(Cmd::START_FORCE_MODE, buffer, timeout_ms);
 }
 
-bool ScriptCommandInterface::endForceMode() {
+std::future<ScriptCommandAck> ScriptCommandInterface::endForceModeAsync(int timeout_ms) {
     int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
     buffer[0] = htonl(static_cast<int32_t>(Cmd::END_FORCE_MODE));
-    return write(buffer, sizeof(buffer)) > 0;
+    return sendCommand(Cmd::END_FORCE_MODE, buffer, timeout_ms);
+}
+
+std::future<ScriptCommandAck> ScriptCommandInterface::ping(int timeout_ms) {
+    int32_t buffer[SCRIPT_COMMAND_DATA_SIZE] = {0};
+    buffer[0] = htonl(static_cast<int32_t>(Cmd::PING));
+    return sendCommand(Cmd::PING, buffer, timeout_ms);
+}
+
+ScriptCommandStats ScriptCommandInterface::getStats(ScriptCommand cmd) {
+    std::lock_guard<std::mutex> lock(ack_state_->mutex_);
+    auto iter = ack_state_->stats_.find(cmd);
+    if (iter == ack_state_->stats_.end()) {
+        return ScriptCommandStats();
+    }
+    return iter->second;
 }
 
-}  // namespace ELITE
\ No newline at end of file
+}  // namespace ELITE
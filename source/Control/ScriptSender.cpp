@@ -8,26 +8,43 @@
 
 using namespace ELITE;
 
+static const std::string PROGRAM_REQUEST = "request_program";
+
 ScriptSender::ScriptSender(int port, const std::string& program, std::shared_ptr<TcpServer::StaticResource> resource)
-    : program_(program), TcpServer(port, 0, resource) {
+    : TcpServer(port, 0, resource), state_(std::make_shared<State>()) {
+    state_->program = program;
     doAccept();
 }
 
-ScriptSender::~ScriptSender() {}
+ScriptSender::~ScriptSender() {
+    // The acceptor is closed by ~TcpServer() afterwards, the aborted accept must not start a new one
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->alive = false;
+}
 
 void ScriptSender::doAccept() {
+    std::shared_ptr<State> state = state_;
     // Accept call back
-    auto accept_cb = [this](boost::system::error_code ec, boost::asio::ip::tcp::socket sock) {
+    auto accept_cb = [this, state](boost::system::error_code ec, boost::asio::ip::tcp::socket sock) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->alive) {
+            return;
+        }
+        if (ec) {
+            ELITE_LOG_ERROR("Script sender accept fail: %s", boost::system::system_error(ec).what());
+            return;
+        }
         auto new_socket = std::make_shared<boost::asio::ip::tcp::socket>(std::move(sock));
-        responseRequest(new_socket);
+        responseRequest(state, new_socket, std::make_shared<boost::asio::streambuf>());
         ScriptSender::doAccept();
     };
     acceptor_->listen(1);
     acceptor_->async_accept(*(resource_->io_context_ptr_), accept_cb);
 }
 
-void ScriptSender::responseRequest(std::shared_ptr<boost::asio::ip::tcp::socket> sock) {
-    boost::asio::async_read_until(*sock, recv_request_buffer_, '\n', [&, sock](boost::system::error_code ec, std::size_t len) {
+void ScriptSender::responseRequest(std::shared_ptr<State> state, std::shared_ptr<boost::asio::ip::tcp::socket> sock,
+                                   std::shared_ptr<boost::asio::streambuf> buffer) {
+    boost::asio::async_read_until(*sock, *buffer, '\n', [state, sock, buffer](boost::system::error_code ec, std::size_t len) {
         if (ec) {
             if (sock->is_open()) {
                 ELITE_LOG_INFO("Connection to script sender interface dropped: %s", boost::system::system_error(ec).what());
@@ -35,17 +52,17 @@ void ScriptSender::responseRequest(std::shared_ptr<boost::asio::ip::tcp::socket>
         } else {
             ELITE_LOG_INFO("Robot request external control script.");
             std::string request;
-            std::istream response_stream(&recv_request_buffer_);
+            std::istream response_stream(buffer.get());
             std::getline(response_stream, request);
-            if (request == PROGRAM_REQUEST_) {
+            if (request == PROGRAM_REQUEST) {
                 boost::system::error_code wec;
-                sock->write_some(boost::asio::buffer(program_), wec);
+                sock->write_some(boost::asio::buffer(state->program), wec);
                 if (wec) {
                     ELITE_LOG_ERROR("Script sender send script fail: %s", boost::system::system_error(wec).what());
                     return;
                 }
             }
-            responseRequest(sock);
+            responseRequest(state, sock, buffer);
         }
     });
 }
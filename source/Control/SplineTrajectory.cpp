@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "SplineTrajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ELITE;
+
+namespace {
+
+// Peak absolute velocity and acceleration of one joint on one segment.
+// q(t) = q0 + v0 t + a0 t^2 / 2 + j t^3 / 6, with the constant jerk j = (a1 - a0) / h
+void segmentPeaks(double v0, double a0, double a1, double h, double& peak_vel, double& peak_acc) {
+    double jerk = (a1 - a0) / h;
+    double v1 = v0 + a0 * h + jerk * h * h / 2;
+    peak_vel = std::max(peak_vel, std::max(std::abs(v0), std::abs(v1)));
+    if (jerk != 0) {
+        double t = -a0 / jerk;
+        if (t > 0 && t < h) {
+            peak_vel = std::max(peak_vel, std::abs(v0 + a0 * t + jerk * t * t / 2));
+        }
+    }
+    // The acceleration is linear on a segment
+    peak_acc = std::max(peak_acc, std::max(std::abs(a0), std::abs(a1)));
+}
+
+}  // namespace
+
+SplineTrajectory::SplineTrajectory() : duration_(0) {}
+
+bool SplineTrajectory::fit(const std::vector<vector6d_t>& waypoints, const std::vector<double>& durations,
+                           const vector6d_t& start_velocity, const vector6d_t& end_velocity) {
+    if (waypoints.size() < 2 || durations.size() != waypoints.size() - 1) {
+        return false;
+    }
+    for (double h : durations) {
+        if (!(h > 0)) {
+            return false;
+        }
+    }
+
+    const size_t n = waypoints.size() - 1;
+    const std::vector<double>& h = durations;
+    std::vector<SplineKnot> all(n + 1);
+    for (size_t i = 0; i <= n; i++) {
+        all[i].positions = waypoints[i];
+        all[i].duration = i > 0 ? h[i - 1] : 0;
+    }
+
+    // Solve the tridiagonal system of the second derivatives M of every joint (Thomas algorithm):
+    // h[i-1] M[i-1] + 2 (h[i-1] + h[i]) M[i] + h[i] M[i+1] = 6 (slope[i] - slope[i-1]),
+    // with the clamped ends 2 h[0] M[0] + h[0] M[1] = 6 (slope[0] - v0) and h[n-1] M[n-1] + 2 h[n-1] M[n] = 6 (vn - slope[n-1]).
+    std::vector<double> lower(n + 1), diag(n + 1), upper(n + 1), rhs(n + 1), m(n + 1);
+    for (int joint = 0; joint < 6; joint++) {
+        std::vector<double> slope(n);
+        for (size_t i = 0; i < n; i++) {
+            slope[i] = (waypoints[i + 1][joint] - waypoints[i][joint]) / h[i];
+        }
+        for (size_t i = 0; i <= n; i++) {
+            if (i == 0) {
+                lower[i] = 0;
+                diag[i] = 2 * h[0];
+                upper[i] = h[0];
+                rhs[i] = 6 * (slope[0] - start_velocity[joint]);
+            } else if (i == n) {
+                lower[i] = h[n - 1];
+                diag[i] = 2 * h[n - 1];
+                upper[i] = 0;
+                rhs[i] = 6 * (end_velocity[joint] - slope[n - 1]);
+            } else {
+                lower[i] = h[i - 1];
+                diag[i] = 2 * (h[i - 1] + h[i]);
+                upper[i] = h[i];
+                rhs[i] = 6 * (slope[i] - slope[i - 1]);
+            }
+        }
+        // The matrix is strictly diagonally dominant, no pivoting is needed
+        for (size_t i = 1; i <= n; i++) {
+            double w = lower[i] / diag[i - 1];
+            diag[i] -= w * upper[i - 1];
+            rhs[i] -= w * rhs[i - 1];
+        }
+        m[n] = rhs[n] / diag[n];
+        for (size_t i = n; i-- > 0;) {
+            m[i] = (rhs[i] - upper[i] * m[i + 1]) / diag[i];
+        }
+
+        for (size_t i = 0; i <= n; i++) {
+            all[i].accelerations[joint] = m[i];
+            if (i < n) {
+                all[i].velocities[joint] = slope[i] - h[i] * (2 * m[i] + m[i + 1]) / 6;
+            } else {
+                all[i].velocities[joint] = slope[n - 1] + h[n - 1] * (m[n - 1] + 2 * m[n]) / 6;
+            }
+        }
+    }
+
+    start_ = all[0];
+    knots_.assign(all.begin() + 1, all.end());
+    duration_ = 0;
+    for (double d : h) {
+        duration_ += d;
+    }
+    return true;
+}
+
+const std::vector<SplineKnot>& SplineTrajectory::knots() const { return knots_; }
+
+const SplineKnot& SplineTrajectory::start() const { return start_; }
+
+double SplineTrajectory::duration() const { return duration_; }
+
+bool SplineTrajectory::sample(double time, vector6d_t& positions, vector6d_t* velocities, vector6d_t* accelerations) const {
+    if (knots_.empty()) {
+        return false;
+    }
+    time = std::min(std::max(time, 0.0), duration_);
+    const SplineKnot* from = &start_;
+    size_t index = 0;
+    while (index + 1 < knots_.size() && time > knots_[index].duration) {
+        time -= knots_[index].duration;
+        from = &knots_[index];
+        index++;
+    }
+    const SplineKnot& to = knots_[index];
+    double h = to.duration;
+    time = std::min(time, h);
+    for (int joint = 0; joint < 6; joint++) {
+        double v0 = from->velocities[joint];
+        double a0 = from->accelerations[joint];
+        double jerk = (to.accelerations[joint] - a0) / h;
+        positions[joint] = from->positions[joint] + v0 * time + a0 * time * time / 2 + jerk * time * time * time / 6;
+        if (velocities) {
+            (*velocities)[joint] = v0 + a0 * time + jerk * time * time / 2;
+        }
+        if (accelerations) {
+            (*accelerations)[joint] = a0 + jerk * time;
+        }
+    }
+    return true;
+}
+
+void SplineTrajectory::peaks(vector6d_t& velocity, vector6d_t& acceleration) const {
+    velocity.fill(0);
+    acceleration.fill(0);
+    const SplineKnot* from = &start_;
+    for (const SplineKnot& to : knots_) {
+        for (int joint = 0; joint < 6; joint++) {
+            segmentPeaks(from->velocities[joint], from->accelerations[joint], to.accelerations[joint], to.duration,
+                         velocity[joint], acceleration[joint]);
+        }
+        from = &to;
+    }
+}
+
+bool SplineTrajectory::withinLimits(const SplineLimits& limits) const {
+    vector6d_t velocity, acceleration;
+    peaks(velocity, acceleration);
+    for (int joint = 0; joint < 6; joint++) {
+        if (limits.max_velocity[joint] > 0 && velocity[joint] > limits.max_velocity[joint]) {
+            return false;
+        }
+        if (limits.max_acceleration[joint] > 0 && acceleration[joint] > limits.max_acceleration[joint]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double SplineTrajectory::scaleToLimits(const SplineLimits& limits) {
+    vector6d_t velocity, acceleration;
+    peaks(velocity, acceleration);
+    double factor = 1;
+    for (int joint = 0; joint < 6; joint++) {
+        if (limits.max_velocity[joint] > 0) {
+            factor = std::max(factor, velocity[joint] / limits.max_velocity[joint]);
+        }
+        if (limits.max_acceleration[joint] > 0) {
+            factor = std::max(factor, std::sqrt(acceleration[joint] / limits.max_acceleration[joint]));
+        }
+    }
+    if (factor == 1) {
+        return factor;
+    }
+
+    auto scale = [factor](SplineKnot& knot) {
+        knot.duration *= factor;
+        for (int joint = 0; joint < 6; joint++) {
+            knot.velocities[joint] /= factor;
+            knot.accelerations[joint] /= factor * factor;
+        }
+    };
+    scale(start_);
+    for (SplineKnot& knot : knots_) {
+        scale(knot);
+    }
+    duration_ *= factor;
+    return factor;
+}
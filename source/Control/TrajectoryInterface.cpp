@@ -8,15 +8,20 @@
 
 using namespace ELITE;
 
-TrajectoryInterface::TrajectoryInterface(int port, std::shared_ptr<TcpServer::StaticResource> resource_)
-    : ReversePort(port, sizeof(TrajectoryMotionResult), resource_) {
+TrajectoryInterface::TrajectoryInterface(int port, std::shared_ptr<TcpServer::StaticResource> resource_,
+                                         CallbackExecutorSharedPtr executor)
+    : ReversePort(port, sizeof(TrajectoryMotionResult), resource_), executor_(std::move(executor)) {
     server_->setReceiveCallback([&](const uint8_t data[], int nb) {
         if (nb != sizeof(TrajectoryMotionResult)) {
             return;
         }
         TrajectoryMotionResult motion_result = (TrajectoryMotionResult)htonl(*((const uint32_t*)data));
         if (motion_result_func_) {
-            motion_result_func_(motion_result);
+            // The user callback leaves the TCP server thread, if an executor is set
+            auto func = motion_result_func_;
+            if (!dispatchCallback(executor_, [func, motion_result]() { func(motion_result); })) {
+                ELITE_LOG_WARN("Trajectory motion result callback dropped");
+            }
         }
     });
     server_->startListen();
@@ -38,4 +43,21 @@ bool TrajectoryInterface::writeTrajectoryPoint(const vector6d_t& positions, floa
     }
 
     return write(buffer, sizeof(buffer)) > 0;
-}
\ No newline at end of file
+}
+
+bool TrajectoryInterface::writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities,
+                                                     const vector6d_t* accelerations, float time) {
+    int32_t buffer[TRAJECTORY_MESSAGE_LEN] = {0};
+    for (size_t i = 0; i < 6; i++) {
+        buffer[i] = htonl(round(positions[i] * CONTROL::POS_ZOOM_RATIO));
+        buffer[i + 6] = htonl(round(velocities[i] * CONTROL::COMMON_ZOOM_RATIO));
+        if (accelerations) {
+            buffer[i + 12] = htonl(round((*accelerations)[i] * CONTROL::COMMON_ZOOM_RATIO));
+        }
+    }
+    buffer[18] = htonl(round(time * CONTROL::TIME_ZOOM_RATIO));
+    buffer[19] = htonl(accelerations ? SPLINE_QUINTIC : SPLINE_CUBIC);
+    buffer[20] = htonl((int)TrajectoryMotionType::SPLINE);
+
+    return write(buffer, sizeof(buffer)) > 0;
+}
@@ -17,6 +17,8 @@ class DashboardClient::Impl {
     boost::asio::io_context io_context_;
     std::unique_ptr<boost::asio::ip::tcp::socket> socket_ptr_;
     std::unique_ptr<boost::asio::ip::tcp::resolver> resolver_ptr_;
+    // The error of the last failed socket operation
+    boost::system::error_code last_error_;
 
     void disconnect();
 };
@@ -396,6 +398,15 @@ std::string DashboardClient::sendAndReceive(const std::string& cmd) {
 }
 
 std::string DashboardClient::asyncReadLine(unsigned timeout_ms) {
+    std::string line;
+    EliteException::Code code = tryReadLine(line, timeout_ms);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, impl_->last_error_.message());
+    }
+    return line;
+}
+
+EliteException::Code DashboardClient::tryReadLine(std::string& line, unsigned timeout_ms) noexcept {
     boost::system::error_code ec = boost::asio::error::would_block;
     boost::asio::streambuf stream_buffer;
     boost::asio::async_read_until(*impl_->socket_ptr_, stream_buffer, '\n',
@@ -410,41 +421,71 @@ std::string DashboardClient::asyncReadLine(unsigned timeout_ms) {
         }
     } while (ec == boost::asio::error::would_block);
     if (ec) {
-        throw EliteException(EliteException::Code::SOCKET_FAIL, ec.message());
+        impl_->last_error_ = ec;
+        return EliteException::Code::SOCKET_FAIL;
     }
-    std::string line(boost::asio::buffers_begin(stream_buffer.data()), boost::asio::buffers_end(stream_buffer.data()));
-    return line;
+    line.assign(boost::asio::buffers_begin(stream_buffer.data()), boost::asio::buffers_end(stream_buffer.data()));
+    return EliteException::Code::SUCCESS;
 }
 
 void DashboardClient::sendCommand(const std::string& cmd) {
+    EliteException::Code code = trySendCommand(cmd);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, impl_->last_error_.message());
+    }
+}
+
+EliteException::Code DashboardClient::trySendCommand(const std::string& cmd) noexcept {
     boost::system::error_code ec;
     impl_->socket_ptr_->send(boost::asio::buffer(cmd), 0, ec);
     if (ec) {
-        throw EliteException(EliteException::Code::SOCKET_FAIL, ec.message());
+        impl_->last_error_ = ec;
+        return EliteException::Code::SOCKET_FAIL;
     }
+    return EliteException::Code::SUCCESS;
 }
 
 std::string DashboardClient::sendAndRequest(const std::string& cmd, const std::string& expected) {
-    std::lock_guard<std::mutex> lock(impl_->socket_mutex_);
-    if (!impl_->socket_ptr_) {
+    std::string response;
+    EliteException::Code code = trySendAndRequest(cmd, expected, response);
+    if (code == EliteException::Code::SOCKET_CONNECT_FAIL) {
         ELITE_LOG_ERROR("Dashboard not connect to robot");
         return "";
+    } else if (code == EliteException::Code::DASHBOARD_NOT_EXPECT_RECIVE) {
+        throw EliteException(code, "Dashboard command \"" + cmd + "\" response expected: " + expected +
+                                       ". But received: " + response);
+    } else if (code == EliteException::Code::ILLEGAL_PARAM) {
+        throw EliteException(code, "Dashboard expected response pattern: " + expected);
+    } else if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, impl_->last_error_.message());
+    }
+    return response;
+}
+
+EliteException::Code DashboardClient::trySendAndRequest(const std::string& cmd, const std::string& expected,
+                                                        std::string& response) noexcept {
+    std::lock_guard<std::mutex> lock(impl_->socket_mutex_);
+    if (!impl_->socket_ptr_) {
+        return EliteException::Code::SOCKET_CONNECT_FAIL;
+    }
+    EliteException::Code code = trySendCommand(cmd);
+    if (code != EliteException::Code::SUCCESS) {
+        return code;
+    }
+    code = tryReadLine(response);
+    if (code != EliteException::Code::SUCCESS || expected.empty()) {
+        return code;
     }
-    sendCommand(cmd);
-    std::string response = asyncReadLine();
-    if (!expected.empty()) {
+    try {
         std::smatch match;
-        bool ret = std::regex_search(response, match, std::regex(expected));
-        if (!ret) {
-            throw EliteException(
-                EliteException::Code::DASHBOARD_NOT_EXPECT_RECIVE,
-                "Dashboard command \"" + cmd + "\" response expected: " + expected + ". But received: " + response);
-            return std::string();
+        if (!std::regex_search(response, match, std::regex(expected))) {
+            return EliteException::Code::DASHBOARD_NOT_EXPECT_RECIVE;
         }
-        return match[0];
-    } else {
-        return response;
+        response = match[0];
+    } catch (const std::regex_error&) {
+        return EliteException::Code::ILLEGAL_PARAM;
     }
+    return EliteException::Code::SUCCESS;
 }
 
 bool DashboardClient::waitForReply(const std::string& cmd, const std::string& expected,
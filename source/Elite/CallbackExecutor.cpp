@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "CallbackExecutor.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Log.hpp"
+#include "Trace.hpp"
+
+using namespace ELITE;
+using namespace std::chrono;
+
+namespace {
+
+// A callback must not unwind through the SDK thread
+void runTask(const CallbackExecutor::Task& task) {
+    ELITE_TRACE_SCOPE("callback.run");
+    try {
+        task();
+    } catch (const std::exception& e) {
+        ELITE_LOG_ERROR("Callback throw exception: %s", e.what());
+    }
+}
+
+}  // namespace
+
+bool InlineExecutor::post(Task task) {
+    runTask(task);
+    executed_++;
+    return true;
+}
+
+CallbackExecutorStats InlineExecutor::getStats() {
+    CallbackExecutorStats stats;
+    stats.executed = executed_;
+    return stats;
+}
+
+class ThreadExecutor::Impl {
+   public:
+    struct QueuedTask {
+        Task task;
+        steady_clock::time_point post_time;
+    };
+
+    size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<QueuedTask> queue_;
+    bool alive_;
+    CallbackExecutorStats stats_;
+    std::unique_ptr<std::thread> thread_;
+
+    explicit Impl(size_t capacity) : capacity_(capacity), alive_(true) {}
+
+    void loop() {
+        TRACE::setThreadName("callback_executor");
+        while (true) {
+            QueuedTask item;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&]() { return !alive_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                item = std::move(queue_.front());
+                queue_.pop_front();
+
+                auto latency = duration_cast<microseconds>(steady_clock::now() - item.post_time);
+                stats_.executed++;
+                if (latency > stats_.max_queue_latency) {
+                    stats_.max_queue_latency = latency;
+                }
+                stats_.mean_queue_latency += (latency - stats_.mean_queue_latency) / (int64_t)stats_.executed;
+                stats_.last_queue_latency = latency;
+            }
+            runTask(item.task);
+        }
+    }
+};
+
+ThreadExecutor::ThreadExecutor(size_t capacity) : impl_(new Impl(capacity > 0 ? capacity : 1)) {
+    Impl* impl = impl_.get();
+    impl_->thread_.reset(new std::thread([impl]() { impl->loop(); }));
+}
+
+ThreadExecutor::~ThreadExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        impl_->alive_ = false;
+    }
+    impl_->cv_.notify_all();
+    if (impl_->thread_->joinable()) {
+        if (std::this_thread::get_id() != impl_->thread_->get_id()) {
+            impl_->thread_->join();
+        } else {
+            // Released by its own task, the thread still uses 'impl_' until the task returns.
+            impl_->thread_->detach();
+            impl_.release();
+            ELITE_LOG_WARN("ThreadExecutor is destroyed in its own thread, the thread is detached.");
+        }
+    }
+}
+
+bool ThreadExecutor::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        if (!impl_->alive_ || impl_->queue_.size() >= impl_->capacity_) {
+            impl_->stats_.dropped++;
+            return false;
+        }
+        impl_->queue_.push_back(Impl::QueuedTask{std::move(task), steady_clock::now()});
+        if (impl_->queue_.size() > impl_->stats_.max_queue_size) {
+            impl_->stats_.max_queue_size = impl_->queue_.size();
+        }
+    }
+    impl_->cv_.notify_one();
+    return true;
+}
+
+CallbackExecutorStats ThreadExecutor::getStats() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->stats_;
+}
+
+size_t ThreadExecutor::size() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->queue_.size();
+}
+
+bool ELITE::dispatchCallback(const CallbackExecutorSharedPtr& executor, CallbackExecutor::Task task) {
+    ELITE_TRACE_SCOPE("callback.dispatch");
+    if (executor) {
+        return executor->post(std::move(task));
+    }
+    runTask(task);
+    return true;
+}
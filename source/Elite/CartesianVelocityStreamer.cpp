@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "CartesianVelocityStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "Log.hpp"
+
+using namespace ELITE;
+using namespace std::chrono;
+
+namespace {
+
+// Damping rising from 0 at the threshold to max_damping at a singularity
+double dampingOf(const CartesianVelocityConfig& config, double manipulability) {
+    if (manipulability >= config.manipulability_threshold || config.manipulability_threshold <= 0) {
+        return 0;
+    }
+    double ratio = manipulability / config.manipulability_threshold;
+    return config.max_damping * std::sqrt(1 - ratio * ratio);
+}
+
+}  // namespace
+
+bool CartesianVelocityStreamer::solve(const Kinematics& kinematics, const CartesianVelocityConfig& config, const vector6d_t& q,
+                                      const vector6d_t& twist, CartesianVelocitySolution& solution) {
+    matrix6d_t jacobian;
+    kinematics.jacobian(q, jacobian);
+    solution.manipulability = Kinematics::manipulability(jacobian);
+    solution.damping = dampingOf(config, solution.manipulability);
+    solution.speed_scale = 1;
+    solution.limited_joints = 0;
+    vector6d_t& qd = solution.joint_velocities;
+    if (!Kinematics::dampedLeastSquares(jacobian, twist, solution.damping, qd)) {
+        qd.fill(0);
+        return false;
+    }
+
+    // Weight down the joints moving into a limit and solve again with the weighted columns, J W
+    vector6d_t weights;
+    for (int i = 0; i < 6; i++) {
+        double distance = qd[i] < 0 ? q[i] - config.joint_lower[i] : config.joint_upper[i] - q[i];
+        weights[i] = config.limit_margin > 0 ? std::min(std::max(distance / config.limit_margin, 0.0), 1.0) : 1.0;
+        if (weights[i] < 1) {
+            solution.limited_joints |= 1 << i;
+        }
+    }
+    if (solution.limited_joints) {
+        for (int row = 0; row < 6; row++) {
+            for (int col = 0; col < 6; col++) {
+                jacobian[row][col] *= weights[col];
+            }
+        }
+        solution.damping = std::max(solution.damping, dampingOf(config, Kinematics::manipulability(jacobian)));
+        if (!Kinematics::dampedLeastSquares(jacobian, twist, solution.damping, qd)) {
+            qd.fill(0);
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            qd[i] *= weights[i];
+        }
+    }
+
+    for (int i = 0; i < 6; i++) {
+        if (config.max_joint_speed[i] > 0) {
+            solution.speed_scale = std::max(solution.speed_scale, std::abs(qd[i]) / config.max_joint_speed[i]);
+        }
+    }
+    if (solution.speed_scale > 1) {
+        for (double& v : qd) {
+            v /= solution.speed_scale;
+        }
+    }
+    return true;
+}
+
+class CartesianVelocityStreamer::Impl {
+   public:
+    RtsiFrameSource& rtsi_;
+    DriverCommandWriter& driver_;
+    Kinematics kinematics_;
+    CallbackExecutorSharedPtr executor_;
+    int frame_cb_handle_;
+
+    std::mutex mutex_;
+    bool streaming_;
+    CartesianVelocityConfig config_;
+    vector6d_t twist_;
+    steady_clock::time_point twist_time_;
+    CartesianVelocitySolution solution_;
+    bool below_threshold_;
+    nanoseconds max_solve_;
+    nanoseconds total_solve_;
+    uint64_t solves_;
+    ManipulabilityCallback manipulability_cb_;
+
+    Impl(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Kinematics& kinematics, CallbackExecutorSharedPtr executor)
+        : rtsi_(rtsi),
+          driver_(driver),
+          kinematics_(kinematics),
+          executor_(std::move(executor)),
+          frame_cb_handle_(-1),
+          streaming_(false),
+          twist_{},
+          below_threshold_(false),
+          max_solve_(0),
+          total_solve_(0),
+          solves_(0) {}
+
+    void onFrame() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!streaming_) {
+            return;
+        }
+        vector6d_t q;
+        if (!rtsi_.getRecipeValue("actual_joint_positions", q)) {
+            return;
+        }
+        auto begin = steady_clock::now();
+        vector6d_t twist = twist_;
+        if (begin - twist_time_ > milliseconds(config_.twist_timeout_ms)) {
+            twist.fill(0);
+        }
+        CartesianVelocitySolution solution;
+        solve(kinematics_, config_, q, twist, solution);
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - begin);
+        max_solve_ = std::max(max_solve_, elapsed);
+        total_solve_ += elapsed;
+        solves_++;
+        solution_ = solution;
+
+        if (!driver_.writeSpeedj(solution.joint_velocities, config_.timeout_ms)) {
+            ELITE_LOG_WARN("Failed to write the joint velocities of the Cartesian twist");
+        }
+
+        bool below = solution.manipulability < config_.manipulability_threshold;
+        if (below == below_threshold_) {
+            return;
+        }
+        below_threshold_ = below;
+        ManipulabilityCallback cb = manipulability_cb_;
+        lock.unlock();
+        if (below) {
+            ELITE_LOG_WARN("Close to a singularity, manipulability: %f", solution.manipulability);
+        }
+        double manipulability = solution.manipulability;
+        if (cb && !dispatchCallback(executor_, [cb, manipulability, below]() { cb(manipulability, below); })) {
+            ELITE_LOG_WARN("Manipulability callback dropped");
+        }
+    }
+};
+
+CartesianVelocityStreamer::CartesianVelocityStreamer(RtsiFrameSource& rtsi, DriverCommandWriter& driver,
+                                                     const Kinematics& kinematics, CallbackExecutorSharedPtr executor)
+    : impl_(new Impl(rtsi, driver, kinematics, std::move(executor))) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+CartesianVelocityStreamer::~CartesianVelocityStreamer() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool CartesianVelocityStreamer::start(const CartesianVelocityConfig& config) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->streaming_) {
+        return false;
+    }
+    impl_->config_ = config;
+    impl_->twist_.fill(0);
+    impl_->twist_time_ = steady_clock::now();
+    impl_->below_threshold_ = false;
+    impl_->max_solve_ = nanoseconds(0);
+    impl_->total_solve_ = nanoseconds(0);
+    impl_->solves_ = 0;
+    impl_->streaming_ = true;
+    return true;
+}
+
+void CartesianVelocityStreamer::stop() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (!impl_->streaming_) {
+        return;
+    }
+    impl_->streaming_ = false;
+    impl_->driver_.writeSpeedj(vector6d_t{}, impl_->config_.timeout_ms);
+}
+
+bool CartesianVelocityStreamer::isStreaming() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->streaming_;
+}
+
+void CartesianVelocityStreamer::setTwist(const vector6d_t& twist) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->twist_ = twist;
+    impl_->twist_time_ = steady_clock::now();
+}
+
+CartesianVelocitySolution CartesianVelocityStreamer::getLastSolution() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->solution_;
+}
+
+void CartesianVelocityStreamer::getSolveTime(nanoseconds& max, nanoseconds& mean) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    max = impl_->max_solve_;
+    mean = impl_->solves_ ? impl_->total_solve_ / (int64_t)impl_->solves_ : nanoseconds(0);
+}
+
+void CartesianVelocityStreamer::setManipulabilityCallback(ManipulabilityCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->manipulability_cb_ = std::move(cb);
+}
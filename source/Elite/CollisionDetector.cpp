@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "CollisionDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "ContactResidual.hpp"
+#include "Log.hpp"
+
+using namespace ELITE;
+using namespace std::chrono;
+
+class CollisionDetector::Impl {
+   public:
+    RtsiFrameSource& rtsi_;
+    DriverCommandWriter& driver_;
+    Dynamics dynamics_;
+    CallbackExecutorSharedPtr executor_;
+    int frame_cb_handle_;
+
+    // Locked by the receive thread for every frame, the other users only change the state
+    std::mutex mutex_;
+    CollisionConfig config_;
+    bool armed_;
+    bool in_collision_;
+    int over_frames_;
+    CONTACT::ResidualFilter filters_[6];
+    vector6d_t residuals_;
+
+    // The previous frame, for the accelerations
+    bool has_previous_;
+    double previous_time_;
+    vector6d_t previous_speeds_;
+    vector6d_t accelerations_;
+    steady_clock::time_point host_start_;
+
+    bool has_collision_;
+    CollisionEvent last_collision_;
+    CollisionStats stats_;
+    nanoseconds total_frame_time_;
+    CollisionCallback collision_cb_;
+
+    Impl(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Dynamics& dynamics, CallbackExecutorSharedPtr executor)
+        : rtsi_(rtsi),
+          driver_(driver),
+          dynamics_(dynamics),
+          executor_(std::move(executor)),
+          frame_cb_handle_(-1),
+          armed_(false),
+          in_collision_(false),
+          over_frames_(0),
+          residuals_{},
+          has_previous_(false),
+          previous_time_(0),
+          previous_speeds_{},
+          accelerations_{},
+          host_start_(steady_clock::now()),
+          has_collision_(false),
+          total_frame_time_(0) {}
+
+    void onFrame() {
+        auto frame_time = steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!armed_) {
+            return;
+        }
+        CollisionEvent event;
+        vector6d_t speeds;
+        if (!rtsi_.getRecipeValue("actual_joint_positions", event.joint_positions) ||
+            !rtsi_.getRecipeValue("actual_joint_speeds", speeds) || !readTorques(event.measured_torques)) {
+            return;
+        }
+        double time;
+        if (!rtsi_.getRecipeValue("timestamp", time)) {
+            time = duration<double>(frame_time - host_start_).count();
+        }
+        event.timestamp = time;
+        updateAccelerations(time, speeds);
+
+        dynamics_.inverseDynamics(event.joint_positions, speeds, accelerations_, event.expected_torques);
+        double max_ratio = 0;
+        for (int i = 0; i < 6; i++) {
+            double friction = config_.friction_deadband > 0
+                                  ? std::min(std::max(speeds[i] / config_.friction_deadband, -1.0), 1.0)
+                                  : (speeds[i] > 0) - (speeds[i] < 0);
+            event.expected_torques[i] += config_.coulomb_friction[i] * friction + config_.viscous_friction[i] * speeds[i];
+            residuals_[i] = filters_[i].update(event.measured_torques[i] - event.expected_torques[i]);
+            if (config_.thresholds[i] > 0) {
+                double ratio = std::abs(residuals_[i]) / config_.thresholds[i];
+                if (ratio > max_ratio) {
+                    max_ratio = ratio;
+                    event.joint = i;
+                    event.residual = residuals_[i];
+                }
+            }
+        }
+
+        if (max_ratio < 1) {
+            over_frames_ = 0;
+            for (auto& filter : filters_) {
+                filter.adapt();
+            }
+            addFrameTime(steady_clock::now() - frame_time);
+            return;
+        }
+        if (++over_frames_ < config_.debounce_frames) {
+            addFrameTime(steady_clock::now() - frame_time);
+            return;
+        }
+
+        // Collision: stop first, then report
+        if (config_.stop) {
+            event.stop_sent = driver_.writeToolContact(config_.stop_timeout_ms, ToolContactOwner::COLLISION_DETECTOR);
+        }
+        event.detect_to_send = duration_cast<microseconds>(steady_clock::now() - frame_time);
+        addFrameTime(steady_clock::now() - frame_time);
+        armed_ = false;
+        in_collision_ = true;
+        has_collision_ = true;
+        last_collision_ = event;
+        stats_.collisions++;
+        CollisionCallback cb = collision_cb_;
+        lock.unlock();
+
+        if (config_.stop && !event.stop_sent) {
+            ELITE_LOG_ERROR("Collision detected on joint %d, but the stop command could not be sent", event.joint + 1);
+        } else {
+            ELITE_LOG_WARN("Collision detected on joint %d, residual: %f N*m", event.joint + 1, event.residual);
+        }
+        if (cb && !dispatchCallback(executor_, [cb, event]() { cb(event); })) {
+            ELITE_LOG_WARN("Collision callback dropped");
+        }
+    }
+
+    bool readTorques(vector6d_t& torques) {
+        if (config_.source == CollisionSource::JOINT_TORQUE) {
+            return rtsi_.getRecipeValue("actual_joint_torques", torques);
+        }
+        if (!rtsi_.getRecipeValue("actual_joint_current", torques)) {
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            torques[i] *= config_.torque_constants[i];
+        }
+        return true;
+    }
+
+    void updateAccelerations(double time, const vector6d_t& speeds) {
+        double dt = time - previous_time_;
+        if (has_previous_ && dt > 0) {
+            for (int i = 0; i < 6; i++) {
+                double acceleration = (speeds[i] - previous_speeds_[i]) / dt;
+                accelerations_[i] += config_.acceleration_alpha * (acceleration - accelerations_[i]);
+            }
+        }
+        has_previous_ = true;
+        previous_time_ = time;
+        previous_speeds_ = speeds;
+    }
+
+    void addFrameTime(nanoseconds elapsed) {
+        stats_.frames++;
+        stats_.max_frame_time = std::max(stats_.max_frame_time, elapsed);
+        total_frame_time_ += elapsed;
+        stats_.mean_frame_time = total_frame_time_ / (int64_t)stats_.frames;
+    }
+};
+
+CollisionDetector::CollisionDetector(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Dynamics& dynamics,
+                                     CallbackExecutorSharedPtr executor)
+    : impl_(new Impl(rtsi, driver, dynamics, std::move(executor))) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+CollisionDetector::~CollisionDetector() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool CollisionDetector::arm(const CollisionConfig& config) {
+    bool watched = false;
+    for (double threshold : config.thresholds) {
+        watched = watched || threshold > 0;
+    }
+    if (!watched) {
+        return false;
+    }
+    if (!(config.filter_alpha > 0 && config.filter_alpha <= 1) || !(config.baseline_alpha >= 0 && config.baseline_alpha < 1) ||
+        !(config.acceleration_alpha > 0 && config.acceleration_alpha <= 1)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->config_ = config;
+    impl_->over_frames_ = 0;
+    for (auto& filter : impl_->filters_) {
+        filter = CONTACT::ResidualFilter(config.filter_alpha, config.baseline_alpha);
+    }
+    impl_->residuals_.fill(0);
+    impl_->has_previous_ = false;
+    impl_->accelerations_.fill(0);
+    impl_->armed_ = true;
+    return true;
+}
+
+void CollisionDetector::disarm() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->armed_ = false;
+}
+
+bool CollisionDetector::isArmed() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->armed_;
+}
+
+bool CollisionDetector::inCollision() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->in_collision_;
+}
+
+void CollisionDetector::release() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->in_collision_ = false;
+    impl_->driver_.clearToolContact(ToolContactOwner::COLLISION_DETECTOR);
+}
+
+void CollisionDetector::setPayload(double mass, const vector3d_t& cog) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->dynamics_.setPayload(mass, cog);
+}
+
+void CollisionDetector::setCollisionCallback(CollisionCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->collision_cb_ = std::move(cb);
+}
+
+bool CollisionDetector::getLastCollision(CollisionEvent& event) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->has_collision_) {
+        event = impl_->last_collision_;
+    }
+    return impl_->has_collision_;
+}
+
+vector6d_t CollisionDetector::getResiduals() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->residuals_;
+}
+
+CollisionStats CollisionDetector::getStats() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->stats_;
+}
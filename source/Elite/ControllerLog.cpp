@@ -2,24 +2,98 @@
 // Copyright (c) 2025, Elite Robots.
 #include "Elite/ControllerLog.hpp"
 #include "Elite/Log.hpp"
+#include "Common/GzipStream.hpp"
 #include "Common/SshUtils.hpp"
 
 #include <cstdlib>
 #include <algorithm>
+#include <fstream>
 
 namespace ELITE {
-bool ControllerLog::downloadSystemLog(const std::string &robot_ip,
-                                      const std::string &password,
-                                      const std::string &path, 
-                                      std::function<void (int f_z, int r_z, const char *err)> progress_cb) {
-    
+
+static std::string remoteLogPath(const std::string &robot_ip, const std::string &password) {
     std::string command = "bash -lc 'printenv RT_ROBOT_DATA_PATH'";
     std::string remote_path = SSH_UTILS::executeCommand(robot_ip, "root", password, command);
     // Erase '\n'
     remote_path.erase(std::remove(remote_path.begin(), remote_path.end(), '\n'), remote_path.end());
     remote_path += "log/log_history.csv";
     ELITE_LOG_DEBUG("Remote path: %s", remote_path.c_str());
+    return remote_path;
+}
+
+#ifdef ELITE_USE_ZLIB
+static bool downloadCompressed(const std::string &robot_ip, const std::string &password, const std::string &remote_path,
+                               const std::string &path,
+                               const std::function<void(int f_z, int c_z, int r_z, const char *err)> &progress_cb) {
+    std::string size_out = SSH_UTILS::executeCommand(robot_ip, "root", password, "stat -c %s '" + remote_path + "'");
+    int file_size = std::atoi(size_out.c_str());
+
+    std::ofstream local_file(path, std::ios::binary | std::ios::trunc);
+    if (!local_file) {
+        ELITE_LOG_ERROR("Failed to open local file: %s", path.c_str());
+        return false;
+    }
+    GzipInflater inflater;
+    const char *err = nullptr;
+    auto write_cb = [&](const char *data, size_t size) {
+        local_file.write(data, size);
+        if (!local_file) {
+            err = "Failed to write local file";
+        }
+        return err == nullptr;
+    };
+    bool ok = SSH_UTILS::executeCommandStream(
+        robot_ip, "root", password, "gzip -c '" + remote_path + "'", [&](const char *data, size_t size) {
+            if (!inflater.feed(data, size, write_cb) && !err) {
+                err = "Invalid gzip stream";
+            }
+            if (progress_cb) {
+                progress_cb(file_size, inflater.compressedBytes(), inflater.uncompressedBytes(), err);
+            }
+            return err == nullptr;
+        });
+    if (!ok || !inflater.finished()) {
+        ELITE_LOG_WARN("Compressed log download fail: %s", err ? err : "incomplete stream");
+        return false;
+    }
+    ELITE_LOG_INFO("Log downloaded: %llu bytes compressed to %llu", (unsigned long long)inflater.uncompressedBytes(),
+                   (unsigned long long)inflater.compressedBytes());
+    return true;
+}
+#endif
+
+bool ControllerLog::downloadSystemLog(const std::string &robot_ip,
+                                      const std::string &password,
+                                      const std::string &path, 
+                                      std::function<void (int f_z, int r_z, const char *err)> progress_cb) {
+    std::string remote_path = remoteLogPath(robot_ip, password);
+#ifdef ELITE_USE_ZLIB
+    auto compressed_cb = [&](int f_z, int c_z, int r_z, const char *err) {
+        (void)c_z;
+        if (progress_cb) {
+            progress_cb(f_z, r_z, err);
+        }
+    };
+    if (downloadCompressed(robot_ip, password, remote_path, path, compressed_cb)) {
+        return true;
+    }
+#endif
     return SSH_UTILS::downloadFile(robot_ip, "root", password, remote_path, path, progress_cb);
 }
 
-} // namespace ELITE
\ No newline at end of file
+bool ControllerLog::downloadSystemLogCompressed(const std::string &robot_ip, const std::string &password, const std::string &path,
+                                                std::function<void(int f_z, int c_z, int r_z, const char *err)> progress_cb) {
+    std::string remote_path = remoteLogPath(robot_ip, password);
+#ifdef ELITE_USE_ZLIB
+    if (downloadCompressed(robot_ip, password, remote_path, path, progress_cb)) {
+        return true;
+    }
+#endif
+    return SSH_UTILS::downloadFile(robot_ip, "root", password, remote_path, path, [&](int f_z, int r_z, const char *err) {
+        if (progress_cb) {
+            progress_cb(f_z, r_z, r_z, err);
+        }
+    });
+}
+
+} // namespace ELITE
@@ -2,10 +2,13 @@
 // Copyright (c) 2025, Elite Robots.
 #include "EliteDriver.hpp"
 #include <boost/asio.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include "ControlCommon.hpp"
 #include "ControlMode.hpp"
 #include "EliteException.hpp"
@@ -37,6 +40,7 @@ static const std::string STOP_J_REPLACE = "{{STOP_J_REPLACE}}";
 static const std::string SERVOJ_TIME_REPLACE = "{{SERVOJ_TIME_REPLACE}}";
 static const std::string SERVOJ_QUEUE_PRE_RECV_SIZE_REPLACE = "{{SERVOJ_QUEUE_PRE_RECV_SIZE_REPLACE}}";
 static const std::string SERVOJ_QUEUE_PRE_RECV_TIMEOUT_REPLACE = "{{SERVOJ_QUEUE_PRE_RECV_TIMEOUT_REPLACE}}";
+static const std::string REATTACH_TIMEOUT_REPLACE = "{{REATTACH_TIMEOUT_REPLACE}}";
 
 class EliteDriver::Impl {
    public:
@@ -55,6 +59,7 @@ class EliteDriver::Impl {
     }
 
     std::string readScriptFile(const std::string& file);
+    void onConnectionChanged(DriverServer server, bool connected, std::chrono::steady_clock::time_point timestamp);
     void scriptParamWrite(std::string& file_string, const EliteDriverConfig& config);
     int getSocatPid(const std::string& ssh_password, int port);
     std::string robot_script_;
@@ -68,8 +73,48 @@ class EliteDriver::Impl {
     bool headless_mode_;
 
     std::shared_ptr<TcpServer::StaticResource> reverse_resource_;
+
+    // Notified on every connection event of the servers
+    std::mutex connection_mutex_;
+    std::condition_variable connection_cv_;
+    std::function<void(const ConnectionEvent&)> connection_cb_;
+
+    CallbackExecutorSharedPtr callback_executor_;
+
+    // Motion commands and the tool contact command are written under the same lock, so a motion command can't be written after
+    // the contact and move the robot again.
+    std::mutex motion_mutex_;
+    // A bit per ToolContactOwner
+    std::atomic<int> tool_contact_{0};
+
+    template <typename F>
+    bool writeMotion(int timeout_ms, F write) {
+        std::lock_guard<std::mutex> lock(motion_mutex_);
+        if (tool_contact_) {
+            // Keep the script alive and the robot stopped
+            reverse_server_->writeJointCommand(nullptr, ControlMode::MODE_TOOL_IN_CONTACT, timeout_ms);
+            return false;
+        }
+        return write();
+    }
 };
 
+void EliteDriver::Impl::onConnectionChanged(DriverServer server, bool connected, std::chrono::steady_clock::time_point timestamp) {
+    std::function<void(const ConnectionEvent&)> cb;
+    {
+        // Lock before notify, so that a waiter which checked the state before this event can't miss it
+        std::lock_guard<std::mutex> lock(connection_mutex_);
+        cb = connection_cb_;
+    }
+    connection_cv_.notify_all();
+    if (cb) {
+        ConnectionEvent event{server, connected, timestamp};
+        if (!dispatchCallback(callback_executor_, [cb, event]() { cb(event); })) {
+            ELITE_LOG_WARN("Connection callback dropped");
+        }
+    }
+}
+
 std::string EliteDriver::Impl::readScriptFile(const std::string& filepath) {
     std::ifstream ifs;
     ifs.open(filepath);
@@ -164,6 +209,12 @@ void EliteDriver::Impl::scriptParamWrite(std::string& file_string, const EliteDr
         file_string.replace(file_string.find(SERVOJ_QUEUE_PRE_RECV_TIMEOUT_REPLACE), SERVOJ_QUEUE_PRE_RECV_TIMEOUT_REPLACE.length(),
                             std::to_string(servoj_queue_pre_recv_timeout));
     }
+
+    float reattach_timeout = config.reattach_timeout > 0 ? config.reattach_timeout : 0;
+    while (file_string.find(REATTACH_TIMEOUT_REPLACE) != std::string::npos) {
+        file_string.replace(file_string.find(REATTACH_TIMEOUT_REPLACE), REATTACH_TIMEOUT_REPLACE.length(),
+                            std::to_string(reattach_timeout));
+    }
 }
 
 void EliteDriver::init(const EliteDriverConfig& config) {
@@ -173,7 +224,9 @@ void EliteDriver::init(const EliteDriverConfig& config) {
 
     // First, need to connect to the robot primary port before attempting to obtain the local IP address
     ELITE_LOG_DEBUG("Connecting to robot primary port %s ...", config.robot_ip.c_str());
+    impl_->callback_executor_ = config.callback_executor;
     impl_->primary_port_ = std::make_unique<PrimaryPortInterface>();
+    impl_->primary_port_->setCallbackExecutor(impl_->callback_executor_);
     if (!impl_->primary_port_->connect(impl_->robot_ip_, PrimaryPortInterface::PRIMARY_PORT)) {
         ELITE_LOG_FATAL("Connect robot primary port fail.");
         throw EliteException(EliteException::Code::SOCKET_CONNECT_FAIL, "Connect robot primary port fail.");
@@ -190,13 +243,49 @@ void EliteDriver::init(const EliteDriverConfig& config) {
     ELITE_LOG_DEBUG("Read script file '%s' success.", config.script_file_path.c_str());
     impl_->scriptParamWrite(control_script, config);
 
+    if (config.inherit_listen_sockets) {
+        int count = 0;
+        if (!config.listen_fds.empty()) {
+            count = impl_->reverse_resource_->addListenSockets(config.listen_fds);
+        } else {
+            // A socket named after a server is used for the port of that server, the others for the port they are bound to
+            const std::unordered_map<std::string, int> named_ports = {{"reverse", config.reverse_port},
+                                                                      {"trajectory", config.trajectory_port},
+                                                                      {"script_command", config.script_command_port},
+                                                                      {"script_sender", config.script_sender_port}};
+            std::vector<int> unnamed;
+            for (auto& socket : TcpServer::activationListenSockets()) {
+                auto iter = named_ports.find(socket.name);
+                if (iter == named_ports.end()) {
+                    unnamed.push_back(socket.fd);
+                } else if (impl_->reverse_resource_->addListenSocket(socket.fd, iter->second)) {
+                    count++;
+                }
+            }
+            count += impl_->reverse_resource_->addListenSockets(unnamed);
+        }
+        ELITE_LOG_INFO("Inherited %d listening sockets", count);
+    }
+
     impl_->reverse_server_ = std::make_unique<ReverseInterface>(config.reverse_port, impl_->reverse_resource_);
     ELITE_LOG_DEBUG("Created reverse interface");
-    impl_->trajectory_server_ = std::make_unique<TrajectoryInterface>(config.trajectory_port, impl_->reverse_resource_);
+    impl_->trajectory_server_ = std::make_unique<TrajectoryInterface>(config.trajectory_port, impl_->reverse_resource_,
+                                                                      impl_->callback_executor_);
     ELITE_LOG_DEBUG("Created trajectory interface");
     impl_->script_command_server_ = std::make_unique<ScriptCommandInterface>(config.script_command_port, impl_->reverse_resource_);
     ELITE_LOG_DEBUG("Created script command interface");
 
+    Impl* impl = impl_.get();
+    impl_->reverse_server_->setConnectionCallback([impl](bool connected, std::chrono::steady_clock::time_point timestamp) {
+        impl->onConnectionChanged(DriverServer::REVERSE, connected, timestamp);
+    });
+    impl_->trajectory_server_->setConnectionCallback([impl](bool connected, std::chrono::steady_clock::time_point timestamp) {
+        impl->onConnectionChanged(DriverServer::TRAJECTORY, connected, timestamp);
+    });
+    impl_->script_command_server_->setConnectionCallback([impl](bool connected, std::chrono::steady_clock::time_point timestamp) {
+        impl->onConnectionChanged(DriverServer::SCRIPT_COMMAND, connected, timestamp);
+    });
+
     impl_->headless_mode_ = config.headless_mode;
 
     if (impl_->headless_mode_) {
@@ -208,7 +297,9 @@ void EliteDriver::init(const EliteDriverConfig& config) {
         }
         impl_->robot_script_ += "end";
 
-        if (sendExternalControlScript()) {
+        if (config.reattach) {
+            ELITE_LOG_INFO("Reattach to the running external control script, the script is not sent.");
+        } else if (sendExternalControlScript()) {
             ELITE_LOG_DEBUG("Sent external control script to robot.");
         } else {
             ELITE_LOG_DEBUG("Send external control script to robot fail.");
@@ -247,45 +338,74 @@ EliteDriver::EliteDriver(const std::string& robot_ip, const std::string& local_i
 EliteDriver::~EliteDriver() { impl_.reset(); }
 
 bool EliteDriver::writeServoj(const vector6d_t& pos, int timeout_ms, bool cartesian, bool queue_mode) {
+    ControlMode mode;
     if (cartesian) {
-        if (queue_mode) {
-            return impl_->reverse_server_->writeJointCommand(pos, ControlMode::MODE_POSE_QUEUE, timeout_ms);
-        } else {
-            return impl_->reverse_server_->writeJointCommand(pos, ControlMode::MODE_POSE, timeout_ms);
-        }
+        mode = queue_mode ? ControlMode::MODE_POSE_QUEUE : ControlMode::MODE_POSE;
     } else {
-        if (queue_mode) {
-            return impl_->reverse_server_->writeJointCommand(pos, ControlMode::MODE_SERVOJ_QUEUE, timeout_ms);
-        } else {
-            return impl_->reverse_server_->writeJointCommand(pos, ControlMode::MODE_SERVOJ, timeout_ms);
-        }
+        mode = queue_mode ? ControlMode::MODE_SERVOJ_QUEUE : ControlMode::MODE_SERVOJ;
     }
+    return impl_->writeMotion(timeout_ms, [&]() { return impl_->reverse_server_->writeJointCommand(pos, mode, timeout_ms); });
 }
 
 bool EliteDriver::writeSpeedl(const vector6d_t& vel, int timeout_ms) {
-    return impl_->reverse_server_->writeJointCommand(vel, ControlMode::MODE_SPEEDL, timeout_ms);
+    return impl_->writeMotion(timeout_ms,
+                              [&]() { return impl_->reverse_server_->writeJointCommand(vel, ControlMode::MODE_SPEEDL, timeout_ms); });
 }
 
 bool EliteDriver::writeSpeedj(const vector6d_t& vel, int timeout_ms) {
-    return impl_->reverse_server_->writeJointCommand(vel, ControlMode::MODE_SPEEDJ, timeout_ms);
+    return impl_->writeMotion(timeout_ms,
+                              [&]() { return impl_->reverse_server_->writeJointCommand(vel, ControlMode::MODE_SPEEDJ, timeout_ms); });
 }
 
 void EliteDriver::setTrajectoryResultCallback(std::function<void(TrajectoryMotionResult)> cb) {
     impl_->trajectory_server_->setMotionResultCallback(cb);
 }
 
+std::function<void(TrajectoryMotionResult)> EliteDriver::getTrajectoryResultCallback() {
+    return impl_->trajectory_server_->getMotionResultCallback();
+}
+
 bool EliteDriver::writeTrajectoryPoint(const vector6d_t& positions, float time, float blend_radius, bool cartesian) {
     return impl_->trajectory_server_->writeTrajectoryPoint(positions, time, blend_radius, cartesian);
 }
 
+bool EliteDriver::writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities, float time) {
+    return impl_->trajectory_server_->writeTrajectorySplinePoint(positions, velocities, nullptr, time);
+}
+
+bool EliteDriver::writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities,
+                                             const vector6d_t& accelerations, float time) {
+    return impl_->trajectory_server_->writeTrajectorySplinePoint(positions, velocities, &accelerations, time);
+}
+
 bool EliteDriver::writeTrajectoryControlAction(TrajectoryControlAction action, const int point_number, int robot_receive_timeout) {
-    return impl_->reverse_server_->writeTrajectoryControlAction(action, point_number, robot_receive_timeout);
+    return impl_->writeMotion(robot_receive_timeout, [&]() {
+        return impl_->reverse_server_->writeTrajectoryControlAction(action, point_number, robot_receive_timeout);
+    });
 }
 
 bool EliteDriver::writeFreedrive(FreedriveAction action, int timeout_ms) {
-    return impl_->reverse_server_->writeFreedrive(action, timeout_ms);
+    return impl_->writeMotion(timeout_ms, [&]() { return impl_->reverse_server_->writeFreedrive(action, timeout_ms); });
+}
+
+bool EliteDriver::writeToolContact(int timeout_ms, ToolContactOwner owner) {
+    std::lock_guard<std::mutex> lock(impl_->motion_mutex_);
+    impl_->tool_contact_ |= 1 << (int)owner;
+    return impl_->reverse_server_->writeJointCommand(nullptr, ControlMode::MODE_TOOL_IN_CONTACT, timeout_ms);
+}
+
+void EliteDriver::clearToolContact() {
+    std::lock_guard<std::mutex> lock(impl_->motion_mutex_);
+    impl_->tool_contact_ = 0;
+}
+
+void EliteDriver::clearToolContact(ToolContactOwner owner) {
+    std::lock_guard<std::mutex> lock(impl_->motion_mutex_);
+    impl_->tool_contact_ &= ~(1 << (int)owner);
 }
 
+bool EliteDriver::isToolInContact() { return impl_->tool_contact_ != 0; }
+
 bool EliteDriver::stopControl(int wait_ms) {
     if (wait_ms < 5) {
         wait_ms = 5;
@@ -294,14 +414,13 @@ bool EliteDriver::stopControl(int wait_ms) {
         return false;
     }
 
-    auto start_time = std::chrono::steady_clock::now();
-    auto timeout = std::chrono::milliseconds(wait_ms);
-    while (impl_->script_command_server_->isRobotConnect() || impl_->reverse_server_->isRobotConnect()) {
-        auto elapsed = std::chrono::steady_clock::now() - start_time;
-        if (elapsed >= timeout) {
+    {
+        std::unique_lock<std::mutex> lock(impl_->connection_mutex_);
+        if (!impl_->connection_cv_.wait_for(lock, std::chrono::milliseconds(wait_ms), [&]() {
+                return !impl_->script_command_server_->isRobotConnect() && !impl_->reverse_server_->isRobotConnect();
+            })) {
             return false;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
 
     return !isRobotConnected();
@@ -318,6 +437,24 @@ bool EliteDriver::isRobotConnected() {
            impl_->script_command_server_->isRobotConnect();
 }
 
+bool EliteDriver::waitRobotConnection(bool connected, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(impl_->connection_mutex_);
+    return impl_->connection_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                          [&]() { return isRobotConnected() == connected; });
+}
+
+void EliteDriver::registerConnectionCallback(std::function<void(const ConnectionEvent&)> cb) {
+    std::lock_guard<std::mutex> lock(impl_->connection_mutex_);
+    impl_->connection_cb_ = std::move(cb);
+}
+
+CallbackExecutorStats EliteDriver::getCallbackExecutorStats() {
+    if (!impl_->callback_executor_) {
+        return CallbackExecutorStats();
+    }
+    return impl_->callback_executor_->getStats();
+}
+
 bool EliteDriver::zeroFTSensor() { return impl_->script_command_server_->zeroFTSensor(); }
 
 bool EliteDriver::setPayload(double mass, const vector3d_t& cog) { return impl_->script_command_server_->setPayload(mass, cog); }
@@ -331,6 +468,35 @@ bool EliteDriver::startForceMode(const vector6d_t& reference_frame, const vector
 
 bool EliteDriver::endForceMode() { return impl_->script_command_server_->endForceMode(); }
 
+std::future<ScriptCommandAck> EliteDriver::zeroFTSensorAsync(int timeout_ms) {
+    return impl_->script_command_server_->zeroFTSensorAsync(timeout_ms);
+}
+
+std::future<ScriptCommandAck> EliteDriver::setPayloadAsync(double mass, const vector3d_t& cog, int timeout_ms) {
+    return impl_->script_command_server_->setPayloadAsync(mass, cog, timeout_ms);
+}
+
+std::future<ScriptCommandAck> EliteDriver::setToolVoltageAsync(const ToolVoltage& vol, int timeout_ms) {
+    return impl_->script_command_server_->setToolVoltageAsync(vol, timeout_ms);
+}
+
+std::future<ScriptCommandAck> EliteDriver::startForceModeAsync(const vector6d_t& reference_frame,
+                                                               const vector6int32_t& selection_vector, const vector6d_t& wrench,
+                                                               const ForceMode& mode, const vector6d_t& limits, int timeout_ms) {
+    return impl_->script_command_server_->startForceModeAsync(reference_frame, selection_vector, wrench, mode, limits,
+                                                              timeout_ms);
+}
+
+std::future<ScriptCommandAck> EliteDriver::endForceModeAsync(int timeout_ms) {
+    return impl_->script_command_server_->endForceModeAsync(timeout_ms);
+}
+
+std::future<ScriptCommandAck> EliteDriver::pingScriptCommand(int timeout_ms) {
+    return impl_->script_command_server_->ping(timeout_ms);
+}
+
+ScriptCommandStats EliteDriver::getScriptCommandStats(ScriptCommand cmd) { return impl_->script_command_server_->getStats(cmd); }
+
 bool EliteDriver::sendScript(const std::string& script) {
     if (!impl_->primary_port_) {
         ELITE_LOG_ERROR("Not connect to robot primary port");
@@ -339,6 +505,13 @@ bool EliteDriver::sendScript(const std::string& script) {
     return impl_->primary_port_->sendScript(script);
 }
 
+ScriptSendStats EliteDriver::getScriptSendStats() {
+    if (!impl_->primary_port_) {
+        return ScriptSendStats();
+    }
+    return impl_->primary_port_->getScriptSendStats();
+}
+
 bool EliteDriver::sendExternalControlScript() {
     if (!impl_->headless_mode_) {
         ELITE_LOG_ERROR("Not in headless mode");
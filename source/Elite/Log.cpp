@@ -2,6 +2,7 @@
 // Copyright (c) 2025, Elite Robots.
 #include "Log.hpp"
 #include "Logger.hpp"
+#include "Trace.hpp"
 #include <cstdarg>
 
 
@@ -22,6 +23,7 @@ void setLogLevel(LogLevel level) {
 
 void log(const char* file, int line, LogLevel level, const char* fmt, ...) {
     if (level >= getLogger().getLogLevel()) {
+        ELITE_TRACE_SCOPE("log");
         size_t buffer_size = 4096;
         std::unique_ptr<char[]> buffer;
         buffer.reset(new char[buffer_size]);
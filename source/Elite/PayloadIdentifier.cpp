@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "PayloadIdentifier.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Log.hpp"
+
+using namespace ELITE;
+
+namespace {
+
+// Offsets of joints 2~6 in units of the amplitude. The wrist poses turn the payload in gravity about all flange axes, the
+// small moves of joints 2 and 3 separate the offsets of those joints from the gravity.
+const double EXCITATION[][5] = {
+    {0, 0, 1, 0, 0},          {0, 0, 1, 1, 0},         {0, 0, 0, 1, 1},     {0, 0, -1, 1, -1}, {0, 0, -1, -1, 0},
+    {0, 0, 0, -1, 1},         {1. / 3, -1. / 3, 1, 0, 1}, {-1. / 3, 1. / 3, -1, 1, 0}, {0, 0, 0, 0, 0},
+};
+
+}  // namespace
+
+class PayloadIdentifier::Impl {
+   public:
+    enum class Phase { IDLE, ARM, PAYLOAD };
+
+    RtsiFrameSource& rtsi_;
+    DriverCommandWriter& driver_;
+    CallbackExecutorSharedPtr executor_;
+    int frame_cb_handle_;
+
+    std::mutex mutex_;
+    PayloadEstimator estimator_;
+    Phase phase_;
+    PayloadIdentificationConfig config_;
+    bool result_cb_set_;
+    DoneCallback done_cb_;
+
+    // Writes the NOOP actions which keep the trajectory alive, out of the RTSI receive thread
+    std::unique_ptr<std::thread> keep_alive_thread_;
+    std::condition_variable keep_alive_cv_;
+    bool exit_;
+
+    Impl(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Kinematics& kinematics, CallbackExecutorSharedPtr executor)
+        : rtsi_(rtsi),
+          driver_(driver),
+          executor_(std::move(executor)),
+          frame_cb_handle_(-1),
+          estimator_(kinematics),
+          phase_(Phase::IDLE),
+          result_cb_set_(false),
+          exit_(false) {}
+
+    void keepAliveLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!exit_) {
+            if (phase_ == Phase::IDLE) {
+                keep_alive_cv_.wait(lock, [&]() { return exit_ || phase_ != Phase::IDLE; });
+                continue;
+            }
+            int timeout_ms = config_.timeout_ms;
+            lock.unlock();
+            driver_.writeTrajectoryControlAction(TrajectoryControlAction::NOOP, 0, timeout_ms);
+            lock.lock();
+            // Twice per read timeout of the script
+            keep_alive_cv_.wait_for(lock, std::chrono::milliseconds(std::max(timeout_ms / 2, 1)),
+                                    [&]() { return exit_ || phase_ == Phase::IDLE; });
+        }
+    }
+
+    void onFrame() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (phase_ == Phase::IDLE) {
+            return;
+        }
+        vector6d_t q, qd, torques;
+        if (!rtsi_.getRecipeValue("actual_joint_positions", q) || !rtsi_.getRecipeValue("actual_joint_speeds", qd) ||
+            !rtsi_.getRecipeValue("actual_joint_torques", torques)) {
+            return;
+        }
+        if (phase_ == Phase::ARM) {
+            estimator_.updateArm(q, qd, torques);
+        } else {
+            estimator_.updatePayload(q, qd, torques);
+        }
+    }
+
+    void onResult(TrajectoryMotionResult result) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (phase_ == Phase::IDLE) {
+            return;
+        }
+        Phase phase = phase_;
+        phase_ = Phase::IDLE;
+        bool success = result == TrajectoryMotionResult::SUCCESS;
+        PayloadEstimate estimate;
+        if (phase == Phase::ARM) {
+            ArmGravityModel model = estimator_.getArmModel();
+            estimate.mass = model.reference_mass;
+            estimate.cog = model.reference_cog;
+            estimate.valid = model.valid;
+            if (!success) {
+                // A partly learned model is not kept
+                estimator_.setArmModel(ArmGravityModel());
+            }
+        } else {
+            estimate = estimator_.getEstimate();
+        }
+        success = success && estimate.valid;
+        bool apply = success && phase == Phase::PAYLOAD && config_.apply;
+        DoneCallback cb = done_cb_;
+        lock.unlock();
+
+        if (!success) {
+            ELITE_LOG_ERROR("Payload identification failed");
+        } else if (phase == Phase::PAYLOAD) {
+            ELITE_LOG_INFO("Payload identified, mass: %f kg, center of gravity: [%f, %f, %f] m, residual: %f N*m", estimate.mass,
+                           estimate.cog[0], estimate.cog[1], estimate.cog[2], estimate.residual_rms);
+        }
+        if (apply && !driver_.setPayload(estimate.mass, estimate.cog)) {
+            ELITE_LOG_ERROR("Failed to set the identified payload");
+            success = false;
+        }
+        if (cb && !dispatchCallback(executor_, [cb, success, estimate]() { cb(success, estimate); })) {
+            ELITE_LOG_WARN("Payload identification done callback dropped");
+        }
+    }
+
+    // Called with the mutex locked
+    bool start(Phase phase, const PayloadIdentificationConfig& config, const vector6d_t& q) {
+        std::vector<vector6d_t> points = excitation(q, config.amplitude);
+        if (!result_cb_set_) {
+            driver_.setTrajectoryResultCallback([this](TrajectoryMotionResult result) { onResult(result); });
+            result_cb_set_ = true;
+        }
+        if (!driver_.writeTrajectoryControlAction(TrajectoryControlAction::START, points.size(), config.timeout_ms)) {
+            ELITE_LOG_ERROR("Failed to start the payload excitation trajectory");
+            return false;
+        }
+        for (const auto& point : points) {
+            if (!driver_.writeTrajectoryPoint(point, config.point_time, 0, false)) {
+                ELITE_LOG_ERROR("Failed to write the payload excitation trajectory");
+                driver_.writeTrajectoryControlAction(TrajectoryControlAction::CANCEL, 0, config.timeout_ms);
+                return false;
+            }
+        }
+        config_ = config;
+        phase_ = phase;
+        keep_alive_cv_.notify_all();
+        return true;
+    }
+};
+
+PayloadIdentifier::PayloadIdentifier(RtsiFrameSource& rtsi, DriverCommandWriter& driver, const Kinematics& kinematics,
+                                     CallbackExecutorSharedPtr executor)
+    : impl_(new Impl(rtsi, driver, kinematics, std::move(executor))) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+    impl_->keep_alive_thread_.reset(new std::thread([this]() { impl_->keepAliveLoop(); }));
+}
+
+PayloadIdentifier::~PayloadIdentifier() {
+    impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_);
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        impl_->exit_ = true;
+    }
+    impl_->keep_alive_cv_.notify_all();
+    impl_->keep_alive_thread_->join();
+    if (impl_->result_cb_set_) {
+        impl_->driver_.setTrajectoryResultCallback(nullptr);
+    }
+}
+
+bool PayloadIdentifier::calibrateArm(const PayloadIdentificationConfig& config) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->phase_ != Impl::Phase::IDLE) {
+        return false;
+    }
+    vector6d_t q;
+    double mass;
+    vector3d_t cog;
+    if (!impl_->rtsi_.getRecipeValue("actual_joint_positions", q) || !impl_->rtsi_.getRecipeValue("payload_mass", mass) ||
+        !impl_->rtsi_.getRecipeValue("payload_cog", cog)) {
+        ELITE_LOG_ERROR("Arm calibration needs \"actual_joint_positions\", \"payload_mass\" and \"payload_cog\"");
+        return false;
+    }
+    impl_->estimator_.startArmCalibration(mass, cog);
+    return impl_->start(Impl::Phase::ARM, config, q);
+}
+
+bool PayloadIdentifier::identify(const PayloadIdentificationConfig& config) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->phase_ != Impl::Phase::IDLE || !impl_->estimator_.getArmModel().valid) {
+        return false;
+    }
+    vector6d_t q;
+    if (!impl_->rtsi_.getRecipeValue("actual_joint_positions", q)) {
+        return false;
+    }
+    impl_->estimator_.startPayload();
+    return impl_->start(Impl::Phase::PAYLOAD, config, q);
+}
+
+void PayloadIdentifier::cancel() {
+    int timeout_ms;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        if (impl_->phase_ == Impl::Phase::IDLE) {
+            return;
+        }
+        timeout_ms = impl_->config_.timeout_ms;
+    }
+    // The CANCELED result finishes the run
+    impl_->driver_.writeTrajectoryControlAction(TrajectoryControlAction::CANCEL, 0, timeout_ms);
+}
+
+bool PayloadIdentifier::isRunning() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->phase_ != Impl::Phase::IDLE;
+}
+
+void PayloadIdentifier::setDoneCallback(DoneCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->done_cb_ = std::move(cb);
+}
+
+PayloadEstimate PayloadIdentifier::getEstimate() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->estimator_.getEstimate();
+}
+
+ArmGravityModel PayloadIdentifier::getArmModel() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->estimator_.getArmModel();
+}
+
+void PayloadIdentifier::setArmModel(const ArmGravityModel& model) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->estimator_.setArmModel(model);
+}
+
+std::vector<vector6d_t> PayloadIdentifier::excitation(const vector6d_t& start, double amplitude) {
+    std::vector<vector6d_t> points;
+    for (const auto& offsets : EXCITATION) {
+        vector6d_t point = start;
+        for (int i = 0; i < 5; i++) {
+            point[i + 1] += offsets[i] * amplitude;
+        }
+        points.push_back(point);
+    }
+    return points;
+}
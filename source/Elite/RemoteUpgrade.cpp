@@ -2,8 +2,14 @@
 // Copyright (c) 2025, Elite Robots.
 #include <iostream>
 #include <cstdio>
+#include <fstream>
+#include <memory>
 #include <string>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Common/BlockDelta.hpp"
 #include "Common/SshUtils.hpp"
 #include "Elite/Log.hpp"
 #include "RemoteUpgrade.hpp"
@@ -16,32 +22,125 @@ namespace ELITE
 namespace UPGRADE
 {
 
-bool upgradeControlSoftware(std::string ip, std::string file, std::string password) {
+namespace
+{
+
+const std::string REMOTE_PACKAGE = "/tmp/CS_UPDATE.eup";
+// The package of the last delta variant upgrade, the base of the next delta. /tmp does not survive the upgrade.
+const std::string REMOTE_CACHE = "/root/CS_UPDATE_CACHE.eup";
+const std::string REMOTE_LITERALS = "/tmp/CS_UPDATE.lit";
+const std::string REMOTE_PATCH = "/tmp/CS_UPDATE.sh";
+constexpr size_t DELTA_BLOCK_SIZE = 16384;
+
+std::unique_ptr<boost::interprocess::mapped_region> mapFile(const std::string& path) {
+	try {
+		boost::interprocess::file_mapping mapping(path.c_str(), boost::interprocess::read_only);
+		return std::unique_ptr<boost::interprocess::mapped_region>(
+			new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+	} catch (const boost::interprocess::interprocess_exception& e) {
+		ELITE_LOG_ERROR("Can't map file %s: %s", path.c_str(), e.what());
+		return nullptr;
+	}
+}
+
+bool writeFile(const std::string& path, const void* data, size_t size) {
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(static_cast<const char*>(data), size);
+	return out.good();
+}
+
+std::string remoteMd5(const std::string& ip, const std::string& password, const std::string& path) {
+	std::string out = executeCommand(ip, "root", password, "md5sum '" + path + "' 2>/dev/null");
+	return out.size() >= 32 ? out.substr(0, 32) : "";
+}
+
+bool upload(const std::string& ip, const std::string& password, const std::string& remote, const std::string& local) {
 	auto upload_error_cb = [&](int f_z, int r_z, const char* err) {
 		if (err) {
 			ELITE_LOG_ERROR("Upload update file fail %d/%d. Reason: %s ", r_z, f_z, err);
 		}
 	};
-	// Upload update package
-	if (!uploadFile(ip, "root", password, "/tmp/CS_UPDATE.eup", file, upload_error_cb)) {
+	return uploadFile(ip, "root", password, remote, local, upload_error_cb);
+}
+
+// Build the package on the controller from its cache. False: the whole package has to be uploaded.
+bool uploadDelta(const std::string& ip, const std::string& file, const std::string& password, const std::string& previous_file) {
+	auto previous = mapFile(previous_file);
+	auto current = mapFile(file);
+	if (!previous || !current) {
+		return false;
+	}
+	const uint8_t* previous_data = static_cast<const uint8_t*>(previous->get_address());
+	const uint8_t* current_data = static_cast<const uint8_t*>(current->get_address());
+	std::string cache_md5 = remoteMd5(ip, password, REMOTE_CACHE);
+	if (cache_md5 != DELTA::md5Hex(previous_data, previous->get_size())) {
+		ELITE_LOG_INFO("The controller has no cached copy of %s, uploading the whole package", previous_file.c_str());
 		return false;
 	}
 
+	DELTA::Delta delta = DELTA::computeDelta(DELTA::signatures(previous_data, previous->get_size(), DELTA_BLOCK_SIZE),
+											 DELTA_BLOCK_SIZE, current_data, current->get_size());
+	ELITE_LOG_INFO("Delta upgrade transfer: %zu of %zu bytes changed", delta.literals.size(), current->get_size());
+	std::string literal_file = file + ".lit";
+	std::string patch_file = file + ".sh";
+	std::string script = DELTA::patchScript(delta, REMOTE_CACHE, REMOTE_LITERALS, REMOTE_PACKAGE);
+	bool ok = writeFile(literal_file, delta.literals.data(), delta.literals.size()) &&
+			  writeFile(patch_file, script.data(), script.size()) && upload(ip, password, REMOTE_LITERALS, literal_file) &&
+			  upload(ip, password, REMOTE_PATCH, patch_file);
+	std::remove(literal_file.c_str());
+	std::remove(patch_file.c_str());
+	if (!ok) {
+		return false;
+	}
+	std::string cmd_out = executeCommand(ip, "root", password, "sh " + REMOTE_PATCH + "; rm -f " + REMOTE_PATCH + " " + REMOTE_LITERALS);
+	ELITE_LOG_DEBUG("Execute patch script, output:%s", cmd_out.c_str());
+	if (remoteMd5(ip, password, REMOTE_PACKAGE) != DELTA::md5Hex(current_data, current->get_size())) {
+		ELITE_LOG_WARN("The patched upgrade package does not match, uploading the whole package");
+		return false;
+	}
+	return true;
+}
+
+bool runUpgrade(const std::string& ip, const std::string& password, bool keep_cache) {
 	// Add executable permissions to the upgrade package.
-	std::string cmd = "chmod +x /tmp/CS_UPDATE.eup";
+	std::string cmd = "chmod +x " + REMOTE_PACKAGE;
 	std::string cmd_out = executeCommand(ip, "root", password, cmd);
 	ELITE_LOG_DEBUG("Execute cmd: %s\n Output:%s", cmd.c_str(), cmd_out.c_str());
 
+	// Keep the package as the base of the next delta transfer, only for the delta variant.
+	if (keep_cache) {
+		cmd = "cp " + REMOTE_PACKAGE + " " + REMOTE_CACHE;
+		cmd_out = executeCommand(ip, "root", password, cmd);
+		ELITE_LOG_DEBUG("Execute cmd: %s\n Output:%s", cmd.c_str(), cmd_out.c_str());
+	}
+
 	// Execute the upgrade package in the bash environment.
-	cmd = "bash -lc '/tmp/CS_UPDATE.eup --app'";
+	cmd = "bash -lc '" + REMOTE_PACKAGE + " --app'";
 	cmd_out = executeCommand(ip, "root", password, cmd);
 	ELITE_LOG_DEBUG("Execute cmd: %s\n Output:%s", cmd.c_str(), cmd_out.c_str());
 	return true;
 }
 
-} // namespace UPGRADE
+} // namespace
 
+bool upgradeControlSoftware(std::string ip, std::string file, std::string password) {
+	// Upload update package
+	if (!upload(ip, password, REMOTE_PACKAGE, file)) {
+		return false;
+	}
+	return runUpgrade(ip, password, false);
+}
 
-} // namespace ELITE
+bool upgradeControlSoftware(std::string ip, std::string file, std::string password, std::string previous_file) {
+	if (previous_file.empty() || !uploadDelta(ip, file, password, previous_file)) {
+		if (!upload(ip, password, REMOTE_PACKAGE, file)) {
+			return false;
+		}
+	}
+	return runUpgrade(ip, password, true);
+}
+
+} // namespace UPGRADE
 
 
+} // namespace ELITE
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "ScaledServoStreamer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+#include "Log.hpp"
+#include "ScaledClock.hpp"
+
+using namespace ELITE;
+
+class ScaledServoStreamer::Impl {
+   public:
+    RtsiFrameSource& rtsi_;
+    DriverCommandWriter& driver_;
+    CallbackExecutorSharedPtr executor_;
+    int frame_cb_handle_;
+
+    std::mutex mutex_;
+    bool streaming_;
+    Sampler sampler_;
+    double duration_;
+    ScaledServoConfig config_;
+    STREAM::ScaledClock clock_;
+    std::chrono::steady_clock::time_point host_start_;
+    double progress_;
+    bool scaling_warned_;
+    DoneCallback done_cb_;
+
+    Impl(RtsiFrameSource& rtsi, DriverCommandWriter& driver, CallbackExecutorSharedPtr executor)
+        : rtsi_(rtsi),
+          driver_(driver),
+          executor_(std::move(executor)),
+          frame_cb_handle_(-1),
+          streaming_(false),
+          duration_(0),
+          clock_(0.004, 0),
+          progress_(0),
+          scaling_warned_(false) {}
+
+    void onFrame() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!streaming_) {
+            return;
+        }
+        double stamp;
+        if (!rtsi_.getRecipeValue("timestamp", stamp)) {
+            stamp = std::chrono::duration<double>(std::chrono::steady_clock::now() - host_start_).count();
+        }
+        double scaling;
+        if (!rtsi_.getRecipeValue("speed_scaling", scaling) && !rtsi_.getRecipeValue("target_speed_fraction", scaling)) {
+            if (!scaling_warned_) {
+                scaling_warned_ = true;
+                ELITE_LOG_WARN("Neither \"speed_scaling\" nor \"target_speed_fraction\" is subscribed, streaming at full speed");
+            }
+            scaling = 1;
+        }
+
+        double time = std::min(clock_.advance(stamp, scaling), duration_);
+        vector6d_t positions;
+        bool ok = sampler_(time, positions) && driver_.writeServoj(positions, config_.timeout_ms, config_.cartesian);
+        progress_ = time;
+        if (ok && time < duration_) {
+            return;
+        }
+
+        streaming_ = false;
+        sampler_ = nullptr;
+        if (!ok) {
+            ELITE_LOG_ERROR("Scaled servo stream aborted at %f s", time);
+        }
+        DoneCallback cb = done_cb_;
+        lock.unlock();
+        if (cb && !dispatchCallback(executor_, [cb, ok]() { cb(ok); })) {
+            ELITE_LOG_WARN("Scaled servo stream done callback dropped");
+        }
+    }
+};
+
+ScaledServoStreamer::ScaledServoStreamer(RtsiFrameSource& rtsi, DriverCommandWriter& driver, CallbackExecutorSharedPtr executor)
+    : impl_(new Impl(rtsi, driver, std::move(executor))) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+ScaledServoStreamer::~ScaledServoStreamer() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool ScaledServoStreamer::start(Sampler sampler, double duration, const ScaledServoConfig& config) {
+    if (!sampler || !(duration > 0)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->streaming_) {
+        return false;
+    }
+    impl_->sampler_ = std::move(sampler);
+    impl_->duration_ = duration;
+    impl_->config_ = config;
+    impl_->clock_ = STREAM::ScaledClock(config.frame_period, config.max_scaling_rate);
+    impl_->host_start_ = std::chrono::steady_clock::now();
+    impl_->progress_ = 0;
+    impl_->streaming_ = true;
+    return true;
+}
+
+bool ScaledServoStreamer::start(const SplineTrajectory& spline, const ScaledServoConfig& config) {
+    if (spline.knots().empty()) {
+        return false;
+    }
+    ScaledServoConfig joint_config = config;
+    joint_config.cartesian = false;
+    return start([spline](double time, vector6d_t& positions) { return spline.sample(time, positions); }, spline.duration(),
+                 joint_config);
+}
+
+void ScaledServoStreamer::stop() {
+    DoneCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex_);
+        if (!impl_->streaming_) {
+            return;
+        }
+        impl_->streaming_ = false;
+        impl_->sampler_ = nullptr;
+        cb = impl_->done_cb_;
+    }
+    if (cb && !dispatchCallback(impl_->executor_, [cb]() { cb(false); })) {
+        ELITE_LOG_WARN("Scaled servo stream done callback dropped");
+    }
+}
+
+bool ScaledServoStreamer::isStreaming() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->streaming_;
+}
+
+double ScaledServoStreamer::progress() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->progress_;
+}
+
+double ScaledServoStreamer::scaling() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->clock_.scaling();
+}
+
+void ScaledServoStreamer::setDoneCallback(DoneCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->done_cb_ = std::move(cb);
+}
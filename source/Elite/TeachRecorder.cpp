@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "TeachRecorder.hpp"
+
+#include <chrono>
+#include <mutex>
+
+#include "Log.hpp"
+#include "PathSimplifier.hpp"
+
+using namespace ELITE;
+
+class TeachRecorder::Impl {
+   public:
+    RtsiFrameSource& rtsi_;
+    int frame_cb_handle_;
+
+    std::mutex mutex_;
+    bool recording_;
+    bool first_frame_;
+    double start_time_;
+    std::chrono::steady_clock::time_point host_start_;
+    uint64_t samples_;
+    TEACH::PathSimplifier simplifier_;
+    std::vector<TeachWaypoint> waypoints_;
+
+    explicit Impl(RtsiFrameSource& rtsi)
+        : rtsi_(rtsi),
+          frame_cb_handle_(-1),
+          recording_(false),
+          first_frame_(false),
+          start_time_(0),
+          samples_(0),
+          simplifier_(0, 0, 1) {}
+
+    void onFrame() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!recording_) {
+            return;
+        }
+        TEACH::PathSample sample;
+        if (!rtsi_.getRecipeValue("actual_joint_positions", sample.joints)) {
+            return;
+        }
+        rtsi_.getRecipeValue("actual_TCP_pose", sample.tcp);
+        double time;
+        if (!rtsi_.getRecipeValue("timestamp", time)) {
+            time = std::chrono::duration<double>(std::chrono::steady_clock::now() - host_start_).count();
+        }
+        if (first_frame_) {
+            first_frame_ = false;
+            start_time_ = time;
+        }
+        sample.time = time - start_time_;
+        samples_++;
+
+        TEACH::PathSample waypoint;
+        if (simplifier_.add(sample, waypoint)) {
+            push(waypoint);
+        }
+    }
+
+    void push(const TEACH::PathSample& sample) {
+        TeachWaypoint waypoint;
+        waypoint.joint_positions = sample.joints;
+        waypoint.tcp_pose = sample.tcp;
+        waypoint.time = sample.time;
+        waypoint.duration = waypoints_.empty() ? 0 : sample.time - waypoints_.back().time;
+        waypoints_.push_back(waypoint);
+    }
+};
+
+TeachRecorder::TeachRecorder(RtsiFrameSource& rtsi) : impl_(new Impl(rtsi)) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+TeachRecorder::~TeachRecorder() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool TeachRecorder::start(const TeachRecorderConfig& config) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->recording_) {
+        return false;
+    }
+    impl_->simplifier_ = TEACH::PathSimplifier(config.joint_tolerance, config.position_tolerance, config.max_segment_samples);
+    impl_->waypoints_.clear();
+    impl_->samples_ = 0;
+    impl_->first_frame_ = true;
+    impl_->host_start_ = std::chrono::steady_clock::now();
+    impl_->recording_ = true;
+    return true;
+}
+
+std::vector<TeachWaypoint> TeachRecorder::stop() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->recording_) {
+        impl_->recording_ = false;
+        TEACH::PathSample waypoint;
+        if (impl_->simplifier_.finish(waypoint)) {
+            impl_->push(waypoint);
+        }
+    }
+    return impl_->waypoints_;
+}
+
+bool TeachRecorder::isRecording() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->recording_;
+}
+
+std::vector<TeachWaypoint> TeachRecorder::getWaypoints() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->waypoints_;
+}
+
+uint64_t TeachRecorder::sampleCount() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->samples_;
+}
+
+bool TeachRecorder::writeTrajectory(DriverCommandWriter& driver, const std::vector<TeachWaypoint>& path, float blend_radius,
+                                    int timeout_ms) {
+    if (path.size() < 2) {
+        return false;
+    }
+    if (!driver.writeTrajectoryControlAction(TrajectoryControlAction::START, path.size() - 1, timeout_ms)) {
+        ELITE_LOG_ERROR("Failed to start the taught trajectory");
+        return false;
+    }
+    for (size_t i = 1; i < path.size(); i++) {
+        if (!driver.writeTrajectoryPoint(path[i].joint_positions, path[i].duration, blend_radius, false)) {
+            ELITE_LOG_ERROR("Failed to write the taught trajectory point %zu", i);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "ToolContactDetector.hpp"
+
+#include <cmath>
+#include <mutex>
+
+#include "ContactResidual.hpp"
+#include "Log.hpp"
+
+using namespace ELITE;
+using namespace std::chrono;
+
+class ToolContactDetector::Impl {
+   public:
+    RtsiFrameSource& rtsi_;
+    DriverCommandWriter& driver_;
+    CallbackExecutorSharedPtr executor_;
+    int frame_cb_handle_;
+
+    // Locked by the receive thread for every frame, the other users only change the state
+    std::mutex mutex_;
+    ToolContactConfig config_;
+    bool armed_;
+    bool in_contact_;
+    bool watch_force_;
+    bool watch_current_;
+    int over_frames_;
+    CONTACT::ResidualFilter force_filters_[3];
+    CONTACT::ResidualFilter current_filters_[6];
+
+    bool has_contact_;
+    ToolContactEvent last_contact_;
+    // Waiting for the robot to stop after a contact
+    bool stop_pending_;
+    ToolContactStats stats_;
+    ContactCallback contact_cb_;
+
+    Impl(RtsiFrameSource& rtsi, DriverCommandWriter& driver, CallbackExecutorSharedPtr executor)
+        : rtsi_(rtsi),
+          driver_(driver),
+          executor_(std::move(executor)),
+          frame_cb_handle_(-1),
+          armed_(false),
+          in_contact_(false),
+          watch_force_(false),
+          watch_current_(false),
+          over_frames_(0),
+          has_contact_(false),
+          stop_pending_(false) {}
+
+    void onFrame() {
+        auto frame_time = steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stop_pending_) {
+            checkStopped();
+        }
+        if (!armed_) {
+            return;
+        }
+
+        // The channel with the largest residual relative to its threshold
+        double max_ratio = 0;
+        ToolContactEvent event;
+        bool sampled = false;
+        if (watch_force_ && rtsi_.getRecipeValue("actual_TCP_force", event.tcp_force)) {
+            sampled = true;
+            double sum = 0;
+            for (int i = 0; i < 3; i++) {
+                double r = force_filters_[i].update(event.tcp_force[i]);
+                sum += r * r;
+            }
+            double residual = std::sqrt(sum);
+            max_ratio = residual / config_.force_threshold;
+            event.source = ToolContactSource::FORCE;
+            event.joint = -1;
+            event.residual = residual;
+        }
+        vector6d_t current;
+        if (watch_current_ && rtsi_.getRecipeValue("actual_joint_current", current)) {
+            sampled = true;
+            for (int i = 0; i < 6; i++) {
+                double residual = current_filters_[i].update(current[i]);
+                if (config_.current_thresholds[i] > 0) {
+                    double ratio = std::abs(residual) / config_.current_thresholds[i];
+                    if (ratio > max_ratio) {
+                        max_ratio = ratio;
+                        event.source = ToolContactSource::JOINT_CURRENT;
+                        event.joint = i;
+                        event.residual = residual;
+                    }
+                }
+            }
+        }
+        if (!sampled) {
+            return;
+        }
+
+        if (max_ratio < 1) {
+            over_frames_ = 0;
+            for (auto& filter : force_filters_) {
+                filter.adapt();
+            }
+            for (auto& filter : current_filters_) {
+                filter.adapt();
+            }
+            return;
+        }
+        if (++over_frames_ < config_.debounce_frames) {
+            return;
+        }
+
+        // Contact: stop first, then report
+        event.stop_sent = driver_.writeToolContact(config_.stop_timeout_ms, ToolContactOwner::TOOL_CONTACT_DETECTOR);
+        event.detect_to_send = duration_cast<microseconds>(steady_clock::now() - frame_time);
+        rtsi_.getRecipeValue("timestamp", event.timestamp);
+        rtsi_.getRecipeValue("actual_TCP_pose", event.tcp_pose);
+        rtsi_.getRecipeValue("actual_joint_positions", event.joint_positions);
+
+        armed_ = false;
+        in_contact_ = true;
+        has_contact_ = true;
+        last_contact_ = event;
+        stop_pending_ = true;
+        stats_.contacts++;
+        stats_.last_detect_to_send = event.detect_to_send;
+        if (event.detect_to_send > stats_.max_detect_to_send) {
+            stats_.max_detect_to_send = event.detect_to_send;
+        }
+        stats_.mean_detect_to_send += (event.detect_to_send - stats_.mean_detect_to_send) / (int64_t)stats_.contacts;
+        stats_.last_stop_time = -1;
+        ContactCallback cb = contact_cb_;
+        lock.unlock();
+
+        if (!event.stop_sent) {
+            ELITE_LOG_ERROR("Tool contact detected, but the stop command could not be sent");
+        }
+        if (cb && !dispatchCallback(executor_, [cb, event]() { cb(event); })) {
+            ELITE_LOG_WARN("Tool contact callback dropped");
+        }
+    }
+
+    void checkStopped() {
+        vector6d_t speeds;
+        double timestamp = 0;
+        if (!rtsi_.getRecipeValue("actual_joint_speeds", speeds) || !rtsi_.getRecipeValue("timestamp", timestamp)) {
+            stop_pending_ = false;
+            return;
+        }
+        for (double speed : speeds) {
+            if (std::abs(speed) >= config_.stop_speed) {
+                return;
+            }
+        }
+        stats_.last_stop_time = timestamp - last_contact_.timestamp;
+        stop_pending_ = false;
+    }
+};
+
+ToolContactDetector::ToolContactDetector(RtsiFrameSource& rtsi, DriverCommandWriter& driver, CallbackExecutorSharedPtr executor)
+    : impl_(new Impl(rtsi, driver, std::move(executor))) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+ToolContactDetector::~ToolContactDetector() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool ToolContactDetector::arm(const ToolContactConfig& config) {
+    bool watch_force = config.force_threshold > 0;
+    bool watch_current = false;
+    for (double threshold : config.current_thresholds) {
+        watch_current = watch_current || threshold > 0;
+    }
+    if (!watch_force && !watch_current) {
+        return false;
+    }
+    if (!(config.filter_alpha > 0 && config.filter_alpha <= 1) || !(config.baseline_alpha >= 0 && config.baseline_alpha < 1)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->config_ = config;
+    impl_->watch_force_ = watch_force;
+    impl_->watch_current_ = watch_current;
+    impl_->over_frames_ = 0;
+    for (auto& filter : impl_->force_filters_) {
+        filter = CONTACT::ResidualFilter(config.filter_alpha, config.baseline_alpha);
+    }
+    for (auto& filter : impl_->current_filters_) {
+        filter = CONTACT::ResidualFilter(config.filter_alpha, config.baseline_alpha);
+    }
+    impl_->armed_ = true;
+    return true;
+}
+
+void ToolContactDetector::disarm() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->armed_ = false;
+}
+
+bool ToolContactDetector::isArmed() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->armed_;
+}
+
+bool ToolContactDetector::inContact() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->in_contact_;
+}
+
+void ToolContactDetector::release() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->in_contact_ = false;
+    impl_->stop_pending_ = false;
+    impl_->driver_.clearToolContact(ToolContactOwner::TOOL_CONTACT_DETECTOR);
+}
+
+void ToolContactDetector::setContactCallback(ContactCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->contact_cb_ = std::move(cb);
+}
+
+bool ToolContactDetector::getLastContact(ToolContactEvent& event) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->has_contact_) {
+        event = impl_->last_contact_;
+    }
+    return impl_->has_contact_;
+}
+
+ToolContactStats ToolContactDetector::getStats() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->stats_;
+}
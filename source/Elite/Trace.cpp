@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32) || defined(_WIN64)
+#include <process.h>
+#endif
+
+using namespace ELITE;
+
+std::atomic<bool> TRACE::DETAIL::enabled{false};
+
+namespace {
+
+enum EventType : uint64_t { BEGIN = 0, END = 1, INSTANT = 2 };
+
+// The timestamp and the type are one word, so that a slot is two atomic stores
+struct Slot {
+    std::atomic<uint64_t> word;
+    std::atomic<const char*> name;
+};
+
+struct ThreadBuffer {
+    uint64_t tid = 0;
+    std::string name;
+    bool exited = false;
+    size_t capacity = 0;
+    std::unique_ptr<Slot[]> slots;
+    // Events written, the owner thread is the only writer
+    std::atomic<uint64_t> head{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t capacity = 16384;
+    // Events before it were cleared
+    std::atomic<uint64_t> start_ns{0};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t currentTid() {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+    return (uint64_t)syscall(SYS_gettid);
+#else
+    return (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+}
+
+uint64_t currentPid() {
+#if defined(_WIN32) || defined(_WIN64)
+    return (uint64_t)_getpid();
+#else
+    return (uint64_t)getpid();
+#endif
+}
+
+// Keeps the buffer of the thread registered, and marks it when the thread exits
+struct ThreadHandle {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ThreadBuffer& get() {
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            buffer->tid = currentTid();
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    ~ThreadHandle() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            buffer->exited = true;
+        }
+    }
+};
+
+thread_local ThreadHandle this_thread;
+
+void record(const char* name, EventType type) {
+    if (!TRACE::isEnabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = this_thread.get();
+    if (!buffer.slots) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer.capacity = reg.capacity;
+        buffer.slots.reset(new Slot[buffer.capacity]);
+    }
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[head % buffer.capacity];
+    slot.word.store((nowNs() << 2) | type, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+struct Event {
+    uint64_t ns;
+    EventType type;
+    const char* name;
+    size_t thread;
+};
+
+struct ThreadInfo {
+    uint64_t tid;
+    std::string name;
+};
+
+/**
+ * Copy the events of all threads, sorted by time. An event which the owner thread may have overwritten during the copy, or
+ * may be overwriting, is dropped: the head is read again after the copy, like a sequence lock.
+ */
+void collect(std::vector<ThreadInfo>& threads, std::vector<Event>& events) {
+    Registry& reg = registry();
+    uint64_t start = reg.start_ns.load();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        size_t thread = threads.size();
+        threads.push_back({buffer->tid, buffer->name});
+        if (!buffer->slots) {
+            continue;
+        }
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t first = head > buffer->capacity ? head - buffer->capacity : 0;
+        size_t copied = events.size();
+        for (uint64_t i = first; i < head; i++) {
+            const Slot& slot = buffer->slots[i % buffer->capacity];
+            uint64_t word = slot.word.load(std::memory_order_relaxed);
+            events.push_back({word >> 2, (EventType)(word & 3), slot.name.load(std::memory_order_relaxed), thread});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t new_head = buffer->head.load(std::memory_order_relaxed);
+        // The owner may be writing the slot of 'new_head' right now, it holds the event new_head - capacity
+        uint64_t overwritten = new_head >= buffer->capacity ? new_head - buffer->capacity + 1 : 0;
+        if (overwritten > first) {
+            size_t drop = (size_t)std::min(overwritten - first, head - first);
+            events.erase(events.begin() + copied, events.begin() + copied + drop);
+        }
+    }
+    events.erase(std::remove_if(events.begin(), events.end(), [start](const Event& e) { return e.ns < start || !e.name; }),
+                 events.end());
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.ns < b.ns; });
+}
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; c++) {
+        switch (*c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            default:
+                if ((unsigned char)*c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                    out += escaped;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// Protobuf wire format
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)(value | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+void putVarintField(std::string& out, int field, uint64_t value) {
+    putVarint(out, (uint64_t)field << 3);
+    putVarint(out, value);
+}
+
+void putBytesField(std::string& out, int field, const std::string& bytes) {
+    putVarint(out, ((uint64_t)field << 3) | 2);
+    putVarint(out, bytes.size());
+    out += bytes;
+}
+
+// Field numbers of perfetto.protos
+constexpr int TRACE_PACKET = 1;
+constexpr int PACKET_TIMESTAMP = 8;
+constexpr int PACKET_SEQUENCE_ID = 10;
+constexpr int PACKET_TRACK_EVENT = 11;
+constexpr int PACKET_TRACK_DESCRIPTOR = 60;
+constexpr int TRACK_UUID = 1;
+constexpr int TRACK_NAME = 2;
+constexpr int TRACK_THREAD = 4;
+constexpr int THREAD_PID = 1;
+constexpr int THREAD_TID = 2;
+constexpr int THREAD_NAME = 5;
+constexpr int EVENT_TYPE = 9;
+constexpr int EVENT_TRACK_UUID = 11;
+constexpr int EVENT_NAME = 23;
+constexpr uint64_t SEQUENCE_ID = 1;
+constexpr uint64_t TRACK_UUID_BASE = 0x454c495445000000ULL;
+
+bool writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(content.data(), content.size());
+    return file.good();
+}
+
+}  // namespace
+
+void TRACE::enable(size_t events_per_thread) {
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().capacity = std::max<size_t>(events_per_thread, 16);
+    }
+    DETAIL::enabled.store(true);
+}
+
+void TRACE::disable() { DETAIL::enabled.store(false); }
+
+void TRACE::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = this_thread.get();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+void TRACE::begin(const char* name) { record(name, BEGIN); }
+
+void TRACE::end(const char* name) { record(name, END); }
+
+void TRACE::instant(const char* name) { record(name, INSTANT); }
+
+void TRACE::clear() {
+    Registry& reg = registry();
+    reg.start_ns.store(nowNs());
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                                     [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer->exited; }),
+                      reg.buffers.end());
+}
+
+bool TRACE::dumpChromeJson(const std::string& path) {
+    std::vector<ThreadInfo> threads;
+    std::vector<Event> events;
+    collect(threads, events);
+    uint64_t pid = currentPid();
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            out += ",\n";
+        }
+        first = false;
+    };
+    char number[96];
+    for (const auto& thread : threads) {
+        if (thread.name.empty()) {
+            continue;
+        }
+        separator();
+        std::snprintf(number, sizeof(number), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%llu,\"tid\":%llu,\"args\":{\"name\":",
+                      (unsigned long long)pid, (unsigned long long)thread.tid);
+        out += number;
+        appendJsonString(out, thread.name.c_str());
+        out += "}}";
+    }
+    static const char PHASES[] = {'B', 'E', 'i'};
+    for (const auto& event : events) {
+        separator();
+        out += "{\"name\":";
+        appendJsonString(out, event.name);
+        // Microseconds with the nanoseconds as decimals
+        std::snprintf(number, sizeof(number), ",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":%llu,\"tid\":%llu%s}", PHASES[event.type],
+                      (unsigned long long)(event.ns / 1000), (unsigned)(event.ns % 1000), (unsigned long long)pid,
+                      (unsigned long long)threads[event.thread].tid, event.type == INSTANT ? ",\"s\":\"t\"" : "");
+        out += number;
+    }
+    out += "\n]}\n";
+    return writeFile(path, out);
+}
+
+bool TRACE::dumpPerfetto(const std::string& path) {
+    std::vector<ThreadInfo> threads;
+    std::vector<Event> events;
+    collect(threads, events);
+    uint64_t pid = currentPid();
+
+    std::string out;
+    std::string packet;
+    std::string message;
+    std::string inner;
+    for (size_t i = 0; i < threads.size(); i++) {
+        inner.clear();
+        putVarintField(inner, THREAD_PID, pid);
+        putVarintField(inner, THREAD_TID, threads[i].tid);
+        if (!threads[i].name.empty()) {
+            putBytesField(inner, THREAD_NAME, threads[i].name);
+        }
+        message.clear();
+        putVarintField(message, TRACK_UUID, TRACK_UUID_BASE + i);
+        if (!threads[i].name.empty()) {
+            putBytesField(message, TRACK_NAME, threads[i].name);
+        }
+        putBytesField(message, TRACK_THREAD, inner);
+        packet.clear();
+        putVarintField(packet, PACKET_SEQUENCE_ID, SEQUENCE_ID);
+        putBytesField(packet, PACKET_TRACK_DESCRIPTOR, message);
+        putBytesField(out, TRACE_PACKET, packet);
+    }
+    // TrackEvent.Type: SLICE_BEGIN 1, SLICE_END 2, INSTANT 3
+    for (const auto& event : events) {
+        message.clear();
+        putVarintField(message, EVENT_TYPE, event.type + 1);
+        putVarintField(message, EVENT_TRACK_UUID, TRACK_UUID_BASE + event.thread);
+        if (event.type != END) {
+            putBytesField(message, EVENT_NAME, event.name);
+        }
+        packet.clear();
+        putVarintField(packet, PACKET_TIMESTAMP, event.ns);
+        putVarintField(packet, PACKET_SEQUENCE_ID, SEQUENCE_ID);
+        putBytesField(packet, PACKET_TRACK_EVENT, message);
+        putBytesField(out, TRACE_PACKET, packet);
+    }
+    return writeFile(path, out);
+}
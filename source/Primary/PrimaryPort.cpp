@@ -3,6 +3,7 @@
 #include "PrimaryPort.hpp"
 #include "EliteException.hpp"
 #include "Log.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 using namespace std::chrono;
@@ -10,7 +11,7 @@ using namespace std::chrono;
 namespace ELITE {
 using namespace std::chrono;
 
-PrimaryPort::PrimaryPort() { message_head_.resize(HEAD_LENGTH); }
+PrimaryPort::PrimaryPort() : write_thread_alive_(false) { message_head_.resize(HEAD_LENGTH); }
 
 PrimaryPort::~PrimaryPort() { disconnect(); }
 
@@ -24,38 +25,164 @@ bool PrimaryPort::connect(const std::string& ip, int port) {
         socket_async_thread_alive_ = true;
         socket_async_thread_.reset(new std::thread([&](std::string ip, int port) { socketAsyncLoop(ip, port); }, ip, port));
     }
+    if (!write_thread_) {
+        {
+            std::lock_guard<std::mutex> queue_lock(write_queue_mutex_);
+            write_thread_alive_ = true;
+        }
+        write_thread_.reset(new std::thread([&]() { writeLoop(); }));
+    }
     return true;
 }
 
 void PrimaryPort::disconnect() {
+    // Stop the write thread, the scripts still in queue will not be sent
+    std::deque<ScriptRequestSharedPtr> pending;
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex_);
+        write_thread_alive_ = false;
+        pending.swap(write_queue_);
+    }
+    write_queue_cv_.notify_all();
     // Close socket and set thread flag
     {
         std::lock_guard<std::mutex> lock(socket_mutex_);
         socket_async_thread_alive_ = false;
         socketDisconnect();
+        std::lock_guard<std::mutex> write_lock(write_mutex_);
         socket_ptr_.reset();
     }
     if (socket_async_thread_ && socket_async_thread_->joinable()) {
         socket_async_thread_->join();
     }
     socket_async_thread_.reset();
+    if (write_thread_ && write_thread_->joinable()) {
+        write_thread_->join();
+    }
+    write_thread_.reset();
+    for (auto& req : pending) {
+        completeRequest(req, false, false);
+    }
 }
 
-bool PrimaryPort::sendScript(const std::string& script) {
-    std::lock_guard<std::mutex> lock(socket_mutex_);
-    if (!socket_ptr_) {
+bool PrimaryPort::sendScript(const std::string& script, int timeout_ms) {
+    // The write thread completes every request before its deadline, or right after the write in progress
+    return sendScriptAsync(script, timeout_ms).get();
+}
+
+std::future<bool> PrimaryPort::sendScriptAsync(const std::string& script, int timeout_ms) {
+    auto req = std::make_shared<ScriptRequest>();
+    req->data = script + "\n";
+    req->enqueue_time = steady_clock::now();
+    req->deadline = req->enqueue_time + milliseconds(timeout_ms);
+    std::future<bool> result = req->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex_);
+        if (write_thread_alive_) {
+            write_queue_.push_back(req);
+            write_queue_cv_.notify_one();
+            return result;
+        }
+    }
+    ELITE_LOG_ERROR("Don't connect to robot primary port");
+    completeRequest(req, false, false);
+    return result;
+}
+
+ScriptSendStats PrimaryPort::getScriptSendStats() {
+    std::lock_guard<std::mutex> lock(write_queue_mutex_);
+    return send_stats_;
+}
+
+void PrimaryPort::writeLoop() {
+    TRACE::setThreadName("primary_write");
+    while (true) {
+        ScriptRequestSharedPtr req;
+        {
+            std::unique_lock<std::mutex> lock(write_queue_mutex_);
+            write_queue_cv_.wait(lock, [&]() { return !write_thread_alive_ || !write_queue_.empty(); });
+            if (!write_thread_alive_) {
+                return;
+            }
+            req = write_queue_.front();
+            write_queue_.pop_front();
+        }
+        bool is_timeout = false;
+        bool success = false;
+        if (steady_clock::now() >= req->deadline) {
+            ELITE_LOG_ERROR("Send script to robot timeout: waited in queue");
+            is_timeout = true;
+        } else {
+            success = writeScript(*req, is_timeout);
+        }
+        completeRequest(req, success, is_timeout);
+    }
+}
+
+bool PrimaryPort::writeScript(const ScriptRequest& req, bool& is_timeout) {
+    ELITE_TRACE_SCOPE("primary.write_script");
+    std::unique_lock<std::mutex> lock(write_mutex_);
+    if (!socket_ptr_ || !socket_ptr_->is_open()) {
         ELITE_LOG_ERROR("Don't connect to robot primary port");
         return false;
     }
-    auto script_with_newline = std::make_shared<std::string>(script + "\n");
-    boost::system::error_code ec;
-    socket_ptr_->write_some(boost::asio::buffer(*script_with_newline), ec);
-    if (ec) {
-        ELITE_LOG_ERROR("Send script to robot fail : %s", boost::system::system_error(ec).what());
-        return false;
-    } else {
+    // The socket is non-blocking, write until all of the script is in the send buffer
+    boost::asio::ip::tcp::socket* socket = socket_ptr_.get();
+    size_t written = 0;
+    while (written < req.data.size()) {
+        boost::system::error_code ec;
+        written += socket->write_some(boost::asio::buffer(req.data.data() + written, req.data.size() - written), ec);
+        if (ec == boost::asio::error::would_block || ec == boost::asio::error::try_again) {
+            if (steady_clock::now() >= req.deadline) {
+                ELITE_LOG_ERROR("Send script to robot timeout: %zu of %zu bytes written", written, req.data.size());
+                is_timeout = true;
+                break;
+            }
+            // Don't keep the socket locked while the send buffer is full, it may be reconnecting
+            lock.unlock();
+            std::this_thread::sleep_for(1ms);
+            lock.lock();
+            if (socket_ptr_.get() != socket || !socket->is_open()) {
+                ELITE_LOG_ERROR("Send script to robot fail: connection closed while writing");
+                return false;
+            }
+        } else if (ec) {
+            ELITE_LOG_ERROR("Send script to robot fail : %s", boost::system::system_error(ec).what());
+            break;
+        }
+    }
+    if (written == req.data.size()) {
         return true;
     }
+    if (written > 0) {
+        // The robot got a piece of the script, the following scripts would be broken by it.
+        boost::system::error_code ignore_ec;
+        socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_ec);
+    }
+    return false;
+}
+
+void PrimaryPort::completeRequest(const ScriptRequestSharedPtr& req, bool success, bool is_timeout) {
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex_);
+        if (success) {
+            auto latency = duration_cast<microseconds>(steady_clock::now() - req->enqueue_time);
+            send_stats_.sent++;
+            if (send_stats_.sent == 1 || latency < send_stats_.min_latency) {
+                send_stats_.min_latency = latency;
+            }
+            if (latency > send_stats_.max_latency) {
+                send_stats_.max_latency = latency;
+            }
+            send_stats_.mean_latency += (latency - send_stats_.mean_latency) / (int64_t)send_stats_.sent;
+            send_stats_.last_latency = latency;
+        } else if (is_timeout) {
+            send_stats_.timeout++;
+        } else {
+            send_stats_.failed++;
+        }
+    }
+    req->promise.set_value(success);
 }
 
 bool PrimaryPort::getPackage(std::shared_ptr<PrimaryPackage> pkg, int timeout_ms) {
@@ -193,6 +320,7 @@ RobotExceptionSharedPtr PrimaryPort::parserException(const std::vector<uint8_t>&
 }
 
 bool PrimaryPort::parserMessageBody(int type, int package_len) {
+    ELITE_TRACE_SCOPE("primary.message");
     boost::system::error_code ec;
     int body_len = package_len - HEAD_LENGTH;
     int read_len = 0;
@@ -229,7 +357,16 @@ bool PrimaryPort::parserMessageBody(int type, int package_len) {
     if (type == ROBOT_STATE_MSG_TYPE) {
         uint32_t sub_len = 0;
         for (auto iter = message_body_.begin(); iter < message_body_.end(); iter += sub_len) {
+            if (message_body_.end() - iter < 5) {
+                ELITE_LOG_ERROR("Primary port robot state sub-package head is truncated");
+                return false;
+            }
             EndianUtils::unpack(iter, sub_len);
+            // A bad length would stall the loop or read past the body
+            if (sub_len < 5 || sub_len > (uint32_t)(message_body_.end() - iter)) {
+                ELITE_LOG_ERROR("Primary port robot state sub-package len error: %u", sub_len);
+                return false;
+            }
             int sub_type = *(iter + 4);
 
             std::lock_guard<std::mutex> lock(mutex_);
@@ -244,13 +381,20 @@ bool PrimaryPort::parserMessageBody(int type, int package_len) {
         if (robot_exception_cb_) {
             RobotExceptionSharedPtr ex = parserException(message_body_);
             if (ex) {
-                robot_exception_cb_(ex);
+                callRobotExceptionCallback(ex);
             }
         }
     }
     return true;
 }
 
+void PrimaryPort::callRobotExceptionCallback(RobotExceptionSharedPtr ex) {
+    auto cb = robot_exception_cb_;
+    if (!dispatchCallback(callback_executor_, [cb, ex]() { cb(ex); })) {
+        ELITE_LOG_WARN("Robot exception callback dropped");
+    }
+}
+
 bool PrimaryPort::socketReconnect(const std::string& ip, int port, bool is_last_connect_success) {
     // Disconnect and reconnect
     std::lock_guard<std::mutex> lock(socket_mutex_);
@@ -259,6 +403,7 @@ bool PrimaryPort::socketReconnect(const std::string& ip, int port, bool is_last_
 }
 
 void PrimaryPort::socketAsyncLoop(const std::string& ip, int port) {
+    TRACE::setThreadName("primary_port");
     bool is_last_connect_success = true;
     while (socket_async_thread_alive_) {
         try {
@@ -268,7 +413,7 @@ void PrimaryPort::socketAsyncLoop(const std::string& ip, int port) {
                 auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
                 auto ex = std::make_shared<RobotException>(RobotException::Type::ROBOT_DISCONNECTED, timestamp);
                 if (robot_exception_cb_ && is_last_connect_success) {
-                    robot_exception_cb_(ex);
+                    callRobotExceptionCallback(ex);
                 }
                 is_last_connect_success = socketReconnect(ip, port, is_last_connect_success);
             }
@@ -280,25 +425,29 @@ void PrimaryPort::socketAsyncLoop(const std::string& ip, int port) {
 }
 
 bool PrimaryPort::socketConnect(const std::string& ip, int port, bool is_last_connect_success) {
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        socket_ptr_.reset();
+    }
     try {
-        socket_ptr_.reset(new boost::asio::ip::tcp::socket(io_context_));
-        socket_ptr_->open(boost::asio::ip::tcp::v4());
-        socket_ptr_->set_option(boost::asio::ip::tcp::no_delay(true));
-        socket_ptr_->set_option(boost::asio::socket_base::reuse_address(true));
-        socket_ptr_->set_option(boost::asio::socket_base::keep_alive(false));
-        socket_ptr_->non_blocking(true);
+        // Connect a new socket first, so that the write thread never sees a socket which is connecting
+        std::unique_ptr<boost::asio::ip::tcp::socket> socket(new boost::asio::ip::tcp::socket(io_context_));
+        socket->open(boost::asio::ip::tcp::v4());
+        socket->set_option(boost::asio::ip::tcp::no_delay(true));
+        socket->set_option(boost::asio::socket_base::reuse_address(true));
+        socket->set_option(boost::asio::socket_base::keep_alive(false));
+        socket->non_blocking(true);
 #if defined(__linux) || defined(linux) || defined(__linux__)
-        socket_ptr_->set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true));
+        socket->set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true));
 #endif
         boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::make_address(ip), port);
         boost::system::error_code connect_ec;
-        socket_ptr_->async_connect(endpoint, [&](const boost::system::error_code& ec) { connect_ec = ec; });
+        socket->async_connect(endpoint, [&](const boost::system::error_code& ec) { connect_ec = ec; });
         if (io_context_.stopped()) {
             io_context_.restart();
         }
         io_context_.run_for(500ms);
         if (connect_ec) {
-            socket_ptr_.reset();
             if (is_last_connect_success) {
                 ELITE_LOG_ERROR("Connect to robot primary port fail: %s", boost::system::system_error(connect_ec).what());
             }
@@ -311,12 +460,19 @@ bool PrimaryPort::socketConnect(const std::string& ip, int port, bool is_last_co
             if (is_last_connect_success) {
                 ELITE_LOG_ERROR("Connect to robot primary port fail: timeout");
             }
-            socketDisconnect();
-            socket_ptr_.reset();
+            boost::system::error_code ignore_ec;
+            socket->cancel(ignore_ec);
+            socket->close(ignore_ec);
+            // Run the canceled handler, it refers to 'connect_ec'
+            if (io_context_.stopped()) {
+                io_context_.restart();
+            }
+            io_context_.run_for(500ms);
             io_context_.stop();
             return false;
         }
-
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        socket_ptr_ = std::move(socket);
     } catch (const boost::system::system_error& error) {
         throw EliteException(EliteException::Code::SOCKET_CONNECT_FAIL, error.what());
         return false;
@@ -327,10 +483,13 @@ bool PrimaryPort::socketConnect(const std::string& ip, int port, bool is_last_co
 void PrimaryPort::socketDisconnect() {
     if (socket_ptr_ && socket_ptr_->is_open()) {
         try {
-            boost::system::error_code ignore_ec;
-            socket_ptr_->cancel(ignore_ec);
-            socket_ptr_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_ec);
-            socket_ptr_->close(ignore_ec);
+            {
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                boost::system::error_code ignore_ec;
+                socket_ptr_->cancel(ignore_ec);
+                socket_ptr_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_ec);
+                socket_ptr_->close(ignore_ec);
+            }
             if (io_context_.stopped()) {
                 io_context_.restart();
             }
@@ -342,7 +501,7 @@ void PrimaryPort::socketDisconnect() {
 }
 
 std::string PrimaryPort::getLocalIP() {
-    std::lock_guard<std::mutex> lock(socket_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     if (socket_ptr_ && socket_ptr_->is_open()) {
         boost::system::error_code ignore_ec;
         auto address = socket_ptr_->local_endpoint(ignore_ec).address().to_string();
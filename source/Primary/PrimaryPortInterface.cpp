@@ -32,6 +32,14 @@ bool PrimaryPortInterface::sendScript(const std::string& script) {
     return impl_->primary_.sendScript(script);
 }
 
+std::future<bool> PrimaryPortInterface::sendScriptAsync(const std::string& script, int timeout_ms) {
+    return impl_->primary_.sendScriptAsync(script, timeout_ms);
+}
+
+ScriptSendStats PrimaryPortInterface::getScriptSendStats() {
+    return impl_->primary_.getScriptSendStats();
+}
+
 bool PrimaryPortInterface::getPackage(std::shared_ptr<PrimaryPackage> pkg, int timeout_ms) {
     return impl_->primary_.getPackage(pkg, timeout_ms);
 }
@@ -44,5 +52,9 @@ void PrimaryPortInterface::registerRobotExceptionCallback(std::function<void(Rob
     impl_->primary_.registerRobotExceptionCallback(cb);
 }
 
+void PrimaryPortInterface::setCallbackExecutor(CallbackExecutorSharedPtr executor) {
+    impl_->primary_.setCallbackExecutor(executor);
+}
+
 } // namespace ELITE
 
@@ -0,0 +1,526 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "RtsiAggregator.hpp"
+#include "EliteException.hpp"
+#include "Log.hpp"
+#include "RtsiRecipeInternal.hpp"
+#include "SpscQueue.hpp"
+#include "Trace.hpp"
+#include "Utils.hpp"
+
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace ELITE;
+
+namespace {
+
+constexpr int HEADER_SIZE = 3;
+constexpr uint16_t PROTOCOL_VERSION = 1;
+
+// Rtsi package type, see RtsiClient
+enum PackageType : uint8_t {
+    REQUEST_PROTOCOL_VERSION = 86,       // ascii V
+    GET_ELITE_CONTROL_VERSION = 118,     // ascii v
+    DATA_PACKAGE = 85,                   // ascii U
+    CONTROL_PACKAGE_SETUP_OUTPUTS = 79,  // ascii O
+    CONTROL_PACKAGE_START = 83,          // ascii S
+};
+
+// The steps of the connection, a robot is set up by sending a request and waiting for its reply
+enum class Stage { CONNECT, PROTOCOL_VERSION, CONTROLLER_VERSION, SETUP_OUTPUTS, START, STREAMING, CLOSED };
+
+}  // namespace
+
+class RtsiAggregator::Impl {
+   public:
+    using FrameCallbackList = std::vector<std::pair<int, FrameCallback>>;
+
+    struct Loop {
+        boost::asio::io_context io_context;
+        std::unique_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work;
+        std::thread thread;
+        SpscQueue<RtsiSnapshot> queue;
+        // Held while the frame callbacks run, so that removeFrameCallback() can wait for them
+        std::mutex call_mutex;
+        // Robots assigned to the loop, guarded by robots_mutex_
+        size_t robot_count = 0;
+
+        explicit Loop(size_t queue_capacity) : queue(std::max<size_t>(queue_capacity, 1)) {}
+    };
+
+    // Only the thread of its loop touches the socket, the buffers and the stage
+    struct Robot {
+        int id;
+        Loop* loop;
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::steady_timer timer;
+        std::vector<uint8_t> recv_buffer;
+        std::vector<uint8_t> send_buffer;
+        RtsiRecipeInternal recipe;
+        Stage stage = Stage::CONNECT;
+        std::promise<bool> ready;
+        VersionInfo version;
+        std::atomic<bool> connected{false};
+
+        // The newest frame, and the frame being decoded
+        std::mutex snapshot_mutex;
+        RtsiSnapshot latest;
+        RtsiSnapshot decoding;
+
+        Robot(int id_, Loop* loop_, const std::vector<std::string>& recipe_list)
+            : id(id_), loop(loop_), socket(loop_->io_context), timer(loop_->io_context), recipe(recipe_list) {
+            // The length of RTSI package is uint16, so the buffers never grow again
+            recv_buffer.resize(UINT16_MAX + 1);
+            send_buffer.reserve(UINT16_MAX + 1);
+        }
+    };
+    using RobotPtr = std::shared_ptr<Robot>;
+
+    std::vector<std::string> recipe_list_;
+    double frequency_;
+    size_t queue_capacity_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::atomic<size_t> poll_next_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex robots_mutex_;
+    std::map<int, RobotPtr> robots_;
+    int robot_next_id_ = 0;
+
+    std::mutex frame_cb_mutex_;
+    std::shared_ptr<const FrameCallbackList> frame_cbs_;
+    int frame_cb_next_handle_ = 0;
+
+    Impl(const std::vector<std::string>& recipe_list, double frequency, int threads, size_t queue_capacity)
+        : recipe_list_(recipe_list), frequency_(frequency), queue_capacity_(queue_capacity) {
+        if (recipe_list_.empty()) {
+            throw EliteException(EliteException::Code::ILLEGAL_PARAM, "empty output recipe");
+        }
+        for (int i = 0; i < std::max(threads, 1); i++) {
+            loops_.emplace_back(new Loop(queue_capacity));
+            Loop* loop = loops_.back().get();
+            loop->work.reset(new boost::asio::executor_work_guard<boost::asio::io_context::executor_type>(
+                boost::asio::make_work_guard(loop->io_context)));
+            loop->thread = std::thread([loop]() {
+                TRACE::setThreadName("rtsi_aggregator");
+                try {
+                    loop->io_context.run();
+                } catch (const std::exception& e) {
+                    ELITE_LOG_FATAL("RTSI aggregator thread exception: %s", e.what());
+                }
+            });
+        }
+    }
+
+    ~Impl() {
+        std::map<int, RobotPtr> robots;
+        {
+            std::lock_guard<std::mutex> lock(robots_mutex_);
+            robots.swap(robots_);
+        }
+        for (auto& item : robots) {
+            RobotPtr robot = item.second;
+            boost::asio::post(robot->loop->io_context, [this, robot]() { close(*robot); });
+        }
+        // The loops return once the cancelled operations have completed
+        for (auto& loop : loops_) {
+            loop->work.reset();
+        }
+        for (auto& loop : loops_) {
+            if (loop->thread.joinable()) {
+                loop->thread.join();
+            }
+        }
+    }
+
+    Loop* currentLoop() {
+        for (auto& loop : loops_) {
+            if (loop->thread.get_id() == std::this_thread::get_id()) {
+                return loop.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void start(const RobotPtr& robot, const boost::asio::ip::tcp::endpoint& endpoint, unsigned timeout_ms) {
+        robot->timer.expires_after(std::chrono::milliseconds(timeout_ms));
+        robot->timer.async_wait([this, robot](const boost::system::error_code& ec) {
+            if (!ec && robot->stage != Stage::STREAMING) {
+                fail(*robot, "setup timeout");
+            }
+        });
+        robot->socket.async_connect(endpoint, [this, robot](const boost::system::error_code& ec) {
+            if (ec) {
+                fail(*robot, ec.message());
+                return;
+            }
+            boost::system::error_code option_ec;
+            robot->socket.set_option(boost::asio::ip::tcp::no_delay(true), option_ec);
+#if defined(__linux) || defined(linux) || defined(__linux__)
+            robot->socket.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), option_ec);
+#endif
+            robot->stage = Stage::PROTOCOL_VERSION;
+            uint8_t payload[] = {(uint8_t)(PROTOCOL_VERSION >> 8), (uint8_t)PROTOCOL_VERSION};
+            sendPackage(robot, REQUEST_PROTOCOL_VERSION, payload, sizeof(payload));
+            readHeader(robot);
+        });
+    }
+
+    void sendPackage(const RobotPtr& robot, PackageType type, const uint8_t* payload, size_t size) {
+        std::vector<uint8_t>& buffer = robot->send_buffer;
+        uint16_t len = HEADER_SIZE + size;
+        buffer.assign({(uint8_t)(len >> 8), (uint8_t)len, (uint8_t)type});
+        buffer.insert(buffer.end(), payload, payload + size);
+        // A request is sent only after the reply of the previous one, so there is one write at a time
+        boost::asio::async_write(robot->socket, boost::asio::buffer(buffer),
+                                 [this, robot](const boost::system::error_code& ec, std::size_t) {
+                                     if (ec) {
+                                         fail(*robot, ec.message());
+                                     }
+                                 });
+    }
+
+    void readHeader(const RobotPtr& robot) {
+        boost::asio::async_read(robot->socket, boost::asio::buffer(robot->recv_buffer.data(), HEADER_SIZE),
+                                [this, robot](const boost::system::error_code& ec, std::size_t) {
+                                    if (ec) {
+                                        fail(*robot, ec.message());
+                                        return;
+                                    }
+                                    uint16_t len;
+                                    EndianUtils::unpack(robot->recv_buffer.cbegin(), len);
+                                    if (len < HEADER_SIZE) {
+                                        fail(*robot, "illegal package length " + std::to_string(len));
+                                        return;
+                                    }
+                                    readBody(robot, len);
+                                });
+    }
+
+    void readBody(const RobotPtr& robot, uint16_t len) {
+        boost::asio::async_read(robot->socket,
+                                boost::asio::buffer(robot->recv_buffer.data() + HEADER_SIZE, len - HEADER_SIZE),
+                                [this, robot, len](const boost::system::error_code& ec, std::size_t) {
+                                    if (ec) {
+                                        fail(*robot, ec.message());
+                                        return;
+                                    }
+                                    handlePackage(robot, len);
+                                    if (robot->stage != Stage::CLOSED) {
+                                        readHeader(robot);
+                                    }
+                                });
+    }
+
+    void handlePackage(const RobotPtr& robot, uint16_t len) {
+        const std::vector<uint8_t>& package = robot->recv_buffer;
+        uint8_t type = package[2];
+        // Text messages and the replies which are not waited for are skipped, like RtsiClient does
+        switch (robot->stage) {
+            case Stage::PROTOCOL_VERSION:
+                if (type == REQUEST_PROTOCOL_VERSION) {
+                    // According to the RTSI document, the fourth byte of the message is whether the version is accepted
+                    if (len <= HEADER_SIZE || !package[3]) {
+                        fail(*robot, "protocol version is not accepted");
+                        return;
+                    }
+                    robot->stage = Stage::CONTROLLER_VERSION;
+                    sendPackage(robot, GET_ELITE_CONTROL_VERSION, nullptr, 0);
+                }
+                break;
+            case Stage::CONTROLLER_VERSION:
+                if (type == GET_ELITE_CONTROL_VERSION) {
+                    if (len < HEADER_SIZE + 16) {
+                        fail(*robot, "illegal controller version package");
+                        return;
+                    }
+                    int offset = HEADER_SIZE;
+                    EndianUtils::unpack(package, offset, robot->version.major);
+                    EndianUtils::unpack(package, offset, robot->version.minor);
+                    EndianUtils::unpack(package, offset, robot->version.bugfix);
+                    EndianUtils::unpack(package, offset, robot->version.build);
+                    robot->stage = Stage::SETUP_OUTPUTS;
+                    // The first eight bytes of the payload section in the output subscription message are the frequency.
+                    std::vector<uint8_t> payload = EndianUtils::pack(frequency_);
+                    for (size_t i = 0; i < recipe_list_.size(); i++) {
+                        if (i) {
+                            payload.push_back(',');
+                        }
+                        payload.insert(payload.end(), recipe_list_[i].begin(), recipe_list_[i].end());
+                    }
+                    sendPackage(robot, CONTROL_PACKAGE_SETUP_OUTPUTS, payload.data(), payload.size());
+                }
+                break;
+            case Stage::SETUP_OUTPUTS:
+                if (type == CONTROL_PACKAGE_SETUP_OUTPUTS) {
+                    try {
+                        robot->recipe.parserTypePackage(len, package);
+                    } catch (const EliteException& e) {
+                        fail(*robot, e.what());
+                        return;
+                    }
+                    robot->stage = Stage::START;
+                    sendPackage(robot, CONTROL_PACKAGE_START, nullptr, 0);
+                }
+                break;
+            case Stage::START:
+                if (type == CONTROL_PACKAGE_START) {
+                    // According to the RTSI document, the fourth byte of the message is whether the output has started
+                    if (len <= HEADER_SIZE || !package[3]) {
+                        fail(*robot, "output can't start");
+                        return;
+                    }
+                    robot->stage = Stage::STREAMING;
+                    robot->connected = true;
+                    robot->timer.cancel();
+                    robot->ready.set_value(true);
+                }
+                break;
+            case Stage::STREAMING:
+                if (type == DATA_PACKAGE) {
+                    handleFrame(*robot, len);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void handleFrame(Robot& robot, uint16_t len) {
+        {
+            ELITE_TRACE_SCOPE("rtsi.decode");
+            if (!robot.recipe.parserDataPackage(len, robot.recv_buffer)) {
+                return;
+            }
+            RtsiSnapshot& frame = robot.decoding;
+            robot.recipe.getValues(frame.values);
+            frame.robot = robot.id;
+            frame.sequence = robot.latest.sequence + 1;
+            frame.received = std::chrono::steady_clock::now();
+            // Readers copy under the lock, the swap keeps it short and reuses the buffers of the older frame
+            std::lock_guard<std::mutex> lock(robot.snapshot_mutex);
+            std::swap(robot.latest, robot.decoding);
+        }
+        // Only this thread writes 'latest', so it is read here without the lock
+        if (queue_capacity_ > 0 && !robot.loop->queue.push(robot.latest)) {
+            dropped_++;
+        }
+        callFrameCallbacks(robot);
+    }
+
+    void callFrameCallbacks(Robot& robot) {
+        // The list is taken under the call mutex, so removeFrameCallback() either waits for this call or this call sees the
+        // new list
+        std::lock_guard<std::mutex> call_lock(robot.loop->call_mutex);
+        std::shared_ptr<const FrameCallbackList> list;
+        {
+            std::lock_guard<std::mutex> lock(frame_cb_mutex_);
+            list = frame_cbs_;
+        }
+        if (!list) {
+            return;
+        }
+        ELITE_TRACE_SCOPE("rtsi.frame_callbacks");
+        for (auto& item : *list) {
+            // A throwing callback must not stop the other robots of the loop
+            try {
+                item.second(robot.latest);
+            } catch (const std::exception& e) {
+                ELITE_LOG_ERROR("RTSI aggregator frame callback exception: %s", e.what());
+            }
+        }
+    }
+
+    void close(Robot& robot) {
+        if (robot.stage == Stage::CLOSED) {
+            return;
+        }
+        if (robot.stage != Stage::STREAMING) {
+            robot.ready.set_value(false);
+        }
+        robot.stage = Stage::CLOSED;
+        robot.connected = false;
+        boost::system::error_code ec;
+        robot.socket.close(ec);
+        robot.timer.cancel();
+    }
+
+    void fail(Robot& robot, const std::string& reason) {
+        if (robot.stage == Stage::CLOSED) {
+            return;
+        }
+        if (robot.stage == Stage::STREAMING) {
+            ELITE_LOG_ERROR("RTSI aggregator lost robot %d: %s", robot.id, reason.c_str());
+        } else {
+            ELITE_LOG_ERROR("RTSI aggregator can't set up robot %d: %s", robot.id, reason.c_str());
+        }
+        close(robot);
+    }
+};
+
+RtsiAggregator::RtsiAggregator(const std::vector<std::string>& output_recipe, double frequency, int threads,
+                               size_t queue_capacity) {
+    impl_ = std::make_unique<Impl>(output_recipe, frequency, threads, queue_capacity);
+}
+
+RtsiAggregator::~RtsiAggregator() = default;
+
+int RtsiAggregator::addRobot(const std::string& ip, int port, unsigned timeout_ms) {
+    boost::asio::ip::tcp::endpoint endpoint;
+    try {
+        endpoint = boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(ip), port);
+    } catch (const boost::system::system_error& e) {
+        ELITE_LOG_ERROR("RTSI aggregator illegal IP %s: %s", ip.c_str(), e.what());
+        return -1;
+    }
+    Impl::RobotPtr robot;
+    {
+        std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+        // The loop with the fewest robots
+        Impl::Loop* loop = impl_->loops_.front().get();
+        for (auto& item : impl_->loops_) {
+            if (item->robot_count < loop->robot_count) {
+                loop = item.get();
+            }
+        }
+        loop->robot_count++;
+        robot = std::make_shared<Impl::Robot>(impl_->robot_next_id_++, loop, impl_->recipe_list_);
+    }
+    std::future<bool> ready = robot->ready.get_future();
+    boost::asio::post(robot->loop->io_context, [this, robot, endpoint, timeout_ms]() { impl_->start(robot, endpoint, timeout_ms); });
+    bool ok = ready.get();
+
+    std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+    if (!ok) {
+        robot->loop->robot_count--;
+        return -1;
+    }
+    impl_->robots_[robot->id] = robot;
+    ELITE_LOG_INFO("RTSI aggregator added robot %d (%s:%d)", robot->id, ip.c_str(), port);
+    return robot->id;
+}
+
+void RtsiAggregator::removeRobot(int robot) {
+    Impl::RobotPtr removed;
+    {
+        std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+        auto iter = impl_->robots_.find(robot);
+        if (iter == impl_->robots_.end()) {
+            return;
+        }
+        removed = iter->second;
+        impl_->robots_.erase(iter);
+        removed->loop->robot_count--;
+    }
+    if (impl_->currentLoop() == removed->loop) {
+        impl_->close(*removed);
+        return;
+    }
+    // Close it in its thread, and wait so that no callback of the robot runs after the return
+    std::promise<void> closed;
+    boost::asio::post(removed->loop->io_context, [this, removed, &closed]() {
+        impl_->close(*removed);
+        closed.set_value();
+    });
+    closed.get_future().wait();
+}
+
+std::vector<int> RtsiAggregator::getRobots() {
+    std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+    std::vector<int> robots;
+    for (auto& item : impl_->robots_) {
+        robots.push_back(item.first);
+    }
+    return robots;
+}
+
+bool RtsiAggregator::isConnected(int robot) {
+    std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+    auto iter = impl_->robots_.find(robot);
+    return iter != impl_->robots_.end() && iter->second->connected;
+}
+
+VersionInfo RtsiAggregator::getControllerVersion(int robot) {
+    std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+    auto iter = impl_->robots_.find(robot);
+    return iter != impl_->robots_.end() ? iter->second->version : VersionInfo();
+}
+
+int RtsiAggregator::getSlot(const std::string& name) const {
+    auto iter = std::find(impl_->recipe_list_.begin(), impl_->recipe_list_.end(), name);
+    return iter != impl_->recipe_list_.end() ? (int)(iter - impl_->recipe_list_.begin()) : -1;
+}
+
+bool RtsiAggregator::getSnapshot(int robot, RtsiSnapshot& snapshot) {
+    Impl::RobotPtr found;
+    {
+        std::lock_guard<std::mutex> lock(impl_->robots_mutex_);
+        auto iter = impl_->robots_.find(robot);
+        if (iter == impl_->robots_.end()) {
+            return false;
+        }
+        found = iter->second;
+    }
+    std::lock_guard<std::mutex> lock(found->snapshot_mutex);
+    if (found->latest.sequence == 0) {
+        return false;
+    }
+    snapshot = found->latest;
+    return true;
+}
+
+bool RtsiAggregator::pollFrame(RtsiSnapshot& snapshot) {
+    if (impl_->queue_capacity_ == 0) {
+        return false;
+    }
+    // Start from the next loop each time, so that a busy loop does not starve the others
+    size_t count = impl_->loops_.size();
+    size_t first = impl_->poll_next_++;
+    for (size_t i = 0; i < count; i++) {
+        if (impl_->loops_[(first + i) % count]->queue.pop(snapshot)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t RtsiAggregator::droppedCount() { return impl_->dropped_; }
+
+int RtsiAggregator::addFrameCallback(FrameCallback cb) {
+    std::lock_guard<std::mutex> lock(impl_->frame_cb_mutex_);
+    auto list = impl_->frame_cbs_ ? std::make_shared<Impl::FrameCallbackList>(*impl_->frame_cbs_)
+                                  : std::make_shared<Impl::FrameCallbackList>();
+    int handle = impl_->frame_cb_next_handle_++;
+    list->emplace_back(handle, std::move(cb));
+    impl_->frame_cbs_ = list;
+    return handle;
+}
+
+void RtsiAggregator::removeFrameCallback(int handle) {
+    {
+        std::lock_guard<std::mutex> lock(impl_->frame_cb_mutex_);
+        if (!impl_->frame_cbs_) {
+            return;
+        }
+        auto list = std::make_shared<Impl::FrameCallbackList>();
+        for (auto& item : *impl_->frame_cbs_) {
+            if (item.first != handle) {
+                list->push_back(item);
+            }
+        }
+        impl_->frame_cbs_ = list;
+    }
+    // The other loops may still be running the old list, wait for them so that the caller can release the callback's resources.
+    Impl::Loop* current = impl_->currentLoop();
+    for (auto& loop : impl_->loops_) {
+        if (loop.get() != current) {
+            std::lock_guard<std::mutex> lock(loop->call_mutex);
+        }
+    }
+}
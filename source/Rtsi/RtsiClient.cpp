@@ -6,6 +6,7 @@
 #include "Utils.hpp"
 #include "VersionInfo.hpp"
 #include "Log.hpp"
+#include "Trace.hpp"
 
 #include <array>
 #include <iostream>
@@ -18,6 +19,9 @@ void RtsiClient::connect(const std::string& ip, int port) {
     try {
         // If reconnect, the buffer not clean
         socket_ptr_.reset(new boost::asio::ip::tcp::socket(io_context_));
+        // The length of RTSI package is uint16, so the buffers never grow again
+        recv_buffer_.resize(UINT16_MAX + 1);
+        send_buffer_.reserve(UINT16_MAX + 1);
         resolver_ptr_.reset(new boost::asio::ip::tcp::resolver(io_context_));
         socket_ptr_->open(boost::asio::ip::tcp::v4());
         socket_ptr_->set_option(boost::asio::ip::tcp::no_delay(true));
@@ -141,65 +145,110 @@ bool RtsiClient::isStarted() { return connection_state == ConnectionState::START
 bool RtsiClient::isReadAvailable() { return socket_ptr_ ? socket_ptr_->available() : false; }
 
 void RtsiClient::send(RtsiRecipeSharedPtr& recipe) {
-    sendAll(PackageType::DATA_PACKAGE, static_cast<RtsiRecipeInternal*>(recipe.get())->packToBytes());
+    EliteException::Code code = trySend(recipe);
+    if (code == EliteException::Code::SOCKET_FAIL) {
+        throw EliteException(code, last_error_.message());
+    } else if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, "bad recipe");
+    }
+}
+
+EliteException::Code RtsiClient::trySend(const RtsiRecipeSharedPtr& recipe) noexcept {
+    ELITE_TRACE_SCOPE("rtsi.send");
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_buffer_.resize(RTSI_HEADR_SIZE);
+    EliteException::Code code = static_cast<RtsiRecipeInternal*>(recipe.get())->packToBytes(send_buffer_);
+    if (code != EliteException::Code::SUCCESS) {
+        return code;
+    }
+    return writePackage(PackageType::DATA_PACKAGE);
 }
 
 int RtsiClient::receiveData(std::vector<RtsiRecipeSharedPtr>& recipes, bool read_newest) {
     int result_id = -1;
-    receive(
+    EliteException::Code code = tryReceiveData(recipes, read_newest, result_id);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, last_error_.message());
+    }
+    return result_id;
+}
+
+bool RtsiClient::receiveData(RtsiRecipeSharedPtr recipe, bool read_newest) {
+    bool result = false;
+    EliteException::Code code = tryReceiveData(recipe, read_newest, result);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, last_error_.message());
+    }
+    return result;
+}
+
+EliteException::Code RtsiClient::tryReceiveData(std::vector<RtsiRecipeSharedPtr>& recipes, bool read_newest,
+                                                int& recipe_id) noexcept {
+    recipe_id = -1;
+    return receivePackage(
         PackageType::DATA_PACKAGE,
         [&](int len, const std::vector<uint8_t>& package) {
             // Referring to the RTSI document, the fourth byte of the message is the recipe ID.
-            int recipe_id = package[3];
+            int id = package[3];
             for (size_t i = 0; i < recipes.size(); i++) {
                 if (!recipes[i]) {
                     break;
                 }
-                if (recipes[i]->getID() == recipe_id) {
+                if (recipes[i]->getID() == id) {
                     static_cast<RtsiRecipeInternal*>(recipes[i].get())->parserDataPackage(len, package);
-                    result_id = recipe_id;
+                    recipe_id = id;
                     break;
                 }
             }
         },
         read_newest);
-    return result_id;
 }
 
-bool RtsiClient::receiveData(RtsiRecipeSharedPtr recipe, bool read_newest) {
-    bool result = false;
-    receive(
+EliteException::Code RtsiClient::tryReceiveData(const RtsiRecipeSharedPtr& recipe, bool read_newest, bool& received) noexcept {
+    received = false;
+    return receivePackage(
         PackageType::DATA_PACKAGE,
         [&](int len, const std::vector<uint8_t>& package) {
             // Referring to the RTSI document, the fourth byte of the message is the recipe ID.
             int recipe_id = package[3];
             if (recipe->getID() == recipe_id) {
                 static_cast<RtsiRecipeInternal*>(recipe.get())->parserDataPackage(len, package);
-                result = true;
+                received = true;
             }
         },
         read_newest);
-
-    return result;
 }
 
 void RtsiClient::sendAll(const PackageType& cmd, const std::vector<uint8_t>& payload) {
-    std::vector<uint8_t> message(RTSI_HEADR_SIZE);
-    uint16_t message_len = RTSI_HEADR_SIZE + payload.size();
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_buffer_.resize(RTSI_HEADR_SIZE);
+    send_buffer_.insert(send_buffer_.end(), payload.begin(), payload.end());
+    if (writePackage(cmd) != EliteException::Code::SUCCESS) {
+        throw EliteException(EliteException::Code::SOCKET_FAIL, last_error_.message());
+    }
+}
+
+EliteException::Code RtsiClient::writePackage(const PackageType& cmd) noexcept {
+    if (!socket_ptr_) {
+        last_error_ = boost::asio::error::not_connected;
+        ELITE_LOG_ERROR("RTSI socket send fail: %s", last_error_.message().c_str());
+        return EliteException::Code::SOCKET_FAIL;
+    }
+    uint16_t message_len = send_buffer_.size();
 
     // Build package header
-    message[0] = (uint8_t)(message_len >> 8);
-    message[1] = (uint8_t)message_len;
-    message[2] = static_cast<uint8_t>(cmd);
-    // Push back payload
-    std::copy(payload.begin(), payload.end(), std::back_inserter(message));
+    send_buffer_[0] = (uint8_t)(message_len >> 8);
+    send_buffer_[1] = (uint8_t)message_len;
+    send_buffer_[2] = static_cast<uint8_t>(cmd);
 
     boost::system::error_code ec;
-    socket_ptr_->write_some(boost::asio::buffer(message), ec);
+    boost::asio::write(*socket_ptr_, boost::asio::buffer(send_buffer_), ec);
     if (ec) {
+        last_error_ = ec;
         ELITE_LOG_FATAL("RTSI socket send fail: %s", ec.message().c_str());
-        throw EliteException(EliteException::Code::SOCKET_FAIL, ec.message());
+        return EliteException::Code::SOCKET_FAIL;
     }
+    return EliteException::Code::SUCCESS;
 }
 
 void RtsiClient::socketDisconnect() {
@@ -207,19 +256,18 @@ void RtsiClient::socketDisconnect() {
     connection_state = DISCONNECTED;
 }
 
-int RtsiClient::receiveSocket(std::vector<uint8_t>& buff, int size, int offset, unsigned timeout_ms) {
-    if (buff.size() < (size + offset)) {
-        buff.resize(size + offset);
+EliteException::Code RtsiClient::receiveSocket(int size, int offset, unsigned timeout_ms) noexcept {
+    if (!socket_ptr_) {
+        last_error_ = boost::asio::error::not_connected;
+        return EliteException::Code::SOCKET_FAIL;
+    }
+    if (recv_buffer_.size() < (size_t)(size + offset)) {
+        recv_buffer_.resize(size + offset);
     }
-    int read_len = 0;
-    boost::asio::async_read(*socket_ptr_, boost::asio::buffer(buff.data() + offset, size),
-                            [&](const boost::system::error_code& ec, std::size_t nb) {
-                                if (ec) {
-                                    ELITE_LOG_FATAL("RTSI socket receive fail: %s", ec.message().c_str());
-                                    throw EliteException(EliteException::Code::SOCKET_FAIL, ec.message());
-                                }
-                                read_len = nb;
-                            });
+    boost::system::error_code error;
+    // The handler only records the result, it runs inside 'io_context_.run_for()' and must not throw.
+    boost::asio::async_read(*socket_ptr_, boost::asio::buffer(recv_buffer_.data() + offset, size),
+                            [&](const boost::system::error_code& ec, std::size_t nb) { error = ec; });
 
     // Restart the io_context, as it may have been left in the "stopped" state
     // by a previous operation.
@@ -245,37 +293,60 @@ int RtsiClient::receiveSocket(std::vector<uint8_t>& buff, int size, int offset,
         io_context_.run();
         work.reset();
 
-        return -1;
+        last_error_ = boost::asio::error::timed_out;
+        ELITE_LOG_ERROR("RTSI socket receive timeout");
+        return EliteException::Code::SOCKET_TIMEOUT;
     }
-    return read_len;
+    if (error) {
+        last_error_ = error;
+        ELITE_LOG_FATAL("RTSI socket receive fail: %s", error.message().c_str());
+        return EliteException::Code::SOCKET_FAIL;
+    }
+    return EliteException::Code::SUCCESS;
 }
 
 void RtsiClient::receive(const PackageType& target_type, std::function<void(int, const std::vector<uint8_t>&)> parser_func,
                          bool read_newest) {
-    std::vector<uint8_t> buff(4069);
+    EliteException::Code code = receivePackage(target_type, parser_func, read_newest);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, last_error_.message());
+    }
+}
+
+template <typename F>
+EliteException::Code RtsiClient::receivePackage(const PackageType& target_type, F&& parser_func, bool read_newest) {
+    EliteException::Code code;
     // Receive RTSI package head
-    while (receiveSocket(buff, RTSI_HEADR_SIZE, 0) > 0) {
+    while ((code = receiveSocket(RTSI_HEADR_SIZE, 0)) == EliteException::Code::SUCCESS) {
         // Parser package head
         uint16_t pkg_len;
-        EndianUtils::unpack(buff.begin(), pkg_len);
-        PackageType pkg_type = static_cast<PackageType>(buff[2]);
+        EndianUtils::unpack(recv_buffer_.cbegin(), pkg_len);
+        PackageType pkg_type = static_cast<PackageType>(recv_buffer_[2]);
+        if (pkg_len < RTSI_HEADR_SIZE) {
+            last_error_ = boost::asio::error::invalid_argument;
+            ELITE_LOG_FATAL("RTSI receive package with illegal length %d", pkg_len);
+            return EliteException::Code::SOCKET_FAIL;
+        }
 
         // Receive RTSI package body
-        if (receiveSocket(buff, (pkg_len - RTSI_HEADR_SIZE), RTSI_HEADR_SIZE) <= 0) {
-            break;
+        code = receiveSocket(pkg_len - RTSI_HEADR_SIZE, RTSI_HEADR_SIZE);
+        if (code != EliteException::Code::SUCCESS) {
+            return code;
         }
 
         if (target_type == pkg_type) {
-            parser_func(pkg_len, buff);
+            {
+                ELITE_TRACE_SCOPE("rtsi.decode");
+                parser_func(pkg_len, recv_buffer_);
+            }
             if (!read_newest) {
-                return;
-            } else {
-                if (socket_ptr_->available() >= RTSI_HEADR_SIZE) {
-                    continue;
-                } else {
-                    break;
-                }
+                return EliteException::Code::SUCCESS;
+            }
+            boost::system::error_code ec;
+            if (socket_ptr_->available(ec) < RTSI_HEADR_SIZE || ec) {
+                return EliteException::Code::SUCCESS;
             }
         }
     }
-}
\ No newline at end of file
+    return code;
+}
@@ -43,6 +43,20 @@ bool RtsiClientInterface::receiveData(RtsiRecipeSharedPtr recipe, bool read_newe
     return impl_->client_.receiveData(recipe, read_newest);
 }
 
+EliteException::Code RtsiClientInterface::trySend(const RtsiRecipeSharedPtr& recipe) noexcept {
+    return impl_->client_.trySend(recipe);
+}
+
+EliteException::Code RtsiClientInterface::tryReceiveData(std::vector<RtsiRecipeSharedPtr>& recipes, bool read_newest,
+                                                         int& recipe_id) noexcept {
+    return impl_->client_.tryReceiveData(recipes, read_newest, recipe_id);
+}
+
+EliteException::Code RtsiClientInterface::tryReceiveData(const RtsiRecipeSharedPtr& recipe, bool read_newest,
+                                                         bool& received) noexcept {
+    return impl_->client_.tryReceiveData(recipe, read_newest, received);
+}
+
 bool RtsiClientInterface::isConnected() { return impl_->client_.isConnected(); }
 
 bool RtsiClientInterface::isStarted() { return impl_->client_.isStarted(); }
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "RtsiIOEventEngine.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RtsiIOEdge.hpp"
+#include "SpscQueue.hpp"
+
+using namespace ELITE;
+
+namespace {
+
+constexpr int DIGITAL_SOURCE_NUM = 4;
+
+// The names are built once, the frames look the values up without allocating
+struct DigitalWatch {
+    std::string low_name;
+    // Upper 32 bits, empty if the source has only one field
+    std::string high_name;
+    std::atomic<uint64_t> mask;
+    uint64_t prev;
+    bool valid;
+};
+
+struct AnalogWatch {
+    IOEventSource source;
+    int index;
+    std::string name;
+    IO_EDGE::HysteresisTrigger trigger;
+};
+
+const char* analogName(IOEventSource source, int index) {
+    if (source == IOEventSource::ANALOG_INPUT) {
+        if (index == 0) {
+            return "standard_analog_input0";
+        } else if (index == 1) {
+            return "standard_analog_input1";
+        }
+    } else if (source == IOEventSource::TOOL_ANALOG_INPUT && index == 0) {
+        return "tool_analog_input";
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+class RtsiIOEventEngine::Impl {
+   public:
+    using ListenerList = std::vector<std::pair<int, Listener>>;
+
+    RtsiFrameSource& rtsi_;
+    int frame_cb_handle_;
+    const std::string timestamp_name_;
+    SpscQueue<IOEvent> queue_;
+    std::atomic<uint64_t> dropped_;
+
+    DigitalWatch digital_[DIGITAL_SOURCE_NUM];
+
+    std::mutex analog_mutex_;
+    std::vector<AnalogWatch> analog_;
+    // The crossings of a frame, emitted once analog_mutex_ is released. Only used in onFrame().
+    std::vector<IOEvent> analog_events_;
+
+    std::mutex listener_mutex_;
+    // Held while onFrame() runs the listeners, removeListener() waits on it
+    std::mutex listener_call_mutex_;
+    std::atomic<std::thread::id> frame_thread_;
+    std::shared_ptr<const ListenerList> listeners_;
+    int listener_next_handle_;
+
+    Impl(RtsiFrameSource& rtsi, size_t capacity)
+        : rtsi_(rtsi), timestamp_name_("timestamp"), queue_(capacity), dropped_(0), listener_next_handle_(0) {
+        const char* names[DIGITAL_SOURCE_NUM][2] = {{"actual_digital_input_bits", nullptr},
+                                                    {"actual_digital_output_bits", nullptr},
+                                                    {"input_bit_registers0_to_31", "input_bit_registers32_to_63"},
+                                                    {"output_bit_registers0_to_31", "output_bit_registers32_to_63"}};
+        for (int i = 0; i < DIGITAL_SOURCE_NUM; i++) {
+            digital_[i].low_name = names[i][0];
+            digital_[i].high_name = names[i][1] ? names[i][1] : "";
+            digital_[i].mask = 0;
+            digital_[i].prev = 0;
+            digital_[i].valid = false;
+        }
+    }
+
+    void emit(const IOEvent& event, const std::shared_ptr<const ListenerList>& listeners) {
+        if (!queue_.push(event)) {
+            dropped_++;
+        }
+        if (listeners) {
+            for (auto& item : *listeners) {
+                item.second(event);
+            }
+        }
+    }
+
+    // Called in the RTSI receive thread for every frame.
+    void onFrame() {
+        frame_thread_ = std::this_thread::get_id();
+        // Take the list while holding the call mutex, like RtsiIOInterface::callFrameCallbacks()
+        std::lock_guard<std::mutex> call_lock(listener_call_mutex_);
+        double timestamp = 0;
+        rtsi_.getRecipeValue(timestamp_name_, timestamp);
+        std::shared_ptr<const ListenerList> listeners;
+        {
+            std::lock_guard<std::mutex> lock(listener_mutex_);
+            listeners = listeners_;
+        }
+
+        for (int i = 0; i < DIGITAL_SOURCE_NUM; i++) {
+            DigitalWatch& watch = digital_[i];
+            uint64_t mask = watch.mask.load(std::memory_order_relaxed);
+            if (mask == 0) {
+                watch.valid = false;
+                continue;
+            }
+            uint32_t low = 0;
+            uint32_t high = 0;
+            if (!rtsi_.getRecipeValue(watch.low_name, low)) {
+                continue;
+            }
+            if (!watch.high_name.empty()) {
+                rtsi_.getRecipeValue(watch.high_name, high);
+            }
+            uint64_t curr = ((uint64_t)high << 32) | low;
+            if (watch.valid) {
+                IOEventSource source = static_cast<IOEventSource>(i);
+                IO_EDGE::forEachEdge(watch.prev, curr, mask, [&](int index, bool rising) {
+                    IOEvent event;
+                    event.source = source;
+                    event.index = index;
+                    event.rising = rising;
+                    event.timestamp = timestamp;
+                    event.value = rising ? 1 : 0;
+                    emit(event, listeners);
+                });
+            }
+            watch.prev = curr;
+            watch.valid = true;
+        }
+
+        // A listener may watch or unwatch an analog input, emit after releasing the lock
+        analog_events_.clear();
+        {
+            std::lock_guard<std::mutex> lock(analog_mutex_);
+            for (auto& watch : analog_) {
+                double value = 0;
+                if (!rtsi_.getRecipeValue(watch.name, value)) {
+                    continue;
+                }
+                int crossing = watch.trigger.update(value);
+                if (crossing != 0) {
+                    IOEvent event;
+                    event.source = watch.source;
+                    event.index = watch.index;
+                    event.rising = crossing > 0;
+                    event.timestamp = timestamp;
+                    event.value = value;
+                    analog_events_.push_back(event);
+                }
+            }
+        }
+        for (auto& event : analog_events_) {
+            emit(event, listeners);
+        }
+    }
+};
+
+RtsiIOEventEngine::RtsiIOEventEngine(RtsiFrameSource& rtsi, size_t queue_capacity) : impl_(new Impl(rtsi, queue_capacity)) {
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+RtsiIOEventEngine::~RtsiIOEventEngine() { impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_); }
+
+bool RtsiIOEventEngine::watchDigital(IOEventSource source, uint64_t mask) {
+    int i = static_cast<int>(source);
+    if (i < 0 || i >= DIGITAL_SOURCE_NUM) {
+        return false;
+    }
+    impl_->digital_[i].mask = mask;
+    return true;
+}
+
+bool RtsiIOEventEngine::watchAnalog(IOEventSource source, int index, double threshold, double hysteresis) {
+    const char* name = analogName(source, index);
+    if (!name || hysteresis < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(impl_->analog_mutex_);
+    for (auto& watch : impl_->analog_) {
+        if (watch.source == source && watch.index == index) {
+            watch.trigger = IO_EDGE::HysteresisTrigger(threshold, hysteresis);
+            return true;
+        }
+    }
+    impl_->analog_.push_back(AnalogWatch{source, index, name, IO_EDGE::HysteresisTrigger(threshold, hysteresis)});
+    return true;
+}
+
+void RtsiIOEventEngine::unwatchAnalog(IOEventSource source, int index) {
+    std::lock_guard<std::mutex> lock(impl_->analog_mutex_);
+    for (auto iter = impl_->analog_.begin(); iter != impl_->analog_.end(); ++iter) {
+        if (iter->source == source && iter->index == index) {
+            impl_->analog_.erase(iter);
+            return;
+        }
+    }
+}
+
+bool RtsiIOEventEngine::pollEvent(IOEvent& event) { return impl_->queue_.pop(event); }
+
+uint64_t RtsiIOEventEngine::droppedCount() { return impl_->dropped_; }
+
+int RtsiIOEventEngine::addListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(impl_->listener_mutex_);
+    auto list = impl_->listeners_ ? std::make_shared<Impl::ListenerList>(*impl_->listeners_)
+                                  : std::make_shared<Impl::ListenerList>();
+    int handle = impl_->listener_next_handle_++;
+    list->emplace_back(handle, std::move(listener));
+    impl_->listeners_ = list;
+    return handle;
+}
+
+void RtsiIOEventEngine::removeListener(int handle) {
+    {
+        std::lock_guard<std::mutex> lock(impl_->listener_mutex_);
+        if (!impl_->listeners_) {
+            return;
+        }
+        auto list = std::make_shared<Impl::ListenerList>();
+        for (auto& item : *impl_->listeners_) {
+            if (item.first != handle) {
+                list->push_back(item);
+            }
+        }
+        impl_->listeners_ = list;
+    }
+    // The frame thread may still be running the old list, wait for it. A listener removing itself must not wait.
+    if (impl_->frame_thread_.load() != std::this_thread::get_id()) {
+        std::lock_guard<std::mutex> lock(impl_->listener_call_mutex_);
+    }
+}
@@ -11,6 +11,7 @@
 #include "Log.hpp"
 #include "RtUtils.hpp"
 #include "RtsiIOInterface.hpp"
+#include "Trace.hpp"
 
 using namespace ELITE;
 
@@ -18,14 +19,16 @@ RtsiIOInterface::RtsiIOInterface(const std::string& output_recipe_file, const st
     : output_recipe_string_(readRecipe(output_recipe_file)),
       input_recipe_string_(readRecipe(input_recipe_file)),
       target_frequency_(frequency),
-      input_new_cmd_(false) {}
+      input_new_cmd_(false),
+      frame_cb_next_handle_(0) {}
 
 RtsiIOInterface::RtsiIOInterface(const std::vector<std::string>& output_recipe, const std::vector<std::string>& input_recipe,
                                  double frequency)
     : output_recipe_string_(output_recipe),
       input_recipe_string_(input_recipe),
       target_frequency_(frequency),
-      input_new_cmd_(false) {}
+      input_new_cmd_(false),
+      frame_cb_next_handle_(0) {}
 
 RtsiIOInterface::~RtsiIOInterface() { disconnect(); }
 
@@ -65,6 +68,7 @@ bool RtsiIOInterface::connect(const std::string& ip) {
     is_recv_thread_alive_ = true;
     std::promise<bool> thread_prom;
     recv_thread_.reset(new std::thread([&]() {
+        TRACE::setThreadName("rtsi_io");
         // To avoid the situation where retrieving recipe data immediately after connecting returns null values, a data packet is
         // received first.
         try {
@@ -571,40 +575,124 @@ uint32_t RtsiIOInterface::getInBoolRegisters32To63() {
 
 bool RtsiIOInterface::getInBoolRegister(int index) {
     bool result = 0;
-    getRecipeValue("input_bit_register" + std::to_string(index), result);
+    if (index >= 64 && index < 128) {
+        readSingleRegister(output_recipe_, out_in_bool_slots_, index - 64, result);
+    } else {
+        getRecipeValue("input_bit_register" + std::to_string(index), result);
+    }
     return result;
 }
 
 bool RtsiIOInterface::getOutBoolRegister(int index) {
     bool result = 0;
-    getRecipeValue("output_bit_register" + std::to_string(index), result);
+    if (index >= 64 && index < 128) {
+        readSingleRegister(output_recipe_, out_out_bool_slots_, index - 64, result);
+    } else {
+        getRecipeValue("output_bit_register" + std::to_string(index), result);
+    }
     return result;
 }
 
 int32_t RtsiIOInterface::getInIntRegister(int index) {
     int32_t result = 0;
-    getRecipeValue("input_int_register" + std::to_string(index), result);
+    readSingleRegister(output_recipe_, out_in_int_slots_, index, result);
     return result;
 }
 
 int32_t RtsiIOInterface::getOutIntRegister(int index) {
     int32_t result = 0;
-    getRecipeValue("output_int_register" + std::to_string(index), result);
+    readSingleRegister(output_recipe_, out_out_int_slots_, index, result);
     return result;
 }
 
 double RtsiIOInterface::getInDoubleRegister(int index) {
     double result = 0;
-    getRecipeValue("input_double_register" + std::to_string(index), result);
+    readSingleRegister(output_recipe_, out_in_double_slots_, index, result);
     return result;
 }
 
 double RtsiIOInterface::getOutDoubleRegister(int index) {
     double result = 0;
-    getRecipeValue("output_double_register" + std::to_string(index), result);
+    readSingleRegister(output_recipe_, out_out_double_slots_, index, result);
     return result;
 }
 
+int RtsiIOInterface::getInIntRegisters(IntRegisterBank& values) {
+    values.fill(0);
+    return readRegisterBank(output_recipe_, out_in_int_slots_, 0, values.data());
+}
+
+int RtsiIOInterface::getOutIntRegisters(IntRegisterBank& values) {
+    values.fill(0);
+    return readRegisterBank(output_recipe_, out_out_int_slots_, 0, values.data());
+}
+
+int RtsiIOInterface::getInDoubleRegisters(DoubleRegisterBank& values) {
+    values.fill(0);
+    return readRegisterBank(output_recipe_, out_in_double_slots_, 0, values.data());
+}
+
+int RtsiIOInterface::getOutDoubleRegisters(DoubleRegisterBank& values) {
+    values.fill(0);
+    return readRegisterBank(output_recipe_, out_out_double_slots_, 0, values.data());
+}
+
+uint64_t RtsiIOInterface::getInBoolRegisters64To127() {
+    std::array<bool, 64> values{};
+    readRegisterBank(output_recipe_, out_in_bool_slots_, 64, values.data());
+    uint64_t result = 0;
+    for (int i = 0; i < 64; i++) {
+        result |= (uint64_t)values[i] << i;
+    }
+    return result;
+}
+
+uint64_t RtsiIOInterface::getOutBoolRegisters64To127() {
+    std::array<bool, 64> values{};
+    readRegisterBank(output_recipe_, out_out_bool_slots_, 64, values.data());
+    uint64_t result = 0;
+    for (int i = 0; i < 64; i++) {
+        result |= (uint64_t)values[i] << i;
+    }
+    return result;
+}
+
+bool RtsiIOInterface::setInputIntRegisters(int start, const int32_t* values, int count) {
+    if (start < 0 || count < 0 || start + count > REGISTER_BANK_SIZE) {
+        return false;
+    }
+    std::array<int, REGISTER_BANK_SIZE> indexes;
+    for (int i = 0; i < count; i++) {
+        indexes[i] = start + i;
+    }
+    return writeRegisterBank(in_int_slots_, indexes.data(), values, count);
+}
+
+bool RtsiIOInterface::setInputDoubleRegisters(int start, const double* values, int count) {
+    if (start < 0 || count < 0 || start + count > REGISTER_BANK_SIZE) {
+        return false;
+    }
+    std::array<int, REGISTER_BANK_SIZE> indexes;
+    for (int i = 0; i < count; i++) {
+        indexes[i] = start + i;
+    }
+    return writeRegisterBank(in_double_slots_, indexes.data(), values, count);
+}
+
+bool RtsiIOInterface::setInputBoolRegisters64To127(uint64_t mask, uint64_t values) {
+    std::array<int, 64> indexes;
+    std::array<bool, 64> levels;
+    int count = 0;
+    for (int i = 0; i < 64; i++) {
+        if ((mask >> i) & 1) {
+            indexes[count] = i;
+            levels[count] = (values >> i) & 1;
+            count++;
+        }
+    }
+    return writeRegisterBank(in_bool_slots_, indexes.data(), levels.data(), count);
+}
+
 std::vector<std::string> RtsiIOInterface::readRecipe(const std::string& recipe_file) {
     // If empty, return empty
     if (recipe_file.empty()) {
@@ -633,6 +721,85 @@ std::vector<std::string> RtsiIOInterface::readRecipe(const std::string& recipe_f
     return recipe;
 }
 
+int RtsiIOInterface::addFrameCallback(std::function<void()> cb) {
+    std::lock_guard<std::mutex> lock(frame_cb_mutex_);
+    std::shared_ptr<FrameCallbackList> list =
+        frame_cbs_ ? std::make_shared<FrameCallbackList>(*frame_cbs_) : std::make_shared<FrameCallbackList>();
+    int handle = frame_cb_next_handle_++;
+    list->emplace_back(handle, std::move(cb));
+    frame_cbs_ = list;
+    return handle;
+}
+
+void RtsiIOInterface::removeFrameCallback(int handle) {
+    {
+        std::lock_guard<std::mutex> lock(frame_cb_mutex_);
+        if (!frame_cbs_) {
+            return;
+        }
+        std::shared_ptr<FrameCallbackList> list = std::make_shared<FrameCallbackList>();
+        for (auto& item : *frame_cbs_) {
+            if (item.first != handle) {
+                list->push_back(item);
+            }
+        }
+        frame_cbs_ = list;
+    }
+    // The receive thread may still be running the old list, wait for it so that the caller can release the callback's resources.
+    if (!recv_thread_ || recv_thread_->get_id() != std::this_thread::get_id()) {
+        std::lock_guard<std::mutex> lock(frame_cb_call_mutex_);
+    }
+}
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, bool& out_value) { return getRecipeValue<bool>(name, out_value); }
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, int32_t& out_value) { return getRecipeValue<int32_t>(name, out_value); }
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, uint32_t& out_value) {
+    return getRecipeValue<uint32_t>(name, out_value);
+}
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, uint64_t& out_value) {
+    return getRecipeValue<uint64_t>(name, out_value);
+}
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, double& out_value) { return getRecipeValue<double>(name, out_value); }
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, vector3d_t& out_value) {
+    return getRecipeValue<vector3d_t>(name, out_value);
+}
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, vector6d_t& out_value) {
+    return getRecipeValue<vector6d_t>(name, out_value);
+}
+
+bool RtsiIOInterface::getRecipeValue(const std::string& name, vector6int32_t& out_value) {
+    return getRecipeValue<vector6int32_t>(name, out_value);
+}
+
+void RtsiIOInterface::callFrameCallbacks() {
+    ELITE_TRACE_SCOPE("rtsi.frame_callbacks");
+    // Take the list while holding the call mutex: a removeFrameCallback() that swapped the list before can not return
+    // before this call has seen the new list, and one that swaps it after waits for this call to end.
+    std::lock_guard<std::mutex> call_lock(frame_cb_call_mutex_);
+    std::shared_ptr<const FrameCallbackList> list;
+    {
+        std::lock_guard<std::mutex> lock(frame_cb_mutex_);
+        list = frame_cbs_;
+    }
+    if (!list) {
+        return;
+    }
+    for (auto& item : *list) {
+        // A throwing callback must not end the receive thread
+        try {
+            item.second();
+        } catch (const std::exception& e) {
+            ELITE_LOG_ERROR("RTSI frame callback exception: %s", e.what());
+        }
+    }
+}
+
 void RtsiIOInterface::setupRecipe() {
     if (!input_recipe_string_.empty()) {
         input_recipe_ = setupInputRecipe(input_recipe_string_);
@@ -640,6 +807,80 @@ void RtsiIOInterface::setupRecipe() {
     if (!output_recipe_string_.empty()) {
         output_recipe_ = setupOutputRecipe(output_recipe_string_, target_frequency_);
     }
+
+    // Look up the register names once, so that the register interfaces do not need to build and search the names.
+    mapRegisterSlots(output_recipe_, "input_int_register", 0, REGISTER_BANK_SIZE, out_in_int_slots_);
+    mapRegisterSlots(output_recipe_, "output_int_register", 0, REGISTER_BANK_SIZE, out_out_int_slots_);
+    mapRegisterSlots(output_recipe_, "input_double_register", 0, REGISTER_BANK_SIZE, out_in_double_slots_);
+    mapRegisterSlots(output_recipe_, "output_double_register", 0, REGISTER_BANK_SIZE, out_out_double_slots_);
+    mapRegisterSlots(output_recipe_, "input_bit_register", 64, 64, out_in_bool_slots_);
+    mapRegisterSlots(output_recipe_, "output_bit_register", 64, 64, out_out_bool_slots_);
+    mapRegisterSlots(input_recipe_, "input_int_register", 0, REGISTER_BANK_SIZE, in_int_slots_);
+    mapRegisterSlots(input_recipe_, "input_double_register", 0, REGISTER_BANK_SIZE, in_double_slots_);
+    mapRegisterSlots(input_recipe_, "input_bit_register", 64, 64, in_bool_slots_);
+}
+
+void RtsiIOInterface::mapRegisterSlots(const std::shared_ptr<RtsiRecipe>& recipe, const std::string& prefix, int first, int count,
+                                       RegisterBankSlots& out) {
+    out.indexes.clear();
+    out.slots.clear();
+    out.slot_of.assign(count, -1);
+    if (!recipe) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        int slot = recipe->getSlot(prefix + std::to_string(first + i));
+        if (slot >= 0) {
+            out.indexes.push_back(first + i);
+            out.slots.push_back(slot);
+            out.slot_of[i] = slot;
+        }
+    }
+}
+
+template <typename T>
+int RtsiIOInterface::readRegisterBank(const std::shared_ptr<RtsiRecipe>& recipe, const RegisterBankSlots& bank, int first,
+                                      T* values) {
+    if (!recipe || bank.slots.empty()) {
+        return 0;
+    }
+    std::array<T, 64> buffer;
+    if (!recipe->getSlotValues(bank.slots.data(), bank.slots.size(), buffer.data())) {
+        return 0;
+    }
+    for (size_t i = 0; i < bank.slots.size(); i++) {
+        values[bank.indexes[i] - first] = buffer[i];
+    }
+    return (int)bank.slots.size();
+}
+
+template <typename T>
+bool RtsiIOInterface::readSingleRegister(const std::shared_ptr<RtsiRecipe>& recipe, const RegisterBankSlots& bank, int offset,
+                                         T& value) {
+    if (!recipe || offset < 0 || offset >= (int)bank.slot_of.size() || bank.slot_of[offset] < 0) {
+        return false;
+    }
+    return recipe->getSlotValues(&bank.slot_of[offset], 1, &value);
+}
+
+template <typename T>
+bool RtsiIOInterface::writeRegisterBank(const RegisterBankSlots& bank, const int* offsets, const T* values, int count) {
+    if (!input_recipe_) {
+        return false;
+    }
+    std::array<int, 64> slots;
+    for (int i = 0; i < count; i++) {
+        int offset = offsets[i];
+        if (offset < 0 || offset >= (int)bank.slot_of.size() || bank.slot_of[offset] < 0) {
+            return false;
+        }
+        slots[i] = bank.slot_of[offset];
+    }
+    if (!input_recipe_->setSlotValues(slots.data(), count, values)) {
+        return false;
+    }
+    input_new_cmd_ = true;
+    return true;
 }
 
 void RtsiIOInterface::recvLoop() {
@@ -647,18 +888,26 @@ void RtsiIOInterface::recvLoop() {
     double period_ms = (1 / target_frequency_) * 1000;
     ELITE_LOG_INFO("RTSI IO interface sync thread start, period %lfms", period_ms);
     while (is_recv_thread_alive_) {
-        try {
-            if (output_recipe_) {
-                receiveData(output_recipe_, false);
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds((uint64_t)period_ms));
+        // The loop uses the exception free API, an error ends the thread without unwinding.
+        EliteException::Code code = EliteException::Code::SUCCESS;
+        if (output_recipe_) {
+            bool received = false;
+            {
+                ELITE_TRACE_SCOPE("rtsi.receive");
+                code = tryReceiveData(output_recipe_, false, received);
             }
-            if (input_new_cmd_ && input_recipe_) {
-                send(input_recipe_);
-                input_new_cmd_ = false;
+            if (code == EliteException::Code::SUCCESS && received) {
+                callFrameCallbacks();
             }
-        } catch (const std::exception& e) {
-            ELITE_LOG_FATAL("RTSI receive data fail: %s", e.what());
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds((uint64_t)period_ms));
+        }
+        if (code == EliteException::Code::SUCCESS && input_new_cmd_ && input_recipe_) {
+            code = trySend(input_recipe_);
+            input_new_cmd_ = false;
+        }
+        if (code != EliteException::Code::SUCCESS) {
+            ELITE_LOG_FATAL("RTSI receive data fail: %s", EliteException::exceptionCodeToString(code));
             is_recv_thread_alive_ = false;
         }
     }
@@ -23,6 +23,7 @@ void RtsiRecipeInternal::parserTypePackage(int package_len, const std::vector<st
     }
 
     RtsiTypeVariant init_value;
+    slot_table_.clear();
     for (int i = 0; i < recipe_list_.size(); i++) {
         if (types_list[i] == "VECTOR6D") {
             init_value = vector6d_t();
@@ -50,11 +51,13 @@ void RtsiRecipeInternal::parserTypePackage(int package_len, const std::vector<st
             throw EliteException(EliteException::Code::RTSI_UNKNOW_VARIABLE_TYPE,
                                  "variable \"" + recipe_list_[i] + "\" error type: " + types_list[i]);
         }
-        value_table_.insert({recipe_list_[i], init_value});
+        auto inserted = value_table_.insert({recipe_list_[i], init_value});
+        // Pointers to the elements of an unordered_map stay valid after rehashing.
+        slot_table_.push_back(&inserted.first->second);
     }
 }
 
-bool RtsiRecipeInternal::parserDataPackage(int package_len, const std::vector<std::uint8_t>& package) {
+bool RtsiRecipeInternal::parserDataPackage(int package_len, const std::vector<std::uint8_t>& package) noexcept {
     std::lock_guard<std::mutex> lock(update_mutex_);
     // Referring to the RTSI document, the fourth byte of the message is the recipe ID.
     int offset = 3;
@@ -64,8 +67,8 @@ bool RtsiRecipeInternal::parserDataPackage(int package_len, const std::vector<st
     offset++;
 
 #if (ELITE_SDK_COMPILE_STANDARD >= 17)
-    for (auto item : recipe_list_) {
-        RtsiTypeVariant& value = value_table_[item];
+    for (RtsiTypeVariant* slot : slot_table_) {
+        RtsiTypeVariant& value = *slot;
         // bool, uint8_t, uint16_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t, vector6int32_t, vector6uint32_t
         if (std::holds_alternative<bool>(value)) {
             value = (bool)package[offset];
@@ -107,8 +110,8 @@ bool RtsiRecipeInternal::parserDataPackage(int package_len, const std::vector<st
         }
     }
 #elif (ELITE_SDK_COMPILE_STANDARD == 14)
-    for (auto item : recipe_list_) {
-        RtsiTypeVariant& value = value_table_[item];
+    for (RtsiTypeVariant* slot : slot_table_) {
+        RtsiTypeVariant& value = *slot;
         // bool, uint8_t, uint16_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t, vector6int32_t, vector6uint32_t
         if (boost::get<bool>(&value)) {
             value = (bool)package[offset];
@@ -153,114 +156,104 @@ bool RtsiRecipeInternal::parserDataPackage(int package_len, const std::vector<st
     return true;
 }
 
-std::vector<uint8_t> RtsiRecipeInternal::packToBytes() {
+void RtsiRecipeInternal::getValues(std::vector<RtsiTypeVariant>& values) {
     std::lock_guard<std::mutex> lock(update_mutex_);
-    std::unordered_map<std::string, ELITE::RtsiTypeVariant>::const_iterator iter;
+    values.resize(slot_table_.size());
+    for (size_t i = 0; i < slot_table_.size(); i++) {
+        values[i] = *slot_table_[i];
+    }
+}
+
+std::vector<uint8_t> RtsiRecipeInternal::packToBytes() {
     std::vector<uint8_t> result;
-    std::vector<uint8_t> bytes;
-    result.push_back(recipe_id_);
+    EliteException::Code code = packToBytes(result);
+    if (code != EliteException::Code::SUCCESS) {
+        throw EliteException(code, "bad recipe");
+    }
+    return result;
+}
+
+EliteException::Code RtsiRecipeInternal::packToBytes(std::vector<uint8_t>& out) noexcept {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (slot_table_.size() != recipe_list_.size()) {
+        return EliteException::Code::RTSI_RECIPE_PARSER_FAIL;
+    }
+    out.push_back(recipe_id_);
 
 #if (ELITE_SDK_COMPILE_STANDARD >= 17)
-    for (auto item : recipe_list_) {
-        iter = value_table_.find(item);
-        if (iter == value_table_.end()) {
-            throw EliteException(EliteException::Code::RTSI_RECIPE_PARSER_FAIL, "bad recipe");
-        }
+    for (const RtsiTypeVariant* value : slot_table_) {
         // bool, uint8_t, uint16_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t, vector6int32_t, vector6uint32_t
-        if (auto va = std::get_if<bool>(&iter->second)) {
-            result.push_back(*va);
+        if (auto va = std::get_if<bool>(value)) {
+            out.push_back(*va);
 
-        } else if (auto va = std::get_if<uint8_t>(&iter->second)) {
-            result.push_back(*va);
+        } else if (auto va = std::get_if<uint8_t>(value)) {
+            out.push_back(*va);
 
-        } else if (auto va = std::get_if<uint16_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<uint16_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = std::get_if<uint32_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<uint32_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = std::get_if<uint64_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<uint64_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = std::get_if<int32_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<int32_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = std::get_if<double>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<double>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = std::get_if<vector3d_t>(&iter->second)) {
-            bytes = EndianUtils::pack<double, 3>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<vector3d_t>(value)) {
+            EndianUtils::packTo<double, 3>(out, *va);
 
-        } else if (auto va = std::get_if<vector6d_t>(&iter->second)) {
-            bytes = EndianUtils::pack<double, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<vector6d_t>(value)) {
+            EndianUtils::packTo<double, 6>(out, *va);
 
-        } else if (auto va = std::get_if<vector6int32_t>(&iter->second)) {
-            bytes = EndianUtils::pack<int32_t, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<vector6int32_t>(value)) {
+            EndianUtils::packTo<int32_t, 6>(out, *va);
 
-        } else if (auto va = std::get_if<vector6uint32_t>(&iter->second)) {
-            bytes = EndianUtils::pack<uint32_t, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = std::get_if<vector6uint32_t>(value)) {
+            EndianUtils::packTo<uint32_t, 6>(out, *va);
         }
     }
 #elif (ELITE_SDK_COMPILE_STANDARD == 14)
-    for (auto item : recipe_list_) {
-        iter = value_table_.find(item);
-        if (iter == value_table_.end()) {
-            throw EliteException(EliteException::Code::RTSI_RECIPE_PARSER_FAIL, "bad recipe");
-        }
+    for (const RtsiTypeVariant* value : slot_table_) {
         // bool, uint8_t, uint16_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t, vector6int32_t, vector6uint32_t
-        if (auto va = boost::get<bool>(&iter->second)) {
-            result.push_back(*va);
+        if (auto va = boost::get<bool>(value)) {
+            out.push_back(*va);
 
-        } else if (auto va = boost::get<uint8_t>(&iter->second)) {
-            result.push_back(*va);
+        } else if (auto va = boost::get<uint8_t>(value)) {
+            out.push_back(*va);
 
-        } else if (auto va = boost::get<uint16_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<uint16_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = boost::get<uint32_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<uint32_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = boost::get<uint64_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<uint64_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = boost::get<int32_t>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<int32_t>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = boost::get<double>(&iter->second)) {
-            bytes = EndianUtils::pack(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<double>(value)) {
+            EndianUtils::packTo(out, *va);
 
-        } else if (auto va = boost::get<vector3d_t>(&iter->second)) {
-            bytes = EndianUtils::pack<double, 3>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<vector3d_t>(value)) {
+            EndianUtils::packTo<double, 3>(out, *va);
 
-        } else if (auto va = boost::get<vector6d_t>(&iter->second)) {
-            bytes = EndianUtils::pack<double, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<vector6d_t>(value)) {
+            EndianUtils::packTo<double, 6>(out, *va);
 
-        } else if (auto va = boost::get<vector6int32_t>(&iter->second)) {
-            bytes = EndianUtils::pack<int32_t, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<vector6int32_t>(value)) {
+            EndianUtils::packTo<int32_t, 6>(out, *va);
 
-        } else if (auto va = boost::get<vector6uint32_t>(&iter->second)) {
-            bytes = EndianUtils::pack<uint32_t, 6>(*va);
-            result.insert(result.end(), std::make_move_iterator(bytes.begin()), std::make_move_iterator(bytes.end()));
+        } else if (auto va = boost::get<vector6uint32_t>(value)) {
+            EndianUtils::packTo<uint32_t, 6>(out, *va);
         }
     }
-
 #endif
-    return result;
-}
\ No newline at end of file
+    return EliteException::Code::SUCCESS;
+}
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "RtsiRegisterRpc.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "EliteException.hpp"
+#include "Log.hpp"
+
+using namespace ELITE;
+
+namespace {
+
+struct PendingRequest {
+    int32_t opcode;
+    std::vector<int32_t> int_values;
+    std::vector<double> double_values;
+    std::promise<RtsiRegisterRpc::Response> promise;
+};
+
+}  // namespace
+
+class RtsiRegisterRpc::Impl {
+   public:
+    RtsiIOInterface& rtsi_;
+    Config config_;
+    int frame_cb_handle_;
+
+    std::mutex mutex_;
+    std::deque<PendingRequest> queue_;
+    // The request written to the registers, valid when in_flight_seq_ != 0
+    PendingRequest in_flight_;
+    int32_t in_flight_seq_;
+    std::chrono::steady_clock::time_point in_flight_time_;
+    int32_t last_seq_;
+
+    std::string ack_name_;
+
+    Impl(RtsiIOInterface& rtsi, const Config& config)
+        : rtsi_(rtsi),
+          config_(config),
+          in_flight_seq_(0),
+          last_seq_(0),
+          ack_name_("output_int_register" + std::to_string(config.int_register_base)) {}
+
+    int32_t nextSeq() {
+        int32_t seq = last_seq_ + 1;
+        if (seq <= 0) {
+            seq = 1;
+        }
+        return seq;
+    }
+
+    // Write the request to the input registers. The sequence number is written last, it is sent in the same package anyway.
+    bool writeRequest(const PendingRequest& req, int32_t seq) {
+        RtsiIOInterface::IntRegisterBank ints{};
+        ints[0] = req.opcode;
+        std::copy(req.int_values.begin(), req.int_values.end(), ints.begin() + 1);
+        if (!rtsi_.setInputIntRegisters(config_.int_register_base + 1, ints.data(), config_.int_payload_count + 1)) {
+            return false;
+        }
+        RtsiIOInterface::DoubleRegisterBank doubles{};
+        std::copy(req.double_values.begin(), req.double_values.end(), doubles.begin());
+        if (!rtsi_.setInputDoubleRegisters(config_.double_register_base, doubles.data(), config_.double_payload_count)) {
+            return false;
+        }
+        return rtsi_.setInputIntRegisters(config_.int_register_base, &seq, 1);
+    }
+
+    Response readResponse() {
+        Response resp;
+        resp.status = Status::SUCCESS;
+        RtsiIOInterface::IntRegisterBank ints;
+        RtsiIOInterface::DoubleRegisterBank doubles;
+        rtsi_.getOutIntRegisters(ints);
+        rtsi_.getOutDoubleRegisters(doubles);
+        resp.result = ints[config_.int_register_base + 1];
+        resp.int_values.assign(ints.begin() + config_.int_register_base + 2,
+                               ints.begin() + config_.int_register_base + 2 + config_.int_payload_count);
+        resp.double_values.assign(doubles.begin() + config_.double_register_base,
+                                  doubles.begin() + config_.double_register_base + config_.double_payload_count);
+        return resp;
+    }
+
+    // Issue queued requests until one is in flight. Requests that can not be written are completed with SEND_FAIL.
+    // Must be called with 'mutex_' locked, the completed requests are returned to be resolved without the lock.
+    void issueNext(std::vector<std::pair<PendingRequest, Response>>& done) {
+        while (in_flight_seq_ == 0 && !queue_.empty()) {
+            PendingRequest req = std::move(queue_.front());
+            queue_.pop_front();
+            int32_t seq = nextSeq();
+            if (!writeRequest(req, seq)) {
+                Response resp;
+                resp.status = Status::SEND_FAIL;
+                done.emplace_back(std::move(req), std::move(resp));
+                continue;
+            }
+            last_seq_ = seq;
+            in_flight_seq_ = seq;
+            in_flight_ = std::move(req);
+            in_flight_time_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    // Called in the RTSI receive thread for every frame.
+    void onFrame() {
+        std::vector<std::pair<PendingRequest, Response>> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            int32_t ack = 0;
+            bool has_ack = rtsi_.getRecipeValue(ack_name_, ack);
+            if (in_flight_seq_ == 0) {
+                // Keep the sequence ahead of the robot, in case the SDK was restarted while the robot task kept running.
+                if (has_ack && ack >= last_seq_) {
+                    last_seq_ = ack;
+                }
+            } else {
+                auto now = std::chrono::steady_clock::now();
+                if (has_ack && ack == in_flight_seq_) {
+                    Response resp = readResponse();
+                    resp.latency = std::chrono::duration_cast<std::chrono::microseconds>(now - in_flight_time_);
+                    done.emplace_back(std::move(in_flight_), std::move(resp));
+                    in_flight_seq_ = 0;
+                } else if (now - in_flight_time_ > std::chrono::milliseconds(config_.timeout_ms)) {
+                    ELITE_LOG_WARN("RTSI register RPC request %d (opcode %d) timeout", in_flight_seq_, in_flight_.opcode);
+                    Response resp;
+                    resp.status = Status::TIMEOUT;
+                    resp.latency = std::chrono::duration_cast<std::chrono::microseconds>(now - in_flight_time_);
+                    done.emplace_back(std::move(in_flight_), std::move(resp));
+                    in_flight_seq_ = 0;
+                }
+            }
+            issueNext(done);
+        }
+        for (auto& item : done) {
+            item.first.promise.set_value(std::move(item.second));
+        }
+    }
+};
+
+RtsiRegisterRpc::RtsiRegisterRpc(RtsiIOInterface& rtsi, const Config& config) {
+    if (config.int_register_base < 0 || config.int_payload_count < 0 ||
+        config.int_register_base + config.int_payload_count + 2 > REGISTER_COUNT || config.double_register_base < 0 ||
+        config.double_payload_count < 0 || config.double_register_base + config.double_payload_count > REGISTER_COUNT ||
+        config.timeout_ms <= 0) {
+        throw EliteException(EliteException::Code::ILLEGAL_PARAM, "RTSI register RPC layout out of range");
+    }
+    impl_.reset(new Impl(rtsi, config));
+    impl_->frame_cb_handle_ = rtsi.addFrameCallback([this]() { impl_->onFrame(); });
+}
+
+RtsiRegisterRpc::~RtsiRegisterRpc() {
+    impl_->rtsi_.removeFrameCallback(impl_->frame_cb_handle_);
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (impl_->in_flight_seq_ != 0) {
+        impl_->in_flight_.promise.set_value(Response());
+    }
+    for (auto& req : impl_->queue_) {
+        req.promise.set_value(Response());
+    }
+}
+
+std::future<RtsiRegisterRpc::Response> RtsiRegisterRpc::call(int32_t opcode, const std::vector<int32_t>& int_values,
+                                                             const std::vector<double>& double_values) {
+    if ((int)int_values.size() > impl_->config_.int_payload_count ||
+        (int)double_values.size() > impl_->config_.double_payload_count) {
+        throw EliteException(EliteException::Code::ILLEGAL_PARAM, "RTSI register RPC payload is longer than the layout");
+    }
+    PendingRequest req;
+    req.opcode = opcode;
+    req.int_values = int_values;
+    req.double_values = double_values;
+    std::future<Response> fut = req.promise.get_future();
+
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    impl_->queue_.push_back(std::move(req));
+    return fut;
+}
+
+size_t RtsiRegisterRpc::pendingCount() {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    return impl_->queue_.size() + (impl_->in_flight_seq_ != 0 ? 1 : 0);
+}
+
+std::vector<std::string> RtsiRegisterRpc::inputRecipe(const Config& config) {
+    std::vector<std::string> recipe;
+    for (int i = 0; i < config.int_payload_count + 2; i++) {
+        recipe.push_back("input_int_register" + std::to_string(config.int_register_base + i));
+    }
+    for (int i = 0; i < config.double_payload_count; i++) {
+        recipe.push_back("input_double_register" + std::to_string(config.double_register_base + i));
+    }
+    return recipe;
+}
+
+std::vector<std::string> RtsiRegisterRpc::outputRecipe(const Config& config) {
+    std::vector<std::string> recipe;
+    for (int i = 0; i < config.int_payload_count + 2; i++) {
+        recipe.push_back("output_int_register" + std::to_string(config.int_register_base + i));
+    }
+    for (int i = 0; i < config.double_payload_count; i++) {
+        recipe.push_back("output_double_register" + std::to_string(config.double_register_base + i));
+    }
+    return recipe;
+}
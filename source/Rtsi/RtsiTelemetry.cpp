@@ -0,0 +1,900 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+#include "RtsiTelemetry.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "Log.hpp"
+
+using namespace ELITE;
+
+namespace {
+
+const char FILE_MAGIC[8] = {'E', 'L', 'I', 'T', 'E', 'T', 'M', '1'};
+const char INDEX_MAGIC[8] = {'E', 'L', 'I', 'T', 'E', 'T', 'I', 'X'};
+constexpr uint32_t BLOCK_MAGIC = 0x4b4c4254;  // "TBLK"
+// magic, payload size, frames, first and last time
+constexpr size_t BLOCK_HEADER_SIZE = 4 + 4 + 4 + 8 + 8;
+// offset, first and last time, frames
+constexpr size_t INDEX_ENTRY_SIZE = 8 + 8 + 8 + 4;
+// block count, index offset, magic
+constexpr size_t FOOTER_SIZE = 4 + 8 + 8;
+
+#if (ELITE_SDK_COMPILE_STANDARD >= 17)
+template <typename T>
+const T& variantGet(const RtsiTypeVariant& value) {
+    return std::get<T>(value);
+}
+int variantIndex(const RtsiTypeVariant& value) { return (int)value.index(); }
+#elif (ELITE_SDK_COMPILE_STANDARD == 14)
+template <typename T>
+const T& variantGet(const RtsiTypeVariant& value) {
+    return boost::get<T>(value);
+}
+int variantIndex(const RtsiTypeVariant& value) { return value.which(); }
+#endif
+
+// Little endian fixed size integers
+template <typename T>
+void putFixed(std::vector<uint8_t>& out, T value) {
+    uint64_t bits = (uint64_t)value;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out.push_back((uint8_t)(bits >> (8 * i)));
+    }
+}
+
+template <typename T>
+T getFixed(const uint8_t* data) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bits |= (uint64_t)data[i] << (8 * i);
+    }
+    return (T)bits;
+}
+
+uint64_t zigzag(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+
+int64_t unzigzag(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+// Two's complement difference and sum, a delta of any two values (e.g. UINT64 bits over INT64_MAX) wraps instead of overflowing
+int64_t wrappingSub(int64_t a, int64_t b) { return (int64_t)((uint64_t)a - (uint64_t)b); }
+
+int64_t wrappingAdd(int64_t a, int64_t b) { return (int64_t)((uint64_t)a + (uint64_t)b); }
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+bool getVarint(const uint8_t* data, size_t size, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int leadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    for (uint64_t bit = 1ULL << 63; !(value & bit); bit >>= 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+int trailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    for (; !(value & 1); value >>= 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+class BitWriter {
+   public:
+    void write(uint64_t value, int count) {
+        if (count > 32) {
+            write(value >> 32, count - 32);
+            count = 32;
+        }
+        uint64_t mask = count == 64 ? ~0ULL : ((1ULL << count) - 1);
+        acc_ = (acc_ << count) | (value & mask);
+        bits_ += count;
+        while (bits_ >= 8) {
+            bits_ -= 8;
+            bytes_.push_back((uint8_t)(acc_ >> bits_));
+        }
+    }
+
+    std::vector<uint8_t>& finish() {
+        if (bits_ > 0) {
+            bytes_.push_back((uint8_t)(acc_ << (8 - bits_)));
+            bits_ = 0;
+        }
+        return bytes_;
+    }
+
+    void clear() {
+        bytes_.clear();
+        acc_ = 0;
+        bits_ = 0;
+    }
+
+   private:
+    std::vector<uint8_t> bytes_;
+    uint64_t acc_ = 0;
+    int bits_ = 0;
+};
+
+class BitReader {
+   public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size), pos_(0), error_(false) {}
+
+    uint64_t read(int count) {
+        uint64_t value = 0;
+        while (count > 0) {
+            if ((pos_ >> 3) >= size_) {
+                error_ = true;
+                return 0;
+            }
+            int available = 8 - (int)(pos_ & 7);
+            int take = std::min(available, count);
+            uint64_t bits = (data_[pos_ >> 3] >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | bits;
+            pos_ += take;
+            count -= take;
+        }
+        return value;
+    }
+
+    bool error() const { return error_; }
+
+   private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+    bool error_;
+};
+
+// Gorilla XOR compression of doubles
+class DoubleEncoder {
+   public:
+    void reset() {
+        writer_.clear();
+        first_ = true;
+        prev_ = 0;
+        prev_leading_ = -1;
+        prev_trailing_ = 0;
+    }
+
+    void put(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if (first_) {
+            writer_.write(bits, 64);
+            first_ = false;
+            prev_ = bits;
+            return;
+        }
+        uint64_t x = bits ^ prev_;
+        prev_ = bits;
+        if (x == 0) {
+            writer_.write(0, 1);
+            return;
+        }
+        int leading = std::min(leadingZeros(x), 31);
+        int trailing = trailingZeros(x);
+        if (prev_leading_ >= 0 && leading >= prev_leading_ && trailing >= prev_trailing_) {
+            // The meaningful bits fit in the previous window
+            writer_.write(2, 2);
+            writer_.write(x >> prev_trailing_, 64 - prev_leading_ - prev_trailing_);
+            return;
+        }
+        int length = 64 - leading - trailing;
+        writer_.write(3, 2);
+        writer_.write(leading, 5);
+        writer_.write(length - 1, 6);
+        writer_.write(x >> trailing, length);
+        prev_leading_ = leading;
+        prev_trailing_ = trailing;
+    }
+
+    std::vector<uint8_t>& finish() { return writer_.finish(); }
+
+   private:
+    BitWriter writer_;
+    bool first_ = true;
+    uint64_t prev_ = 0;
+    int prev_leading_ = -1;
+    int prev_trailing_ = 0;
+};
+
+bool decodeDoubles(const uint8_t* data, size_t size, uint32_t frames, std::vector<double>& out) {
+    BitReader reader(data, size);
+    out.resize(frames);
+    uint64_t prev = 0;
+    int leading = 0;
+    int length = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+        if (i == 0) {
+            prev = reader.read(64);
+        } else if (reader.read(1)) {
+            if (reader.read(1)) {
+                leading = (int)reader.read(5);
+                length = (int)reader.read(6) + 1;
+            }
+            int trailing = 64 - leading - length;
+            if (trailing < 0) {
+                return false;
+            }
+            prev ^= reader.read(length) << trailing;
+        }
+        std::memcpy(&out[i], &prev, sizeof(prev));
+    }
+    return !reader.error();
+}
+
+// Delta-of-delta compression of the timestamps
+class TimeEncoder {
+   public:
+    void reset() {
+        writer_.clear();
+        count_ = 0;
+        prev_ = 0;
+        prev_delta_ = 0;
+    }
+
+    void put(int64_t time) {
+        if (count_++ == 0) {
+            writer_.write((uint64_t)time, 64);
+            prev_ = time;
+            return;
+        }
+        int64_t delta = wrappingSub(time, prev_);
+        uint64_t dod = zigzag(wrappingSub(delta, prev_delta_));
+        prev_ = time;
+        prev_delta_ = delta;
+        if (dod == 0) {
+            writer_.write(0, 1);
+        } else if (dod < (1ULL << 7)) {
+            writer_.write(2, 2);
+            writer_.write(dod, 7);
+        } else if (dod < (1ULL << 12)) {
+            writer_.write(6, 3);
+            writer_.write(dod, 12);
+        } else if (dod < (1ULL << 20)) {
+            writer_.write(14, 4);
+            writer_.write(dod, 20);
+        } else {
+            writer_.write(15, 4);
+            writer_.write(dod, 64);
+        }
+    }
+
+    std::vector<uint8_t>& finish() { return writer_.finish(); }
+
+   private:
+    BitWriter writer_;
+    uint32_t count_ = 0;
+    int64_t prev_ = 0;
+    int64_t prev_delta_ = 0;
+};
+
+bool decodeTimes(const uint8_t* data, size_t size, uint32_t frames, std::vector<int64_t>& out) {
+    BitReader reader(data, size);
+    out.resize(frames);
+    int64_t prev = 0;
+    int64_t delta = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+        if (i == 0) {
+            prev = (int64_t)reader.read(64);
+        } else {
+            uint64_t dod = 0;
+            if (reader.read(1)) {
+                if (!reader.read(1)) {
+                    dod = reader.read(7);
+                } else if (!reader.read(1)) {
+                    dod = reader.read(12);
+                } else if (!reader.read(1)) {
+                    dod = reader.read(20);
+                } else {
+                    dod = reader.read(64);
+                }
+            }
+            delta = wrappingAdd(delta, unzigzag(dod));
+            prev = wrappingAdd(prev, delta);
+        }
+        out[i] = prev;
+    }
+    return !reader.error();
+}
+
+// Run length encoding of integers, the run values as zigzag deltas
+class IntegerEncoder {
+   public:
+    void reset() {
+        bytes_.clear();
+        run_ = 0;
+        value_ = 0;
+        prev_ = 0;
+    }
+
+    void put(int64_t value) {
+        if (run_ > 0 && value == value_) {
+            run_++;
+            return;
+        }
+        flush();
+        value_ = value;
+        run_ = 1;
+    }
+
+    std::vector<uint8_t>& finish() {
+        flush();
+        return bytes_;
+    }
+
+   private:
+    void flush() {
+        if (run_ == 0) {
+            return;
+        }
+        putVarint(bytes_, zigzag(wrappingSub(value_, prev_)));
+        putVarint(bytes_, run_);
+        prev_ = value_;
+        run_ = 0;
+    }
+
+    std::vector<uint8_t> bytes_;
+    uint64_t run_ = 0;
+    int64_t value_ = 0;
+    int64_t prev_ = 0;
+};
+
+bool decodeIntegers(const uint8_t* data, size_t size, uint32_t frames, std::vector<int64_t>& out) {
+    out.clear();
+    out.reserve(frames);
+    size_t pos = 0;
+    int64_t value = 0;
+    while (out.size() < frames) {
+        uint64_t delta, run;
+        if (!getVarint(data, size, pos, delta) || !getVarint(data, size, pos, run) || run > frames - out.size()) {
+            return false;
+        }
+        value = wrappingAdd(value, unzigzag(delta));
+        out.insert(out.end(), run, value);
+    }
+    return true;
+}
+
+// Scalar columns of a field
+int laneCount(TelemetryType type) {
+    switch (type) {
+        case TelemetryType::VECTOR3D:
+            return 3;
+        case TelemetryType::VECTOR6D:
+        case TelemetryType::VECTOR6INT32:
+        case TelemetryType::VECTOR6UINT32:
+            return 6;
+        default:
+            return 1;
+    }
+}
+
+bool isDouble(TelemetryType type) {
+    return type == TelemetryType::DOUBLE || type == TelemetryType::VECTOR3D || type == TelemetryType::VECTOR6D;
+}
+
+struct BlockEntry {
+    uint64_t offset;
+    int64_t first;
+    int64_t last;
+    uint32_t frames;
+};
+
+}  // namespace
+
+class TelemetryWriter::Impl {
+   public:
+    std::ofstream file_;
+    std::vector<TelemetryField> fields_;
+    int block_frames_ = 0;
+    uint64_t offset_ = 0;
+    uint64_t frames_ = 0;
+    std::vector<BlockEntry> index_;
+
+    // The current block
+    uint32_t block_count_ = 0;
+    int64_t block_first_ = 0;
+    int64_t last_time_ = 0;
+    TimeEncoder time_;
+    std::vector<DoubleEncoder> doubles_;
+    std::vector<IntegerEncoder> integers_;
+    std::vector<uint8_t> buffer_;
+
+    bool write(const std::vector<uint8_t>& bytes) {
+        file_.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        offset_ += bytes.size();
+        return file_.good();
+    }
+
+    void resetBlock() {
+        block_count_ = 0;
+        time_.reset();
+        for (auto& lane : doubles_) {
+            lane.reset();
+        }
+        for (auto& lane : integers_) {
+            lane.reset();
+        }
+    }
+
+    bool writeBlock() {
+        if (block_count_ == 0) {
+            return true;
+        }
+        std::vector<uint8_t> payload;
+        auto putStream = [&payload](const std::vector<uint8_t>& stream) {
+            putFixed<uint32_t>(payload, (uint32_t)stream.size());
+            payload.insert(payload.end(), stream.begin(), stream.end());
+        };
+        putStream(time_.finish());
+        size_t double_lane = 0;
+        size_t integer_lane = 0;
+        for (const auto& field : fields_) {
+            for (int i = 0; i < laneCount(field.type); i++) {
+                putStream(isDouble(field.type) ? doubles_[double_lane++].finish() : integers_[integer_lane++].finish());
+            }
+        }
+
+        buffer_.clear();
+        putFixed<uint32_t>(buffer_, BLOCK_MAGIC);
+        putFixed<uint32_t>(buffer_, (uint32_t)payload.size());
+        putFixed<uint32_t>(buffer_, block_count_);
+        putFixed<int64_t>(buffer_, block_first_);
+        putFixed<int64_t>(buffer_, last_time_);
+        index_.push_back({offset_, block_first_, last_time_, block_count_});
+        resetBlock();
+        return write(buffer_) && write(payload);
+    }
+
+    template <typename T>
+    void putIntegers(const RtsiTypeVariant& value, size_t& lane) {
+        integers_[lane++].put((int64_t)variantGet<T>(value));
+    }
+
+    template <typename T>
+    void putIntegerArray(const RtsiTypeVariant& value, size_t& lane) {
+        for (auto v : variantGet<T>(value)) {
+            integers_[lane++].put((int64_t)v);
+        }
+    }
+
+    template <typename T>
+    void putDoubleArray(const RtsiTypeVariant& value, size_t& lane) {
+        for (double v : variantGet<T>(value)) {
+            doubles_[lane++].put(v);
+        }
+    }
+};
+
+TelemetryWriter::TelemetryWriter() : impl_(new Impl()) {}
+
+TelemetryWriter::~TelemetryWriter() {
+    if (impl_->file_.is_open()) {
+        close();
+    }
+}
+
+TelemetryType TelemetryWriter::typeOf(const RtsiTypeVariant& value) { return (TelemetryType)variantIndex(value); }
+
+bool TelemetryWriter::open(const std::string& path, const std::vector<TelemetryField>& fields, int block_frames) {
+    if (impl_->file_.is_open() || fields.empty() || block_frames <= 0) {
+        return false;
+    }
+    impl_->file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!impl_->file_) {
+        ELITE_LOG_ERROR("Can't create telemetry file %s", path.c_str());
+        return false;
+    }
+    impl_->fields_ = fields;
+    impl_->block_frames_ = block_frames;
+    impl_->offset_ = 0;
+    impl_->frames_ = 0;
+    impl_->index_.clear();
+    size_t doubles = 0;
+    size_t integers = 0;
+    for (const auto& field : fields) {
+        (isDouble(field.type) ? doubles : integers) += laneCount(field.type);
+    }
+    impl_->doubles_.assign(doubles, DoubleEncoder());
+    impl_->integers_.assign(integers, IntegerEncoder());
+    impl_->resetBlock();
+
+    std::vector<uint8_t> header(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    putFixed<uint32_t>(header, (uint32_t)fields.size());
+    for (const auto& field : fields) {
+        header.push_back((uint8_t)field.type);
+        putFixed<uint16_t>(header, (uint16_t)field.name.size());
+        header.insert(header.end(), field.name.begin(), field.name.end());
+    }
+    return impl_->write(header);
+}
+
+bool TelemetryWriter::append(double timestamp, const std::vector<RtsiTypeVariant>& values) {
+    if (!impl_->file_.is_open() || values.size() != impl_->fields_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+        if (typeOf(values[i]) != impl_->fields_[i].type) {
+            return false;
+        }
+    }
+    int64_t time = std::llround(timestamp * 1e6);
+    if (impl_->frames_ > 0 && time < impl_->last_time_) {
+        return false;
+    }
+
+    if (impl_->block_count_ == 0) {
+        impl_->block_first_ = time;
+    }
+    impl_->time_.put(time);
+    impl_->last_time_ = time;
+    size_t double_lane = 0;
+    size_t integer_lane = 0;
+    for (const auto& value : values) {
+        switch (typeOf(value)) {
+            case TelemetryType::BOOL:
+                impl_->putIntegers<bool>(value, integer_lane);
+                break;
+            case TelemetryType::INT8:
+                impl_->putIntegers<int8_t>(value, integer_lane);
+                break;
+            case TelemetryType::UINT8:
+                impl_->putIntegers<uint8_t>(value, integer_lane);
+                break;
+            case TelemetryType::INT16:
+                impl_->putIntegers<int16_t>(value, integer_lane);
+                break;
+            case TelemetryType::UINT16:
+                impl_->putIntegers<uint16_t>(value, integer_lane);
+                break;
+            case TelemetryType::INT32:
+                impl_->putIntegers<int32_t>(value, integer_lane);
+                break;
+            case TelemetryType::UINT32:
+                impl_->putIntegers<uint32_t>(value, integer_lane);
+                break;
+            case TelemetryType::INT64:
+                impl_->putIntegers<int64_t>(value, integer_lane);
+                break;
+            case TelemetryType::UINT64:
+                impl_->putIntegers<uint64_t>(value, integer_lane);
+                break;
+            case TelemetryType::DOUBLE:
+                impl_->doubles_[double_lane++].put(variantGet<double>(value));
+                break;
+            case TelemetryType::VECTOR3D:
+                impl_->putDoubleArray<vector3d_t>(value, double_lane);
+                break;
+            case TelemetryType::VECTOR6D:
+                impl_->putDoubleArray<vector6d_t>(value, double_lane);
+                break;
+            case TelemetryType::VECTOR6INT32:
+                impl_->putIntegerArray<vector6int32_t>(value, integer_lane);
+                break;
+            case TelemetryType::VECTOR6UINT32:
+                impl_->putIntegerArray<vector6uint32_t>(value, integer_lane);
+                break;
+        }
+    }
+    impl_->frames_++;
+    if (++impl_->block_count_ >= (uint32_t)impl_->block_frames_) {
+        return impl_->writeBlock();
+    }
+    return true;
+}
+
+bool TelemetryWriter::close() {
+    if (!impl_->file_.is_open()) {
+        return false;
+    }
+    bool ok = impl_->writeBlock();
+    std::vector<uint8_t> footer;
+    uint64_t index_offset = impl_->offset_;
+    for (const auto& entry : impl_->index_) {
+        putFixed<uint64_t>(footer, entry.offset);
+        putFixed<int64_t>(footer, entry.first);
+        putFixed<int64_t>(footer, entry.last);
+        putFixed<uint32_t>(footer, entry.frames);
+    }
+    putFixed<uint32_t>(footer, (uint32_t)impl_->index_.size());
+    putFixed<uint64_t>(footer, index_offset);
+    footer.insert(footer.end(), INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+    ok = impl_->write(footer) && ok;
+    impl_->file_.close();
+    return ok;
+}
+
+uint64_t TelemetryWriter::frameCount() const { return impl_->frames_; }
+
+uint64_t TelemetryWriter::bytesWritten() const { return impl_->offset_; }
+
+class TelemetryReader::Impl {
+   public:
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<TelemetryField> fields_;
+    size_t lanes_ = 0;
+    std::vector<BlockEntry> index_;
+    uint64_t frames_ = 0;
+
+    bool parseHeader(size_t& pos) {
+        if (size_ < sizeof(FILE_MAGIC) + 4 || std::memcmp(data_, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+            return false;
+        }
+        pos = sizeof(FILE_MAGIC);
+        uint32_t count = getFixed<uint32_t>(data_ + pos);
+        pos += 4;
+        fields_.clear();
+        lanes_ = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (pos + 3 > size_) {
+                return false;
+            }
+            TelemetryField field;
+            field.type = (TelemetryType)data_[pos];
+            uint16_t length = getFixed<uint16_t>(data_ + pos + 1);
+            pos += 3;
+            if (field.type > TelemetryType::VECTOR6UINT32 || pos + length > size_) {
+                return false;
+            }
+            field.name.assign(reinterpret_cast<const char*>(data_ + pos), length);
+            pos += length;
+            lanes_ += laneCount(field.type);
+            fields_.push_back(field);
+        }
+        return true;
+    }
+
+    bool parseIndex() {
+        if (size_ < FOOTER_SIZE || std::memcmp(data_ + size_ - 8, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+            return false;
+        }
+        uint32_t count = getFixed<uint32_t>(data_ + size_ - FOOTER_SIZE);
+        uint64_t offset = getFixed<uint64_t>(data_ + size_ - FOOTER_SIZE + 4);
+        if (offset + (uint64_t)count * INDEX_ENTRY_SIZE + FOOTER_SIZE != size_) {
+            return false;
+        }
+        index_.clear();
+        for (uint32_t i = 0; i < count; i++) {
+            const uint8_t* entry = data_ + offset + i * INDEX_ENTRY_SIZE;
+            index_.push_back({getFixed<uint64_t>(entry), getFixed<int64_t>(entry + 8), getFixed<int64_t>(entry + 16),
+                              getFixed<uint32_t>(entry + 24)});
+        }
+        return true;
+    }
+
+    // Without the index, walk the block headers up to the last complete block
+    void scanBlocks(size_t pos) {
+        index_.clear();
+        while (pos + BLOCK_HEADER_SIZE <= size_ && getFixed<uint32_t>(data_ + pos) == BLOCK_MAGIC) {
+            uint32_t payload = getFixed<uint32_t>(data_ + pos + 4);
+            if (pos + BLOCK_HEADER_SIZE + payload > size_) {
+                break;
+            }
+            index_.push_back({pos, getFixed<int64_t>(data_ + pos + 12), getFixed<int64_t>(data_ + pos + 20),
+                              getFixed<uint32_t>(data_ + pos + 8)});
+            pos += BLOCK_HEADER_SIZE + payload;
+        }
+    }
+
+    bool readBlock(const BlockEntry& entry, int64_t start, int64_t end, const FrameCallback& cb, bool& stop) const {
+        if (entry.offset + BLOCK_HEADER_SIZE > size_ || getFixed<uint32_t>(data_ + entry.offset) != BLOCK_MAGIC) {
+            return false;
+        }
+        uint32_t payload = getFixed<uint32_t>(data_ + entry.offset + 4);
+        const uint8_t* data = data_ + entry.offset + BLOCK_HEADER_SIZE;
+        if (entry.offset + BLOCK_HEADER_SIZE + payload > size_) {
+            return false;
+        }
+        size_t pos = 0;
+        auto nextStream = [&](const uint8_t*& stream, size_t& length) {
+            if (pos + 4 > payload) {
+                return false;
+            }
+            length = getFixed<uint32_t>(data + pos);
+            stream = data + pos + 4;
+            pos += 4 + length;
+            return pos <= payload;
+        };
+
+        const uint8_t* stream;
+        size_t length;
+        std::vector<int64_t> times;
+        if (!nextStream(stream, length) || !decodeTimes(stream, length, entry.frames, times)) {
+            return false;
+        }
+        std::vector<std::vector<double>> doubles;
+        std::vector<std::vector<int64_t>> integers;
+        for (const auto& field : fields_) {
+            for (int i = 0; i < laneCount(field.type); i++) {
+                if (!nextStream(stream, length)) {
+                    return false;
+                }
+                bool ok;
+                if (isDouble(field.type)) {
+                    doubles.emplace_back();
+                    ok = decodeDoubles(stream, length, entry.frames, doubles.back());
+                } else {
+                    integers.emplace_back();
+                    ok = decodeIntegers(stream, length, entry.frames, integers.back());
+                }
+                if (!ok) {
+                    return false;
+                }
+            }
+        }
+
+        std::vector<RtsiTypeVariant> values(fields_.size());
+        for (uint32_t frame = 0; frame < entry.frames; frame++) {
+            if (times[frame] < start || times[frame] > end) {
+                continue;
+            }
+            size_t double_lane = 0;
+            size_t integer_lane = 0;
+            for (size_t f = 0; f < fields_.size(); f++) {
+                values[f] = valueOf(fields_[f].type, doubles, integers, double_lane, integer_lane, frame);
+            }
+            if (!cb(times[frame] / 1e6, values)) {
+                stop = true;
+                return true;
+            }
+        }
+        return true;
+    }
+
+    static RtsiTypeVariant valueOf(TelemetryType type, const std::vector<std::vector<double>>& doubles,
+                                   const std::vector<std::vector<int64_t>>& integers, size_t& double_lane, size_t& integer_lane,
+                                   uint32_t frame) {
+        switch (type) {
+            case TelemetryType::BOOL:
+                return RtsiTypeVariant(integers[integer_lane++][frame] != 0);
+            case TelemetryType::INT8:
+                return RtsiTypeVariant((int8_t)integers[integer_lane++][frame]);
+            case TelemetryType::UINT8:
+                return RtsiTypeVariant((uint8_t)integers[integer_lane++][frame]);
+            case TelemetryType::INT16:
+                return RtsiTypeVariant((int16_t)integers[integer_lane++][frame]);
+            case TelemetryType::UINT16:
+                return RtsiTypeVariant((uint16_t)integers[integer_lane++][frame]);
+            case TelemetryType::INT32:
+                return RtsiTypeVariant((int32_t)integers[integer_lane++][frame]);
+            case TelemetryType::UINT32:
+                return RtsiTypeVariant((uint32_t)integers[integer_lane++][frame]);
+            case TelemetryType::INT64:
+                return RtsiTypeVariant((int64_t)integers[integer_lane++][frame]);
+            case TelemetryType::UINT64:
+                return RtsiTypeVariant((uint64_t)integers[integer_lane++][frame]);
+            case TelemetryType::DOUBLE:
+                return RtsiTypeVariant(doubles[double_lane++][frame]);
+            case TelemetryType::VECTOR3D: {
+                vector3d_t v;
+                for (double& x : v) {
+                    x = doubles[double_lane++][frame];
+                }
+                return RtsiTypeVariant(v);
+            }
+            case TelemetryType::VECTOR6D: {
+                vector6d_t v;
+                for (double& x : v) {
+                    x = doubles[double_lane++][frame];
+                }
+                return RtsiTypeVariant(v);
+            }
+            case TelemetryType::VECTOR6INT32: {
+                vector6int32_t v;
+                for (int32_t& x : v) {
+                    x = (int32_t)integers[integer_lane++][frame];
+                }
+                return RtsiTypeVariant(v);
+            }
+            case TelemetryType::VECTOR6UINT32:
+            default: {
+                vector6uint32_t v;
+                for (uint32_t& x : v) {
+                    x = (uint32_t)integers[integer_lane++][frame];
+                }
+                return RtsiTypeVariant(v);
+            }
+        }
+    }
+};
+
+TelemetryReader::TelemetryReader() : impl_(new Impl()) {}
+
+TelemetryReader::~TelemetryReader() = default;
+
+bool TelemetryReader::open(const std::string& path) {
+    impl_->region_.reset();
+    impl_->data_ = nullptr;
+    impl_->index_.clear();
+    try {
+        boost::interprocess::file_mapping mapping(path.c_str(), boost::interprocess::read_only);
+        impl_->region_.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    } catch (const boost::interprocess::interprocess_exception& e) {
+        ELITE_LOG_ERROR("Can't map telemetry file %s: %s", path.c_str(), e.what());
+        return false;
+    }
+    impl_->data_ = static_cast<const uint8_t*>(impl_->region_->get_address());
+    impl_->size_ = impl_->region_->get_size();
+    size_t pos;
+    if (!impl_->parseHeader(pos)) {
+        ELITE_LOG_ERROR("%s is not a telemetry file", path.c_str());
+        impl_->region_.reset();
+        impl_->data_ = nullptr;
+        return false;
+    }
+    if (!impl_->parseIndex()) {
+        ELITE_LOG_WARN("Telemetry file %s has no index, it was not closed", path.c_str());
+        impl_->scanBlocks(pos);
+    }
+    impl_->frames_ = 0;
+    for (const auto& entry : impl_->index_) {
+        impl_->frames_ += entry.frames;
+    }
+    return true;
+}
+
+const std::vector<TelemetryField>& TelemetryReader::fields() const { return impl_->fields_; }
+
+uint64_t TelemetryReader::frameCount() const { return impl_->frames_; }
+
+size_t TelemetryReader::blockCount() const { return impl_->index_.size(); }
+
+double TelemetryReader::startTime() const { return impl_->index_.empty() ? 0 : impl_->index_.front().first / 1e6; }
+
+double TelemetryReader::endTime() const { return impl_->index_.empty() ? 0 : impl_->index_.back().last / 1e6; }
+
+bool TelemetryReader::read(double start, double end, const FrameCallback& cb) const {
+    if (!impl_->data_) {
+        return false;
+    }
+    int64_t start_us = (int64_t)std::ceil(start * 1e6 - 0.5);
+    int64_t end_us = (int64_t)std::floor(end * 1e6 + 0.5);
+    // The blocks are in time order, skip to the first one ending in the range
+    auto first = std::lower_bound(impl_->index_.begin(), impl_->index_.end(), start_us,
+                                  [](const BlockEntry& entry, int64_t time) { return entry.last < time; });
+    for (auto it = first; it != impl_->index_.end() && it->first <= end_us; ++it) {
+        bool stop = false;
+        if (!impl_->readBlock(*it, start_us, end_us, cb, stop)) {
+            ELITE_LOG_ERROR("Telemetry block at %llu is corrupted", (unsigned long long)it->offset);
+            return false;
+        }
+        if (stop) {
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/BlockDelta.hpp"
+
+using namespace ELITE;
+
+static std::vector<uint8_t> randomBytes(std::mt19937& rng, size_t size) {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> data(size);
+    for (auto& byte : data) {
+        byte = dist(rng);
+    }
+    return data;
+}
+
+// A new release: some bytes patched, a section inserted and one removed
+static std::vector<uint8_t> modified(std::mt19937& rng, std::vector<uint8_t> data) {
+    for (size_t i = 10000; i < 10100; i++) {
+        data[i] ^= 0x5a;
+    }
+    auto inserted = randomBytes(rng, 3000);
+    data.insert(data.begin() + 200000, inserted.begin(), inserted.end());
+    data.erase(data.begin() + 400000, data.begin() + 405000);
+    return data;
+}
+
+static void writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write((const char*)data.data(), data.size());
+}
+
+TEST(BlockDeltaTest, rolling_hash_matches_reset) {
+    std::mt19937 rng(1);
+    auto data = randomBytes(rng, 1000);
+    DELTA::RollingHash rolling, fresh;
+    rolling.reset(data.data(), 64);
+    for (size_t i = 1; i + 64 <= data.size(); i++) {
+        rolling.roll(data[i - 1], data[i + 63]);
+        fresh.reset(data.data() + i, 64);
+        ASSERT_EQ(rolling.value(), fresh.value());
+    }
+}
+
+TEST(BlockDeltaTest, md5_matches_md5sum) {
+    std::string abc = "abc";
+    EXPECT_EQ(DELTA::md5Hex((const uint8_t*)abc.data(), abc.size()), "900150983cd24fb0d6963f7d28e17f72");
+    EXPECT_EQ(DELTA::md5Hex(nullptr, 0), "d41d8cd98f00b204e9800998ecf8427e");
+}
+
+TEST(BlockDeltaTest, identical_file_is_one_copy) {
+    std::mt19937 rng(2);
+    auto data = randomBytes(rng, 100000);
+    auto delta = DELTA::computeDelta(DELTA::signatures(data.data(), data.size(), 1024), 1024, data.data(), data.size());
+    ASSERT_EQ(delta.ops.size(), 2);
+    EXPECT_EQ(delta.ops[0].type, DELTA::DeltaOp::COPY);
+    EXPECT_EQ(delta.ops[0].length, 97 * 1024);
+    // The partial last block
+    EXPECT_EQ(delta.literals.size(), 100000 - 97 * 1024);
+    EXPECT_EQ(DELTA::applyDelta(data.data(), data.size(), delta), data);
+}
+
+TEST(BlockDeltaTest, delta_rebuilds_new_file) {
+    std::mt19937 rng(3);
+    auto old_data = randomBytes(rng, 1 << 20);
+    auto new_data = modified(rng, old_data);
+    const size_t block = 4096;
+    auto delta = DELTA::computeDelta(DELTA::signatures(old_data.data(), old_data.size(), block), block, new_data.data(),
+                                     new_data.size());
+    EXPECT_EQ(DELTA::applyDelta(old_data.data(), old_data.size(), delta), new_data);
+    // Each change costs at most two blocks, far less than the file
+    EXPECT_LT(delta.literals.size(), 6 * block + 3000);
+    EXPECT_EQ(delta.copied + delta.literals.size(), new_data.size());
+
+    // Unrelated data has nothing to copy
+    auto other = randomBytes(rng, 50000);
+    auto none = DELTA::computeDelta(DELTA::signatures(old_data.data(), old_data.size(), block), block, other.data(), other.size());
+    EXPECT_EQ(none.copied, 0);
+    EXPECT_EQ(DELTA::applyDelta(old_data.data(), old_data.size(), none), other);
+}
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+// A temporary directory, removed with its files
+class TempDir {
+   public:
+    TempDir() {
+        char templ[] = "/tmp/elite_delta_XXXXXX";
+        if (mkdtemp(templ)) {
+            path_ = templ;
+        }
+    }
+    ~TempDir() {
+        if (!path_.empty()) {
+            std::system(("rm -rf '" + path_ + "'").c_str());
+        }
+    }
+    bool valid() const { return !path_.empty(); }
+    std::string file(const std::string& name) const { return path_ + "/" + name; }
+
+   private:
+    std::string path_;
+};
+
+TEST(BlockDeltaTest, patch_script_rebuilds_new_file) {
+    std::mt19937 rng(4);
+    auto old_data = randomBytes(rng, 1 << 20);
+    auto new_data = modified(rng, old_data);
+    const size_t block = 16384;
+    auto delta = DELTA::computeDelta(DELTA::signatures(old_data.data(), old_data.size(), block), block, new_data.data(),
+                                     new_data.size());
+    TempDir dir;
+    ASSERT_TRUE(dir.valid());
+    writeFile(dir.file("old.bin"), old_data);
+    writeFile(dir.file("literals.bin"), delta.literals);
+    std::string script = DELTA::patchScript(delta, dir.file("old.bin"), dir.file("literals.bin"), dir.file("new.bin"));
+    std::ofstream(dir.file("patch.sh")) << script;
+    ASSERT_EQ(std::system(("sh " + dir.file("patch.sh")).c_str()), 0);
+
+    std::ifstream in(dir.file("new.bin"), std::ios::binary);
+    std::vector<uint8_t> rebuilt((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(rebuilt, new_data);
+}
+#endif
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Elite/CallbackExecutor.hpp"
+
+using namespace ELITE;
+using namespace std::chrono;
+
+TEST(CallbackExecutorTest, inline_executor) {
+    auto executor = std::make_shared<InlineExecutor>();
+    std::thread::id run_id;
+    EXPECT_TRUE(executor->post([&]() { run_id = std::this_thread::get_id(); }));
+    EXPECT_EQ(run_id, std::this_thread::get_id());
+    // An exception does not leave post()
+    EXPECT_TRUE(executor->post([]() { throw std::runtime_error("callback error"); }));
+    EXPECT_EQ(executor->getStats().executed, 2);
+
+    // Without an executor the task runs in the current thread
+    bool run = false;
+    EXPECT_TRUE(dispatchCallback(nullptr, [&]() { run = true; }));
+    EXPECT_TRUE(run);
+}
+
+TEST(CallbackExecutorTest, thread_executor_order) {
+    std::vector<int> results;
+    std::thread::id run_id;
+    {
+        ThreadExecutor executor;
+        for (int i = 0; i < 100; i++) {
+            EXPECT_TRUE(executor.post([&results, &run_id, i]() {
+                results.push_back(i);
+                run_id = std::this_thread::get_id();
+            }));
+        }
+        EXPECT_TRUE(executor.post([]() { throw std::runtime_error("callback error"); }));
+        // The destructor runs the tasks already queued
+    }
+    ASSERT_EQ(results.size(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(results[i], i);
+    }
+    EXPECT_NE(run_id, std::this_thread::get_id());
+}
+
+TEST(CallbackExecutorTest, thread_executor_overflow) {
+    ThreadExecutor executor(2);
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool started = false;
+    bool release = false;
+
+    // Block the executor thread, then fill the queue
+    executor.post([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        started = true;
+        cv.notify_all();
+        cv.wait(lock, [&]() { return release; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return started; });
+    }
+    EXPECT_TRUE(executor.post([]() {}));
+    EXPECT_TRUE(executor.post([]() {}));
+    EXPECT_FALSE(executor.post([]() {}));
+    EXPECT_EQ(executor.size(), 2);
+
+    std::this_thread::sleep_for(20ms);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    while (executor.size() > 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(10ms);
+
+    CallbackExecutorStats stats = executor.getStats();
+    EXPECT_EQ(stats.executed, 3);
+    EXPECT_EQ(stats.dropped, 1);
+    EXPECT_EQ(stats.max_queue_size, 2);
+    // The queued tasks waited for the blocked one
+    EXPECT_GE(stats.max_queue_latency, 20ms);
+    EXPECT_LE(stats.mean_queue_latency, stats.max_queue_latency);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Elite/Coroutine.hpp"
+
+// The test is built as C++20, see test/CMakeLists.txt
+#ifndef ELITE_SDK_COROUTINE
+#error "CoroutineTest must be compiled as C++20 with <coroutine>"
+#endif
+
+using namespace ELITE;
+using namespace std::chrono;
+
+static CoTask<int> addAsync(CallbackExecutorSharedPtr worker, int a, int b) {
+    int sum = co_await asyncCall(worker, [a, b]() { return a + b; });
+    co_return sum;
+}
+
+TEST(CoroutineTest, async_call_resume_on_executor) {
+    auto worker = std::make_shared<ThreadExecutor>();
+    auto orchestrator = std::make_shared<ThreadExecutor>();
+    std::promise<std::pair<int, std::thread::id>> done;
+    // The executor runs its tasks in order, the id is set before the coroutine starts
+    std::thread::id orchestrator_id;
+    orchestrator->post([&]() { orchestrator_id = std::this_thread::get_id(); });
+
+    auto task = [](CallbackExecutorSharedPtr worker, CallbackExecutorSharedPtr orchestrator,
+                   std::promise<std::pair<int, std::thread::id>>& done) -> CoTask<void> {
+        int sum = co_await addAsync(worker, 1, 2);
+        // Back to the orchestrator thread
+        co_await asyncCall(worker, []() {}, orchestrator);
+        done.set_value({sum, std::this_thread::get_id()});
+    };
+    ASSERT_TRUE(spawn(task(worker, orchestrator, done), orchestrator));
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(1s), std::future_status::ready);
+    auto result = future.get();
+    EXPECT_EQ(result.first, 3);
+    EXPECT_EQ(result.second, orchestrator_id);
+    EXPECT_NE(result.second, std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, exception_propagates) {
+    auto task = []() -> CoTask<int> {
+        co_await asyncCall(nullptr, []() -> int { throw std::runtime_error("request failed"); });
+        co_return 0;
+    };
+    bool caught = false;
+    auto outer = [&]() -> CoTask<void> {
+        try {
+            co_await task();
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+    };
+    spawn(outer());
+    EXPECT_TRUE(caught);
+}
+
+TEST(CoroutineTest, event_before_await_is_kept) {
+    auto state = std::make_shared<detail::OneShotState<int>>(nullptr);
+    int result = 0;
+    auto task = [&]() -> CoTask<void> {
+        detail::OneShotAwaitable<int> awaitable(state, nullptr);
+        // Set before the co_await, e.g. a trajectory finished before the coroutine got there
+        state->set(5);
+        state->set(6);
+        result = co_await awaitable;
+    };
+    spawn(task());
+    EXPECT_EQ(result, 5);
+}
+
+TEST(CoroutineTest, resume_in_event_thread) {
+    auto state = std::make_shared<detail::OneShotState<int>>(nullptr);
+    std::thread::id resume_id;
+    int result = 0;
+    auto task = [&]() -> CoTask<void> {
+        result = co_await detail::OneShotAwaitable<int>(state, nullptr);
+        resume_id = std::this_thread::get_id();
+    };
+    spawn(task());
+    EXPECT_EQ(result, 0);
+
+    std::thread event_thread([&]() { state->set(7); });
+    std::thread::id event_id = event_thread.get_id();
+    event_thread.join();
+    EXPECT_EQ(result, 7);
+    EXPECT_EQ(resume_id, event_id);
+}
+
+TEST(CoroutineTest, trajectory_done_chains_user_callback) {
+    std::vector<TrajectoryMotionResult> user_results;
+    std::function<void(TrajectoryMotionResult)> user = [&](TrajectoryMotionResult result) { user_results.push_back(result); };
+    auto state = std::make_shared<detail::OneShotState<TrajectoryMotionResult>>(nullptr);
+    std::function<void(TrajectoryMotionResult)> installed = detail::TrajectoryDoneCallback{state, user};
+
+    TrajectoryMotionResult awaited = TrajectoryMotionResult::FAILURE;
+    auto task = [&]() -> CoTask<void> {
+        awaited = co_await detail::OneShotAwaitable<TrajectoryMotionResult>(state, nullptr);
+        // The user callback ran before the coroutine resumed
+        EXPECT_EQ(user_results.size(), 1);
+    };
+    spawn(task());
+    installed(TrajectoryMotionResult::SUCCESS);
+    EXPECT_EQ(awaited, TrajectoryMotionResult::SUCCESS);
+
+    // Later results still reach the user callback
+    installed(TrajectoryMotionResult::CANCELED);
+    EXPECT_EQ(user_results, std::vector<TrajectoryMotionResult>({TrajectoryMotionResult::SUCCESS, TrajectoryMotionResult::CANCELED}));
+
+    // The next trajectoryDone() finds the user callback in the installed one, the chain does not grow
+    auto previous = installed.target<detail::TrajectoryDoneCallback>();
+    ASSERT_NE(previous, nullptr);
+    EXPECT_TRUE((bool)previous->user);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Elite/CollisionDetector.hpp"
+#include "Elite/Dynamics.hpp"
+#include "Elite/ToolContactDetector.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+
+using namespace ELITE;
+
+static const double PI = 3.14159265358979323846;
+static const vector6d_t DH_A{0, -0.3, -0.276, 0, 0, 0};
+static const vector6d_t DH_D{0.1215, 0, 0, 0.1105, 0.09, 0.082};
+static const vector6d_t DH_ALPHA{PI / 2, 0, 0, PI / 2, -PI / 2, 0};
+
+static std::array<LinkInertia, 6> testLinks() {
+    std::array<LinkInertia, 6> links;
+    const double masses[6] = {3.5, 6.0, 2.5, 1.2, 1.2, 0.3};
+    const vector3d_t coms[6] = {{0, -0.02, 0}, {0.15, 0, 0.1}, {0.12, 0, 0.02}, {0, 0.01, 0}, {0, -0.01, 0}, {0, 0, -0.02}};
+    for (int i = 0; i < 6; i++) {
+        links[i].mass = masses[i];
+        links[i].com = coms[i];
+        links[i].inertia = {0.01 * masses[i], 0.012 * masses[i], 0.008 * masses[i], 0.001, -0.0005, 0.0002};
+    }
+    return links;
+}
+
+// The height of a point fixed in the frame of link k
+static double height(int k, const vector6d_t& q, const vector3d_t& point) {
+    vector6d_t a{}, d{}, alpha{}, qk{};
+    for (int i = 0; i <= k; i++) {
+        a[i] = DH_A[i];
+        d[i] = DH_D[i];
+        alpha[i] = DH_ALPHA[i];
+        qk[i] = q[i];
+    }
+    Kinematics kin(a, d, alpha);
+    kin.setTcpOffset({point[0], point[1], point[2], 0, 0, 0});
+    return kin.forward(qk)[2];
+}
+
+static vector6d_t randomJoints(std::mt19937& rng, double range) {
+    std::uniform_real_distribution<double> dist(-range, range);
+    vector6d_t q;
+    for (double& v : q) {
+        v = dist(rng);
+    }
+    return q;
+}
+
+static matrix6d_t massMatrix(const Dynamics& dynamics, const vector6d_t& q) {
+    matrix6d_t mass;
+    vector6d_t gravity = dynamics.gravityTorques(q);
+    for (int col = 0; col < 6; col++) {
+        vector6d_t qdd{}, torques;
+        qdd[col] = 1;
+        dynamics.inverseDynamics(q, vector6d_t{}, qdd, torques);
+        for (int row = 0; row < 6; row++) {
+            mass[row][col] = torques[row] - gravity[row];
+        }
+    }
+    return mass;
+}
+
+TEST(DynamicsTest, gravity_is_the_potential_gradient) {
+    auto links = testLinks();
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), links);
+    const double payload_mass = 1.5;
+    const vector3d_t payload_cog{0.01, 0.02, 0.05};
+    dynamics.setPayload(payload_mass, payload_cog);
+    auto potential = [&](const vector6d_t& q) {
+        double v = payload_mass * 9.81 * height(5, q, payload_cog);
+        for (int k = 0; k < 6; k++) {
+            v += links[k].mass * 9.81 * height(k, q, links[k].com);
+        }
+        return v;
+    };
+
+    std::mt19937 rng(5);
+    for (int n = 0; n < 10; n++) {
+        vector6d_t q = randomJoints(rng, PI);
+        vector6d_t torques = dynamics.gravityTorques(q);
+        for (int j = 0; j < 6; j++) {
+            vector6d_t qp = q, qm = q;
+            qp[j] += 1e-6;
+            qm[j] -= 1e-6;
+            EXPECT_NEAR(torques[j], (potential(qp) - potential(qm)) / 2e-6, 1e-5);
+        }
+    }
+}
+
+TEST(DynamicsTest, mass_matrix_is_symmetric_positive) {
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    std::mt19937 rng(7);
+    for (int n = 0; n < 10; n++) {
+        matrix6d_t mass = massMatrix(dynamics, randomJoints(rng, PI));
+        for (int row = 0; row < 6; row++) {
+            EXPECT_GT(mass[row][row], 0);
+            for (int col = 0; col < row; col++) {
+                EXPECT_NEAR(mass[row][col], mass[col][row], 1e-12);
+            }
+        }
+        EXPECT_GT(Kinematics::manipulability(mass), 0);
+    }
+}
+
+TEST(DynamicsTest, coriolis_power_matches_mass_matrix_derivative) {
+    // The Coriolis and centrifugal power is qd^T C qd = 1/2 qd^T dM/dt qd
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    std::mt19937 rng(9);
+    for (int n = 0; n < 10; n++) {
+        vector6d_t q = randomJoints(rng, PI);
+        vector6d_t qd = randomJoints(rng, 2);
+        vector6d_t torques;
+        dynamics.inverseDynamics(q, qd, vector6d_t{}, torques);
+        vector6d_t gravity = dynamics.gravityTorques(q);
+        double power = 0;
+        for (int i = 0; i < 6; i++) {
+            power += qd[i] * (torques[i] - gravity[i]);
+        }
+
+        const double h = 1e-6;
+        vector6d_t qp = q, qm = q;
+        for (int i = 0; i < 6; i++) {
+            qp[i] += qd[i] * h;
+            qm[i] -= qd[i] * h;
+        }
+        matrix6d_t mp = massMatrix(dynamics, qp);
+        matrix6d_t mm = massMatrix(dynamics, qm);
+        double expected = 0;
+        for (int row = 0; row < 6; row++) {
+            for (int col = 0; col < 6; col++) {
+                expected += 0.5 * qd[row] * (mp[row][col] - mm[row][col]) / (2 * h) * qd[col];
+            }
+        }
+        EXPECT_NEAR(power, expected, 1e-5 * (1 + std::abs(expected)));
+    }
+}
+
+// A frame of the robot at rest at 'q', the joint torques are the model torques plus 'offset'
+static void restFrame(FakeFrameSource& frames, const Dynamics& dynamics, const vector6d_t& q, const vector6d_t& offset,
+                      double timestamp) {
+    vector6d_t torques = dynamics.gravityTorques(q);
+    for (int i = 0; i < 6; i++) {
+        torques[i] += offset[i];
+    }
+    frames.set("timestamp", timestamp);
+    frames.set("actual_joint_positions", q);
+    frames.set("actual_joint_speeds", vector6d_t{});
+    frames.set("actual_joint_torques", torques);
+    frames.frame();
+}
+
+static CollisionConfig collisionConfig() {
+    CollisionConfig config;
+    config.thresholds = {0, 5, 5, 0, 0, 0};
+    config.filter_alpha = 1;
+    config.debounce_frames = 2;
+    return config;
+}
+
+TEST(DynamicsTest, collision_debounce_and_stop) {
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    const vector6d_t q{0, -1.2, 1.0, -0.5, 1.4, 0};
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    CollisionDetector detector(frames, driver, dynamics);
+    std::vector<CollisionEvent> events;
+    detector.setCollisionCallback([&](const CollisionEvent& event) { events.push_back(event); });
+    EXPECT_FALSE(detector.arm(CollisionConfig()));
+    ASSERT_TRUE(detector.arm(collisionConfig()));
+
+    // The model offset of the first frame is the baseline, a single frame over the threshold is debounced
+    restFrame(frames, dynamics, q, {0, 1, 1, 0, 0, 0}, 0.000);
+    restFrame(frames, dynamics, q, {0, 1, -7, 0, 0, 0}, 0.002);
+    restFrame(frames, dynamics, q, {0, 1, 1, 0, 0, 0}, 0.004);
+    // Joint 0 isn't watched
+    restFrame(frames, dynamics, q, {20, 1, 1, 0, 0, 0}, 0.006);
+    EXPECT_FALSE(detector.inCollision());
+    EXPECT_EQ(driver.toolContactWrites(), 0);
+
+    restFrame(frames, dynamics, q, {0, 1, -7, 0, 0, 0}, 0.008);
+    restFrame(frames, dynamics, q, {0, 1, -7, 0, 0, 0}, 0.010);
+    ASSERT_TRUE(detector.inCollision());
+    EXPECT_FALSE(detector.isArmed());
+    EXPECT_TRUE(driver.toolContact(ToolContactOwner::COLLISION_DETECTOR));
+    EXPECT_FALSE(driver.writeServoj(vector6d_t{}, 100));
+
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].joint, 2);
+    EXPECT_NEAR(events[0].residual, -8, 1e-9);
+    EXPECT_DOUBLE_EQ(events[0].timestamp, 0.010);
+    EXPECT_EQ(events[0].joint_positions, q);
+    EXPECT_TRUE(events[0].stop_sent);
+
+    // Disarmed after the collision, no second stop
+    restFrame(frames, dynamics, q, {0, 1, -7, 0, 0, 0}, 0.012);
+    EXPECT_EQ(driver.toolContactWrites(), 1);
+    EXPECT_EQ(detector.getStats().collisions, 1);
+
+    detector.release();
+    EXPECT_FALSE(detector.inCollision());
+    EXPECT_FALSE(driver.toolContact());
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+}
+
+TEST(DynamicsTest, collision_without_stop) {
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    const vector6d_t q{0, -1.2, 1.0, -0.5, 1.4, 0};
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    CollisionDetector detector(frames, driver, dynamics);
+    CollisionConfig config = collisionConfig();
+    config.stop = false;
+    config.debounce_frames = 1;
+    ASSERT_TRUE(detector.arm(config));
+    restFrame(frames, dynamics, q, vector6d_t{}, 0.000);
+    restFrame(frames, dynamics, q, {0, 6, 0, 0, 0, 0}, 0.002);
+    ASSERT_TRUE(detector.inCollision());
+    CollisionEvent event;
+    ASSERT_TRUE(detector.getLastCollision(event));
+    EXPECT_EQ(event.joint, 1);
+    EXPECT_FALSE(event.stop_sent);
+    EXPECT_EQ(driver.toolContactWrites(), 0);
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+}
+
+TEST(DynamicsTest, collision_release_keeps_tool_contact) {
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    const vector6d_t q{0, -1.2, 1.0, -0.5, 1.4, 0};
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    CollisionDetector collision(frames, driver, dynamics);
+    ToolContactDetector contact(frames, driver);
+    ToolContactConfig contact_config;
+    contact_config.force_threshold = 5;
+    contact_config.filter_alpha = 1;
+    contact_config.debounce_frames = 1;
+    ASSERT_TRUE(collision.arm(collisionConfig()));
+    ASSERT_TRUE(contact.arm(contact_config));
+
+    // A collision and a tool contact in the same frames, both detectors stop the motion
+    frames.set("actual_TCP_force", vector6d_t{});
+    restFrame(frames, dynamics, q, vector6d_t{}, 0.000);
+    frames.set("actual_TCP_force", vector6d_t{10, 0, 0, 0, 0, 0});
+    restFrame(frames, dynamics, q, {0, 10, 0, 0, 0, 0}, 0.002);
+    restFrame(frames, dynamics, q, {0, 10, 0, 0, 0, 0}, 0.004);
+    ASSERT_TRUE(collision.inCollision());
+    ASSERT_TRUE(contact.inContact());
+
+    // Releasing the collision doesn't release the stop of the tool contact
+    collision.release();
+    EXPECT_FALSE(driver.toolContact(ToolContactOwner::COLLISION_DETECTOR));
+    EXPECT_TRUE(driver.toolContact(ToolContactOwner::TOOL_CONTACT_DETECTOR));
+    EXPECT_TRUE(contact.inContact());
+    EXPECT_FALSE(driver.writeServoj(vector6d_t{}, 100));
+
+    contact.release();
+    EXPECT_FALSE(driver.toolContact());
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+
+    // And the other way round
+    ASSERT_TRUE(collision.arm(collisionConfig()));
+    ASSERT_TRUE(contact.arm(contact_config));
+    restFrame(frames, dynamics, q, vector6d_t{}, 0.006);
+    restFrame(frames, dynamics, q, {0, 10, 0, 0, 0, 0}, 0.008);
+    frames.set("actual_TCP_force", vector6d_t{20, 0, 0, 0, 0, 0});
+    restFrame(frames, dynamics, q, {0, 10, 0, 0, 0, 0}, 0.010);
+    ASSERT_TRUE(collision.inCollision());
+    ASSERT_TRUE(contact.inContact());
+    contact.release();
+    EXPECT_TRUE(driver.toolContact(ToolContactOwner::COLLISION_DETECTOR));
+    EXPECT_FALSE(driver.writeServoj(vector6d_t{}, 100));
+    collision.release();
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+
+    // A user stop is cleared by neither detector
+    driver.writeToolContact(100);
+    collision.release();
+    contact.release();
+    EXPECT_TRUE(driver.toolContact(ToolContactOwner::USER));
+    driver.clearToolContact();
+    EXPECT_FALSE(driver.toolContact());
+}
+
+TEST(DynamicsTest, collision_unregisters_on_destruction) {
+    Dynamics dynamics(Kinematics(DH_A, DH_D, DH_ALPHA), testLinks());
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    {
+        CollisionDetector detector(frames, driver, dynamics);
+        EXPECT_EQ(frames.callbackCount(), 1);
+    }
+    EXPECT_EQ(frames.callbackCount(), 0);
+    frames.frame();
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,378 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "C/EliteC.h"
+#include "Common/EndianUtils.hpp"
+
+using namespace ELITE;
+using boost::asio::ip::tcp;
+
+/**
+ * An RTSI controller on 127.0.0.1:30004, the port RtsiIOInterface connects to. It streams a data package with timestamp,
+ * robot_mode and actual_joint_positions every 2 ms.
+ */
+class FakeRtsiController {
+   public:
+    FakeRtsiController() : acceptor_(io_context_) {
+        boost::system::error_code ec;
+        acceptor_.open(tcp::v4(), ec);
+        acceptor_.set_option(tcp::acceptor::reuse_address(true), ec);
+        acceptor_.bind(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30004), ec);
+        if (!ec) {
+            acceptor_.listen(1, ec);
+        }
+        listening_ = !ec;
+        if (listening_) {
+            thread_ = std::thread([this]() { serve(); });
+        }
+    }
+
+    ~FakeRtsiController() {
+        running_ = false;
+        boost::system::error_code ec;
+        tcp::socket waker(io_context_);
+        waker.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30004), ec);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    bool listening() const { return listening_; }
+
+   private:
+    boost::asio::io_context io_context_;
+    tcp::acceptor acceptor_;
+    std::thread thread_;
+    bool listening_ = false;
+    std::atomic<bool> running_{true};
+
+    static void reply(tcp::socket& socket, uint8_t type, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> package = EndianUtils::pack((uint16_t)(3 + payload.size()));
+        package.push_back(type);
+        package.insert(package.end(), payload.begin(), payload.end());
+        boost::system::error_code ec;
+        boost::asio::write(socket, boost::asio::buffer(package), ec);
+    }
+
+    void serve() {
+        tcp::socket socket(io_context_);
+        boost::system::error_code ec;
+        acceptor_.accept(socket, ec);
+        if (ec || !running_) {
+            return;
+        }
+        bool streaming = false;
+        while (running_ && !streaming) {
+            uint8_t header[3];
+            if (!boost::asio::read(socket, boost::asio::buffer(header), ec)) {
+                return;
+            }
+            std::vector<uint8_t> body(((header[0] << 8) | header[1]) - 3);
+            boost::asio::read(socket, boost::asio::buffer(body), ec);
+            if (ec) {
+                return;
+            }
+            switch (header[2]) {
+                case 'V':
+                    reply(socket, 'V', {1});
+                    break;
+                case 'v': {
+                    std::vector<uint8_t> version;
+                    for (uint32_t value : {2u, 14u, 5u, 1234u}) {
+                        auto bytes = EndianUtils::pack(value);
+                        version.insert(version.end(), bytes.begin(), bytes.end());
+                    }
+                    reply(socket, 'v', version);
+                    break;
+                }
+                case 'O': {
+                    std::string types = "DOUBLE,INT32,VECTOR6D";
+                    std::vector<uint8_t> payload = {1};
+                    payload.insert(payload.end(), types.begin(), types.end());
+                    reply(socket, 'O', payload);
+                    break;
+                }
+                case 'S':
+                    reply(socket, 'S', {1});
+                    streaming = true;
+                    break;
+            }
+        }
+        for (int frame = 1; running_; frame++) {
+            std::vector<uint8_t> payload = {1};
+            auto append = [&](const std::vector<uint8_t>& bytes) { payload.insert(payload.end(), bytes.begin(), bytes.end()); };
+            append(EndianUtils::pack(frame * 0.002));
+            append(EndianUtils::pack((int32_t)7));
+            for (int i = 0; i < 6; i++) {
+                append(EndianUtils::pack((double)frame));
+            }
+            reply(socket, 'U', payload);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+};
+
+static bool waitFor(const std::function<bool()>& condition, int timeout_ms = 3000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+static const char* RECIPE[] = {"timestamp", "robot_mode", "actual_joint_positions"};
+
+TEST(EliteCTest, version) {
+    EXPECT_EQ(elite_c_abi_version(), (uint32_t)ELITE_C_ABI_VERSION);
+    EXPECT_STREQ(elite_sdk_version(), ELITE_SDK_VERSION);
+    // The sequence is the first member, zero-copy readers rely on it
+    EXPECT_EQ(offsetof(elite_rtsi_snapshot_t, sequence), 0u);
+}
+
+TEST(EliteCTest, invalid_arguments) {
+    EXPECT_EQ(elite_driver_create(nullptr, nullptr), ELITE_ERR_INVALID_ARGUMENT);
+    elite_driver_config_t config;
+    elite_driver_config_init(&config);
+    EXPECT_EQ(config.reverse_port, 50001);
+    EXPECT_FLOAT_EQ(config.servoj_time, 0.008f);
+    elite_driver_t* driver = (elite_driver_t*)1;
+    EXPECT_EQ(elite_driver_create(&config, &driver), ELITE_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(driver, nullptr);
+    EXPECT_STRNE(elite_last_error(), "");
+
+    double pos[6] = {0};
+    EXPECT_EQ(elite_driver_write_servoj(nullptr, pos, 100, false, false), ELITE_ERR_INVALID_ARGUMENT);
+    EXPECT_FALSE(elite_driver_is_robot_connected(nullptr));
+    elite_driver_destroy(nullptr);
+
+    elite_rtsi_t* rtsi = nullptr;
+    EXPECT_EQ(elite_rtsi_create(nullptr, 0, nullptr, 0, 250, &rtsi), ELITE_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(elite_rtsi_create(RECIPE, 3, nullptr, 0, 0, &rtsi), ELITE_ERR_INVALID_ARGUMENT);
+    EXPECT_EQ(rtsi, nullptr);
+    EXPECT_EQ(elite_rtsi_snapshot(nullptr), nullptr);
+    elite_rtsi_destroy(nullptr);
+
+    EXPECT_EQ(elite_dashboard_echo(nullptr), ELITE_ERR_INVALID_ARGUMENT);
+    elite_dashboard_destroy(nullptr);
+}
+
+TEST(EliteCTest, failures_are_status_codes) {
+    elite_rtsi_t* rtsi = nullptr;
+    ASSERT_EQ(elite_rtsi_create(RECIPE, 3, nullptr, 0, 250, &rtsi), ELITE_OK);
+    // No robot: an error code, not an exception
+    EXPECT_NE(elite_rtsi_connect(rtsi, "not an ip"), ELITE_OK);
+    EXPECT_STRNE(elite_last_error(), "");
+    EXPECT_FALSE(elite_rtsi_is_connected(rtsi));
+    elite_rtsi_snapshot_t snapshot;
+    ASSERT_EQ(elite_rtsi_read_snapshot(rtsi, &snapshot), ELITE_OK);
+    EXPECT_EQ(snapshot.sequence, 0u);
+    EXPECT_EQ(snapshot.fields, 0u);
+    int32_t value = 0;
+    EXPECT_EQ(elite_rtsi_get_out_int_register(rtsi, 0, &value), ELITE_ERR_SOCKET);
+    elite_rtsi_destroy(rtsi);
+
+    elite_dashboard_t* dashboard = nullptr;
+    ASSERT_EQ(elite_dashboard_create(&dashboard), ELITE_OK);
+    EXPECT_NE(elite_dashboard_connect(dashboard, "not an ip", 0), ELITE_OK);
+    elite_dashboard_destroy(dashboard);
+}
+
+struct FrameCounter {
+    std::atomic<int> frames{0};
+    std::atomic<uint64_t> last_sequence{0};
+};
+
+static void onFrame(const elite_rtsi_snapshot_t* snapshot, void* context) {
+    FrameCounter* counter = static_cast<FrameCounter*>(context);
+    counter->last_sequence = snapshot->sequence;
+    counter->frames++;
+}
+
+TEST(EliteCTest, rtsi_snapshot) {
+    FakeRtsiController controller;
+    if (!controller.listening()) {
+        GTEST_SKIP() << "port 30004 is in use";
+    }
+    FrameCounter counter;
+    elite_rtsi_t* rtsi = nullptr;
+    ASSERT_EQ(elite_rtsi_create(RECIPE, 3, nullptr, 0, 500, &rtsi), ELITE_OK);
+    ASSERT_EQ(elite_rtsi_set_frame_callback(rtsi, onFrame, &counter), ELITE_OK);
+    ASSERT_EQ(elite_rtsi_connect(rtsi, "127.0.0.1"), ELITE_OK) << elite_last_error();
+    uint32_t version[4] = {0};
+    ASSERT_EQ(elite_rtsi_get_controller_version(rtsi, version), ELITE_OK);
+    EXPECT_EQ(version[1], 14u);
+
+    const volatile elite_rtsi_snapshot_t* shared = elite_rtsi_snapshot(rtsi);
+    ASSERT_NE(shared, nullptr);
+    ASSERT_TRUE(waitFor([&]() { return shared->sequence >= 20; }));
+
+    // Every copy is one frame: the joints and the timestamp are written by the same frame
+    for (int i = 0; i < 200; i++) {
+        elite_rtsi_snapshot_t snapshot;
+        ASSERT_EQ(elite_rtsi_read_snapshot(rtsi, &snapshot), ELITE_OK);
+        EXPECT_EQ(snapshot.sequence % 2, 0u);
+        EXPECT_EQ(snapshot.sequence, snapshot.frame_count * 2);
+        EXPECT_EQ(snapshot.fields, (uint64_t)(ELITE_RTSI_TIMESTAMP | ELITE_RTSI_ROBOT_MODE | ELITE_RTSI_ACTUAL_JOINT_POSITIONS));
+        EXPECT_EQ(snapshot.robot_mode, 7);
+        EXPECT_DOUBLE_EQ(snapshot.actual_joint_positions[5] * 0.002, snapshot.timestamp);
+        EXPECT_EQ(snapshot.actual_TCP_pose[0], 0);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    EXPECT_GT(counter.frames, 0);
+    ASSERT_EQ(elite_rtsi_set_frame_callback(rtsi, nullptr, nullptr), ELITE_OK);
+    int after_remove = counter.frames;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(counter.frames, after_remove);
+    EXPECT_EQ(counter.last_sequence % 2, 0u);
+
+    elite_rtsi_disconnect(rtsi);
+    EXPECT_FALSE(elite_rtsi_is_connected(rtsi));
+    elite_rtsi_destroy(rtsi);
+}
+
+struct SelfRemover {
+    elite_rtsi_t* rtsi = nullptr;
+    std::atomic<int> frames{0};
+};
+
+static void removeOnFrame(const elite_rtsi_snapshot_t*, void* context) {
+    SelfRemover* remover = static_cast<SelfRemover*>(context);
+    remover->frames++;
+    elite_rtsi_set_frame_callback(remover->rtsi, nullptr, nullptr);
+}
+
+TEST(EliteCTest, rtsi_callback_removes_itself) {
+    FakeRtsiController controller;
+    if (!controller.listening()) {
+        GTEST_SKIP() << "port 30004 is in use";
+    }
+    SelfRemover remover;
+    ASSERT_EQ(elite_rtsi_create(RECIPE, 3, nullptr, 0, 500, &remover.rtsi), ELITE_OK);
+    ASSERT_EQ(elite_rtsi_set_frame_callback(remover.rtsi, removeOnFrame, &remover), ELITE_OK);
+    ASSERT_EQ(elite_rtsi_connect(remover.rtsi, "127.0.0.1"), ELITE_OK) << elite_last_error();
+
+    // Setting the callback from inside it doesn't deadlock the receive thread
+    const volatile elite_rtsi_snapshot_t* shared = elite_rtsi_snapshot(remover.rtsi);
+    ASSERT_TRUE(waitFor([&]() { return remover.frames > 0; }));
+    uint64_t sequence = shared->sequence;
+    ASSERT_TRUE(waitFor([&]() { return shared->sequence > sequence + 10; }));
+    EXPECT_EQ(remover.frames, 1);
+    elite_rtsi_destroy(remover.rtsi);
+}
+
+/**
+ * The primary port of a robot on the loopback, so that the driver can be created, and the reverse socket of the control script.
+ */
+class LoopbackRobot {
+   public:
+    LoopbackRobot() : primary_acceptor_(io_context_), primary_socket_(io_context_), reverse_socket_(io_context_) {
+        boost::system::error_code ec;
+        primary_acceptor_.open(tcp::v4(), ec);
+        primary_acceptor_.set_option(tcp::acceptor::reuse_address(true), ec);
+        primary_acceptor_.bind(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30001), ec);
+        if (!ec) {
+            primary_acceptor_.listen(1, ec);
+        }
+        listening_ = !ec;
+        if (listening_) {
+            primary_acceptor_.async_accept(primary_socket_, [](const boost::system::error_code&) {});
+            thread_ = std::thread([this]() { io_context_.run(); });
+        }
+    }
+
+    ~LoopbackRobot() {
+        io_context_.stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    bool listening() const { return listening_; }
+
+    bool connectReverse(int port) {
+        boost::system::error_code ec;
+        reverse_socket_.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port), ec);
+        return !ec;
+    }
+
+    void closeReverse() {
+        boost::system::error_code ec;
+        reverse_socket_.close(ec);
+    }
+
+   private:
+    boost::asio::io_context io_context_;
+    tcp::acceptor primary_acceptor_;
+    tcp::socket primary_socket_;
+    tcp::socket reverse_socket_;
+    std::thread thread_;
+    bool listening_ = false;
+};
+
+struct ConnectionRecorder {
+    elite_driver_t* driver = nullptr;
+    std::atomic<int> calls{0};
+    std::atomic<bool> inside{false};
+    std::atomic<bool> finished{false};
+};
+
+static void slowConnection(int32_t, bool, void* context) {
+    ConnectionRecorder* recorder = static_cast<ConnectionRecorder*>(context);
+    recorder->inside = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    recorder->calls++;
+    recorder->finished = true;
+}
+
+static void removeOnConnection(int32_t, bool, void* context) {
+    ConnectionRecorder* recorder = static_cast<ConnectionRecorder*>(context);
+    recorder->calls++;
+    elite_driver_set_connection_callback(recorder->driver, nullptr, nullptr);
+}
+
+TEST(EliteCTest, driver_callback_setter_waits) {
+    LoopbackRobot robot;
+    if (!robot.listening()) {
+        GTEST_SKIP() << "port 30001 is in use";
+    }
+    elite_driver_config_t config;
+    elite_driver_config_init(&config);
+    config.robot_ip = "127.0.0.1";
+    config.local_ip = "127.0.0.1";
+    config.script_file_path = "external_control.script";
+    config.headless_mode = false;
+    ConnectionRecorder recorder;
+    ASSERT_EQ(elite_driver_create(&config, &recorder.driver), ELITE_OK) << elite_last_error();
+    ASSERT_EQ(elite_driver_set_connection_callback(recorder.driver, slowConnection, &recorder), ELITE_OK);
+    ASSERT_TRUE(robot.connectReverse(config.reverse_port));
+
+    // The setter returns after the callback it replaces
+    ASSERT_TRUE(waitFor([&]() { return recorder.inside.load(); }));
+    ASSERT_EQ(elite_driver_set_connection_callback(recorder.driver, removeOnConnection, &recorder), ELITE_OK);
+    EXPECT_TRUE(recorder.finished);
+    EXPECT_EQ(recorder.calls, 1);
+
+    // A callback removes itself
+    robot.closeReverse();
+    ASSERT_TRUE(waitFor([&]() { return recorder.calls == 2; }));
+    ASSERT_TRUE(robot.connectReverse(config.reverse_port));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(recorder.calls, 2);
+    elite_driver_destroy(recorder.driver);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,11 +1,22 @@
 #include "Elite/EliteDriver.hpp"
+#include "Elite/ControlMode.hpp"
+#include "Common/EndianUtils.hpp"
 
 #include <gtest/gtest.h>
+#include <boost/asio.hpp>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <cstdlib>
 #include <thread>
 
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 using namespace ELITE;
 using namespace std::chrono;
 
@@ -36,6 +47,196 @@ TEST(EliteDriverTest, ConstructorsAndDestructors) {
     }
 }
 
+/**
+ * A robot on the loopback: the primary port accepts the driver, the reverse socket is connected like the control script does.
+ */
+class LoopbackRobot {
+   public:
+    LoopbackRobot() : primary_acceptor_(io_context_), primary_socket_(io_context_), reverse_socket_(io_context_) {
+        using boost::asio::ip::tcp;
+        boost::system::error_code ec;
+        primary_acceptor_.open(tcp::v4(), ec);
+        primary_acceptor_.set_option(tcp::acceptor::reuse_address(true), ec);
+        primary_acceptor_.bind(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30001), ec);
+        if (!ec) {
+            primary_acceptor_.listen(1, ec);
+        }
+        listening_ = !ec;
+        if (listening_) {
+            primary_acceptor_.async_accept(primary_socket_, [](const boost::system::error_code&) {});
+            thread_ = std::thread([this]() { io_context_.run(); });
+        }
+    }
+
+    ~LoopbackRobot() {
+        io_context_.stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    // false if port 30001 is in use, the test should be skipped
+    bool listening() const { return listening_; }
+
+    bool connectReverse(int port) {
+        boost::system::error_code ec;
+        reverse_socket_.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port), ec);
+        return !ec;
+    }
+
+    // The next reverse message: timeout, 6 values, mode
+    std::vector<int32_t> readReverse() {
+        std::vector<uint8_t> buffer(8 * sizeof(int32_t));
+        boost::system::error_code ec;
+        boost::asio::read(reverse_socket_, boost::asio::buffer(buffer), ec);
+        std::vector<int32_t> message(8, 0);
+        if (ec) {
+            return {};
+        }
+        int offset = 0;
+        for (auto& value : message) {
+            ELITE::EndianUtils::unpack(buffer, offset, value);
+        }
+        return message;
+    }
+
+   private:
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor primary_acceptor_;
+    boost::asio::ip::tcp::socket primary_socket_;
+    boost::asio::ip::tcp::socket reverse_socket_;
+    std::thread thread_;
+    bool listening_ = false;
+};
+
+TEST(EliteDriverTest, tool_contact_blocks_motion) {
+    LoopbackRobot robot;
+    if (!robot.listening()) {
+        GTEST_SKIP() << "port 30001 is in use";
+    }
+    EliteDriverConfig config;
+    config.robot_ip = "127.0.0.1";
+    config.local_ip = "127.0.0.1";
+    config.script_file_path = "external_control.script";
+    config.headless_mode = false;
+    EliteDriver driver(config);
+    ASSERT_TRUE(robot.connectReverse(config.reverse_port));
+
+    // Nothing is written before the script connects
+    vector6d_t pos{0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+    auto deadline = steady_clock::now() + 2s;
+    while (!driver.writeServoj(pos, 100) && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+    }
+    auto message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[0], 100);
+    EXPECT_EQ(message[1], 100000);
+    EXPECT_EQ(message[6], 600000);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_SERVOJ);
+
+    EXPECT_TRUE(driver.writeToolContact(200));
+    EXPECT_TRUE(driver.isToolInContact());
+    message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[0], 200);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_TOOL_IN_CONTACT);
+
+    // A motion command keeps the robot stopped instead of moving it
+    EXPECT_FALSE(driver.writeServoj(pos, 100));
+    EXPECT_FALSE(driver.writeSpeedj(pos, 100));
+    EXPECT_FALSE(driver.writeTrajectoryControlAction(TrajectoryControlAction::START, 1, 100));
+    for (int i = 0; i < 3; i++) {
+        message = robot.readReverse();
+        ASSERT_EQ(message.size(), 8);
+        EXPECT_EQ(message[1], 0);
+        EXPECT_EQ(message[7], (int)ControlMode::MODE_TOOL_IN_CONTACT);
+    }
+
+    driver.clearToolContact();
+    EXPECT_FALSE(driver.isToolInContact());
+    EXPECT_TRUE(driver.writeSpeedj(pos, 100));
+    message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[1], 100000);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_SPEEDJ);
+
+    // Every owner has its own stop, clearing one keeps the other
+    EXPECT_TRUE(driver.writeToolContact(100, ToolContactOwner::TOOL_CONTACT_DETECTOR));
+    EXPECT_TRUE(driver.writeToolContact(100, ToolContactOwner::COLLISION_DETECTOR));
+    for (int i = 0; i < 2; i++) {
+        message = robot.readReverse();
+        ASSERT_EQ(message.size(), 8);
+        EXPECT_EQ(message[7], (int)ControlMode::MODE_TOOL_IN_CONTACT);
+    }
+    driver.clearToolContact(ToolContactOwner::COLLISION_DETECTOR);
+    EXPECT_TRUE(driver.isToolInContact());
+    EXPECT_FALSE(driver.writeSpeedj(pos, 100));
+    message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_TOOL_IN_CONTACT);
+    driver.clearToolContact(ToolContactOwner::TOOL_CONTACT_DETECTOR);
+    EXPECT_FALSE(driver.isToolInContact());
+    EXPECT_TRUE(driver.writeSpeedj(pos, 100));
+    message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_SPEEDJ);
+}
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+// A systemd activation socket named "reverse" is taken by the reverse server, whatever port it is bound to
+TEST(EliteDriverTest, named_activation_socket) {
+    // The activation sockets start at descriptor 3
+    if (fcntl(3, F_GETFD) != -1) {
+        GTEST_SKIP() << "descriptor 3 is in use";
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    ASSERT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(fd, 1), 0);
+    socklen_t addr_len = sizeof(addr);
+    ASSERT_EQ(getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len), 0);
+    int bound_port = ntohs(addr.sin_port);
+    if (fd != 3) {
+        ASSERT_EQ(dup2(fd, 3), 3);
+        ::close(fd);
+    }
+
+    LoopbackRobot robot;
+    if (!robot.listening()) {
+        ::close(3);
+        GTEST_SKIP() << "port 30001 is in use";
+    }
+    EliteDriverConfig config;
+    config.robot_ip = "127.0.0.1";
+    config.local_ip = "127.0.0.1";
+    config.script_file_path = "external_control.script";
+    config.headless_mode = false;
+    config.inherit_listen_sockets = true;
+    setenv("LISTEN_PID", std::to_string(getpid()).c_str(), 1);
+    setenv("LISTEN_FDS", "1", 1);
+    setenv("LISTEN_FDNAMES", "reverse", 1);
+    EliteDriver driver(config);
+    unsetenv("LISTEN_PID");
+    unsetenv("LISTEN_FDS");
+    unsetenv("LISTEN_FDNAMES");
+
+    ASSERT_NE(bound_port, config.reverse_port);
+    ASSERT_TRUE(robot.connectReverse(bound_port));
+    vector6d_t pos{0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+    auto deadline = steady_clock::now() + 2s;
+    while (!driver.writeServoj(pos, 100) && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+    }
+    auto message = robot.readReverse();
+    ASSERT_EQ(message.size(), 8);
+    EXPECT_EQ(message[7], (int)ControlMode::MODE_SERVOJ);
+}
+#endif
 
 int main(int argc, char** argv) {
     if(argc >= 3) {
@@ -0,0 +1,181 @@
+// A fake driver for the tests of the frame-driven helpers, the commands are recorded instead of being sent to a robot.
+#ifndef __TEST_FAKE_COMMAND_WRITER_HPP__
+#define __TEST_FAKE_COMMAND_WRITER_HPP__
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Elite/DataType.hpp"
+#include "Elite/DriverCommandWriter.hpp"
+
+/**
+ * Like EliteDriver, the motion commands fail while the tool contact is latched. 'connected' false fails every command.
+ */
+class FakeCommandWriter : public ELITE::DriverCommandWriter {
+   public:
+    struct Servoj {
+        ELITE::vector6d_t pos;
+        int timeout_ms;
+        bool cartesian;
+        bool queue_mode;
+    };
+
+    struct TrajectoryPoint {
+        ELITE::vector6d_t positions;
+        float time;
+        float blend_radius;
+        bool cartesian;
+    };
+
+    struct ControlAction {
+        ELITE::TrajectoryControlAction action;
+        int point_number;
+        int timeout_ms;
+    };
+
+    bool connected = true;
+
+    std::vector<Servoj> servoj() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return servoj_;
+    }
+
+    std::vector<ELITE::vector6d_t> speedj() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return speedj_;
+    }
+
+    std::vector<TrajectoryPoint> trajectoryPoints() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return trajectory_points_;
+    }
+
+    std::vector<ControlAction> controlActions() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return control_actions_;
+    }
+
+    std::vector<std::pair<double, ELITE::vector3d_t>> payloads() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return payloads_;
+    }
+
+    int toolContactWrites() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tool_contact_writes_;
+    }
+
+    int toolContactClears() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tool_contact_clears_;
+    }
+
+    bool toolContact() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tool_contact_ != 0;
+    }
+
+    bool toolContact(ELITE::ToolContactOwner owner) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tool_contact_ & (1 << (int)owner);
+    }
+
+    // Report the end of a trajectory like the robot does
+    void finishTrajectory(ELITE::TrajectoryMotionResult result) {
+        std::function<void(ELITE::TrajectoryMotionResult)> cb = getTrajectoryResultCallback();
+        if (cb) {
+            cb(result);
+        }
+    }
+
+    bool writeServoj(const ELITE::vector6d_t& pos, int timeout_ms, bool cartesian = false, bool queue_mode = false) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected || tool_contact_) {
+            return false;
+        }
+        servoj_.push_back({pos, timeout_ms, cartesian, queue_mode});
+        return true;
+    }
+
+    bool writeSpeedj(const ELITE::vector6d_t& vel, int timeout_ms) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected || tool_contact_) {
+            return false;
+        }
+        speedj_.push_back(vel);
+        return true;
+    }
+
+    void setTrajectoryResultCallback(std::function<void(ELITE::TrajectoryMotionResult)> cb) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trajectory_result_cb_ = std::move(cb);
+    }
+
+    std::function<void(ELITE::TrajectoryMotionResult)> getTrajectoryResultCallback() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return trajectory_result_cb_;
+    }
+
+    bool writeTrajectoryPoint(const ELITE::vector6d_t& positions, float time, float blend_radius, bool cartesian) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected) {
+            return false;
+        }
+        trajectory_points_.push_back({positions, time, blend_radius, cartesian});
+        return true;
+    }
+
+    bool writeTrajectoryControlAction(ELITE::TrajectoryControlAction action, const int point_number, int timeout_ms) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected || tool_contact_) {
+            return false;
+        }
+        control_actions_.push_back({action, point_number, timeout_ms});
+        return true;
+    }
+
+    bool writeToolContact(int timeout_ms, ELITE::ToolContactOwner owner = ELITE::ToolContactOwner::USER) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tool_contact_ |= 1 << (int)owner;
+        tool_contact_writes_++;
+        return connected;
+    }
+
+    void clearToolContact() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tool_contact_ = 0;
+        tool_contact_clears_++;
+    }
+
+    void clearToolContact(ELITE::ToolContactOwner owner) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tool_contact_ &= ~(1 << (int)owner);
+        tool_contact_clears_++;
+    }
+
+    bool setPayload(double mass, const ELITE::vector3d_t& cog) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected) {
+            return false;
+        }
+        payloads_.emplace_back(mass, cog);
+        return true;
+    }
+
+   private:
+    std::mutex mutex_;
+    // A bit per ToolContactOwner
+    int tool_contact_ = 0;
+    int tool_contact_writes_ = 0;
+    int tool_contact_clears_ = 0;
+    std::vector<Servoj> servoj_;
+    std::vector<ELITE::vector6d_t> speedj_;
+    std::vector<TrajectoryPoint> trajectory_points_;
+    std::vector<ControlAction> control_actions_;
+    std::vector<std::pair<double, ELITE::vector3d_t>> payloads_;
+    std::function<void(ELITE::TrajectoryMotionResult)> trajectory_result_cb_;
+};
+
+#endif
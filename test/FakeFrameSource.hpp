@@ -0,0 +1,99 @@
+// A fake RTSI frame source for the tests of the frame-driven helpers, frames are delivered by frame() in the calling thread.
+#ifndef __TEST_FAKE_FRAME_SOURCE_HPP__
+#define __TEST_FAKE_FRAME_SOURCE_HPP__
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Elite/DataType.hpp"
+#include "Rtsi/RtsiFrameSource.hpp"
+
+/**
+ * The output recipe is the set of values set by set(). frame() calls the frame callbacks like the RTSI receive thread does.
+ */
+class FakeFrameSource : public ELITE::RtsiFrameSource {
+   public:
+    template <typename T>
+    void set(const std::string& name, const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        values_[name] = value;
+    }
+
+    void erase(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        values_.erase(name);
+    }
+
+    // One output frame
+    void frame() {
+        std::vector<std::pair<int, std::function<void()>>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callbacks = callbacks_;
+        }
+        for (auto& item : callbacks) {
+            item.second();
+        }
+    }
+
+    size_t callbackCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return callbacks_.size();
+    }
+
+    int addFrameCallback(std::function<void()> cb) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks_.emplace_back(next_handle_, std::move(cb));
+        return next_handle_++;
+    }
+
+    void removeFrameCallback(int handle) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto iter = callbacks_.begin(); iter != callbacks_.end(); ++iter) {
+            if (iter->first == handle) {
+                callbacks_.erase(iter);
+                return;
+            }
+        }
+    }
+
+    bool getRecipeValue(const std::string& name, bool& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, int32_t& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, uint32_t& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, uint64_t& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, double& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, ELITE::vector3d_t& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, ELITE::vector6d_t& out_value) override { return get(name, out_value); }
+    bool getRecipeValue(const std::string& name, ELITE::vector6int32_t& out_value) override { return get(name, out_value); }
+
+   private:
+    std::mutex mutex_;
+    std::map<std::string, ELITE::RtsiTypeVariant> values_;
+    std::vector<std::pair<int, std::function<void()>>> callbacks_;
+    int next_handle_ = 0;
+
+    template <typename T>
+    bool get(const std::string& name, T& out_value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = values_.find(name);
+        if (iter == values_.end()) {
+            return false;
+        }
+#if (ELITE_SDK_COMPILE_STANDARD >= 17)
+        const T* value = std::get_if<T>(&iter->second);
+#else
+        const T* value = boost::get<T>(&iter->second);
+#endif
+        if (!value) {
+            return false;
+        }
+        out_value = *value;
+        return true;
+    }
+};
+
+#endif
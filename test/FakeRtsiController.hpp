@@ -0,0 +1,287 @@
+// A fake RTSI controller for the tests, on 127.0.0.1:30004 where RtsiIOInterface connects.
+#ifndef __TEST_FAKE_RTSI_CONTROLLER_HPP__
+#define __TEST_FAKE_RTSI_CONTROLLER_HPP__
+
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/EndianUtils.hpp"
+#include "Common/StringUtils.hpp"
+
+/**
+ * Serves one RtsiIOInterface at a time. The input and output recipes are accepted with the types of typeOf(). Every 'period_ms'
+ * the newest input package is decoded, 'step' may change the outputs, and an output package is sent. A value is a list of
+ * numbers, one for a scalar and 3 or 6 for a vector.
+ */
+class FakeRtsiController {
+   public:
+    using Values = std::map<std::string, std::vector<double>>;
+    using Step = std::function<void(const Values& inputs, Values& outputs)>;
+
+    explicit FakeRtsiController(Step step = nullptr, int period_ms = 2)
+        : acceptor_(io_context_), step_(std::move(step)), period_ms_(period_ms) {
+        using boost::asio::ip::tcp;
+        boost::system::error_code ec;
+        acceptor_.open(tcp::v4(), ec);
+        acceptor_.set_option(tcp::acceptor::reuse_address(true), ec);
+        acceptor_.bind(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30004), ec);
+        if (!ec) {
+            acceptor_.listen(1, ec);
+        }
+        listening_ = !ec;
+        if (listening_) {
+            thread_ = std::thread([this]() { acceptLoop(); });
+        }
+    }
+
+    ~FakeRtsiController() {
+        using boost::asio::ip::tcp;
+        running_ = false;
+        boost::system::error_code ec;
+        tcp::socket waker(io_context_);
+        waker.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), 30004), ec);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    // false if port 30004 is in use, the test should be skipped
+    bool listening() const { return listening_; }
+
+    void setOutput(const std::string& name, const std::vector<double>& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        outputs_[name] = value;
+    }
+
+    Values inputs() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inputs_;
+    }
+
+    // The number of output packages sent
+    uint64_t frames() const { return frames_; }
+
+    // The number of input packages received
+    uint64_t inputPackages() const { return input_packages_; }
+
+    static std::string typeOf(const std::string& name) {
+        static const std::map<std::string, std::string> types = {
+            {"timestamp", "DOUBLE"},
+            {"speed_scaling", "DOUBLE"},
+            {"target_speed_fraction", "DOUBLE"},
+            {"payload_mass", "DOUBLE"},
+            {"standard_analog_input0", "DOUBLE"},
+            {"standard_analog_input1", "DOUBLE"},
+            {"tool_analog_input", "DOUBLE"},
+            {"robot_mode", "INT32"},
+            {"safety_status", "INT32"},
+            {"runtime_state", "UINT32"},
+            {"actual_digital_input_bits", "UINT32"},
+            {"actual_digital_output_bits", "UINT32"},
+            {"input_bit_registers0_to_31", "UINT32"},
+            {"input_bit_registers32_to_63", "UINT32"},
+            {"output_bit_registers0_to_31", "UINT32"},
+            {"output_bit_registers32_to_63", "UINT32"},
+            {"payload_cog", "VECTOR3D"},
+            {"elbow_position", "VECTOR3D"},
+            {"joint_mode", "VECTOR6INT32"},
+        };
+        auto iter = types.find(name);
+        if (iter != types.end()) {
+            return iter->second;
+        }
+        if (name.find("int_register") != std::string::npos) {
+            return "INT32";
+        }
+        if (name.find("double_register") != std::string::npos) {
+            return "DOUBLE";
+        }
+        // The joint and TCP vectors
+        return "VECTOR6D";
+    }
+
+   private:
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    Step step_;
+    int period_ms_;
+    std::thread thread_;
+    bool listening_ = false;
+    std::atomic<bool> running_{true};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> input_packages_{0};
+
+    std::mutex mutex_;
+    Values inputs_;
+    Values outputs_;
+
+    static const uint8_t INPUT_RECIPE_ID = 2;
+    static const uint8_t OUTPUT_RECIPE_ID = 1;
+
+    static int countOf(const std::string& type) {
+        if (type == "VECTOR3D") {
+            return 3;
+        }
+        return type.find("VECTOR6") == 0 ? 6 : 1;
+    }
+
+    static void packValue(std::vector<uint8_t>& out, const std::string& type, const std::vector<double>& value) {
+        for (int i = 0; i < countOf(type); i++) {
+            double number = i < (int)value.size() ? value[i] : 0;
+            if (type == "INT32" || type == "VECTOR6INT32") {
+                ELITE::EndianUtils::packTo(out, (int32_t)number);
+            } else if (type == "UINT32") {
+                ELITE::EndianUtils::packTo(out, (uint32_t)number);
+            } else {
+                ELITE::EndianUtils::packTo(out, number);
+            }
+        }
+    }
+
+    static std::vector<double> unpackValue(const std::vector<uint8_t>& data, int& offset, const std::string& type) {
+        std::vector<double> value;
+        for (int i = 0; i < countOf(type); i++) {
+            if (type == "INT32" || type == "VECTOR6INT32") {
+                int32_t number = 0;
+                ELITE::EndianUtils::unpack(data, offset, number);
+                value.push_back(number);
+            } else if (type == "UINT32") {
+                uint32_t number = 0;
+                ELITE::EndianUtils::unpack(data, offset, number);
+                value.push_back(number);
+            } else {
+                double number = 0;
+                ELITE::EndianUtils::unpack(data, offset, number);
+                value.push_back(number);
+            }
+        }
+        return value;
+    }
+
+    static bool reply(boost::asio::ip::tcp::socket& socket, uint8_t type, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> package = ELITE::EndianUtils::pack((uint16_t)(3 + payload.size()));
+        package.push_back(type);
+        package.insert(package.end(), payload.begin(), payload.end());
+        boost::system::error_code ec;
+        boost::asio::write(socket, boost::asio::buffer(package), ec);
+        return !ec;
+    }
+
+    static bool readPackage(boost::asio::ip::tcp::socket& socket, uint8_t& type, std::vector<uint8_t>& body) {
+        boost::system::error_code ec;
+        uint8_t header[3];
+        if (!boost::asio::read(socket, boost::asio::buffer(header), ec)) {
+            return false;
+        }
+        type = header[2];
+        body.resize(((header[0] << 8) | header[1]) - 3);
+        boost::asio::read(socket, boost::asio::buffer(body), ec);
+        return !ec;
+    }
+
+    // Answer a recipe setup with the types of the names
+    static std::vector<uint8_t> setupReply(uint8_t id, const std::vector<std::string>& names) {
+        std::string types;
+        for (auto& name : names) {
+            types += (types.empty() ? "" : ",") + typeOf(name);
+        }
+        std::vector<uint8_t> payload = {id};
+        payload.insert(payload.end(), types.begin(), types.end());
+        return payload;
+    }
+
+    void acceptLoop() {
+        while (running_) {
+            boost::asio::ip::tcp::socket socket(io_context_);
+            boost::system::error_code ec;
+            acceptor_.accept(socket, ec);
+            if (ec || !running_) {
+                return;
+            }
+            serve(socket);
+        }
+    }
+
+    void serve(boost::asio::ip::tcp::socket& socket) {
+        std::vector<std::string> input_names;
+        std::vector<std::string> output_names;
+        bool streaming = false;
+        uint8_t type = 0;
+        std::vector<uint8_t> body;
+        while (running_ && !streaming) {
+            if (!readPackage(socket, type, body)) {
+                return;
+            }
+            switch (type) {
+                case 'V':
+                    reply(socket, 'V', {1});
+                    break;
+                case 'v': {
+                    std::vector<uint8_t> version;
+                    for (uint32_t value : {2u, 14u, 5u, 1234u}) {
+                        ELITE::EndianUtils::packTo(version, value);
+                    }
+                    reply(socket, 'v', version);
+                    break;
+                }
+                case 'I':
+                    input_names = ELITE::StringUtils::splitString(std::string(body.begin(), body.end()), ",");
+                    reply(socket, 'I', setupReply(INPUT_RECIPE_ID, input_names));
+                    break;
+                case 'O':
+                    // The frequency comes first
+                    output_names = ELITE::StringUtils::splitString(std::string(body.begin() + 8, body.end()), ",");
+                    reply(socket, 'O', setupReply(OUTPUT_RECIPE_ID, output_names));
+                    break;
+                case 'S':
+                    reply(socket, 'S', {1});
+                    streaming = true;
+                    break;
+            }
+        }
+        while (running_) {
+            boost::system::error_code ec;
+            while (socket.available(ec) >= 3 && !ec) {
+                if (!readPackage(socket, type, body)) {
+                    return;
+                }
+                if (type == 'U' && !body.empty() && body[0] == INPUT_RECIPE_ID) {
+                    int offset = 1;
+                    input_packages_++;
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (auto& name : input_names) {
+                        inputs_[name] = unpackValue(body, offset, typeOf(name));
+                    }
+                }
+            }
+            if (ec) {
+                return;
+            }
+            std::vector<uint8_t> payload = {OUTPUT_RECIPE_ID};
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (step_) {
+                    step_(inputs_, outputs_);
+                }
+                for (auto& name : output_names) {
+                    packValue(payload, typeOf(name), outputs_[name]);
+                }
+            }
+            // The client disconnected
+            if (!reply(socket, 'U', payload)) {
+                return;
+            }
+            frames_++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(period_ms_));
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "Common/GzipStream.hpp"
+
+#ifdef ELITE_USE_ZLIB
+
+using namespace ELITE;
+
+static std::string gzip(const std::string& text) {
+    z_stream stream{};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, text.size()), '\0');
+    stream.next_in = (Bytef*)text.data();
+    stream.avail_in = text.size();
+    stream.next_out = (Bytef*)&out[0];
+    stream.avail_out = out.size();
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// A log like CSV text
+static std::string csvLog(size_t lines) {
+    std::mt19937 rng(1);
+    std::string text;
+    for (size_t i = 0; i < lines; i++) {
+        text += "2025-01-01 12:00:" + std::to_string(i % 60) + ",INFO,Controller," + std::to_string(rng() % 1000) +
+                ",Joint position reached\n";
+    }
+    return text;
+}
+
+TEST(GzipStreamTest, decompresses_in_chunks) {
+    std::string text = csvLog(20000);
+    std::string compressed = gzip(text);
+    EXPECT_LT(compressed.size() * 5, text.size());
+
+    for (size_t chunk : {size_t(1), size_t(1000), compressed.size()}) {
+        GzipInflater inflater;
+        std::string out;
+        for (size_t offset = 0; offset < compressed.size(); offset += chunk) {
+            size_t size = std::min(chunk, compressed.size() - offset);
+            ASSERT_TRUE(inflater.feed(compressed.data() + offset, size, [&](const char* data, size_t n) {
+                out.append(data, n);
+                return true;
+            }));
+        }
+        EXPECT_TRUE(inflater.finished());
+        EXPECT_EQ(out, text);
+        EXPECT_EQ(inflater.compressedBytes(), compressed.size());
+        EXPECT_EQ(inflater.uncompressedBytes(), text.size());
+    }
+}
+
+TEST(GzipStreamTest, concatenated_members) {
+    std::string compressed = gzip("first\n") + gzip("second\n");
+    GzipInflater inflater;
+    std::string out;
+    ASSERT_TRUE(inflater.feed(compressed.data(), compressed.size(), [&](const char* data, size_t n) {
+        out.append(data, n);
+        return true;
+    }));
+    EXPECT_TRUE(inflater.finished());
+    EXPECT_EQ(out, "first\nsecond\n");
+}
+
+TEST(GzipStreamTest, rejects_invalid_and_truncated_data) {
+    auto sink = [](const char*, size_t) { return true; };
+    std::string garbage = "this is not gzip";
+    GzipInflater invalid;
+    EXPECT_FALSE(invalid.feed(garbage.data(), garbage.size(), sink));
+
+    std::string compressed = gzip(csvLog(100));
+    GzipInflater truncated;
+    EXPECT_TRUE(truncated.feed(compressed.data(), compressed.size() / 2, sink));
+    EXPECT_FALSE(truncated.finished());
+
+    GzipInflater stopped;
+    EXPECT_FALSE(stopped.feed(compressed.data(), compressed.size(), [](const char*, size_t) { return false; }));
+}
+
+#endif  // ELITE_USE_ZLIB
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Elite/CartesianVelocityStreamer.hpp"
+#include "Elite/Kinematics.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+
+using namespace ELITE;
+
+static const double PI = 3.14159265358979323846;
+
+static Kinematics makeKinematics() {
+    // CS63 like DH parameters
+    Kinematics kin({0, -0.3, -0.276, 0, 0, 0}, {0.1215, 0, 0, 0.1105, 0.09, 0.082}, {PI / 2, 0, 0, PI / 2, -PI / 2, 0});
+    kin.setTcpOffset({0, 0, 0.1, 0, 0, 0});
+    return kin;
+}
+
+static const vector6d_t Q_GENERAL{0.3, -1.2, 1.4, -1.6, -1.57, 0.5};
+
+TEST(KinematicsTest, rotation_vector_round_trip) {
+    for (const vector3d_t& rv : {vector3d_t{0, 0, 0}, vector3d_t{0.1, -0.2, 0.3}, vector3d_t{1.2, 0.4, -2.0},
+                                 vector3d_t{0, 0, PI - 1e-9}, vector3d_t{PI / std::sqrt(2.0), -PI / std::sqrt(2.0), 0}}) {
+        vector3d_t out = Kinematics::rotationVector(Kinematics::rotationMatrix(rv));
+        auto r1 = Kinematics::rotationMatrix(rv);
+        auto r2 = Kinematics::rotationMatrix(out);
+        for (int i = 0; i < 9; i++) {
+            EXPECT_NEAR(r1[i], r2[i], 1e-7);
+        }
+    }
+}
+
+TEST(KinematicsTest, forward_zero_position) {
+    Kinematics kin({0, -0.3, -0.276, 0, 0, 0}, {0.1215, 0, 0, 0.1105, 0.09, 0.082}, {PI / 2, 0, 0, PI / 2, -PI / 2, 0});
+    vector6d_t pose = kin.forward({0, 0, 0, 0, 0, 0});
+    // Arm stretched along -x, flange offset by d4 and d6 along -y, d5 down from d1
+    EXPECT_NEAR(pose[0], -0.576, 1e-9);
+    EXPECT_NEAR(pose[1], -0.1925, 1e-9);
+    EXPECT_NEAR(pose[2], 0.1215 - 0.09, 1e-9);
+}
+
+TEST(KinematicsTest, jacobian_matches_finite_differences) {
+    Kinematics kin = makeKinematics();
+    matrix6d_t jacobian;
+    kin.jacobian(Q_GENERAL, jacobian);
+    vector6d_t pose = kin.forward(Q_GENERAL);
+    auto r = Kinematics::rotationMatrix({pose[3], pose[4], pose[5]});
+    const double h = 1e-6;
+    for (int joint = 0; joint < 6; joint++) {
+        vector6d_t qp = Q_GENERAL, qm = Q_GENERAL;
+        qp[joint] += h;
+        qm[joint] -= h;
+        vector6d_t pp = kin.forward(qp), pm = kin.forward(qm);
+        for (int row = 0; row < 3; row++) {
+            EXPECT_NEAR(jacobian[row][joint], (pp[row] - pm[row]) / (2 * h), 1e-6);
+        }
+        // Angular velocity from dR R^T
+        auto rp = Kinematics::rotationMatrix({pp[3], pp[4], pp[5]});
+        auto rm = Kinematics::rotationMatrix({pm[3], pm[4], pm[5]});
+        double w[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                w[i][j] = 0;
+                for (int k = 0; k < 3; k++) {
+                    w[i][j] += (rp[i * 3 + k] - rm[i * 3 + k]) / (2 * h) * r[j * 3 + k];
+                }
+            }
+        }
+        EXPECT_NEAR(jacobian[3][joint], w[2][1], 1e-6);
+        EXPECT_NEAR(jacobian[4][joint], w[0][2], 1e-6);
+        EXPECT_NEAR(jacobian[5][joint], w[1][0], 1e-6);
+    }
+}
+
+TEST(KinematicsTest, least_squares_follows_twist) {
+    Kinematics kin = makeKinematics();
+    matrix6d_t jacobian;
+    kin.jacobian(Q_GENERAL, jacobian);
+    EXPECT_GT(Kinematics::manipulability(jacobian), 0.001);
+    vector6d_t twist{0.05, -0.02, 0.03, 0.1, 0, -0.2};
+    vector6d_t qd;
+    ASSERT_TRUE(Kinematics::dampedLeastSquares(jacobian, twist, 0, qd));
+    for (int row = 0; row < 6; row++) {
+        double v = 0;
+        for (int k = 0; k < 6; k++) {
+            v += jacobian[row][k] * qd[k];
+        }
+        EXPECT_NEAR(v, twist[row], 1e-9);
+    }
+}
+
+TEST(KinematicsTest, singularity_is_damped) {
+    Kinematics kin = makeKinematics();
+    // Wrist singularity: joint 5 at 0 aligns the axes of joints 4 and 6
+    vector6d_t q = Q_GENERAL;
+    q[4] = 0;
+    matrix6d_t jacobian;
+    kin.jacobian(q, jacobian);
+    EXPECT_NEAR(Kinematics::manipulability(jacobian), 0, 1e-9);
+    vector6d_t qd;
+    EXPECT_FALSE(Kinematics::dampedLeastSquares(jacobian, {0, 0, 0, 0.1, 0.1, 0.1}, 0, qd));
+
+    CartesianVelocityConfig config;
+    CartesianVelocitySolution solution;
+    ASSERT_TRUE(CartesianVelocityStreamer::solve(kin, config, q, {0, 0, 0, 0.1, 0.1, 0.1}, solution));
+    EXPECT_NEAR(solution.damping, config.max_damping, 1e-6);
+    for (double v : solution.joint_velocities) {
+        EXPECT_LT(std::abs(v), 5.0);
+    }
+    EXPECT_TRUE(CartesianVelocityStreamer::solve(kin, config, Q_GENERAL, {0, 0, 0, 0.1, 0.1, 0.1}, solution));
+    EXPECT_DOUBLE_EQ(solution.damping, 0);
+}
+
+TEST(KinematicsTest, joint_limit_and_speed) {
+    Kinematics kin = makeKinematics();
+    CartesianVelocityConfig config;
+    CartesianVelocitySolution solution;
+    vector6d_t twist{0.05, 0.05, 0, 0, 0, 0};
+    ASSERT_TRUE(CartesianVelocityStreamer::solve(kin, config, Q_GENERAL, twist, solution));
+    EXPECT_EQ(solution.limited_joints, 0);
+
+    // The base joint at the limit it moves towards
+    if (solution.joint_velocities[0] > 0) {
+        config.joint_upper[0] = Q_GENERAL[0];
+    } else {
+        config.joint_lower[0] = Q_GENERAL[0];
+    }
+    ASSERT_TRUE(CartesianVelocityStreamer::solve(kin, config, Q_GENERAL, twist, solution));
+    EXPECT_EQ(solution.limited_joints, 1);
+    EXPECT_DOUBLE_EQ(solution.joint_velocities[0], 0);
+
+    // The joint velocities are scaled together
+    config = CartesianVelocityConfig();
+    config.max_joint_speed.fill(0.01);
+    ASSERT_TRUE(CartesianVelocityStreamer::solve(kin, config, Q_GENERAL, twist, solution));
+    EXPECT_GT(solution.speed_scale, 1);
+    double peak = 0;
+    for (double v : solution.joint_velocities) {
+        peak = std::max(peak, std::abs(v));
+    }
+    EXPECT_NEAR(peak, 0.01, 1e-12);
+}
+
+TEST(KinematicsTest, streamer_writes_speedj_per_frame) {
+    Kinematics kin = makeKinematics();
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    CartesianVelocityStreamer streamer(frames, driver, kin);
+    std::vector<std::pair<double, bool>> events;
+    streamer.setManipulabilityCallback([&](double manipulability, bool below) { events.emplace_back(manipulability, below); });
+    CartesianVelocityConfig config;
+    config.twist_timeout_ms = 50;
+    ASSERT_TRUE(streamer.start(config));
+    EXPECT_FALSE(streamer.start(config));
+
+    // No command without the joint positions
+    frames.frame();
+    EXPECT_TRUE(driver.speedj().empty());
+    frames.set("actual_joint_positions", Q_GENERAL);
+    frames.frame();
+    ASSERT_EQ(driver.speedj().size(), 1);
+    EXPECT_EQ(driver.speedj()[0], vector6d_t{});
+
+    vector6d_t twist{0.05, 0, 0.02, 0, 0, 0.1};
+    streamer.setTwist(twist);
+    frames.frame();
+    CartesianVelocitySolution expected;
+    ASSERT_TRUE(CartesianVelocityStreamer::solve(kin, config, Q_GENERAL, twist, expected));
+    ASSERT_EQ(driver.speedj().size(), 2);
+    EXPECT_EQ(driver.speedj()[1], expected.joint_velocities);
+    EXPECT_EQ(streamer.getLastSolution().joint_velocities, expected.joint_velocities);
+
+    // Through a singularity and out of it, the callback is called on the changes only
+    vector6d_t q = Q_GENERAL;
+    q[4] = 0;
+    frames.set("actual_joint_positions", q);
+    frames.frame();
+    frames.frame();
+    frames.set("actual_joint_positions", Q_GENERAL);
+    frames.frame();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_TRUE(events[0].second);
+    EXPECT_NEAR(events[0].first, 0, 1e-9);
+    EXPECT_FALSE(events[1].second);
+
+    // A twist which is not updated is stopped
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    frames.frame();
+    EXPECT_EQ(driver.speedj().back(), vector6d_t{});
+
+    // stop() sends a zero velocity once
+    streamer.setTwist(twist);
+    frames.frame();
+    streamer.stop();
+    EXPECT_FALSE(streamer.isStreaming());
+    auto speedj = driver.speedj();
+    EXPECT_EQ(speedj.back(), vector6d_t{});
+    frames.frame();
+    EXPECT_EQ(driver.speedj().size(), speedj.size());
+    std::chrono::nanoseconds max, mean;
+    streamer.getSolveTime(max, mean);
+    EXPECT_GE(max, mean);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
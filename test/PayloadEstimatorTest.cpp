@@ -0,0 +1,327 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "Elite/Kinematics.hpp"
+#include "Elite/PayloadEstimator.hpp"
+#include "Elite/PayloadIdentifier.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+#include "RecursiveLeastSquares.hpp"
+
+using namespace ELITE;
+
+static const double PI = 3.14159265358979323846;
+static const vector6d_t DH_A{0, -0.3, -0.276, 0, 0, 0};
+static const vector6d_t DH_D{0.1215, 0, 0, 0.1105, 0.09, 0.082};
+static const vector6d_t DH_ALPHA{PI / 2, 0, 0, PI / 2, -PI / 2, 0};
+
+// A simulated arm: point masses on links 2~6, the payload on the flange, joint offsets and friction
+struct SimArm {
+    double link_mass[6] = {0, 3.0, 1.5, 0.8, 0.8, 0.3};
+    vector3d_t link_cog[6] = {{0, 0, 0}, {0.15, 0, 0.1}, {0.12, 0, 0.02}, {0, 0.01, 0}, {0, -0.01, 0}, {0, 0, -0.02}};
+    double offset[6] = {0, 0.3, -0.2, 0.1, 0.05, -0.05};
+    double friction[6] = {0, 2.0, 1.5, 0.6, 0.5, 0.4};
+    double payload_mass = 0;
+    vector3d_t payload_cog{};
+
+    // The height of a point fixed in the frame of link k
+    static double height(int k, const vector6d_t& q, const vector3d_t& point) {
+        vector6d_t a{}, d{}, alpha{}, qk{};
+        for (int i = 0; i <= k; i++) {
+            a[i] = DH_A[i];
+            d[i] = DH_D[i];
+            alpha[i] = DH_ALPHA[i];
+            qk[i] = q[i];
+        }
+        Kinematics kin(a, d, alpha);
+        kin.setTcpOffset({point[0], point[1], point[2], 0, 0, 0});
+        return kin.forward(qk)[2];
+    }
+
+    double potential(const vector6d_t& q) const {
+        double v = payload_mass * 9.81 * height(5, q, payload_cog);
+        for (int k = 1; k < 6; k++) {
+            v += link_mass[k] * 9.81 * height(k, q, link_cog[k]);
+        }
+        return v;
+    }
+
+    // Holding torques, the gradient of the potential energy
+    vector6d_t torques(const vector6d_t& q, const vector6d_t& qd) const {
+        vector6d_t tau{};
+        const double h = 1e-6;
+        for (int j = 0; j < 6; j++) {
+            vector6d_t qp = q, qm = q;
+            qp[j] += h;
+            qm[j] -= h;
+            tau[j] = (potential(qp) - potential(qm)) / (2 * h) + offset[j] + friction[j] * ((qd[j] > 0) - (qd[j] < 0));
+        }
+        return tau;
+    }
+};
+
+TEST(PayloadEstimatorTest, recursive_least_squares) {
+    RecursiveLeastSquares<3> rls(1e6);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    for (int i = 0; i < 200; i++) {
+        std::array<double, 3> phi{dist(rng), dist(rng), 1};
+        rls.update(phi, 2 * phi[0] - 3 * phi[1] + 0.5);
+    }
+    EXPECT_NEAR(rls.parameters()[0], 2, 1e-6);
+    EXPECT_NEAR(rls.parameters()[1], -3, 1e-6);
+    EXPECT_NEAR(rls.parameters()[2], 0.5, 1e-6);
+    EXPECT_EQ(rls.count(), 200);
+    EXPECT_LT(rls.variance(0), 1);
+}
+
+TEST(PayloadEstimatorTest, identifies_payload) {
+    Kinematics kin(DH_A, DH_D, DH_ALPHA);
+    PayloadEstimator estimator(kin, {0, 0, -9.81}, 0);
+    EXPECT_FALSE(estimator.updatePayload({}, {}, {}));
+
+    SimArm arm;
+    arm.payload_mass = 0.5;
+    arm.payload_cog = {0, 0, 0.03};
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> joint(-PI, PI);
+    std::uniform_real_distribution<double> speed(-0.5, 0.5);
+    std::normal_distribution<double> noise(0, 0.02);
+    auto frame = [&](vector6d_t& q, vector6d_t& qd, vector6d_t& tau) {
+        for (int i = 0; i < 6; i++) {
+            q[i] = joint(rng);
+            qd[i] = speed(rng);
+        }
+        tau = arm.torques(q, qd);
+        for (double& t : tau) {
+            t += noise(rng);
+        }
+    };
+
+    // Learn the arm with the configured payload
+    estimator.startArmCalibration(arm.payload_mass, arm.payload_cog);
+    vector6d_t q, qd, tau;
+    for (int i = 0; i < 3000; i++) {
+        frame(q, qd, tau);
+        estimator.updateArm(q, qd, tau);
+    }
+    ArmGravityModel model = estimator.getArmModel();
+    ASSERT_TRUE(model.valid);
+    frame(q, qd, tau);
+    vector6d_t predicted = estimator.predict(q, qd);
+    for (int j = 1; j < 6; j++) {
+        EXPECT_NEAR(predicted[j], tau[j], 0.1);
+    }
+
+    // A new tool
+    arm.payload_mass = 2.0;
+    arm.payload_cog = {0.01, -0.02, 0.08};
+    PayloadEstimator restored(kin, {0, 0, -9.81}, 0);
+    restored.setArmModel(model);
+    restored.startPayload();
+    for (int i = 0; i < 1000; i++) {
+        frame(q, qd, tau);
+        ASSERT_TRUE(restored.updatePayload(q, qd, tau));
+    }
+    PayloadEstimate estimate = restored.getEstimate();
+    ASSERT_TRUE(estimate.valid);
+    EXPECT_EQ(estimate.samples, 5000);
+    EXPECT_NEAR(estimate.mass, 2.0, 0.02);
+    EXPECT_NEAR(estimate.cog[0], 0.01, 0.003);
+    EXPECT_NEAR(estimate.cog[1], -0.02, 0.003);
+    EXPECT_NEAR(estimate.cog[2], 0.08, 0.003);
+    EXPECT_LT(estimate.residual_rms, 0.1);
+}
+
+TEST(PayloadEstimatorTest, excitation_returns_to_start) {
+    vector6d_t start{0.1, -1.2, 1.0, -1.4, 1.5, 0};
+    auto points = PayloadIdentifier::excitation(start, 0.6);
+    ASSERT_GT(points.size(), 5);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_DOUBLE_EQ(points.back()[i], start[i]);
+    }
+    for (const auto& point : points) {
+        EXPECT_DOUBLE_EQ(point[0], start[0]);
+        for (int i = 1; i < 6; i++) {
+            EXPECT_LE(std::abs(point[i] - start[i]), 0.6 + 1e-12);
+        }
+    }
+}
+
+// The done callbacks of a PayloadIdentifier
+class DoneRecorder {
+   public:
+    PayloadIdentifier::DoneCallback callback() {
+        return [this](bool success, const PayloadEstimate& estimate) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            results_.emplace_back(success, estimate);
+        };
+    }
+
+    std::vector<std::pair<bool, PayloadEstimate>> results() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return results_;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::vector<std::pair<bool, PayloadEstimate>> results_;
+};
+
+static int countActions(FakeCommandWriter& driver, TrajectoryControlAction action) {
+    int count = 0;
+    for (auto& item : driver.controlActions()) {
+        count += item.action == action;
+    }
+    return count;
+}
+
+TEST(PayloadEstimatorTest, identifier_calibrates_and_identifies) {
+    Kinematics kin(DH_A, DH_D, DH_ALPHA);
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    PayloadIdentifier identifier(frames, driver, kin);
+    DoneRecorder done;
+    identifier.setDoneCallback(done.callback());
+
+    SimArm arm;
+    arm.payload_mass = 0.5;
+    arm.payload_cog = {0, 0, 0.03};
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> joint(-PI, PI);
+    std::uniform_real_distribution<double> speed(-0.5, 0.5);
+    auto feed = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            vector6d_t q, qd;
+            for (int j = 0; j < 6; j++) {
+                q[j] = joint(rng);
+                qd[j] = speed(rng);
+            }
+            frames.set("actual_joint_positions", q);
+            frames.set("actual_joint_speeds", qd);
+            frames.set("actual_joint_torques", arm.torques(q, qd));
+            frames.frame();
+        }
+    };
+
+    // The arm model is needed first, the calibration needs the configured payload
+    EXPECT_FALSE(identifier.identify());
+    vector6d_t start{0.1, -1.2, 1.0, -1.4, 1.5, 0};
+    frames.set("actual_joint_positions", start);
+    EXPECT_FALSE(identifier.calibrateArm());
+    frames.set("payload_mass", arm.payload_mass);
+    frames.set("payload_cog", arm.payload_cog);
+
+    PayloadIdentificationConfig config;
+    config.point_time = 1.5;
+    config.timeout_ms = 20;
+    ASSERT_TRUE(identifier.calibrateArm(config));
+    EXPECT_TRUE(identifier.isRunning());
+    EXPECT_FALSE(identifier.calibrateArm(config));
+    auto actions = driver.controlActions();
+    ASSERT_GE(actions.size(), 1);
+    EXPECT_EQ(actions[0].action, TrajectoryControlAction::START);
+    auto excitation = PayloadIdentifier::excitation(start, config.amplitude);
+    EXPECT_EQ(actions[0].point_number, (int)excitation.size());
+    auto points = driver.trajectoryPoints();
+    ASSERT_EQ(points.size(), excitation.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i].positions, excitation[i]);
+        EXPECT_FLOAT_EQ(points[i].time, 1.5f);
+        EXPECT_FALSE(points[i].cartesian);
+    }
+    feed(3000);
+    driver.finishTrajectory(TrajectoryMotionResult::SUCCESS);
+    EXPECT_FALSE(identifier.isRunning());
+    ASSERT_TRUE(identifier.getArmModel().valid);
+    ASSERT_EQ(done.results().size(), 1);
+    EXPECT_TRUE(done.results()[0].first);
+    EXPECT_DOUBLE_EQ(done.results()[0].second.mass, 0.5);
+    // The calibration does not set the payload
+    EXPECT_TRUE(driver.payloads().empty());
+
+    arm.payload_mass = 2.0;
+    arm.payload_cog = {0.01, -0.02, 0.08};
+    frames.set("actual_joint_positions", start);
+    ASSERT_TRUE(identifier.identify(config));
+    feed(1000);
+    EXPECT_NEAR(identifier.getEstimate().mass, 2.0, 0.02);
+    driver.finishTrajectory(TrajectoryMotionResult::SUCCESS);
+    auto results = done.results();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_TRUE(results[1].first);
+    EXPECT_NEAR(results[1].second.mass, 2.0, 0.02);
+    EXPECT_NEAR(results[1].second.cog[2], 0.08, 0.003);
+    // The identified payload is set on the robot
+    auto payloads = driver.payloads();
+    ASSERT_EQ(payloads.size(), 1);
+    EXPECT_DOUBLE_EQ(payloads[0].first, results[1].second.mass);
+}
+
+TEST(PayloadEstimatorTest, identifier_keeps_trajectory_alive_off_frame_thread) {
+    Kinematics kin(DH_A, DH_D, DH_ALPHA);
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    DoneRecorder done;
+    vector6d_t start{0.1, -1.2, 1.0, -1.4, 1.5, 0};
+    frames.set("actual_joint_positions", start);
+    frames.set("payload_mass", 0.0);
+    frames.set("payload_cog", vector3d_t{});
+    {
+        PayloadIdentifier identifier(frames, driver, kin);
+        identifier.setDoneCallback(done.callback());
+        // No keep-alive while idle
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        EXPECT_EQ(countActions(driver, TrajectoryControlAction::NOOP), 0);
+
+        PayloadIdentificationConfig config;
+        config.timeout_ms = 20;
+        ASSERT_TRUE(identifier.calibrateArm(config));
+        // The frames do not write to the driver
+        int before = (int)driver.controlActions().size();
+        for (int i = 0; i < 50; i++) {
+            frames.frame();
+        }
+        EXPECT_LE((int)driver.controlActions().size(), before + 1);
+        // A NOOP every 10 ms from the identifier's thread
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        int noops = countActions(driver, TrajectoryControlAction::NOOP);
+        EXPECT_GE(noops, 4);
+        EXPECT_LE(noops, 15);
+        for (auto& item : driver.controlActions()) {
+            EXPECT_EQ(item.timeout_ms, 20);
+        }
+
+        // Canceled: the result ends the run and the keep-alive
+        identifier.cancel();
+        EXPECT_EQ(countActions(driver, TrajectoryControlAction::CANCEL), 1);
+        driver.finishTrajectory(TrajectoryMotionResult::CANCELED);
+        EXPECT_FALSE(identifier.isRunning());
+        ASSERT_EQ(done.results().size(), 1);
+        EXPECT_FALSE(done.results()[0].first);
+        // The partly learned arm model is dropped
+        EXPECT_FALSE(identifier.getArmModel().valid);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        noops = countActions(driver, TrajectoryControlAction::NOOP);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(countActions(driver, TrajectoryControlAction::NOOP), noops);
+
+        // A trajectory which can't be started is not a run
+        driver.connected = false;
+        EXPECT_FALSE(identifier.calibrateArm(config));
+        EXPECT_FALSE(identifier.isRunning());
+        EXPECT_EQ(frames.callbackCount(), 1);
+    }
+    // The result callback is unset on destruction
+    EXPECT_FALSE(driver.getTrajectoryResultCallback());
+    EXPECT_EQ(frames.callbackCount(), 0);
+    EXPECT_TRUE(driver.payloads().empty());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -59,6 +59,57 @@ TEST(PrimaryPortTest, get_package) {
     primary->disconnect();
 }
 
+// A local stand-in of the robot primary port. It sends a package head without the body, so the receive thread waits for
+// the body, and reads the scripts.
+TEST(PrimaryPortTest, send_script_not_blocked_by_receive) {
+    constexpr int PORT = 30101;
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), PORT));
+    boost::asio::ip::tcp::socket robot(io);
+
+    std::unique_ptr<PrimaryPort> primary = std::make_unique<PrimaryPort>();
+    // Not connected
+    auto not_sent = primary->sendScriptAsync("def test():\nend", 100);
+    ASSERT_EQ(not_sent.wait_for(0s), std::future_status::ready);
+    EXPECT_FALSE(not_sent.get());
+
+    std::thread accept_thread([&]() { acceptor.accept(robot); });
+    ASSERT_TRUE(primary->connect("127.0.0.1", PORT));
+    accept_thread.join();
+
+    // Head of a 1000 bytes package
+    uint8_t head[] = {0, 0, 0x03, 0xE8, 16};
+    boost::asio::write(robot, boost::asio::buffer(head));
+    std::this_thread::sleep_for(50ms);
+
+    std::string script = "def test():\n  textmsg(\"hello\")\nend";
+    auto begin = steady_clock::now();
+    EXPECT_TRUE(primary->sendScript(script));
+    EXPECT_LT(steady_clock::now() - begin, 200ms);
+
+    std::string received(script.size() + 1, 0);
+    boost::asio::read(robot, boost::asio::buffer(&received[0], received.size()));
+    EXPECT_EQ(received, script + "\n");
+
+    // The scripts are written in order
+    auto first = primary->sendScriptAsync("first");
+    auto second = primary->sendScriptAsync("second");
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+    received.assign(13, 0);
+    boost::asio::read(robot, boost::asio::buffer(&received[0], received.size()));
+    EXPECT_EQ(received, "first\nsecond\n");
+
+    ScriptSendStats stats = primary->getScriptSendStats();
+    EXPECT_EQ(stats.sent, 3);
+    EXPECT_EQ(stats.failed, 1);
+    EXPECT_EQ(stats.timeout, 0);
+    EXPECT_LE(stats.min_latency, stats.mean_latency);
+    EXPECT_LE(stats.mean_latency, stats.max_latency);
+
+    primary->disconnect();
+    EXPECT_FALSE(primary->sendScript(script));
+}
 
 int main(int argc, char** argv) {
     setLogLevel(LogLevel::ELI_DEBUG);
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "Elite/Kinematics.hpp"
+#include "Elite/ReachabilityMap.hpp"
+
+using namespace ELITE;
+
+static const double PI = 3.14159265358979323846;
+
+static Kinematics makeKinematics() {
+    // CS63 like DH parameters
+    return Kinematics({0, -0.3, -0.276, 0, 0, 0}, {0.1215, 0, 0, 0.1105, 0.09, 0.082}, {PI / 2, 0, 0, PI / 2, -PI / 2, 0});
+}
+
+static ReachabilityMap& sharedMap() {
+    static ReachabilityMap map;
+    if (!map.isValid()) {
+        ReachabilityConfig config;
+        config.resolution = 0.05;
+        config.wrist_samples = 12;
+        EXPECT_TRUE(map.build(makeKinematics(), config));
+    }
+    return map;
+}
+
+TEST(ReachabilityMapTest, forward_kinematics_is_reachable) {
+    ReachabilityMap& map = sharedMap();
+    ASSERT_TRUE(map.isValid());
+    Kinematics kin = makeKinematics();
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> joint(-PI, PI);
+    int with_direction = 0;
+    const int count = 500;
+    for (int i = 0; i < count; i++) {
+        vector6d_t q{joint(rng), joint(rng), joint(rng), joint(rng), joint(rng), joint(rng)};
+        vector6d_t pose = kin.forward(q);
+        EXPECT_TRUE(map.reachable(vector3d_t{pose[0], pose[1], pose[2]}));
+        EXPECT_GT(map.directionCount(vector3d_t{pose[0], pose[1], pose[2]}), 0);
+        with_direction += map.reachable(pose);
+    }
+    // The wrist is sampled, a few poses fall between the samples at the edge of a direction bin
+    EXPECT_GT(with_direction, count * 95 / 100);
+}
+
+TEST(ReachabilityMapTest, out_of_reach) {
+    ReachabilityMap& map = sharedMap();
+    EXPECT_FALSE(map.reachable(vector3d_t{1.5, 0, 0.1}));
+    EXPECT_FALSE(map.reachable(vector3d_t{0, 0, 5}));
+    EXPECT_FALSE(map.reachable(vector3d_t{0, 0, -5}));
+    EXPECT_DOUBLE_EQ(map.manipulability(vector3d_t{1.5, 0, 0.1}), 0);
+    // Rotationally symmetric
+    EXPECT_DOUBLE_EQ(map.manipulability(vector3d_t{0.5, 0, 0.2}), map.manipulability(vector3d_t{0, -0.5, 0.2}));
+    EXPECT_GT(map.manipulability(vector3d_t{0.5, 0, 0.2}), 0);
+}
+
+TEST(ReachabilityMapTest, save_and_map) {
+    ReachabilityMap& map = sharedMap();
+    const std::string path = "reachability_map_test.bin";
+    ASSERT_TRUE(map.save(path));
+    ReachabilityMap mapped;
+    ASSERT_TRUE(mapped.load(path));
+    EXPECT_DOUBLE_EQ(mapped.resolution(), map.resolution());
+    EXPECT_EQ(mapped.sampleCount(), map.sampleCount());
+    for (double x = -1; x <= 1; x += 0.05) {
+        for (double z = -1; z <= 1; z += 0.05) {
+            vector3d_t p{x, 0.1, z};
+            EXPECT_EQ(mapped.reachable(p), map.reachable(p));
+            EXPECT_EQ(mapped.directionCount(p), map.directionCount(p));
+            EXPECT_DOUBLE_EQ(mapped.manipulability(p), map.manipulability(p));
+        }
+    }
+
+    // Not a map
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("not a map", file);
+        std::fclose(file);
+    }
+    ReachabilityMap bad;
+    EXPECT_FALSE(bad.load(path));
+    EXPECT_FALSE(bad.isValid());
+    std::remove(path.c_str());
+    EXPECT_FALSE(bad.load(path));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/EndianUtils.hpp"
+#include "EliteException.hpp"
+#include "Rtsi/RtsiAggregator.hpp"
+
+using namespace ELITE;
+using boost::asio::ip::tcp;
+
+static const std::vector<std::string> RECIPE = {"timestamp", "robot_mode", "actual_joint_positions"};
+
+/**
+ * A controller which accepts any number of RTSI connections and streams a data package every 2 ms on each of them. The robot
+ * mode of the n-th connection is 100 + n.
+ */
+class FakeRtsiServer {
+   public:
+    explicit FakeRtsiServer(const std::string& types = "DOUBLE,INT32,VECTOR6D", bool accept_version = true)
+        : acceptor_(io_context_, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+          types_(types),
+          accept_version_(accept_version) {
+        port_ = acceptor_.local_endpoint().port();
+        accept_thread_ = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~FakeRtsiServer() {
+        running_ = false;
+        // Wake up the blocking accept
+        boost::system::error_code ec;
+        tcp::socket waker(io_context_);
+        waker.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port_), ec);
+        accept_thread_.join();
+        for (auto& session : sessions_) {
+            session.join();
+        }
+    }
+
+    int port() const { return port_; }
+
+    // Close all connections
+    void dropAll() { drop_ = true; }
+
+   private:
+    boost::asio::io_context io_context_;
+    tcp::acceptor acceptor_;
+    std::string types_;
+    bool accept_version_;
+    int port_;
+    std::thread accept_thread_;
+    std::vector<std::thread> sessions_;
+    std::atomic<bool> running_{true};
+    std::atomic<bool> drop_{false};
+
+    void acceptLoop() {
+        for (int index = 0;; index++) {
+            auto socket = std::make_shared<tcp::socket>(io_context_);
+            boost::system::error_code ec;
+            acceptor_.accept(*socket, ec);
+            if (ec || !running_) {
+                return;
+            }
+            sessions_.emplace_back([this, socket, index]() { serve(*socket, index); });
+        }
+    }
+
+    static void reply(tcp::socket& socket, uint8_t type, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> package = EndianUtils::pack((uint16_t)(3 + payload.size()));
+        package.push_back(type);
+        package.insert(package.end(), payload.begin(), payload.end());
+        boost::system::error_code ec;
+        boost::asio::write(socket, boost::asio::buffer(package), ec);
+    }
+
+    void serve(tcp::socket& socket, int index) {
+        boost::system::error_code ec;
+        bool streaming = false;
+        while (running_ && !streaming) {
+            uint8_t header[3];
+            if (!boost::asio::read(socket, boost::asio::buffer(header), ec)) {
+                return;
+            }
+            std::vector<uint8_t> body(((header[0] << 8) | header[1]) - 3);
+            boost::asio::read(socket, boost::asio::buffer(body), ec);
+            if (ec) {
+                return;
+            }
+            switch (header[2]) {
+                case 'V':
+                    // A text message first, it must be skipped
+                    reply(socket, 'M', {'h', 'i'});
+                    reply(socket, 'V', {accept_version_});
+                    break;
+                case 'v': {
+                    std::vector<uint8_t> version;
+                    for (uint32_t value : {2u, 14u, 5u, 1234u}) {
+                        auto bytes = EndianUtils::pack(value);
+                        version.insert(version.end(), bytes.begin(), bytes.end());
+                    }
+                    reply(socket, 'v', version);
+                    break;
+                }
+                case 'O': {
+                    std::vector<uint8_t> payload = {1};
+                    payload.insert(payload.end(), types_.begin(), types_.end());
+                    reply(socket, 'O', payload);
+                    break;
+                }
+                case 'S':
+                    reply(socket, 'S', {1});
+                    streaming = true;
+                    break;
+            }
+        }
+        for (int frame = 0; running_ && !drop_; frame++) {
+            std::vector<uint8_t> payload = {1};
+            auto append = [&](const std::vector<uint8_t>& bytes) { payload.insert(payload.end(), bytes.begin(), bytes.end()); };
+            append(EndianUtils::pack(frame * 0.002));
+            append(EndianUtils::pack((int32_t)(100 + index)));
+            for (int i = 0; i < 6; i++) {
+                append(EndianUtils::pack((double)frame));
+            }
+            reply(socket, 'U', payload);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        socket.close(ec);
+    }
+};
+
+static bool waitFor(const std::function<bool()>& condition, int timeout_ms = 3000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+TEST(RtsiAggregatorTest, many_robots_on_two_threads) {
+    // Declared first, the callback uses them until the aggregator is destroyed
+    std::mutex mutex;
+    std::map<int, uint64_t> callback_frames;
+    std::map<int, std::thread::id> callback_threads;
+
+    FakeRtsiServer server;
+    RtsiAggregator aggregator(RECIPE, 500, 2, 4096);
+    int mode_slot = aggregator.getSlot("robot_mode");
+    int joint_slot = aggregator.getSlot("actual_joint_positions");
+    EXPECT_EQ(aggregator.getSlot("not_in_recipe"), -1);
+
+    aggregator.addFrameCallback([&](const RtsiSnapshot& frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        callback_frames[frame.robot]++;
+        callback_threads[frame.robot] = std::this_thread::get_id();
+    });
+
+    std::vector<int> robots;
+    for (int i = 0; i < 6; i++) {
+        int robot = aggregator.addRobot("127.0.0.1", server.port());
+        ASSERT_GE(robot, 0);
+        robots.push_back(robot);
+    }
+    EXPECT_EQ(aggregator.getRobots(), robots);
+    EXPECT_EQ(aggregator.getControllerVersion(robots[0]).toString(), VersionInfo(2, 14, 5, 1234).toString());
+
+    // Every robot has its own snapshot
+    for (size_t i = 0; i < robots.size(); i++) {
+        RtsiSnapshot snapshot;
+        ASSERT_TRUE(waitFor([&]() { return aggregator.getSnapshot(robots[i], snapshot) && snapshot.sequence > 10; }));
+        EXPECT_TRUE(aggregator.isConnected(robots[i]));
+        EXPECT_EQ(snapshot.robot, robots[i]);
+        int32_t mode = 0;
+        ASSERT_TRUE(snapshot.getValue(mode_slot, mode));
+        EXPECT_EQ(mode, 100 + (int)i);
+        vector6d_t joints;
+        ASSERT_TRUE(snapshot.getValue(joint_slot, joints));
+        EXPECT_GT(joints[0], 0);
+        double wrong_type = 0;
+        EXPECT_FALSE(snapshot.getValue(mode_slot, wrong_type));
+    }
+
+    // The queue delivers the frames of each robot in order
+    std::map<int, uint64_t> last_sequence;
+    RtsiSnapshot frame;
+    ASSERT_TRUE(waitFor([&]() {
+        while (aggregator.pollFrame(frame)) {
+            EXPECT_GT(frame.sequence, last_sequence[frame.robot]);
+            last_sequence[frame.robot] = frame.sequence;
+        }
+        return last_sequence.size() == robots.size();
+    }));
+    EXPECT_EQ(aggregator.droppedCount(), 0);
+
+    // Two threads serve the six robots, three each
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::thread::id, int> robots_per_thread;
+    for (auto& item : callback_threads) {
+        robots_per_thread[item.second]++;
+        EXPECT_GT(callback_frames[item.first], 0);
+    }
+    ASSERT_EQ(robots_per_thread.size(), 2);
+    for (auto& item : robots_per_thread) {
+        EXPECT_EQ(item.second, 3);
+    }
+}
+
+TEST(RtsiAggregatorTest, setup_failures) {
+    RtsiAggregator aggregator(RECIPE, 500);
+    {
+        // Nobody listens
+        boost::asio::io_context io_context;
+        tcp::acceptor acceptor(io_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        int port = acceptor.local_endpoint().port();
+        acceptor.close();
+        EXPECT_EQ(aggregator.addRobot("127.0.0.1", port, 1000), -1);
+    }
+    {
+        FakeRtsiServer server("DOUBLE,INT32,VECTOR6D", false);
+        EXPECT_EQ(aggregator.addRobot("127.0.0.1", server.port(), 1000), -1);
+    }
+    {
+        FakeRtsiServer server("DOUBLE,NOT_FOUND,VECTOR6D");
+        EXPECT_EQ(aggregator.addRobot("127.0.0.1", server.port(), 1000), -1);
+    }
+    EXPECT_EQ(aggregator.addRobot("not an ip"), -1);
+    EXPECT_TRUE(aggregator.getRobots().empty());
+    EXPECT_THROW(RtsiAggregator({}, 500), EliteException);
+}
+
+TEST(RtsiAggregatorTest, lost_and_removed_robot) {
+    FakeRtsiServer server;
+    RtsiAggregator aggregator(RECIPE, 500, 1, 0);
+    int robot = aggregator.addRobot("127.0.0.1", server.port());
+    ASSERT_GE(robot, 0);
+    RtsiSnapshot snapshot;
+    ASSERT_TRUE(waitFor([&]() { return aggregator.getSnapshot(robot, snapshot); }));
+    // The queue is disabled
+    EXPECT_FALSE(aggregator.pollFrame(snapshot));
+
+    server.dropAll();
+    ASSERT_TRUE(waitFor([&]() { return !aggregator.isConnected(robot); }));
+    // The last snapshot is kept
+    EXPECT_TRUE(aggregator.getSnapshot(robot, snapshot));
+    EXPECT_EQ(aggregator.getRobots().size(), 1);
+
+    aggregator.removeRobot(robot);
+    EXPECT_FALSE(aggregator.getSnapshot(robot, snapshot));
+    EXPECT_TRUE(aggregator.getRobots().empty());
+}
+
+TEST(RtsiAggregatorTest, remove_frame_callback) {
+    std::atomic<int> count{0};
+    FakeRtsiServer server;
+    RtsiAggregator aggregator(RECIPE, 500, 2);
+    int handle = aggregator.addFrameCallback([&](const RtsiSnapshot&) {
+        if (++count == 1) {
+            throw std::runtime_error("callback exception");
+        }
+    });
+    ASSERT_GE(aggregator.addRobot("127.0.0.1", server.port()), 0);
+    ASSERT_GE(aggregator.addRobot("127.0.0.1", server.port()), 0);
+    // A throwing callback does not stop the loop
+    ASSERT_TRUE(waitFor([&]() { return count > 20; }));
+    aggregator.removeFrameCallback(handle);
+    int after_remove = count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(count, after_remove);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "FakeRtsiController.hpp"
+#include "Rtsi/RtsiClientInterface.hpp"
+
+using namespace ELITE;
+
+static const int SENDS = 50000;
+
+TEST(RtsiClientTest, concurrent_send) {
+    // A torn package shows up as an int register which doesn't match the double register of the same package
+    std::atomic<int> mismatches{0};
+    FakeRtsiController controller([&](const FakeRtsiController::Values& inputs, FakeRtsiController::Values&) {
+        auto int_iter = inputs.find("input_int_register0");
+        auto double_iter = inputs.find("input_double_register0");
+        if (int_iter != inputs.end() && double_iter != inputs.end() && int_iter->second[0] != double_iter->second[0]) {
+            mismatches++;
+        }
+    });
+    if (!controller.listening()) {
+        GTEST_SKIP() << "port 30004 is in use";
+    }
+    RtsiClientInterface client;
+    client.connect("127.0.0.1");
+    ASSERT_TRUE(client.negotiateProtocolVersion());
+    const std::vector<std::string> inputs = {"input_int_register0", "input_double_register0"};
+    ASSERT_TRUE(client.setupOutputRecipe({"timestamp"}, 500));
+    // Every thread sends its own recipe, the controller takes them for the same input recipe
+    std::vector<RtsiRecipeSharedPtr> recipes;
+    for (int i = 0; i < 4; i++) {
+        recipes.push_back(client.setupInputRecipe(inputs));
+        ASSERT_TRUE(recipes.back());
+        recipes.back()->setValue("input_int_register0", (int32_t)(i + 1));
+        recipes.back()->setValue("input_double_register0", (double)(i + 1));
+    }
+    ASSERT_TRUE(client.start());
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> senders;
+    for (auto& recipe : recipes) {
+        senders.emplace_back([&client, &failures, recipe]() {
+            for (int i = 0; i < SENDS; i++) {
+                if (client.trySend(recipe) != EliteException::Code::SUCCESS) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    EXPECT_EQ(failures, 0);
+
+    // Every package arrives on its own, none is merged into another or lost
+    const uint64_t sent = recipes.size() * SENDS;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (controller.inputPackages() < sent && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(controller.inputPackages(), sent);
+    EXPECT_EQ(mismatches, 0);
+    client.disconnect();
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "FakeFrameSource.hpp"
+#include "Rtsi/RtsiIOEdge.hpp"
+#include "Rtsi/RtsiIOEventEngine.hpp"
+#include "SpscQueue.hpp"
+
+using namespace ELITE;
+
+TEST(RtsiIOEventTest, bit_edges) {
+    std::vector<std::pair<int, bool>> edges;
+    auto emit = [&](int index, bool rising) { edges.push_back({index, rising}); };
+
+    // Bit 0 rising, bit 3 falling, bit 40 rising
+    uint64_t prev = 0x8;
+    uint64_t curr = 0x1 | (1ULL << 40);
+    IO_EDGE::forEachEdge(prev, curr, ~0ULL, emit);
+    ASSERT_EQ(edges.size(), 3);
+    EXPECT_EQ(edges[0], std::make_pair(0, true));
+    EXPECT_EQ(edges[1], std::make_pair(3, false));
+    EXPECT_EQ(edges[2], std::make_pair(40, true));
+
+    // Masked bits are ignored
+    edges.clear();
+    IO_EDGE::forEachEdge(prev, curr, 0x1, emit);
+    ASSERT_EQ(edges.size(), 1);
+    EXPECT_EQ(edges[0], std::make_pair(0, true));
+
+    // No change
+    edges.clear();
+    IO_EDGE::forEachEdge(curr, curr, ~0ULL, emit);
+    EXPECT_TRUE(edges.empty());
+}
+
+TEST(RtsiIOEventTest, hysteresis) {
+    IO_EDGE::HysteresisTrigger trigger(5.0, 1.0);
+    // First sample only initializes
+    EXPECT_EQ(trigger.update(4.0), 0);
+    // Inside the band
+    EXPECT_EQ(trigger.update(5.4), 0);
+    EXPECT_EQ(trigger.update(5.6), 1);
+    // Noise around the threshold does not toggle
+    EXPECT_EQ(trigger.update(4.8), 0);
+    EXPECT_EQ(trigger.update(5.2), 0);
+    EXPECT_EQ(trigger.update(4.4), -1);
+    EXPECT_EQ(trigger.update(4.0), 0);
+
+    IO_EDGE::HysteresisTrigger high_start(5.0, 1.0);
+    EXPECT_EQ(high_start.update(8.0), 0);
+    EXPECT_TRUE(high_start.state());
+    EXPECT_EQ(high_start.update(1.0), -1);
+}
+
+TEST(RtsiIOEventTest, spsc_queue) {
+    SpscQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(8));
+    int value = -1;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 0);
+
+    // Producer and consumer in different threads
+    SpscQueue<int> cross(64);
+    constexpr int COUNT = 10000;
+    std::thread producer([&]() {
+        for (int i = 0; i < COUNT; i++) {
+            while (!cross.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expect = 0;
+    while (expect < COUNT) {
+        if (cross.pop(value)) {
+            ASSERT_EQ(value, expect);
+            expect++;
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(cross.pop(value));
+}
+
+static std::vector<IOEvent> pollAll(RtsiIOEventEngine& engine) {
+    std::vector<IOEvent> events;
+    IOEvent event;
+    while (engine.pollEvent(event)) {
+        events.push_back(event);
+    }
+    return events;
+}
+
+TEST(RtsiIOEventTest, engine_digital_edges) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi);
+    EXPECT_EQ(rtsi.callbackCount(), 1);
+    EXPECT_TRUE(engine.watchDigital(IOEventSource::DIGITAL_INPUT, 0x5));
+    EXPECT_FALSE(engine.watchDigital(IOEventSource::ANALOG_INPUT, 0x1));
+
+    rtsi.set("timestamp", 1.0);
+    rtsi.set("actual_digital_input_bits", (uint32_t)0x4);
+    // The first frame is the reference, bit 2 already high is not an edge
+    rtsi.frame();
+    EXPECT_TRUE(pollAll(engine).empty());
+
+    // Bit 0 rises, bit 1 is not watched, bit 2 falls
+    rtsi.set("timestamp", 1.002);
+    rtsi.set("actual_digital_input_bits", (uint32_t)0x3);
+    rtsi.frame();
+    auto events = pollAll(engine);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].source, IOEventSource::DIGITAL_INPUT);
+    EXPECT_EQ(events[0].index, 0);
+    EXPECT_TRUE(events[0].rising);
+    EXPECT_EQ(events[0].value, 1);
+    EXPECT_DOUBLE_EQ(events[0].timestamp, 1.002);
+    EXPECT_EQ(events[1].index, 2);
+    EXPECT_FALSE(events[1].rising);
+    EXPECT_EQ(events[1].value, 0);
+
+    // Level does not repeat
+    rtsi.frame();
+    EXPECT_TRUE(pollAll(engine).empty());
+
+    // Not watched: no event, and the change while unwatched is not reported when watched again
+    engine.watchDigital(IOEventSource::DIGITAL_INPUT, 0);
+    rtsi.set("actual_digital_input_bits", (uint32_t)0x0);
+    rtsi.frame();
+    engine.watchDigital(IOEventSource::DIGITAL_INPUT, 0x5);
+    rtsi.frame();
+    EXPECT_TRUE(pollAll(engine).empty());
+}
+
+TEST(RtsiIOEventTest, engine_bool_registers_64_bits) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi);
+    engine.watchDigital(IOEventSource::IN_BOOL_REGISTER, ~0ULL);
+    rtsi.set("input_bit_registers0_to_31", (uint32_t)0);
+    rtsi.set("input_bit_registers32_to_63", (uint32_t)0);
+    rtsi.frame();
+    rtsi.set("input_bit_registers32_to_63", (uint32_t)0x2);
+    rtsi.frame();
+    auto events = pollAll(engine);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].source, IOEventSource::IN_BOOL_REGISTER);
+    EXPECT_EQ(events[0].index, 33);
+    EXPECT_TRUE(events[0].rising);
+    // Without "timestamp" in the recipe
+    EXPECT_EQ(events[0].timestamp, 0);
+
+    // A source not in the recipe is skipped
+    engine.watchDigital(IOEventSource::DIGITAL_OUTPUT, ~0ULL);
+    rtsi.frame();
+    EXPECT_TRUE(pollAll(engine).empty());
+}
+
+TEST(RtsiIOEventTest, engine_analog_hysteresis) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi);
+    EXPECT_FALSE(engine.watchAnalog(IOEventSource::ANALOG_INPUT, 2, 5.0, 1.0));
+    EXPECT_FALSE(engine.watchAnalog(IOEventSource::TOOL_ANALOG_INPUT, 1, 5.0, 1.0));
+    EXPECT_FALSE(engine.watchAnalog(IOEventSource::ANALOG_INPUT, 1, 5.0, -1.0));
+    ASSERT_TRUE(engine.watchAnalog(IOEventSource::ANALOG_INPUT, 1, 5.0, 1.0));
+
+    std::vector<std::pair<bool, double>> crossings;
+    for (double value : {4.0, 5.4, 5.6, 5.8, 4.8, 5.2, 4.4, 4.0}) {
+        rtsi.set("standard_analog_input1", value);
+        rtsi.frame();
+        for (auto& event : pollAll(engine)) {
+            EXPECT_EQ(event.source, IOEventSource::ANALOG_INPUT);
+            EXPECT_EQ(event.index, 1);
+            crossings.push_back({event.rising, event.value});
+        }
+    }
+    ASSERT_EQ(crossings.size(), 2);
+    EXPECT_EQ(crossings[0], std::make_pair(true, 5.6));
+    EXPECT_EQ(crossings[1], std::make_pair(false, 4.4));
+
+    engine.unwatchAnalog(IOEventSource::ANALOG_INPUT, 1);
+    rtsi.set("standard_analog_input1", 9.0);
+    rtsi.frame();
+    EXPECT_TRUE(pollAll(engine).empty());
+}
+
+TEST(RtsiIOEventTest, engine_listeners_and_full_queue) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi, 2);
+    engine.watchDigital(IOEventSource::DIGITAL_OUTPUT, 0xff);
+    std::vector<int> heard;
+    int handle = engine.addListener([&](const IOEvent& event) { heard.push_back(event.index); });
+
+    rtsi.set("actual_digital_output_bits", (uint32_t)0);
+    rtsi.frame();
+    // 4 edges in one frame, the queue keeps 2, the listener hears all of them
+    rtsi.set("actual_digital_output_bits", (uint32_t)0xf);
+    rtsi.frame();
+    EXPECT_EQ(heard, std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(pollAll(engine).size(), 2);
+    EXPECT_EQ(engine.droppedCount(), 2);
+
+    engine.removeListener(handle);
+    rtsi.set("actual_digital_output_bits", (uint32_t)0);
+    rtsi.frame();
+    EXPECT_EQ(heard.size(), 4);
+    EXPECT_EQ(pollAll(engine).size(), 2);
+}
+
+TEST(RtsiIOEventTest, engine_listener_changes_watches) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi);
+    ASSERT_TRUE(engine.watchAnalog(IOEventSource::ANALOG_INPUT, 0, 5.0, 1.0));
+    // On the first crossing of input 0, watch input 1 and stop watching input 0
+    std::vector<int> heard;
+    int handle = -1;
+    handle = engine.addListener([&](const IOEvent& event) {
+        heard.push_back(event.index);
+        if (event.index == 0) {
+            engine.unwatchAnalog(IOEventSource::ANALOG_INPUT, 0);
+            engine.watchAnalog(IOEventSource::ANALOG_INPUT, 1, 5.0, 1.0);
+        } else {
+            engine.removeListener(handle);
+        }
+    });
+    rtsi.set("standard_analog_input0", 0.0);
+    rtsi.set("standard_analog_input1", 0.0);
+    rtsi.frame();
+    rtsi.set("standard_analog_input0", 9.0);
+    rtsi.frame();
+    // Input 1 starts from this frame
+    rtsi.frame();
+    rtsi.set("standard_analog_input0", 0.0);
+    rtsi.set("standard_analog_input1", 9.0);
+    rtsi.frame();
+    rtsi.set("standard_analog_input1", 0.0);
+    rtsi.frame();
+    EXPECT_EQ(heard, std::vector<int>({0, 1}));
+    EXPECT_EQ(pollAll(engine).size(), 3);
+}
+
+TEST(RtsiIOEventTest, engine_remove_listener_waits) {
+    FakeFrameSource rtsi;
+    RtsiIOEventEngine engine(rtsi);
+    engine.watchDigital(IOEventSource::DIGITAL_INPUT, 0x1);
+    std::atomic<bool> entered{false};
+    std::atomic<bool> running{false};
+    int handle = engine.addListener([&](const IOEvent&) {
+        running = true;
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        running = false;
+    });
+    rtsi.set("actual_digital_input_bits", (uint32_t)0);
+    rtsi.frame();
+    rtsi.set("actual_digital_input_bits", (uint32_t)1);
+    std::thread frames([&]() { rtsi.frame(); });
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    // The listener captures state of this scope, it must have returned when removeListener() does
+    engine.removeListener(handle);
+    EXPECT_FALSE(running);
+    frames.join();
+}
+
+TEST(RtsiIOEventTest, engine_unregisters_on_destruction) {
+    FakeFrameSource rtsi;
+    {
+        RtsiIOEventEngine engine(rtsi);
+        EXPECT_EQ(rtsi.callbackCount(), 1);
+    }
+    EXPECT_EQ(rtsi.callbackCount(), 0);
+    rtsi.frame();
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
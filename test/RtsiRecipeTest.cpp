@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Common/EndianUtils.hpp"
+#include "Rtsi/RtsiRecipeInternal.hpp"
+
+using namespace ELITE;
+
+static std::vector<uint8_t> typePackage(int id, const std::string& types) {
+    // 2 bytes length + 1 byte type + 1 byte recipe id + types
+    std::vector<uint8_t> package = {0, 0, 'I', (uint8_t)id};
+    package.insert(package.end(), types.begin(), types.end());
+    return package;
+}
+
+static std::vector<uint8_t> dataPackage(int id, int32_t reg0, double reg1, int32_t reg2, bool bit) {
+    std::vector<uint8_t> package = {0, 0, 'U', (uint8_t)id};
+    auto append = [&](const std::vector<uint8_t>& bytes) { package.insert(package.end(), bytes.begin(), bytes.end()); };
+    append(EndianUtils::pack(reg0));
+    append(EndianUtils::pack(reg1));
+    append(EndianUtils::pack(reg2));
+    package.push_back(bit);
+    return package;
+}
+
+class RtsiRecipeTest : public ::testing::Test {
+   protected:
+    std::vector<std::string> names_ = {"output_int_register0", "output_double_register0", "output_int_register1",
+                                       "output_bit_register64"};
+    RtsiRecipeInternal recipe_{names_};
+
+    void SetUp() override {
+        auto package = typePackage(3, "INT32,DOUBLE,INT32,BOOL");
+        recipe_.parserTypePackage(package.size(), package);
+    }
+};
+
+TEST_F(RtsiRecipeTest, slot_lookup) {
+    EXPECT_EQ(recipe_.getSlot("output_int_register0"), 0);
+    EXPECT_EQ(recipe_.getSlot("output_int_register1"), 2);
+    EXPECT_EQ(recipe_.getSlot("output_int_register2"), -1);
+}
+
+TEST_F(RtsiRecipeTest, slot_values_follow_data_package) {
+    auto package = dataPackage(3, -7, 1.5, 42, true);
+    ASSERT_TRUE(recipe_.parserDataPackage(package.size(), package));
+
+    int slots[] = {recipe_.getSlot("output_int_register1"), recipe_.getSlot("output_int_register0")};
+    int32_t ints[2] = {0, 0};
+    ASSERT_TRUE(recipe_.getSlotValues(slots, 2, ints));
+    EXPECT_EQ(ints[0], 42);
+    EXPECT_EQ(ints[1], -7);
+
+    int double_slot = recipe_.getSlot("output_double_register0");
+    double value = 0;
+    ASSERT_TRUE(recipe_.getSlotValues(&double_slot, 1, &value));
+    EXPECT_DOUBLE_EQ(value, 1.5);
+
+    // Same result as the name lookup
+    int32_t by_name = 0;
+    ASSERT_TRUE(recipe_.getValue("output_int_register1", by_name));
+    EXPECT_EQ(by_name, 42);
+
+    // Data package of another recipe is ignored
+    auto other = dataPackage(4, 0, 0, 0, false);
+    EXPECT_FALSE(recipe_.parserDataPackage(other.size(), other));
+    ASSERT_TRUE(recipe_.getSlotValues(slots, 2, ints));
+    EXPECT_EQ(ints[0], 42);
+}
+
+TEST_F(RtsiRecipeTest, set_slot_values_and_pack) {
+    int slots[] = {0, 2};
+    int32_t ints[] = {5, 6};
+    ASSERT_TRUE(recipe_.setSlotValues(slots, 2, ints));
+
+    // An illegal slot writes nothing
+    int bad_slots[] = {0, 9};
+    int32_t other[] = {100, 100};
+    EXPECT_FALSE(recipe_.setSlotValues(bad_slots, 2, other));
+
+    std::vector<uint8_t> bytes = recipe_.packToBytes();
+    // recipe id + int32 + double + int32 + bool
+    ASSERT_EQ(bytes.size(), 1 + 4 + 8 + 4 + 1);
+    EXPECT_EQ(bytes[0], 3);
+    int32_t reg0 = 0;
+    int32_t reg1 = 0;
+    EndianUtils::unpack(bytes.begin() + 1, reg0);
+    EndianUtils::unpack(bytes.begin() + 13, reg1);
+    EXPECT_EQ(reg0, 5);
+    EXPECT_EQ(reg1, 6);
+}
+
+TEST_F(RtsiRecipeTest, pack_to_buffer_without_exception) {
+    int slots[] = {0, 2};
+    int32_t ints[] = {5, 6};
+    ASSERT_TRUE(recipe_.setSlotValues(slots, 2, ints));
+
+    // Bytes are appended, the buffer capacity is reused
+    std::vector<uint8_t> buffer = {0xAA};
+    buffer.reserve(64);
+    const uint8_t* data = buffer.data();
+    ASSERT_EQ(recipe_.packToBytes(buffer), EliteException::Code::SUCCESS);
+    EXPECT_EQ(buffer.data(), data);
+    ASSERT_EQ(buffer.size(), 1 + 1 + 4 + 8 + 4 + 1);
+    EXPECT_EQ(buffer[0], 0xAA);
+    std::vector<uint8_t> bytes = recipe_.packToBytes();
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), buffer.begin() + 1));
+
+    // A recipe which has not been set up returns a code instead of throwing
+    RtsiRecipeInternal empty(names_);
+    std::vector<uint8_t> out;
+    EXPECT_EQ(empty.packToBytes(out), EliteException::Code::RTSI_RECIPE_PARSER_FAIL);
+    EXPECT_TRUE(out.empty());
+    EXPECT_THROW(empty.packToBytes(), EliteException);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "EliteException.hpp"
+#include "FakeRtsiController.hpp"
+#include "Rtsi/RtsiRegisterRpc.hpp"
+
+using namespace ELITE;
+
+/**
+ * The robot task of register_rpc.script: a new sequence number in input_int_register0 is a request, the result is the opcode
+ * times 10, the int results are the sum and the difference of the int payload, the double results are the payload doubled.
+ */
+class FakeRpcRobot {
+   public:
+    std::atomic<bool> respond{true};
+
+    // The sequence numbers of the requests seen
+    std::vector<int> requests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_;
+    }
+
+    FakeRtsiController::Step step() {
+        return [this](const FakeRtsiController::Values& inputs, FakeRtsiController::Values& outputs) {
+            auto seq_iter = inputs.find("input_int_register0");
+            if (!respond || seq_iter == inputs.end()) {
+                return;
+            }
+            int seq = (int)seq_iter->second[0];
+            if (seq == last_seq_) {
+                return;
+            }
+            last_seq_ = seq;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                requests_.push_back(seq);
+            }
+            auto in = [&](const std::string& name) { return inputs.at(name)[0]; };
+            outputs["output_int_register1"] = {in("input_int_register1") * 10};
+            outputs["output_int_register2"] = {in("input_int_register2") + in("input_int_register3")};
+            outputs["output_int_register3"] = {in("input_int_register2") - in("input_int_register3")};
+            for (int i = 0; i < 6; i++) {
+                std::string index = std::to_string(i);
+                outputs["output_double_register" + index] = {in("input_double_register" + index) * 2};
+            }
+            // Written last, like the script
+            outputs["output_int_register0"] = {(double)seq};
+        };
+    }
+
+   private:
+    int last_seq_ = 0;
+    std::mutex mutex_;
+    std::vector<int> requests_;
+};
+
+class RtsiRegisterRpcTest : public ::testing::Test {
+   protected:
+    FakeRpcRobot robot_;
+    std::unique_ptr<FakeRtsiController> controller_;
+    std::unique_ptr<RtsiIOInterface> rtsi_;
+
+    void SetUp() override {
+        controller_.reset(new FakeRtsiController(robot_.step()));
+        if (!controller_->listening()) {
+            GTEST_SKIP() << "port 30004 is in use";
+        }
+        RtsiRegisterRpc::Config config;
+        rtsi_.reset(
+            new RtsiIOInterface(RtsiRegisterRpc::outputRecipe(config), RtsiRegisterRpc::inputRecipe(config), 500));
+        ASSERT_TRUE(rtsi_->connect("127.0.0.1"));
+    }
+
+    void TearDown() override {
+        rtsi_.reset();
+        controller_.reset();
+    }
+};
+
+TEST_F(RtsiRegisterRpcTest, request_ack_sequence) {
+    RtsiRegisterRpc rpc(*rtsi_);
+    std::vector<std::future<RtsiRegisterRpc::Response>> futures;
+    for (int i = 1; i <= 3; i++) {
+        futures.push_back(rpc.call(i, {10 * i, i}, {0.5 * i}));
+    }
+    for (int i = 1; i <= 3; i++) {
+        auto& fut = futures[i - 1];
+        ASSERT_EQ(fut.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+        RtsiRegisterRpc::Response resp = fut.get();
+        EXPECT_EQ(resp.status, RtsiRegisterRpc::Status::SUCCESS);
+        EXPECT_EQ(resp.result, 10 * i);
+        ASSERT_EQ(resp.int_values.size(), 2);
+        EXPECT_EQ(resp.int_values[0], 11 * i);
+        EXPECT_EQ(resp.int_values[1], 9 * i);
+        ASSERT_EQ(resp.double_values.size(), 6);
+        EXPECT_DOUBLE_EQ(resp.double_values[0], 1.0 * i);
+        // Missing payload is sent as 0
+        EXPECT_DOUBLE_EQ(resp.double_values[5], 0);
+        EXPECT_GT(resp.latency.count(), 0);
+    }
+    EXPECT_EQ(rpc.pendingCount(), 0);
+    // One request at a time, the sequence numbers increase
+    EXPECT_EQ(robot_.requests(), std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(RtsiRegisterRpcTest, timeout) {
+    RtsiRegisterRpc::Config config;
+    config.timeout_ms = 50;
+    RtsiRegisterRpc rpc(*rtsi_, config);
+    robot_.respond = false;
+    auto lost = rpc.call(1);
+    ASSERT_EQ(lost.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    RtsiRegisterRpc::Response resp = lost.get();
+    EXPECT_EQ(resp.status, RtsiRegisterRpc::Status::TIMEOUT);
+    EXPECT_GE(resp.latency, std::chrono::milliseconds(50));
+
+    // The next request gets a new sequence number, a late acknowledgement of the lost one is not taken for it
+    robot_.respond = true;
+    auto next = rpc.call(2, {3, 4});
+    ASSERT_EQ(next.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    resp = next.get();
+    EXPECT_EQ(resp.status, RtsiRegisterRpc::Status::SUCCESS);
+    EXPECT_EQ(resp.result, 20);
+    EXPECT_EQ(resp.int_values[0], 7);
+}
+
+TEST_F(RtsiRegisterRpcTest, canceled_on_destruction) {
+    robot_.respond = false;
+    std::future<RtsiRegisterRpc::Response> in_flight;
+    std::future<RtsiRegisterRpc::Response> queued;
+    {
+        RtsiRegisterRpc::Config config;
+        config.timeout_ms = 10000;
+        RtsiRegisterRpc rpc(*rtsi_, config);
+        in_flight = rpc.call(1);
+        queued = rpc.call(2);
+        // Wait for the first request to be written
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (controller_->inputs()["input_int_register0"].empty() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        EXPECT_EQ(rpc.pendingCount(), 2);
+    }
+    ASSERT_EQ(in_flight.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_EQ(queued.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(in_flight.get().status, RtsiRegisterRpc::Status::CANCELED);
+    EXPECT_EQ(queued.get().status, RtsiRegisterRpc::Status::CANCELED);
+}
+
+TEST_F(RtsiRegisterRpcTest, illegal_layout_and_payload) {
+    RtsiRegisterRpc::Config config;
+    config.int_register_base = 46;
+    EXPECT_THROW(RtsiRegisterRpc(*rtsi_, config), EliteException);
+
+    RtsiRegisterRpc rpc(*rtsi_);
+    EXPECT_THROW(rpc.call(1, {1, 2, 3}), EliteException);
+    EXPECT_THROW(rpc.call(1, {}, std::vector<double>(7, 0)), EliteException);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Rtsi/RtsiTelemetry.hpp"
+
+using namespace ELITE;
+
+static const std::vector<TelemetryField> FIELDS = {
+    {"actual_joint_positions", TelemetryType::VECTOR6D}, {"actual_TCP_pose", TelemetryType::VECTOR6D},
+    {"speed_scaling", TelemetryType::DOUBLE},           {"robot_mode", TelemetryType::INT32},
+    {"actual_digital_input_bits", TelemetryType::UINT64}, {"is_power_on_robot", TelemetryType::BOOL},
+    {"joint_mode", TelemetryType::VECTOR6INT32},        {"elbow_position", TelemetryType::VECTOR3D},
+};
+
+struct Frame {
+    double timestamp;
+    std::vector<RtsiTypeVariant> values;
+};
+
+// A slow joint motion at 500 Hz with a sensor noise, and mostly constant states
+static std::vector<Frame> makeFrames(size_t count) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0, 1e-5);
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < count; i++) {
+        double t = 1000.0 + i * 0.002;
+        vector6d_t q, pose;
+        for (int j = 0; j < 6; j++) {
+            q[j] = 0.5 * std::sin(0.2 * t + j) + noise(rng);
+            pose[j] = 0.3 * std::cos(0.2 * t + j);
+        }
+        int32_t mode = i < count / 2 ? 5 : 7;
+        uint64_t bits = (i / 700) % 2 ? 0x5 : 0x1;
+        vector6int32_t joint_mode{253, 253, 253, 253, 253, 253};
+        vector3d_t elbow{0.1, 0.2, 0.3 + 1e-3 * (i % 3)};
+        frames.push_back({t,
+                          {RtsiTypeVariant(q), RtsiTypeVariant(pose), RtsiTypeVariant(1.0), RtsiTypeVariant(mode),
+                           RtsiTypeVariant(bits), RtsiTypeVariant(true), RtsiTypeVariant(joint_mode), RtsiTypeVariant(elbow)}});
+    }
+    return frames;
+}
+
+static std::string writeFile(const std::vector<Frame>& frames) {
+    std::string path = "telemetry_test.etm";
+    TelemetryWriter writer;
+    EXPECT_TRUE(writer.open(path, FIELDS, 500));
+    for (const auto& frame : frames) {
+        EXPECT_TRUE(writer.append(frame.timestamp, frame.values));
+    }
+    EXPECT_TRUE(writer.close());
+    return path;
+}
+
+static std::vector<Frame> readAll(const TelemetryReader& reader, double start, double end) {
+    std::vector<Frame> frames;
+    EXPECT_TRUE(reader.read(start, end, [&](double t, const std::vector<RtsiTypeVariant>& values) {
+        frames.push_back({t, values});
+        return true;
+    }));
+    return frames;
+}
+
+TEST(RtsiTelemetryTest, round_trip) {
+    auto frames = makeFrames(5000);
+    std::string path = writeFile(frames);
+
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_EQ(reader.fields().size(), FIELDS.size());
+    EXPECT_EQ(reader.fields()[3].name, "robot_mode");
+    EXPECT_EQ(reader.fields()[3].type, TelemetryType::INT32);
+    EXPECT_EQ(reader.frameCount(), frames.size());
+    EXPECT_EQ(reader.blockCount(), 10);
+    EXPECT_DOUBLE_EQ(reader.startTime(), frames.front().timestamp);
+
+    auto read = readAll(reader, 0, 1e9);
+    ASSERT_EQ(read.size(), frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        EXPECT_NEAR(read[i].timestamp, frames[i].timestamp, 1e-7);
+        // Lossless, also the doubles
+        ASSERT_TRUE(read[i].values == frames[i].values) << "frame " << i;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(RtsiTelemetryTest, compression) {
+    auto frames = makeFrames(5000);
+    std::string path = writeFile(frames);
+    size_t raw = 0;
+    for (const auto& value : frames.front().values) {
+        switch (TelemetryWriter::typeOf(value)) {
+            case TelemetryType::VECTOR6D:
+                raw += 48;
+                break;
+            case TelemetryType::VECTOR3D:
+                raw += 24;
+                break;
+            case TelemetryType::VECTOR6INT32:
+                raw += 24;
+                break;
+            case TelemetryType::BOOL:
+                raw += 1;
+                break;
+            default:
+                raw += 8;
+                break;
+        }
+    }
+    raw = (raw + 8) * frames.size();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    size_t size = file.tellg();
+    // The 15 moving doubles dominate, the states and the timestamps almost vanish
+    EXPECT_LT(size * 2, raw);
+    std::remove(path.c_str());
+}
+
+TEST(RtsiTelemetryTest, time_range) {
+    auto frames = makeFrames(5000);
+    std::string path = writeFile(frames);
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    double start = frames[1234].timestamp;
+    double end = frames[2345].timestamp;
+    auto read = readAll(reader, start, end);
+    ASSERT_EQ(read.size(), 2345 - 1234 + 1);
+    EXPECT_NEAR(read.front().timestamp, start, 1e-7);
+    EXPECT_NEAR(read.back().timestamp, end, 1e-7);
+    EXPECT_TRUE(read.front().values == frames[1234].values);
+
+    // Stop early
+    int count = 0;
+    EXPECT_TRUE(reader.read(start, end, [&](double, const std::vector<RtsiTypeVariant>&) { return ++count < 10; }));
+    EXPECT_EQ(count, 10);
+
+    EXPECT_TRUE(readAll(reader, 0, 999).empty());
+    EXPECT_TRUE(readAll(reader, 2000, 3000).empty());
+    std::remove(path.c_str());
+}
+
+TEST(RtsiTelemetryTest, without_index) {
+    auto frames = makeFrames(1800);
+    std::string path = writeFile(frames);
+    // Like a recording which was killed: no index and the last block cut
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 4 * 28 - 20 - 10);
+
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.blockCount(), 3);
+    auto read = readAll(reader, 0, 1e9);
+    ASSERT_EQ(read.size(), 1500);
+    EXPECT_TRUE(read.back().values == frames[1499].values);
+    std::remove(path.c_str());
+}
+
+TEST(RtsiTelemetryTest, extreme_integers) {
+    // The deltas between these values overflow int64_t
+    std::string path = "telemetry_test.etm";
+    TelemetryWriter writer;
+    ASSERT_TRUE(writer.open(path, {{"actual_digital_input_bits", TelemetryType::UINT64}, {"robot_mode", TelemetryType::INT32}}));
+    const std::vector<uint64_t> bits = {0, UINT64_MAX, 1ULL << 63, (1ULL << 63) - 1, 0, 1ULL << 63, 1};
+    const std::vector<int32_t> modes = {INT32_MIN, INT32_MAX, INT32_MIN, 0, INT32_MAX, INT32_MIN, -1};
+    for (size_t i = 0; i < bits.size(); i++) {
+        EXPECT_TRUE(writer.append(1.0 + i * 0.002, {RtsiTypeVariant(bits[i]), RtsiTypeVariant(modes[i])}));
+    }
+    EXPECT_TRUE(writer.close());
+
+    TelemetryReader reader;
+    ASSERT_TRUE(reader.open(path));
+    auto read = readAll(reader, 0, 1e9);
+    ASSERT_EQ(read.size(), bits.size());
+    for (size_t i = 0; i < bits.size(); i++) {
+        EXPECT_TRUE(read[i].values == std::vector<RtsiTypeVariant>({RtsiTypeVariant(bits[i]), RtsiTypeVariant(modes[i])}));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(RtsiTelemetryTest, rejects_bad_frames) {
+    std::string path = "telemetry_test.etm";
+    TelemetryWriter writer;
+    EXPECT_FALSE(writer.append(0, {}));
+    ASSERT_TRUE(writer.open(path, {{"speed_scaling", TelemetryType::DOUBLE}, {"robot_mode", TelemetryType::INT32}}));
+    EXPECT_TRUE(writer.append(1.0, {RtsiTypeVariant(1.0), RtsiTypeVariant((int32_t)5)}));
+    EXPECT_FALSE(writer.append(1.1, {RtsiTypeVariant(1.0), RtsiTypeVariant((uint32_t)5)}));
+    EXPECT_FALSE(writer.append(1.1, {RtsiTypeVariant(1.0)}));
+    EXPECT_FALSE(writer.append(0.9, {RtsiTypeVariant(1.0), RtsiTypeVariant((int32_t)5)}));
+    EXPECT_EQ(writer.frameCount(), 1);
+    EXPECT_TRUE(writer.close());
+
+    {
+        TelemetryReader reader;
+        EXPECT_TRUE(reader.open(path));
+        EXPECT_EQ(reader.frameCount(), 1);
+    }
+    std::ofstream(path, std::ios::trunc) << "not a telemetry file";
+    TelemetryReader reader;
+    EXPECT_FALSE(reader.open(path));
+    std::remove(path.c_str());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
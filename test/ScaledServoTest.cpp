@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "Elite/ScaledClock.hpp"
+#include "Elite/ScaledServoStreamer.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+
+using namespace ELITE;
+using namespace ELITE::STREAM;
+
+TEST(ScaledServoTest, full_speed_follows_timestamps) {
+    ScaledClock clock(0.004, 0);
+    double stamp = 100;
+    for (int i = 0; i < 250; i++) {
+        stamp += 0.004;
+        clock.advance(stamp, 1.0);
+    }
+    EXPECT_NEAR(clock.time(), 1.0, 1e-9);
+    EXPECT_DOUBLE_EQ(clock.scaling(), 1.0);
+}
+
+TEST(ScaledServoTest, half_speed_is_half_progress) {
+    ScaledClock clock(0.004, 0);
+    double stamp = 0;
+    for (int i = 0; i < 500; i++) {
+        stamp += 0.004;
+        clock.advance(stamp, 0.5);
+    }
+    EXPECT_NEAR(clock.time(), 1.0, 1e-9);
+
+    // Stopped by the slider, the frame of the change is integrated with the mean scaling
+    stamp += 0.004;
+    clock.advance(stamp, 0);
+    EXPECT_NEAR(clock.time(), 1.001, 1e-9);
+    double time = clock.time();
+    for (int i = 0; i < 10; i++) {
+        stamp += 0.004;
+        clock.advance(stamp, 0);
+    }
+    EXPECT_DOUBLE_EQ(clock.time(), time);
+
+    // Out of range scaling is clamped
+    stamp += 0.004;
+    clock.advance(stamp, 3.0);
+    EXPECT_NEAR(clock.time(), time + 0.002, 1e-9);
+}
+
+TEST(ScaledServoTest, scaling_rate_is_limited) {
+    ScaledClock clock(0.004, 2.0);
+    double stamp = 0;
+    clock.advance(stamp, 1.0);
+    EXPECT_DOUBLE_EQ(clock.scaling(), 1.0);
+    // The slider steps to 0.2, the scaling ramps down in 0.4 s
+    for (int i = 0; i < 50; i++) {
+        stamp += 0.004;
+        clock.advance(stamp, 0.2);
+        EXPECT_GE(clock.scaling(), 0.2);
+    }
+    EXPECT_NEAR(clock.scaling(), 0.6, 1e-9);
+    for (int i = 0; i < 50; i++) {
+        stamp += 0.004;
+        clock.advance(stamp, 0.2);
+    }
+    EXPECT_NEAR(clock.scaling(), 0.2, 1e-9);
+}
+
+TEST(ScaledServoTest, bad_timestamps_use_nominal_period) {
+    ScaledClock clock(0.004, 0);
+    clock.advance(10, 1.0);
+    EXPECT_DOUBLE_EQ(clock.time(), 0.004);
+    // Repeated
+    clock.advance(10, 1.0);
+    EXPECT_DOUBLE_EQ(clock.time(), 0.008);
+    // Lost frames do not jump the trajectory
+    clock.advance(11, 1.0);
+    EXPECT_DOUBLE_EQ(clock.time(), 0.012);
+    clock.advance(11.008, 1.0);
+    EXPECT_NEAR(clock.time(), 0.020, 1e-9);
+
+    clock.reset();
+    EXPECT_DOUBLE_EQ(clock.time(), 0);
+    clock.advance(50, 0.25);
+    EXPECT_DOUBLE_EQ(clock.scaling(), 0.25);
+    EXPECT_DOUBLE_EQ(clock.time(), 0.001);
+}
+
+// 4 ms frames with the speed scaling of the slider
+class ServoFrames {
+   public:
+    FakeFrameSource source;
+
+    void frames(int count, double scaling) {
+        for (int i = 0; i < count; i++) {
+            stamp_ += 0.004;
+            source.set("timestamp", stamp_);
+            source.set("speed_scaling", scaling);
+            source.frame();
+        }
+    }
+
+   private:
+    double stamp_ = 100;
+};
+
+// The position of joint 0 is the trajectory time
+static bool timeSampler(double time, vector6d_t& positions) {
+    positions = vector6d_t{time, 0, 0, 0, 0, 0};
+    return true;
+}
+
+TEST(ScaledServoTest, streamer_follows_scaling_to_the_end) {
+    ServoFrames frames;
+    FakeCommandWriter driver;
+    ScaledServoStreamer streamer(frames.source, driver);
+    std::vector<bool> done;
+    streamer.setDoneCallback([&](bool finished) { done.push_back(finished); });
+    ScaledServoConfig config;
+    config.max_scaling_rate = 0;
+    config.timeout_ms = 50;
+    EXPECT_FALSE(streamer.start(timeSampler, 0, config));
+    ASSERT_TRUE(streamer.start(timeSampler, 1.0, config));
+    EXPECT_FALSE(streamer.start(timeSampler, 1.0, config));
+
+    // One servoj per frame
+    frames.frames(100, 1.0);
+    auto servoj = driver.servoj();
+    ASSERT_EQ(servoj.size(), 100);
+    EXPECT_NEAR(servoj.back().pos[0], 0.4, 1e-9);
+    EXPECT_EQ(servoj.back().timeout_ms, 50);
+    EXPECT_FALSE(servoj.back().cartesian);
+    EXPECT_NEAR(streamer.progress(), 0.4, 1e-9);
+
+    // The slider at 50 %: half the progress per frame
+    frames.frames(100, 0.5);
+    EXPECT_NEAR(streamer.progress(), 0.6, 0.002 + 1e-9);
+    EXPECT_DOUBLE_EQ(streamer.scaling(), 0.5);
+    frames.frames(1, 0);
+    double stopped = streamer.progress();
+    frames.frames(10, 0);
+    EXPECT_DOUBLE_EQ(streamer.progress(), stopped);
+    EXPECT_EQ(driver.servoj().size(), 211);
+    EXPECT_TRUE(done.empty());
+
+    // The end is sent once, exactly
+    frames.frames(200, 1.0);
+    EXPECT_FALSE(streamer.isStreaming());
+    servoj = driver.servoj();
+    EXPECT_DOUBLE_EQ(servoj.back().pos[0], 1.0);
+    EXPECT_LT(servoj[servoj.size() - 2].pos[0], 1.0);
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_TRUE(done[0]);
+    size_t sent = servoj.size();
+    frames.frames(10, 1.0);
+    EXPECT_EQ(driver.servoj().size(), sent);
+}
+
+TEST(ScaledServoTest, streamer_scaling_fallbacks) {
+    ServoFrames frames;
+    FakeCommandWriter driver;
+    ScaledServoStreamer streamer(frames.source, driver);
+    ScaledServoConfig config;
+    config.max_scaling_rate = 0;
+    config.cartesian = true;
+    ASSERT_TRUE(streamer.start(timeSampler, 10.0, config));
+    // "target_speed_fraction" is used without "speed_scaling"
+    frames.source.erase("speed_scaling");
+    frames.source.set("target_speed_fraction", 0.25);
+    frames.source.set("timestamp", 1.0);
+    frames.source.frame();
+    EXPECT_DOUBLE_EQ(streamer.scaling(), 0.25);
+    EXPECT_DOUBLE_EQ(streamer.progress(), 0.001);
+    // Full speed without both
+    frames.source.erase("target_speed_fraction");
+    frames.source.set("timestamp", 1.004);
+    frames.source.frame();
+    EXPECT_DOUBLE_EQ(streamer.scaling(), 1.0);
+    auto servoj = driver.servoj();
+    ASSERT_EQ(servoj.size(), 2);
+    EXPECT_TRUE(servoj[1].cartesian);
+    streamer.stop();
+}
+
+TEST(ScaledServoTest, streamer_aborts) {
+    ServoFrames frames;
+    FakeCommandWriter driver;
+    ScaledServoStreamer streamer(frames.source, driver);
+    std::vector<bool> done;
+    streamer.setDoneCallback([&](bool finished) { done.push_back(finished); });
+
+    // A tool contact blocks the servoj commands
+    ASSERT_TRUE(streamer.start(timeSampler, 1.0));
+    frames.frames(10, 1.0);
+    driver.writeToolContact(100);
+    frames.frames(10, 1.0);
+    EXPECT_FALSE(streamer.isStreaming());
+    EXPECT_EQ(driver.servoj().size(), 10);
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_FALSE(done[0]);
+    driver.clearToolContact();
+
+    // A failed sample
+    int samples = 0;
+    ASSERT_TRUE(streamer.start(
+        [&](double time, vector6d_t& positions) {
+            positions = vector6d_t{};
+            return ++samples < 5;
+        },
+        1.0));
+    frames.frames(10, 1.0);
+    EXPECT_EQ(samples, 5);
+    EXPECT_EQ(driver.servoj().size(), 14);
+    ASSERT_EQ(done.size(), 2);
+    EXPECT_FALSE(done[1]);
+
+    // stop()
+    ASSERT_TRUE(streamer.start(timeSampler, 1.0));
+    frames.frames(3, 1.0);
+    streamer.stop();
+    frames.frames(3, 1.0);
+    EXPECT_EQ(driver.servoj().size(), 17);
+    ASSERT_EQ(done.size(), 3);
+    EXPECT_FALSE(done[2]);
+}
+
+TEST(ScaledServoTest, streamer_streams_spline) {
+    ServoFrames frames;
+    FakeCommandWriter driver;
+    ScaledServoStreamer streamer(frames.source, driver);
+    SplineTrajectory spline;
+    EXPECT_FALSE(streamer.start(spline));
+    ASSERT_TRUE(spline.fit({vector6d_t{}, vector6d_t{0.1, 0, 0, 0, 0, 0}, vector6d_t{0.2, 0.1, 0, 0, 0, 0}}, {0.2, 0.2}));
+    ScaledServoConfig config;
+    config.cartesian = true;
+    ASSERT_TRUE(streamer.start(spline, config));
+    frames.frames(200, 1.0);
+    EXPECT_FALSE(streamer.isStreaming());
+    auto servoj = driver.servoj();
+    ASSERT_EQ(servoj.size(), 100);
+    // A joint stream
+    EXPECT_FALSE(servoj[0].cartesian);
+    EXPECT_NEAR(servoj.back().pos[0], 0.2, 1e-9);
+    EXPECT_NEAR(servoj.back().pos[1], 0.1, 1e-9);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
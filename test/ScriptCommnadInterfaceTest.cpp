@@ -2,6 +2,7 @@
 #include <boost/asio.hpp>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "ScriptCommandInterface.hpp"
 #include "ControlCommon.hpp"
@@ -89,6 +90,7 @@ TEST(ScriptCommandInterfaceTest, SendAndReceive) {
     ASSERT_EQ(recv_len / sizeof(int32_t), ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE);
     int32_t zero_ft_sensor_buffer[ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE] = {0};
     zero_ft_sensor_buffer[0] = htonl(Cmd::ZERO_FTSENSOR);
+    zero_ft_sensor_buffer[ScriptCommandInterface::SCRIPT_COMMAND_SEQ_INDEX] = htonl(1);
     ARRAY_EQUAL_ASSERT(buffer, zero_ft_sensor_buffer);
     
     // setToolVoltage() interface test
@@ -99,6 +101,7 @@ TEST(ScriptCommandInterfaceTest, SendAndReceive) {
     int32_t set_tool_voltage_buffer[ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE] = {0};
     set_tool_voltage_buffer[0] = htonl(Cmd::SET_TOOL_VOLTAGE);
     set_tool_voltage_buffer[1] = htonl((int32_t)ToolVoltage::V_12 * CONTROL::COMMON_ZOOM_RATIO);
+    set_tool_voltage_buffer[ScriptCommandInterface::SCRIPT_COMMAND_SEQ_INDEX] = htonl(2);
     ARRAY_EQUAL_ASSERT(buffer, set_tool_voltage_buffer);
 
     // setPayload() interface test
@@ -171,10 +174,105 @@ TEST(ScriptCommandInterfaceTest, SendAndReceive) {
     ASSERT_EQ(recv_len / sizeof(int32_t), ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE);
     int32_t end_force_mode_buffer[ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE] = {0};
     end_force_mode_buffer[0] = htonl(Cmd::END_FORCE_MODE);
+    end_force_mode_buffer[ScriptCommandInterface::SCRIPT_COMMAND_SEQ_INDEX] = htonl(5);
     ARRAY_EQUAL_ASSERT(buffer, end_force_mode_buffer);
     tcp_resource->shutdown();
 }
 
+TEST(ScriptCommandInterfaceTest, Acknowledge) {
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    std::unique_ptr<ScriptCommandInterface> script_cmd;
+    script_cmd.reset(new ScriptCommandInterface(SCRIPT_COMMAND_INTERFACE_TEST_PORT, tcp_resource));
+
+    // Not connected, the command can not be sent
+    auto not_sent = script_cmd->ping(100);
+    ASSERT_EQ(not_sent.wait_for(0s), std::future_status::ready);
+    EXPECT_EQ(not_sent.get().status, ScriptCommandStatus::SEND_FAIL);
+
+    std::unique_ptr<TcpClient> client;
+    client.reset(new TcpClient());
+    EXPECT_NO_THROW(client->connect("127.0.0.1", SCRIPT_COMMAND_INTERFACE_TEST_PORT));
+    while (!script_cmd->isRobotConnect()) {
+        std::this_thread::sleep_for(4ms);
+    }
+
+    // Script stand-in: read a command, acknowledge it with (sequence number, result)
+    auto script_ack = [&](int32_t result) {
+        int32_t buffer[ScriptCommandInterface::SCRIPT_COMMAND_DATA_SIZE];
+        boost::asio::read(*client->socket_ptr, boost::asio::buffer(buffer));
+        int32_t ack[2] = {buffer[ScriptCommandInterface::SCRIPT_COMMAND_SEQ_INDEX], (int32_t)htonl(result)};
+        boost::asio::write(*client->socket_ptr, boost::asio::buffer(ack));
+        return (int32_t)ntohl(buffer[0]);
+    };
+
+    auto ack_future = script_cmd->setPayloadAsync(1, {0, 0, 0.1});
+    EXPECT_EQ(script_ack(0), Cmd::SET_PAYLOAD);
+    ASSERT_EQ(ack_future.wait_for(1s), std::future_status::ready);
+    ScriptCommandAck ack = ack_future.get();
+    EXPECT_EQ(ack.status, ScriptCommandStatus::SUCCESS);
+    EXPECT_EQ(ack.result, 0);
+    EXPECT_GT(ack.seq, 0);
+
+    ack_future = script_cmd->ping();
+    EXPECT_EQ(script_ack(-1), (int32_t)ScriptCommand::PING);
+    ASSERT_EQ(ack_future.wait_for(1s), std::future_status::ready);
+    ScriptCommandAck ping_ack = ack_future.get();
+    EXPECT_EQ(ping_ack.status, ScriptCommandStatus::SUCCESS);
+    EXPECT_EQ(ping_ack.result, -1);
+    EXPECT_EQ(ping_ack.seq, ack.seq + 1);
+
+    // No acknowledge
+    ack_future = script_cmd->zeroFTSensorAsync(50);
+    ASSERT_EQ(ack_future.wait_for(1s), std::future_status::ready);
+    EXPECT_EQ(ack_future.get().status, ScriptCommandStatus::TIMEOUT);
+    // A late acknowledge is ignored
+    script_ack(0);
+
+    ScriptCommandStats stats = script_cmd->getStats(ScriptCommand::SET_PAYLOAD);
+    EXPECT_EQ(stats.sent, 1);
+    EXPECT_EQ(stats.acked, 1);
+    EXPECT_EQ(stats.min_latency, ack.latency);
+    EXPECT_EQ(stats.max_latency, ack.latency);
+    stats = script_cmd->getStats(ScriptCommand::ZERO_FTSENSOR);
+    EXPECT_EQ(stats.acked, 0);
+    EXPECT_EQ(stats.timeout, 1);
+
+    // Pending commands are canceled on destruction
+    ack_future = script_cmd->endForceModeAsync(10000);
+    script_cmd.reset();
+    ASSERT_EQ(ack_future.wait_for(0s), std::future_status::ready);
+    EXPECT_EQ(ack_future.get().status, ScriptCommandStatus::CANCELED);
+    tcp_resource->shutdown();
+}
+
+TEST(ScriptCommandInterfaceTest, DestructionWithExpiringTimers) {
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    for (int round = 0; round < 10; round++) {
+        std::unique_ptr<ScriptCommandInterface> script_cmd;
+        script_cmd.reset(new ScriptCommandInterface(SCRIPT_COMMAND_INTERFACE_TEST_PORT, tcp_resource));
+        std::unique_ptr<TcpClient> client;
+        client.reset(new TcpClient());
+        EXPECT_NO_THROW(client->connect("127.0.0.1", SCRIPT_COMMAND_INTERFACE_TEST_PORT));
+        while (!script_cmd->isRobotConnect()) {
+            std::this_thread::sleep_for(4ms);
+        }
+
+        // The timers expire in the io_context thread while the destructor cancels them
+        std::vector<std::future<ScriptCommandAck>> acks;
+        for (int i = 0; i < 50; i++) {
+            acks.push_back(script_cmd->ping(1 + i % 3));
+        }
+        std::this_thread::sleep_for(1ms);
+        script_cmd.reset();
+        for (auto& ack : acks) {
+            ASSERT_EQ(ack.wait_for(0s), std::future_status::ready);
+            ScriptCommandStatus status = ack.get().status;
+            EXPECT_TRUE(status == ScriptCommandStatus::TIMEOUT || status == ScriptCommandStatus::CANCELED);
+        }
+    }
+    tcp_resource->shutdown();
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
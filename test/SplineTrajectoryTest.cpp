@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "SplineTrajectory.hpp"
+
+using namespace ELITE;
+
+static std::vector<vector6d_t> testWaypoints() {
+    return {{0, 0, 0, 0, 0, 0}, {0.5, -0.2, 0.3, 0, 0, 0.1}, {1.0, 0.1, 0.2, 0.4, 0, 0.2}, {0.8, 0.3, -0.1, 0.4, 0.2, 0.3}};
+}
+
+TEST(SplineTrajectoryTest, fit_rejects_bad_input) {
+    SplineTrajectory spline;
+    vector6d_t q{};
+    EXPECT_FALSE(spline.fit({q}, {}));
+    EXPECT_FALSE(spline.fit({q, q}, {1, 1}));
+    EXPECT_FALSE(spline.fit({q, q}, {0}));
+    vector6d_t out;
+    EXPECT_FALSE(spline.sample(0, out));
+}
+
+TEST(SplineTrajectoryTest, interpolates_with_continuity) {
+    auto waypoints = testWaypoints();
+    std::vector<double> durations = {1.0, 0.5, 1.5};
+    vector6d_t end_velocity = {0.1, 0, 0, 0, 0, 0};
+    SplineTrajectory spline;
+    ASSERT_TRUE(spline.fit(waypoints, durations, vector6d_t{}, end_velocity));
+    ASSERT_EQ(spline.knots().size(), 3);
+    EXPECT_DOUBLE_EQ(spline.duration(), 3.0);
+
+    // Passes through the waypoints with the clamped end velocities
+    vector6d_t q, qd, qdd;
+    double time = 0;
+    ASSERT_TRUE(spline.sample(0, q, &qd));
+    for (int j = 0; j < 6; j++) {
+        EXPECT_NEAR(q[j], waypoints[0][j], 1e-12);
+        EXPECT_NEAR(qd[j], 0, 1e-12);
+    }
+    for (size_t k = 0; k < durations.size(); k++) {
+        time += durations[k];
+        const SplineKnot& knot = spline.knots()[k];
+        EXPECT_DOUBLE_EQ(knot.duration, durations[k]);
+        spline.sample(time, q, &qd, &qdd);
+        for (int j = 0; j < 6; j++) {
+            EXPECT_NEAR(knot.positions[j], waypoints[k + 1][j], 1e-12);
+            EXPECT_NEAR(q[j], waypoints[k + 1][j], 1e-9);
+            EXPECT_NEAR(qd[j], knot.velocities[j], 1e-9);
+            EXPECT_NEAR(qdd[j], knot.accelerations[j], 1e-9);
+        }
+    }
+    EXPECT_NEAR(spline.knots().back().velocities[0], 0.1, 1e-9);
+
+    // Velocity and acceleration are continuous at the inner knots
+    const double eps = 1e-7;
+    time = 0;
+    for (size_t k = 0; k + 1 < durations.size(); k++) {
+        time += durations[k];
+        vector6d_t q0, qd0, qdd0, q1, qd1, qdd1;
+        spline.sample(time - eps, q0, &qd0, &qdd0);
+        spline.sample(time + eps, q1, &qd1, &qdd1);
+        for (int j = 0; j < 6; j++) {
+            EXPECT_NEAR(q0[j], q1[j], 1e-5);
+            EXPECT_NEAR(qd0[j], qd1[j], 1e-5);
+            EXPECT_NEAR(qdd0[j], qdd1[j], 1e-4);
+        }
+    }
+}
+
+// The quintic segment of external_control.script, from the start state to the first knot
+static double scriptQuintic(double q0, double qd0, double qdd0, double q1, double qd1, double qdd1, double h, double t) {
+    double dq = q1 - q0, h2 = h * h, h3 = h2 * h;
+    double c2 = qdd0 / 2;
+    double c3 = (20 * dq - (8 * qd1 + 12 * qd0) * h - (3 * qdd0 - qdd1) * h2) / (2 * h3);
+    double c4 = (-30 * dq + (14 * qd1 + 16 * qd0) * h + (3 * qdd0 - 2 * qdd1) * h2) / (2 * h3 * h);
+    double c5 = (12 * dq - 6 * (qd1 + qd0) * h - (qdd0 - qdd1) * h2) / (2 * h3 * h2);
+    return q0 + t * (qd0 + t * (c2 + t * (c3 + t * (c4 + t * c5))));
+}
+
+TEST(SplineTrajectoryTest, start_state_reproduces_first_segment) {
+    auto waypoints = testWaypoints();
+    std::vector<double> durations = {1.0, 0.5, 1.5};
+    vector6d_t start_velocity = {0, 0.2, 0, 0, 0, 0};
+    SplineTrajectory spline;
+    ASSERT_TRUE(spline.fit(waypoints, durations, start_velocity));
+    const SplineKnot& start = spline.start();
+    EXPECT_EQ(start.duration, 0);
+    vector6d_t q, qd, qdd;
+    spline.sample(0, q, &qd, &qdd);
+    bool accelerates = false;
+    for (int j = 0; j < 6; j++) {
+        EXPECT_DOUBLE_EQ(start.positions[j], waypoints[0][j]);
+        EXPECT_NEAR(start.velocities[j], start_velocity[j], 1e-12);
+        EXPECT_NEAR(start.accelerations[j], qdd[j], 1e-12);
+        accelerates = accelerates || std::abs(start.accelerations[j]) > 1e-3;
+    }
+    // The clamped fit does not start with zero acceleration, so a segment starting at rest would leave the spline
+    EXPECT_TRUE(accelerates);
+
+    // Starting from start(), the script follows the fitted spline on the first segment
+    const SplineKnot& first = spline.knots()[0];
+    for (double t = 0; t <= first.duration; t += 0.05) {
+        spline.sample(t, q);
+        for (int j = 0; j < 6; j++) {
+            EXPECT_NEAR(scriptQuintic(start.positions[j], start.velocities[j], start.accelerations[j], first.positions[j],
+                                      first.velocities[j], first.accelerations[j], first.duration, t),
+                        q[j], 1e-9);
+        }
+    }
+}
+
+TEST(SplineTrajectoryTest, peaks_match_dense_sampling) {
+    SplineTrajectory spline;
+    ASSERT_TRUE(spline.fit(testWaypoints(), {1.0, 0.5, 1.5}));
+    vector6d_t peak_vel, peak_acc;
+    spline.peaks(peak_vel, peak_acc);
+
+    vector6d_t sampled_vel{}, sampled_acc{};
+    for (double t = 0; t <= spline.duration(); t += 1e-4) {
+        vector6d_t q, qd, qdd;
+        spline.sample(t, q, &qd, &qdd);
+        for (int j = 0; j < 6; j++) {
+            sampled_vel[j] = std::max(sampled_vel[j], std::abs(qd[j]));
+            sampled_acc[j] = std::max(sampled_acc[j], std::abs(qdd[j]));
+        }
+    }
+    for (int j = 0; j < 6; j++) {
+        EXPECT_GE(peak_vel[j] + 1e-12, sampled_vel[j]);
+        EXPECT_NEAR(peak_vel[j], sampled_vel[j], 1e-6);
+        EXPECT_NEAR(peak_acc[j], sampled_acc[j], 1e-3);
+    }
+}
+
+TEST(SplineTrajectoryTest, scale_to_limits) {
+    SplineTrajectory spline;
+    ASSERT_TRUE(spline.fit(testWaypoints(), {0.2, 0.1, 0.3}));
+    SplineLimits limits;
+    limits.max_velocity.fill(1.0);
+    limits.max_acceleration.fill(5.0);
+    EXPECT_FALSE(spline.withinLimits(limits));
+
+    vector6d_t before;
+    spline.sample(0.15, before);
+    double factor = spline.scaleToLimits(limits);
+    EXPECT_GT(factor, 1);
+    EXPECT_NEAR(spline.duration(), 0.6 * factor, 1e-12);
+    EXPECT_TRUE(spline.withinLimits(limits));
+
+    // Same path, slower
+    vector6d_t after;
+    spline.sample(0.15 * factor, after);
+    for (int j = 0; j < 6; j++) {
+        EXPECT_NEAR(before[j], after[j], 1e-9);
+    }
+    EXPECT_DOUBLE_EQ(spline.scaleToLimits(limits), 1);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
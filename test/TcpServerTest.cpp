@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include "Common/TcpServer.hpp"
 #include "boost/asio.hpp"
 #include <iostream>
 
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <unistd.h>
+#include <cstdlib>
+#endif
+
 using namespace std::chrono;
 using namespace ELITE;
 
@@ -198,6 +206,146 @@ TEST(TCP_SERVER, TCP_MULIT_SERVERS) {
 }
 
 
+TEST(TCP_SERVER, TCP_SERVER_CONNECTION_EVENT) {
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    std::shared_ptr<TcpServer> server = std::make_shared<TcpServer>(SERVER_TEST_PORT, 4, tcp_resource);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<bool> events;
+    std::chrono::steady_clock::time_point last_time;
+    server->setConnectionCallback([&](bool connected, std::chrono::steady_clock::time_point timestamp) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(connected);
+        last_time = timestamp;
+        cv.notify_all();
+    });
+    auto wait_events = [&](size_t n) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, 1s, [&]() { return events.size() >= n; });
+    };
+    server->startListen();
+    EXPECT_FALSE(server->isClientConnected());
+
+    auto before = std::chrono::steady_clock::now();
+    std::unique_ptr<TcpClient> client(new TcpClient("127.0.0.1", SERVER_TEST_PORT));
+    ASSERT_TRUE(wait_events(1));
+    EXPECT_TRUE(events[0]);
+    EXPECT_GE(last_time, before);
+    EXPECT_TRUE(server->isClientConnected());
+
+    // A new client replaces the old one: disconnect and connect
+    std::unique_ptr<TcpClient> client2(new TcpClient("127.0.0.1", SERVER_TEST_PORT));
+    ASSERT_TRUE(wait_events(3));
+    EXPECT_FALSE(events[1]);
+    EXPECT_TRUE(events[2]);
+
+    client2.reset();
+    ASSERT_TRUE(wait_events(4));
+    EXPECT_FALSE(events[3]);
+    EXPECT_FALSE(server->isClientConnected());
+
+    server->setConnectionCallback(nullptr);
+    server.reset();
+}
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+// A listening socket kept by another owner (e.g. a process manager) is taken over by the server.
+TEST(TCP_SERVER, TCP_SERVER_TAKE_OVER_LISTEN_SOCKET) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor owner(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), SERVER_TEST_PORT), true);
+    owner.listen(1);
+    int listen_fd = owner.release();
+
+    // The client connects before any server accepts, the connection waits in the backlog
+    TcpClient client("127.0.0.1", SERVER_TEST_PORT);
+
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    // A descriptor which is not a listening socket is ignored
+    EXPECT_EQ(tcp_resource->addListenSockets({listen_fd, 0}), 1);
+    EXPECT_EQ(tcp_resource->takeListenSocket(SERVER_TEST_PORT + 1), -1);
+
+    std::shared_ptr<TcpServer> server = std::make_shared<TcpServer>(SERVER_TEST_PORT, 4, tcp_resource);
+    int receive_data = 0;
+    server->setReceiveCallback([&](const uint8_t data[], int) { receive_data = *(int*)data; });
+    server->startListen();
+    // Wait accept
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(server->isClientConnected());
+
+    int send_data = 54321;
+    client.socket_ptr->send(boost::asio::buffer(&send_data, sizeof(send_data)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(receive_data, send_data);
+
+    // Each socket is taken only once
+    EXPECT_EQ(tcp_resource->takeListenSocket(SERVER_TEST_PORT), -1);
+    server.reset();
+}
+
+// A socket is taken by the server of another port than the one it is bound to, like a named activation socket
+TEST(TCP_SERVER, TCP_SERVER_TAKE_OVER_SOCKET_FOR_PORT) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor owner(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0), true);
+    owner.listen(1);
+    int bound_port = owner.local_endpoint().port();
+    int listen_fd = owner.release();
+
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    EXPECT_FALSE(tcp_resource->addListenSocket(0, SERVER_TEST_PORT));
+    ASSERT_TRUE(tcp_resource->addListenSocket(listen_fd, SERVER_TEST_PORT));
+    EXPECT_EQ(tcp_resource->takeListenSocket(bound_port), -1);
+
+    std::shared_ptr<TcpServer> server = std::make_shared<TcpServer>(SERVER_TEST_PORT, 4, tcp_resource);
+    server->startListen();
+    TcpClient client("127.0.0.1", bound_port);
+    auto deadline = steady_clock::now() + 2s;
+    while (!server->isClientConnected() && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(4ms);
+    }
+    EXPECT_TRUE(server->isClientConnected());
+    server.reset();
+}
+
+TEST(TCP_SERVER, TCP_SERVER_ACTIVATION_LISTEN_SOCKETS) {
+    std::string pid = std::to_string(getpid());
+    // Passed to another process
+    setenv("LISTEN_PID", std::to_string(getpid() + 1).c_str(), 1);
+    setenv("LISTEN_FDS", "2", 1);
+    EXPECT_TRUE(TcpServer::activationListenSockets().empty());
+
+    // Without names
+    setenv("LISTEN_PID", pid.c_str(), 1);
+    auto sockets = TcpServer::activationListenSockets();
+    ASSERT_EQ(sockets.size(), 2);
+    EXPECT_EQ(sockets[0].fd, 3);
+    EXPECT_EQ(sockets[1].fd, 4);
+    EXPECT_EQ(sockets[0].name, "");
+    EXPECT_EQ(sockets[1].name, "");
+
+    // The names are in the order of the descriptors, an empty name stays in its place
+    setenv("LISTEN_FDS", "3", 1);
+    setenv("LISTEN_FDNAMES", "reverse::script_sender", 1);
+    sockets = TcpServer::activationListenSockets();
+    ASSERT_EQ(sockets.size(), 3);
+    EXPECT_EQ(sockets[0].name, "reverse");
+    EXPECT_EQ(sockets[1].name, "");
+    EXPECT_EQ(sockets[2].name, "script_sender");
+    EXPECT_EQ(sockets[2].fd, 5);
+
+    // Fewer names than descriptors
+    setenv("LISTEN_FDNAMES", "trajectory", 1);
+    sockets = TcpServer::activationListenSockets();
+    ASSERT_EQ(sockets.size(), 3);
+    EXPECT_EQ(sockets[0].name, "trajectory");
+    EXPECT_EQ(sockets[2].name, "");
+
+    unsetenv("LISTEN_PID");
+    unsetenv("LISTEN_FDS");
+    unsetenv("LISTEN_FDNAMES");
+}
+#endif
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
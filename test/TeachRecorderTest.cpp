@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "Elite/PathSimplifier.hpp"
+#include "Elite/TeachRecorder.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+
+using namespace ELITE;
+using namespace ELITE::TEACH;
+
+static PathSample makeSample(double time, double joint0, double joint1 = 0) {
+    PathSample sample;
+    sample.time = time;
+    sample.joints[0] = joint0;
+    sample.joints[1] = joint1;
+    sample.tcp[0] = joint0 * 0.5;
+    return sample;
+}
+
+static std::vector<PathSample> simplify(PathSimplifier& simplifier, const std::vector<PathSample>& samples) {
+    std::vector<PathSample> waypoints;
+    PathSample waypoint;
+    for (auto& sample : samples) {
+        if (simplifier.add(sample, waypoint)) {
+            waypoints.push_back(waypoint);
+        }
+    }
+    if (simplifier.finish(waypoint)) {
+        waypoints.push_back(waypoint);
+    }
+    return waypoints;
+}
+
+TEST(TeachRecorderTest, straight_line_is_two_waypoints) {
+    PathSimplifier simplifier(0.001, 0.001, 1000);
+    std::vector<PathSample> samples;
+    for (int i = 0; i <= 500; i++) {
+        samples.push_back(makeSample(i * 0.002, i * 0.001, -i * 0.002));
+    }
+    auto waypoints = simplify(simplifier, samples);
+    ASSERT_EQ(waypoints.size(), 2);
+    EXPECT_DOUBLE_EQ(waypoints[0].time, 0);
+    EXPECT_DOUBLE_EQ(waypoints[1].time, 1.0);
+    EXPECT_DOUBLE_EQ(waypoints[1].joints[0], 0.5);
+}
+
+TEST(TeachRecorderTest, corner_and_pause_are_kept) {
+    PathSimplifier simplifier(0.001, 0, 1000);
+    std::vector<PathSample> samples;
+    double t = 0;
+    // Move, pause, then move another joint
+    for (int i = 0; i <= 100; i++, t += 0.01) {
+        samples.push_back(makeSample(t, i * 0.01));
+    }
+    for (int i = 0; i < 100; i++, t += 0.01) {
+        samples.push_back(makeSample(t, 1.0));
+    }
+    for (int i = 1; i <= 100; i++, t += 0.01) {
+        samples.push_back(makeSample(t, 1.0, i * 0.01));
+    }
+    auto waypoints = simplify(simplifier, samples);
+    ASSERT_EQ(waypoints.size(), 4);
+    EXPECT_NEAR(waypoints[1].time, 1.0, 0.011);
+    EXPECT_NEAR(waypoints[2].time, 2.0, 0.011);
+    EXPECT_DOUBLE_EQ(waypoints[3].joints[1], 1.0);
+}
+
+TEST(TeachRecorderTest, samples_within_tolerance) {
+    const double tolerance = 0.005;
+    PathSimplifier simplifier(tolerance, 0, 1000);
+    std::vector<PathSample> samples;
+    for (int i = 0; i <= 1000; i++) {
+        double t = i * 0.004;
+        samples.push_back(makeSample(t, std::sin(t), 0.3 * std::cos(2 * t)));
+    }
+    auto waypoints = simplify(simplifier, samples);
+    EXPECT_LT(waypoints.size(), 100);
+    EXPECT_GT(waypoints.size(), 2);
+
+    // Every sample is within the tolerance of the segment around it
+    size_t segment = 1;
+    for (auto& sample : samples) {
+        while (segment + 1 < waypoints.size() && sample.time > waypoints[segment].time) {
+            segment++;
+        }
+        double joint, position;
+        PathSimplifier::deviation(waypoints[segment - 1], waypoints[segment], sample, joint, position);
+        EXPECT_LE(joint, tolerance + 1e-12);
+    }
+}
+
+TEST(TeachRecorderTest, segment_is_bounded) {
+    PathSimplifier simplifier(0.001, 0.001, 10);
+    std::vector<PathSample> samples;
+    for (int i = 0; i <= 100; i++) {
+        samples.push_back(makeSample(i * 0.002, 0));
+    }
+    auto waypoints = simplify(simplifier, samples);
+    // A waypoint every 10 samples
+    ASSERT_EQ(waypoints.size(), 11);
+    EXPECT_DOUBLE_EQ(waypoints[1].time, 10 * 0.002);
+
+    simplifier.reset();
+    PathSample waypoint;
+    EXPECT_TRUE(simplifier.add(makeSample(5, 1), waypoint));
+    EXPECT_DOUBLE_EQ(waypoint.time, 5);
+    EXPECT_FALSE(simplifier.finish(waypoint));
+}
+
+// A taught move of joint 0 to 1 rad, a pause, then joint 1 to 1 rad, 10 ms frames from controller time 100 s
+static void teach(FakeFrameSource& frames) {
+    double t = 100;
+    vector6d_t joints{};
+    auto frame = [&]() {
+        frames.set("timestamp", t);
+        frames.set("actual_joint_positions", joints);
+        frames.set("actual_TCP_pose", vector6d_t{joints[0] * 0.5, joints[1] * 0.5, 0, 0, 0, 0});
+        frames.frame();
+        t += 0.01;
+    };
+    for (int i = 0; i <= 100; i++) {
+        joints[0] = i * 0.01;
+        frame();
+    }
+    for (int i = 0; i < 100; i++) {
+        frame();
+    }
+    for (int i = 1; i <= 100; i++) {
+        joints[1] = i * 0.01;
+        frame();
+    }
+}
+
+TEST(TeachRecorderTest, recorder_records_frames) {
+    FakeFrameSource frames;
+    TeachRecorder recorder(frames);
+    // Nothing is recorded before start()
+    frames.set("actual_joint_positions", vector6d_t{});
+    frames.frame();
+    EXPECT_EQ(recorder.sampleCount(), 0);
+
+    TeachRecorderConfig config;
+    config.joint_tolerance = 0.001;
+    config.position_tolerance = 0;
+    ASSERT_TRUE(recorder.start(config));
+    EXPECT_FALSE(recorder.start(config));
+    EXPECT_TRUE(recorder.isRecording());
+    teach(frames);
+    // A frame without the joint positions is not a sample
+    frames.erase("actual_joint_positions");
+    frames.frame();
+    EXPECT_EQ(recorder.sampleCount(), 301);
+
+    auto path = recorder.stop();
+    EXPECT_FALSE(recorder.isRecording());
+    ASSERT_EQ(path.size(), 4);
+    // The times are from the first frame, the pause is kept in the durations
+    EXPECT_DOUBLE_EQ(path[0].time, 0);
+    EXPECT_DOUBLE_EQ(path[0].duration, 0);
+    EXPECT_NEAR(path[1].time, 1.0, 1e-9);
+    EXPECT_NEAR(path[2].duration, 0.99, 0.011);
+    EXPECT_NEAR(path[3].time, 3.0, 1e-9);
+    EXPECT_DOUBLE_EQ(path[3].joint_positions[0], 1.0);
+    EXPECT_DOUBLE_EQ(path[3].joint_positions[1], 1.0);
+    EXPECT_DOUBLE_EQ(path[3].tcp_pose[1], 0.5);
+    double total = 0;
+    for (auto& waypoint : path) {
+        total += waypoint.duration;
+    }
+    EXPECT_NEAR(total, path.back().time, 1e-9);
+
+    // Frames after stop() are not recorded
+    frames.set("actual_joint_positions", vector6d_t{2, 0, 0, 0, 0, 0});
+    frames.frame();
+    EXPECT_EQ(recorder.sampleCount(), 301);
+    EXPECT_EQ(recorder.getWaypoints().size(), 4);
+}
+
+TEST(TeachRecorderTest, recorder_replays_path) {
+    FakeFrameSource frames;
+    TeachRecorder recorder(frames);
+    ASSERT_TRUE(recorder.start());
+    teach(frames);
+    auto path = recorder.stop();
+    ASSERT_GE(path.size(), 3);
+
+    FakeCommandWriter driver;
+    ASSERT_TRUE(TeachRecorder::writeTrajectory(driver, path, 0.01f, 200));
+    auto actions = driver.controlActions();
+    ASSERT_EQ(actions.size(), 1);
+    EXPECT_EQ(actions[0].action, TrajectoryControlAction::START);
+    EXPECT_EQ(actions[0].point_number, (int)path.size() - 1);
+    EXPECT_EQ(actions[0].timeout_ms, 200);
+    // The robot is at the first waypoint, every other one is a joint point with its duration
+    auto points = driver.trajectoryPoints();
+    ASSERT_EQ(points.size(), path.size() - 1);
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i].positions, path[i + 1].joint_positions);
+        EXPECT_FLOAT_EQ(points[i].time, path[i + 1].duration);
+        EXPECT_FLOAT_EQ(points[i].blend_radius, 0.01f);
+        EXPECT_FALSE(points[i].cartesian);
+    }
+
+    FakeCommandWriter short_driver;
+    EXPECT_FALSE(TeachRecorder::writeTrajectory(short_driver, {path[0]}, 0, 200));
+    EXPECT_TRUE(short_driver.controlActions().empty());
+    FakeCommandWriter offline;
+    offline.connected = false;
+    EXPECT_FALSE(TeachRecorder::writeTrajectory(offline, path, 0, 200));
+    EXPECT_TRUE(offline.trajectoryPoints().empty());
+}
+
+TEST(TeachRecorderTest, recorder_unregisters_on_destruction) {
+    FakeFrameSource frames;
+    {
+        TeachRecorder recorder(frames);
+        EXPECT_EQ(frames.callbackCount(), 1);
+    }
+    EXPECT_EQ(frames.callbackCount(), 0);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
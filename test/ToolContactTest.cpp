@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "Elite/ContactResidual.hpp"
+#include "Elite/ToolContactDetector.hpp"
+#include "FakeCommandWriter.hpp"
+#include "FakeFrameSource.hpp"
+
+using namespace ELITE;
+
+TEST(ToolContactTest, first_sample_is_baseline) {
+    CONTACT::ResidualFilter filter(0.5, 0.01);
+    EXPECT_DOUBLE_EQ(filter.update(12.0), 0);
+    EXPECT_DOUBLE_EQ(filter.baseline(), 12.0);
+    EXPECT_DOUBLE_EQ(filter.update(12.0), 0);
+
+    // reset() takes a new baseline
+    filter.reset();
+    EXPECT_DOUBLE_EQ(filter.update(-3.0), 0);
+    EXPECT_DOUBLE_EQ(filter.baseline(), -3.0);
+}
+
+TEST(ToolContactTest, step_is_detected_within_frames) {
+    CONTACT::ResidualFilter filter(0.5, 0.01);
+    const double threshold = 5;
+    filter.update(2.0);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_LT(std::abs(filter.update(2.0)), threshold);
+        filter.adapt();
+    }
+    // A 10 N step crosses a 5 N threshold in the first frame with filter_alpha 0.5
+    EXPECT_GE(filter.update(12.0), threshold);
+    EXPECT_GT(filter.update(12.0), 7.0);
+}
+
+TEST(ToolContactTest, slow_drift_is_followed) {
+    CONTACT::ResidualFilter filter(0.5, 0.05);
+    const double threshold = 1;
+    double value = 0;
+    filter.update(value);
+    // 0.01 per frame, 10 over 1000 frames
+    for (int i = 0; i < 1000; i++) {
+        value += 0.01;
+        double residual = filter.update(value);
+        EXPECT_LT(std::abs(residual), threshold);
+        filter.adapt();
+    }
+    EXPECT_NEAR(filter.baseline(), value, 0.5);
+}
+
+TEST(ToolContactTest, baseline_holds_during_contact) {
+    CONTACT::ResidualFilter filter(1, 0.1);
+    filter.update(0);
+    // Without adapt() the residual of a contact stays
+    for (int i = 0; i < 50; i++) {
+        EXPECT_DOUBLE_EQ(filter.update(3.0), 3.0);
+    }
+    EXPECT_DOUBLE_EQ(filter.baseline(), 0);
+
+    // A fixed baseline (baseline_alpha 0) never moves
+    CONTACT::ResidualFilter fixed(1, 0);
+    fixed.update(1.0);
+    fixed.update(4.0);
+    fixed.adapt();
+    EXPECT_DOUBLE_EQ(fixed.baseline(), 1.0);
+}
+
+// A frame with the TCP force 'fx' along x
+static void forceFrame(FakeFrameSource& frames, double fx, double timestamp) {
+    frames.set("timestamp", timestamp);
+    frames.set("actual_TCP_force", vector6d_t{fx, 0, 0, 0, 0, 0});
+    frames.frame();
+}
+
+static ToolContactConfig forceConfig() {
+    ToolContactConfig config;
+    config.force_threshold = 5;
+    config.filter_alpha = 1;
+    config.baseline_alpha = 0;
+    config.debounce_frames = 2;
+    return config;
+}
+
+TEST(ToolContactTest, detector_debounce_and_latch) {
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    ToolContactDetector detector(frames, driver);
+    std::vector<ToolContactEvent> events;
+    detector.setContactCallback([&](const ToolContactEvent& event) { events.push_back(event); });
+    EXPECT_FALSE(detector.arm(ToolContactConfig()));
+    ASSERT_TRUE(detector.arm(forceConfig()));
+    EXPECT_TRUE(detector.isArmed());
+
+    // The first frame is the baseline, a single frame over the threshold is debounced
+    forceFrame(frames, 1, 0.000);
+    forceFrame(frames, 11, 0.002);
+    forceFrame(frames, 2, 0.004);
+    EXPECT_FALSE(detector.inContact());
+    EXPECT_EQ(driver.toolContactWrites(), 0);
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+
+    forceFrame(frames, 11, 0.006);
+    forceFrame(frames, 11, 0.008);
+    EXPECT_TRUE(detector.inContact());
+    EXPECT_FALSE(detector.isArmed());
+    EXPECT_EQ(driver.toolContactWrites(), 1);
+    // The driver blocks the motion until the contact is released
+    EXPECT_TRUE(driver.toolContact());
+    EXPECT_FALSE(driver.writeServoj(vector6d_t{}, 100));
+
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].source, ToolContactSource::FORCE);
+    EXPECT_EQ(events[0].joint, -1);
+    EXPECT_DOUBLE_EQ(events[0].residual, 10);
+    EXPECT_DOUBLE_EQ(events[0].timestamp, 0.008);
+    EXPECT_TRUE(events[0].stop_sent);
+    ToolContactEvent last;
+    ASSERT_TRUE(detector.getLastContact(last));
+    EXPECT_DOUBLE_EQ(last.timestamp, 0.008);
+
+    // Disarmed after the contact, no second stop
+    forceFrame(frames, 11, 0.010);
+    EXPECT_EQ(driver.toolContactWrites(), 1);
+    EXPECT_EQ(events.size(), 1);
+    EXPECT_EQ(detector.getStats().contacts, 1);
+}
+
+TEST(ToolContactTest, detector_release) {
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    ToolContactDetector detector(frames, driver);
+    ASSERT_TRUE(detector.arm(forceConfig()));
+    forceFrame(frames, 0, 0.000);
+    forceFrame(frames, 20, 0.002);
+    forceFrame(frames, 20, 0.004);
+    ASSERT_TRUE(detector.inContact());
+
+    detector.release();
+    EXPECT_FALSE(detector.inContact());
+    EXPECT_FALSE(driver.toolContact());
+    EXPECT_EQ(driver.toolContactClears(), 1);
+    EXPECT_TRUE(driver.writeServoj(vector6d_t{}, 100));
+
+    // Armed again, the baseline is taken from the next frame: the force held at 20 is not a contact
+    ASSERT_TRUE(detector.arm(forceConfig()));
+    forceFrame(frames, 20, 0.006);
+    forceFrame(frames, 20, 0.008);
+    forceFrame(frames, 20, 0.010);
+    EXPECT_FALSE(detector.inContact());
+    EXPECT_EQ(driver.toolContactWrites(), 1);
+}
+
+TEST(ToolContactTest, detector_joint_current_and_stop_time) {
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    driver.connected = false;
+    ToolContactDetector detector(frames, driver);
+    ToolContactConfig config;
+    config.current_thresholds = {0, 0, 0.5, 0, 0, 0};
+    config.filter_alpha = 1;
+    config.baseline_alpha = 0;
+    config.debounce_frames = 1;
+    ASSERT_TRUE(detector.arm(config));
+
+    frames.set("timestamp", 1.0);
+    frames.set("actual_joint_speeds", vector6d_t{0.2, 0.2, 0.2, 0.2, 0.2, 0.2});
+    frames.set("actual_joint_current", vector6d_t{1, 1, 1, 1, 1, 1});
+    frames.frame();
+    // Joint 0 isn't watched
+    frames.set("actual_joint_current", vector6d_t{5, 1, 1, 1, 1, 1});
+    frames.frame();
+    EXPECT_FALSE(detector.inContact());
+    frames.set("timestamp", 1.002);
+    frames.set("actual_joint_current", vector6d_t{5, 1, 0.2, 1, 1, 1});
+    frames.frame();
+    ASSERT_TRUE(detector.inContact());
+    ToolContactEvent event;
+    ASSERT_TRUE(detector.getLastContact(event));
+    EXPECT_EQ(event.source, ToolContactSource::JOINT_CURRENT);
+    EXPECT_EQ(event.joint, 2);
+    EXPECT_DOUBLE_EQ(event.residual, -0.8);
+    // The driver is not connected
+    EXPECT_FALSE(event.stop_sent);
+
+    // The stop time is measured until all joints are below 'stop_speed'
+    frames.set("timestamp", 1.010);
+    frames.frame();
+    EXPECT_DOUBLE_EQ(detector.getStats().last_stop_time, -1);
+    frames.set("timestamp", 1.052);
+    frames.set("actual_joint_speeds", vector6d_t{});
+    frames.frame();
+    EXPECT_NEAR(detector.getStats().last_stop_time, 0.05, 1e-9);
+}
+
+TEST(ToolContactTest, detector_unregisters_on_destruction) {
+    FakeFrameSource frames;
+    FakeCommandWriter driver;
+    {
+        ToolContactDetector detector(frames, driver);
+        EXPECT_EQ(frames.callbackCount(), 1);
+    }
+    EXPECT_EQ(frames.callbackCount(), 0);
+    frames.frame();
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "Elite/Trace.hpp"
+
+using namespace ELITE;
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static size_t countOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+static uint64_t readVarint(const std::string& data, size_t& pos) {
+    uint64_t value = 0;
+    for (int shift = 0; pos < data.size(); shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    return value;
+}
+
+TEST(TraceTest, disabled_records_nothing) {
+    TRACE::disable();
+    TRACE::clear();
+    {
+        ELITE_TRACE_SCOPE("disabled.scope");
+        ELITE_TRACE_INSTANT("disabled.instant");
+    }
+    ASSERT_TRUE(TRACE::dumpChromeJson("trace_test.json"));
+    std::string json = readFile("trace_test.json");
+    EXPECT_EQ(json.find("disabled."), std::string::npos);
+    std::remove("trace_test.json");
+}
+
+TEST(TraceTest, chrome_json) {
+    TRACE::enable();
+    TRACE::clear();
+    std::thread worker([]() {
+        TRACE::setThreadName("worker \"1\"");
+        for (int i = 0; i < 10; i++) {
+            ELITE_TRACE_SCOPE("worker.step");
+            ELITE_TRACE_INSTANT("worker.tick");
+        }
+    });
+    worker.join();
+    {
+        ELITE_TRACE_SCOPE("main.outer");
+        ELITE_TRACE_SCOPE("main.inner");
+    }
+    TRACE::disable();
+    ASSERT_TRUE(TRACE::dumpChromeJson("trace_test.json"));
+    std::string json = readFile("trace_test.json");
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(countOf(json, "\"name\":\"worker.step\",\"ph\":\"B\""), 10);
+    EXPECT_EQ(countOf(json, "\"name\":\"worker.step\",\"ph\":\"E\""), 10);
+    EXPECT_EQ(countOf(json, "\"name\":\"worker.tick\",\"ph\":\"i\""), 10);
+    EXPECT_EQ(countOf(json, "main.outer"), 2);
+    // The thread exited, its events are kept, and its name is escaped
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker \\\"1\\\"\"}"), std::string::npos);
+    // Nested slices are in time order
+    EXPECT_LT(json.find("\"main.outer\",\"ph\":\"B\""), json.find("\"main.inner\",\"ph\":\"B\""));
+    EXPECT_LT(json.find("\"main.inner\",\"ph\":\"E\""), json.find("\"main.outer\",\"ph\":\"E\""));
+
+    TRACE::clear();
+    ASSERT_TRUE(TRACE::dumpChromeJson("trace_test.json"));
+    json = readFile("trace_test.json");
+    EXPECT_EQ(json.find("worker.step"), std::string::npos);
+    EXPECT_EQ(json.find("worker \\\"1\\\""), std::string::npos);
+    std::remove("trace_test.json");
+}
+
+TEST(TraceTest, ring_keeps_the_newest) {
+    TRACE::enable(64);
+    TRACE::clear();
+    std::thread worker([]() {
+        for (int i = 0; i < 1000; i++) {
+            ELITE_TRACE_INSTANT(i < 990 ? "old" : "new");
+        }
+    });
+    worker.join();
+    TRACE::disable();
+    ASSERT_TRUE(TRACE::dumpChromeJson("trace_test.json"));
+    std::string json = readFile("trace_test.json");
+    EXPECT_EQ(countOf(json, "\"new\""), 10);
+    // The oldest slot of a full ring is the next one to be written, it is not reported
+    EXPECT_EQ(countOf(json, "\"old\""), 53);
+    std::remove("trace_test.json");
+    TRACE::enable();
+    TRACE::disable();
+}
+
+TEST(TraceTest, perfetto) {
+    TRACE::enable();
+    TRACE::clear();
+    std::thread worker([]() {
+        TRACE::setThreadName("perfetto_worker");
+        ELITE_TRACE_SCOPE("perfetto.slice");
+        ELITE_TRACE_INSTANT("perfetto.instant");
+    });
+    worker.join();
+    TRACE::disable();
+    ASSERT_TRUE(TRACE::dumpPerfetto("trace_test.pftrace"));
+    std::string data = readFile("trace_test.pftrace");
+
+    // Trace: repeated TracePacket packet = 1
+    size_t pos = 0;
+    int descriptors = 0;
+    int events = 0;
+    while (pos < data.size()) {
+        ASSERT_EQ(readVarint(data, pos), (1u << 3) | 2);
+        size_t length = readVarint(data, pos);
+        ASSERT_LE(pos + length, data.size());
+        std::string packet = data.substr(pos, length);
+        pos += length;
+        size_t field = 0;
+        while (field < packet.size()) {
+            uint64_t tag = readVarint(packet, field);
+            if ((tag & 7) == 2) {
+                size_t size = readVarint(packet, field);
+                descriptors += (tag >> 3) == 60;
+                events += (tag >> 3) == 11;
+                field += size;
+            } else {
+                readVarint(packet, field);
+            }
+        }
+    }
+    EXPECT_GE(descriptors, 1);
+    EXPECT_EQ(events, 3);
+    EXPECT_NE(data.find("perfetto_worker"), std::string::npos);
+    EXPECT_NE(data.find("perfetto.instant"), std::string::npos);
+    std::remove("trace_test.pftrace");
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -98,6 +98,42 @@ TEST(TRAJECTORY_INTERFACE, write_point) {
     EXPECT_EQ(motion_result, (TrajectoryMotionResult)send_result);
 }
 
+TEST(TRAJECTORY_INTERFACE, write_spline_point) {
+    auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
+    std::unique_ptr<TrajectoryInterface> trajectory_ins = std::make_unique<TrajectoryInterface>(TRAJECTORY_INTERFACE_TEST_PORT, tcp_resource);
+    std::unique_ptr<TcpClient> client = std::make_unique<TcpClient>();
+
+    EXPECT_NO_THROW(client->connect("127.0.0.1", TRAJECTORY_INTERFACE_TEST_PORT));
+
+    std::this_thread::sleep_for(50ms);
+
+    vector6d_t positions = {1, 2, 3, 4, 5, 6};
+    vector6d_t velocities = {0.5, -0.5, 0, 0, 0, 1.5};
+    vector6d_t accelerations = {-2, 0, 0, 0, 0, 0.25};
+    int32_t buffer[TrajectoryInterface::TRAJECTORY_MESSAGE_LEN];
+
+    // Quintic: position, velocity and acceleration
+    ASSERT_TRUE(trajectory_ins->writeTrajectorySplinePoint(positions, velocities, &accelerations, 0.5));
+    int recv_len = boost::asio::read(*client->socket_ptr, boost::asio::buffer(buffer, sizeof(buffer)));
+    EXPECT_EQ(recv_len, sizeof(buffer));
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ((int32_t)::htonl(buffer[i]), (int32_t)(positions[i] * CONTROL::POS_ZOOM_RATIO));
+        EXPECT_EQ((int32_t)::htonl(buffer[i + 6]), (int32_t)(velocities[i] * CONTROL::COMMON_ZOOM_RATIO));
+        EXPECT_EQ((int32_t)::htonl(buffer[i + 12]), (int32_t)(accelerations[i] * CONTROL::COMMON_ZOOM_RATIO));
+    }
+    EXPECT_EQ(::htonl(buffer[18]), 0.5 * CONTROL::TIME_ZOOM_RATIO);
+    EXPECT_EQ(::htonl(buffer[19]), (int)TrajectoryInterface::SPLINE_QUINTIC);
+    EXPECT_EQ(::htonl(buffer[20]), (int)TrajectoryMotionType::SPLINE);
+
+    // Cubic: no acceleration
+    ASSERT_TRUE(trajectory_ins->writeTrajectorySplinePoint(positions, velocities, nullptr, 0.5));
+    recv_len = boost::asio::read(*client->socket_ptr, boost::asio::buffer(buffer, sizeof(buffer)));
+    EXPECT_EQ(recv_len, sizeof(buffer));
+    EXPECT_EQ(::htonl(buffer[12]), 0);
+    EXPECT_EQ(::htonl(buffer[19]), (int)TrajectoryInterface::SPLINE_CUBIC);
+    EXPECT_EQ(::htonl(buffer[20]), (int)TrajectoryMotionType::SPLINE);
+}
+
 TEST(TRAJECTORY_INTERFACE, disconnect) { 
     auto tcp_resource = std::make_shared<TcpServer::StaticResource>();
     std::unique_ptr<TrajectoryInterface> trajectory_ins;
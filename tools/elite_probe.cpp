@@ -0,0 +1,560 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Elite Robots.
+//
+// elite_probe.cpp
+// Measures the RTSI frame jitter, the reverse socket command latency, the primary port message rate and the dashboard and
+// script command round trips of a robot or of the simulator.
+#include <Elite/DashboardClient.hpp>
+#include <Elite/DataType.hpp>
+#include <Elite/EliteDriver.hpp>
+#include <Elite/EliteException.hpp>
+#include <Elite/Log.hpp>
+#include <Elite/PrimaryPortInterface.hpp>
+#include <Elite/RobotConfPackage.hpp>
+#include <Elite/RtUtils.hpp>
+#include <Elite/RtsiClientInterface.hpp>
+#include <Elite/RtsiRecipe.hpp>
+
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+using namespace ELITE;
+using namespace std::chrono;
+namespace po = boost::program_options;
+
+namespace {
+
+struct ProbeOptions {
+    std::string robot_ip;
+    std::string local_ip;
+    std::string script_file;
+    std::set<std::string> tests;
+    std::vector<double> rtsi_rates;
+    double duration = 10;
+    int count = 200;
+    bool headless = false;
+    bool allow_motion = false;
+};
+
+/**
+ * @brief The samples of one measurement, and the numbers which are not distributions (rates, losses)
+ *
+ */
+struct Measurement {
+    std::string name;
+    std::string unit;
+    std::vector<double> samples;
+    std::map<std::string, double> extra;
+};
+
+const double PERCENTILES[] = {50, 90, 99, 99.9};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return NAN;
+    }
+    double rank = p / 100 * (sorted.size() - 1);
+    size_t low = (size_t)rank;
+    size_t high = std::min(low + 1, sorted.size() - 1);
+    return sorted[low] + (rank - low) * (sorted[high] - sorted[low]);
+}
+
+double mean(const std::vector<double>& values) {
+    double sum = 0;
+    for (double v : values) {
+        sum += v;
+    }
+    return values.empty() ? NAN : sum / values.size();
+}
+
+double millisecondsSince(steady_clock::time_point start) {
+    return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+std::string formatNumber(double value) {
+    if (std::isnan(value)) {
+        return "-";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+void printTable(const std::vector<Measurement>& results) {
+    std::printf("\n%-34s %7s %9s %9s %9s %9s %9s %9s %9s  %s\n", "measurement", "n", "min", "p50", "p90", "p99", "p99.9", "max",
+                "mean", "unit");
+    for (const auto& m : results) {
+        std::vector<double> sorted = m.samples;
+        std::sort(sorted.begin(), sorted.end());
+        std::printf("%-34s %7zu %9s", m.name.c_str(), sorted.size(), formatNumber(sorted.empty() ? NAN : sorted.front()).c_str());
+        for (double p : PERCENTILES) {
+            std::printf(" %9s", formatNumber(percentile(sorted, p)).c_str());
+        }
+        std::printf(" %9s %9s  %s\n", formatNumber(sorted.empty() ? NAN : sorted.back()).c_str(),
+                    formatNumber(mean(sorted)).c_str(), m.unit.c_str());
+        for (const auto& item : m.extra) {
+            std::printf("    %-30s %s\n", item.first.c_str(), formatNumber(item.second).c_str());
+        }
+    }
+}
+
+std::string jsonNumber(double value) {
+    if (std::isnan(value) || std::isinf(value)) {
+        return "null";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+// A quoted and escaped JSON string, e.g. the controller version reported by the robot may hold any character
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char text[8];
+                    std::snprintf(text, sizeof(text), "\\u%04x", (unsigned char)c);
+                    out += text;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+    return out + "\"";
+}
+
+std::string toJson(const ProbeOptions& options, const std::string& version, const std::vector<Measurement>& results) {
+    std::ostringstream out;
+    out << "{\n  \"robot_ip\": " << jsonString(options.robot_ip) << ",\n  \"controller_version\": " << jsonString(version)
+        << ",\n  \"measurements\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Measurement& m = results[i];
+        std::vector<double> sorted = m.samples;
+        std::sort(sorted.begin(), sorted.end());
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(m.name) << ", \"unit\": " << jsonString(m.unit)
+            << ", \"count\": " << sorted.size() << ", \"min\": " << jsonNumber(sorted.empty() ? NAN : sorted.front());
+        for (double p : PERCENTILES) {
+            std::ostringstream key;
+            key << "p" << p;
+            out << ", \"" << key.str() << "\": " << jsonNumber(percentile(sorted, p));
+        }
+        out << ", \"max\": " << jsonNumber(sorted.empty() ? NAN : sorted.back()) << ", \"mean\": " << jsonNumber(mean(sorted));
+        for (const auto& item : m.extra) {
+            out << ", " << jsonString(item.first) << ": " << jsonNumber(item.second);
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+/**
+ * The interval between RTSI frames on the host and by the controller timestamp. A controller interval longer than 1.5 periods
+ * is a lost frame.
+ */
+bool probeRtsi(const ProbeOptions& options, double rate, std::vector<Measurement>& results, std::string& version) {
+    RtsiClientInterface rtsi;
+    try {
+        rtsi.connect(options.robot_ip);
+        if (!rtsi.negotiateProtocolVersion()) {
+            ELITE_LOG_ERROR("RTSI protocol version negotiation failed");
+            return false;
+        }
+        version = rtsi.getControllerVersion().toString();
+        auto recipe = rtsi.setupOutputRecipe({"timestamp"}, rate);
+        if (!recipe || !rtsi.start()) {
+            ELITE_LOG_ERROR("RTSI can't start %.0f Hz output", rate);
+            return false;
+        }
+
+        std::string prefix = "rtsi." + std::to_string((int)rate) + "Hz.";
+        Measurement host{prefix + "host_interval", "ms", {}, {}};
+        Measurement controller{prefix + "controller_interval", "ms", {}, {}};
+        Measurement jitter{prefix + "host_jitter", "ms", {}, {}};
+        double period_ms = 1000 / rate;
+        uint64_t lost = 0;
+        steady_clock::time_point last_arrival;
+        double last_timestamp = NAN;
+        auto start = steady_clock::now();
+        while (millisecondsSince(start) < options.duration * 1000) {
+            if (!rtsi.receiveData(recipe)) {
+                continue;
+            }
+            auto arrival = steady_clock::now();
+            double timestamp = 0;
+            recipe->getValue("timestamp", timestamp);
+            if (!std::isnan(last_timestamp)) {
+                double host_ms = duration<double, std::milli>(arrival - last_arrival).count();
+                double controller_ms = (timestamp - last_timestamp) * 1000;
+                host.samples.push_back(host_ms);
+                controller.samples.push_back(controller_ms);
+                jitter.samples.push_back(std::fabs(host_ms - period_ms));
+                if (controller_ms > 1.5 * period_ms) {
+                    lost += (uint64_t)std::lround(controller_ms / period_ms) - 1;
+                }
+            }
+            last_arrival = arrival;
+            last_timestamp = timestamp;
+        }
+        rtsi.pause();
+        rtsi.disconnect();
+        double seconds = millisecondsSince(start) / 1000;
+        host.extra["rate_hz"] = (host.samples.size() + 1) / seconds;
+        controller.extra["lost_frames"] = (double)lost;
+        results.push_back(host);
+        results.push_back(controller);
+        results.push_back(jitter);
+    } catch (const EliteException& e) {
+        ELITE_LOG_ERROR("RTSI %.0f Hz probe failed: %s", rate, e.what());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * The primary port sends the robot state messages periodically, every completed getPackage() is one message.
+ */
+bool probePrimary(const ProbeOptions& options, std::vector<Measurement>& results) {
+    PrimaryPortInterface primary;
+    if (!primary.connect(options.robot_ip)) {
+        ELITE_LOG_ERROR("Can't connect to the primary port");
+        return false;
+    }
+    auto kinematics = std::make_shared<KinematicsInfo>();
+    Measurement interval{"primary.robot_state_interval", "ms", {}, {}};
+    uint64_t timeouts = 0;
+    steady_clock::time_point last;
+    bool first = true;
+    auto start = steady_clock::now();
+    while (millisecondsSince(start) < options.duration * 1000) {
+        if (!primary.getPackage(kinematics, 1000)) {
+            timeouts++;
+            continue;
+        }
+        auto now = steady_clock::now();
+        if (!first) {
+            interval.samples.push_back(duration<double, std::milli>(now - last).count());
+        }
+        first = false;
+        last = now;
+    }
+    primary.disconnect();
+    interval.extra["rate_hz"] = (interval.samples.size() + 1) / (millisecondsSince(start) / 1000);
+    interval.extra["timeouts"] = (double)timeouts;
+    results.push_back(interval);
+    return true;
+}
+
+bool probeDashboard(const ProbeOptions& options, std::vector<Measurement>& results) {
+    DashboardClient dashboard;
+    if (!dashboard.connect(options.robot_ip)) {
+        ELITE_LOG_ERROR("Can't connect to the dashboard");
+        return false;
+    }
+    Measurement round_trip{"dashboard.echo_round_trip", "ms", {}, {}};
+    uint64_t failures = 0;
+    for (int i = 0; i < options.count; i++) {
+        auto start = steady_clock::now();
+        if (dashboard.echo()) {
+            round_trip.samples.push_back(millisecondsSince(start));
+        } else {
+            failures++;
+        }
+    }
+    dashboard.disconnect();
+    round_trip.extra["failures"] = (double)failures;
+    results.push_back(round_trip);
+    return true;
+}
+
+bool probeScriptCommand(EliteDriver& driver, const ProbeOptions& options, std::vector<Measurement>& results) {
+    Measurement round_trip{"script_command.ping_round_trip", "ms", {}, {}};
+    uint64_t failures = 0;
+    for (int i = 0; i < options.count; i++) {
+        ScriptCommandAck ack = driver.pingScriptCommand(1000).get();
+        if (ack.status == ScriptCommandStatus::SUCCESS) {
+            round_trip.samples.push_back(ack.latency.count() / 1000.0);
+        } else {
+            failures++;
+        }
+    }
+    round_trip.extra["failures"] = (double)failures;
+    results.push_back(round_trip);
+    return true;
+}
+
+/**
+ * From writeSpeedj() to the first RTSI frame whose target speed of joint 6 follows the command. The joint turns a few
+ * milliradians back and forth.
+ */
+bool probeReverse(EliteDriver& driver, const ProbeOptions& options, std::vector<Measurement>& results) {
+    constexpr double SPEED = 0.02;
+    RtsiClientInterface rtsi;
+    Measurement latency{"reverse.speedj_to_rtsi_latency", "ms", {}, {}};
+    uint64_t timeouts = 0;
+    try {
+        rtsi.connect(options.robot_ip);
+        if (!rtsi.negotiateProtocolVersion()) {
+            return false;
+        }
+        auto recipe = rtsi.setupOutputRecipe({"target_joint_speeds"}, 500);
+        if (!recipe || !rtsi.start()) {
+            ELITE_LOG_ERROR("RTSI can't start the 500 Hz output");
+            return false;
+        }
+        // Waits for a frame where joint 6 is commanded to 'speed', returns the time from 'start'
+        auto waitSpeed = [&](double speed, steady_clock::time_point start) {
+            vector6d_t speeds;
+            while (millisecondsSince(start) < 1000) {
+                if (!rtsi.receiveData(recipe) || !recipe->getValue("target_joint_speeds", speeds)) {
+                    continue;
+                }
+                bool reached = speed == 0 ? std::fabs(speeds[5]) < 1e-6 : speeds[5] * speed > 0;
+                if (reached) {
+                    return millisecondsSince(start);
+                }
+            }
+            return -1.0;
+        };
+        for (int i = 0; i < options.count; i++) {
+            double speed = i % 2 ? -SPEED : SPEED;
+            vector6d_t command{0, 0, 0, 0, 0, speed};
+            auto start = steady_clock::now();
+            if (!driver.writeSpeedj(command, 100)) {
+                ELITE_LOG_ERROR("Send speedj fail");
+                break;
+            }
+            double ms = waitSpeed(speed, start);
+            if (ms >= 0) {
+                latency.samples.push_back(ms);
+            } else {
+                timeouts++;
+            }
+            driver.writeSpeedj(vector6d_t{0, 0, 0, 0, 0, 0}, 100);
+            if (waitSpeed(0, steady_clock::now()) < 0) {
+                ELITE_LOG_ERROR("Joint 6 does not stop");
+                break;
+            }
+        }
+        driver.writeIdle(100);
+        rtsi.pause();
+        rtsi.disconnect();
+    } catch (const EliteException& e) {
+        ELITE_LOG_ERROR("Reverse socket probe failed: %s", e.what());
+        driver.writeIdle(100);
+        return false;
+    }
+    latency.extra["timeouts"] = (double)timeouts;
+    results.push_back(latency);
+    return true;
+}
+
+bool probeDriver(const ProbeOptions& options, std::vector<Measurement>& results) {
+    EliteDriverConfig config;
+    config.robot_ip = options.robot_ip;
+    config.local_ip = options.local_ip;
+    config.headless_mode = options.headless;
+    config.script_file_path = options.script_file;
+    std::unique_ptr<EliteDriver> driver;
+    try {
+        driver.reset(new EliteDriver(config));
+    } catch (const EliteException& e) {
+        ELITE_LOG_ERROR("Can't create the driver: %s", e.what());
+        return false;
+    }
+    if (options.headless && !driver->isRobotConnected() && !driver->sendExternalControlScript()) {
+        ELITE_LOG_ERROR("Fail to send the external control script");
+        return false;
+    }
+    ELITE_LOG_INFO("Waiting for the external control script");
+    if (!driver->waitRobotConnection(true, 30000)) {
+        ELITE_LOG_ERROR("The external control script did not connect");
+        return false;
+    }
+    bool ok = true;
+    if (options.tests.count("script")) {
+        ok = probeScriptCommand(*driver, options, results) && ok;
+    }
+    if (options.tests.count("reverse")) {
+        if (options.allow_motion) {
+            ok = probeReverse(*driver, options, results) && ok;
+        } else {
+            ELITE_LOG_WARN("The reverse socket latency moves joint 6 slightly, skipped without --allow-motion");
+        }
+    }
+    driver->stopControl();
+    return ok;
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& text) {
+    std::vector<T> values;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        std::istringstream converter(item);
+        T value;
+        if (!(converter >> value)) {
+            throw po::error("invalid list item '" + item + "'");
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    ProbeOptions options;
+    std::string tests;
+    std::string rates;
+    std::string json_path;
+    bool realtime = false;
+
+    po::options_description desc(
+        "Usage:\n"
+        "\t./elite-probe <--robot-ip=ip> [--tests=rtsi,primary,dashboard,script,reverse] [--json=path]\n"
+        "Parameters:");
+    desc.add_options()
+        ("help,h", "Print help message")
+        ("robot-ip", po::value<std::string>(&options.robot_ip)->required(),
+            "\tRequired. IP address of the robot or of the simulator.")
+        ("tests", po::value<std::string>(&tests)->default_value("rtsi,primary,dashboard"),
+            "\tOptional. Comma separated measurements: rtsi, primary, dashboard, script, reverse. "
+            "'script' and 'reverse' start the external control script.")
+        ("rtsi-rates", po::value<std::string>(&rates)->default_value("125,250,500"),
+            "\tOptional. Comma separated RTSI output frequencies (Hz).")
+        ("duration", po::value<double>(&options.duration)->default_value(10),
+            "\tOptional. Seconds of each RTSI and primary port measurement.")
+        ("count", po::value<int>(&options.count)->default_value(200),
+            "\tOptional. Round trips of each dashboard, script command and reverse socket measurement.")
+        ("json", po::value<std::string>(&json_path)->default_value(""),
+            "\tOptional. Write the results as JSON to this file, '-' for the standard output.")
+        ("local-ip", po::value<std::string>(&options.local_ip)->default_value(""),
+            "\tOptional. IP address of the local network interface.")
+        ("use-headless-mode", po::value<bool>(&options.headless)->default_value(false)->implicit_value(true),
+            "\tOptional. Send the external control script instead of waiting for the External Control plugin.")
+        ("script-file", po::value<std::string>(&options.script_file)->default_value("external_control.script"),
+            "\tOptional. Path of external_control.script.")
+        ("allow-motion", po::bool_switch(&options.allow_motion),
+            "\tOptional. Allow the reverse socket measurement, it turns joint 6 a few milliradians back and forth.")
+        ("realtime", po::bool_switch(&realtime),
+            "\tOptional. Lock the memory and run the probe with FIFO scheduling.");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        po::notify(vm);
+        for (const auto& test : parseList<std::string>(tests)) {
+            if (test != "rtsi" && test != "primary" && test != "dashboard" && test != "script" && test != "reverse") {
+                throw po::error("unknown test '" + test + "'");
+            }
+            options.tests.insert(test);
+        }
+        options.rtsi_rates = parseList<double>(rates);
+        if (options.duration <= 0 || options.count <= 0) {
+            throw po::error("duration and count must be positive");
+        }
+    } catch (const po::error& e) {
+        std::cerr << "Argument error: " << e.what() << "\n\n";
+        std::cerr << desc << "\n";
+        return 1;
+    }
+
+    if (realtime) {
+#if defined(__linux) || defined(linux) || defined(__linux__)
+        mlockall(MCL_CURRENT | MCL_FUTURE);
+        pthread_t handle = pthread_self();
+        RT_UTILS::setThreadFiFoScheduling(handle, RT_UTILS::getThreadFiFoMaxPriority());
+#else
+        ELITE_LOG_WARN("--realtime is only supported on Linux");
+#endif
+    }
+
+    std::vector<Measurement> results;
+    std::string version;
+    bool ok = true;
+    // A lost connection throws, the other measurements still run
+    auto guarded = [](const char* name, const std::function<bool()>& probe) {
+        try {
+            return probe();
+        } catch (const EliteException& e) {
+            ELITE_LOG_ERROR("The %s measurement failed: %s", name, e.what());
+            return false;
+        }
+    };
+    if (options.tests.count("rtsi")) {
+        for (double rate : options.rtsi_rates) {
+            ELITE_LOG_INFO("Measuring RTSI at %.0f Hz for %.0f s", rate, options.duration);
+            ok = guarded("rtsi", [&]() { return probeRtsi(options, rate, results, version); }) && ok;
+        }
+    }
+    if (options.tests.count("primary")) {
+        ELITE_LOG_INFO("Measuring the primary port for %.0f s", options.duration);
+        ok = guarded("primary", [&]() { return probePrimary(options, results); }) && ok;
+    }
+    if (options.tests.count("dashboard")) {
+        ELITE_LOG_INFO("Measuring the dashboard round trip");
+        ok = guarded("dashboard", [&]() { return probeDashboard(options, results); }) && ok;
+    }
+    if (options.tests.count("script") || options.tests.count("reverse")) {
+        ok = guarded("driver", [&]() { return probeDriver(options, results); }) && ok;
+    }
+
+    printTable(results);
+    if (!json_path.empty()) {
+        std::string json = toJson(options, version, results);
+        if (json_path == "-") {
+            std::cout << json;
+        } else {
+            std::ofstream file(json_path);
+            if (!(file << json)) {
+                ELITE_LOG_ERROR("Can't write %s", json_path.c_str());
+                return 1;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}